@@ -8,8 +8,8 @@ setlocal
     rem assure that cmake command exists
     call :assureHasCommand cmake
 
-    rem cmake
-    call :assureExecute cmake -DASSIMP_BUILD_ALL_EXPORTERS_BY_DEFAULT=OFF -DASSIMP_INSTALL=OFF -DCMAKE_BUILD_TYPE=Release CMakeLists.txt
+    rem cmake (with Draco, so that glTF files compressed with KHR_draco_mesh_compression are imported)
+    call :assureExecute cmake -DASSIMP_BUILD_ALL_EXPORTERS_BY_DEFAULT=OFF -DASSIMP_INSTALL=OFF -DASSIMP_BUILD_DRACO=ON -DCMAKE_BUILD_TYPE=Release CMakeLists.txt
     call :assureExecute cmake --build . --config Release
 
     rem pop from stack
@@ -40,9 +40,9 @@ removeVersion() {
     # Change to the target directory
     cd "$(dirname "$0")/Source/ThirdParty/assimp/assimp"
 
-    # Run cmake commands
-    # assureExecute cmake -DASSIMP_BUILD_ALL_EXPORTERS_BY_DEFAULT=OFF -DASSIMP_INSTALL=OFF  -DCMAKE_OSX_ARCHITECTURES="arm64;x86_64" -DCMAKE_BUILD_TYPE=Release CMakeLists.txt
-    assureExecute cmake -DASSIMP_BUILD_ALL_EXPORTERS_BY_DEFAULT=OFF -DASSIMP_INSTALL=OFF  -DCMAKE_OSX_ARCHITECTURES="arm64" -DCMAKE_BUILD_TYPE=Release CMakeLists.txt
+    # Run cmake commands (with Draco, so that glTF files compressed with KHR_draco_mesh_compression are imported)
+    # assureExecute cmake -DASSIMP_BUILD_ALL_EXPORTERS_BY_DEFAULT=OFF -DASSIMP_INSTALL=OFF -DASSIMP_BUILD_DRACO=ON -DCMAKE_OSX_ARCHITECTURES="arm64;x86_64" -DCMAKE_BUILD_TYPE=Release CMakeLists.txt
+    assureExecute cmake -DASSIMP_BUILD_ALL_EXPORTERS_BY_DEFAULT=OFF -DASSIMP_INSTALL=OFF -DASSIMP_BUILD_DRACO=ON -DCMAKE_OSX_ARCHITECTURES="arm64" -DCMAKE_BUILD_TYPE=Release CMakeLists.txt
     assureExecute cmake --build . --config Release
 
     ######### change assimp alias dylib to real dylib ########
@@ -53,8 +53,15 @@ removeVersion() {
     # for all *.dylib files in bin directory
     for lib_name in *.dylib; do
         lib_name_without_version=$(echo "$lib_name" | removeVersion)
+        old_install_name=$(otool -D "$lib_name" | tail -n 1)
         # change install path to itself
         install_name_tool -id "@rpath/$lib_name_without_version" "$lib_name"
+        # make the libraries that link it (e.g. assimp links draco) refer to the new install path
+        for other_lib_name in *.dylib; do
+            if [ "$other_lib_name" != "$lib_name" ] && [ ! -L "$other_lib_name" ]; then
+                install_name_tool -change "$old_install_name" "@rpath/$lib_name_without_version" "$other_lib_name"
+            fi
+        done
     done
 
     # for all .*\.dylib or .*\..*\.dylib alias files in lib directory
@@ -0,0 +1,104 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AiImporterPool.h"
+
+#include "LogAssetLoader.h"
+#include "RuntimeAssetImportSettings.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+
+void FAiImporterReturner::operator()(Assimp::Importer* const AiImporter) const {
+	FAiImporterPool::Get().Return(AiImporter);
+}
+
+FAiImporterPool& FAiImporterPool::Get() {
+	static FAiImporterPool Instance;
+	return Instance;
+}
+
+FPooledAiImporterPtr FAiImporterPool::Borrow() {
+	// take an idle importer if there is one
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (!IdleImporters.IsEmpty()) {
+			return FPooledAiImporterPtr(IdleImporters.Pop().Release());
+		}
+	}
+
+	// otherwise construct a new one (outside of the lock, since it is slow)
+	return FPooledAiImporterPtr(new Assimp::Importer);
+}
+
+UE::Tasks::FTask FAiImporterPool::WarmUpAsync() {
+	return UE::Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [this] {
+		    const auto& StartTime = FPlatformTime::Seconds();
+
+		    // construct the missing importers
+		    const auto& MaxNumIdleImporters = GetMaxNumIdleImporters();
+		    int32 NumImporters;
+		    {
+			    FScopeLock ScopeLock(&CriticalSection);
+			    NumImporters = MaxNumIdleImporters - IdleImporters.Num();
+		    }
+		    TArray<TUniquePtr<Assimp::Importer>> NewImporters;
+		    for (auto i = decltype(NumImporters){0}; i < NumImporters; ++i) {
+			    NewImporters.Add(MakeUnique<Assimp::Importer>());
+		    }
+
+		    // add them to the pool, up to its limit (loads may have returned
+		    // importers meanwhile)
+		    {
+			    FScopeLock ScopeLock(&CriticalSection);
+			    for (auto& NewImporter : NewImporters) {
+				    if (IdleImporters.Num() >= MaxNumIdleImporters) {
+					    break;
+				    }
+				    IdleImporters.Add(MoveTemp(NewImporter));
+			    }
+		    }
+
+		    UE_LOG(LogAssetLoader, Log,
+		           TEXT("Warmed up %d assimp importers in %.3f seconds."),
+		           NewImporters.Num(), FPlatformTime::Seconds() - StartTime);
+	    },
+	    LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+void FAiImporterPool::Empty() {
+	TArray<TUniquePtr<Assimp::Importer>> Importers;
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		Importers = MoveTemp(IdleImporters);
+	}
+}
+
+void FAiImporterPool::Return(Assimp::Importer* const AiImporter) {
+	if (nullptr == AiImporter) {
+		return;
+	}
+
+	// reset what loads set on the importer, and free any scene left in it
+	AiImporter->SetIOHandler(nullptr);
+	AiImporter->SetProgressHandler(nullptr);
+	AiImporter->SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, false);
+	AiImporter->FreeScene();
+
+	// keep the importer if the pool is not full
+	TUniquePtr<Assimp::Importer> Importer(AiImporter);
+	{
+		FScopeLock ScopeLock(&CriticalSection);
+		if (IdleImporters.Num() < GetMaxNumIdleImporters()) {
+			IdleImporters.Add(MoveTemp(Importer));
+		}
+	}
+
+	// otherwise delete it (outside of the lock)
+}
+
+int32 FAiImporterPool::GetMaxNumIdleImporters() {
+	return FMath::Max(
+	    GetDefault<URuntimeAssetImportSettings>()->NumPooledImporters, 0);
+}
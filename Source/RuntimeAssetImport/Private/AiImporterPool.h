@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+namespace Assimp {
+class Importer;
+}
+
+/**
+ * Deleter of an importer borrowed from FAiImporterPool, which returns it to the
+ * pool instead of deleting it.
+ */
+struct FAiImporterReturner {
+	void operator()(Assimp::Importer* AiImporter) const;
+};
+
+/**
+ * Importer borrowed from FAiImporterPool. It is returned to the pool when
+ * destroyed.
+ */
+using FPooledAiImporterPtr = TUniquePtr<Assimp::Importer, FAiImporterReturner>;
+
+/**
+ * Pool of reusable assimp importers.
+ * Constructing an importer registers every importer and post-processing step
+ * of assimp, so loads borrow idle importers instead of constructing new ones.
+ * A borrowed importer is used by one load (that is, by one thread at a time)
+ * until it is returned. Returned importers are reset to their default IO
+ * system, progress handler and properties, and at most
+ * URuntimeAssetImportSettings::NumPooledImporters of them are kept.
+ * All functions are thread-safe.
+ */
+class FAiImporterPool {
+public:
+	/**
+	 * Get the process-wide instance.
+	 */
+	static FAiImporterPool& Get();
+
+public:
+	/**
+	 * Borrow an idle importer, or construct a new one if there is none.
+	 * @return  the importer, returned to the pool when destroyed.
+	 */
+	FPooledAiImporterPtr Borrow();
+
+	/**
+	 * Construct importers on a worker thread until the pool holds as many idle
+	 * importers as it keeps. This also loads the assimp library, which is
+	 * delay-loaded, so that the first load does not hitch.
+	 * @return  task completed when the pool has been filled.
+	 */
+	UE::Tasks::FTask WarmUpAsync();
+
+	/**
+	 * Delete all idle importers. Called when the module shuts down, while the
+	 * assimp library is still loaded.
+	 */
+	void Empty();
+
+	/* internal functions */
+private:
+	/**
+	 * Reset an importer and keep it in the pool, or delete it if the pool is
+	 * full.
+	 * @param   AiImporter   importer borrowed from the pool
+	 */
+	void Return(Assimp::Importer* AiImporter);
+
+	/**
+	 * Get the maximum number of idle importers to keep.
+	 */
+	static int32 GetMaxNumIdleImporters();
+
+	friend FAiImporterReturner;
+
+	/* internal fields */
+private:
+	// lock for all fields
+	FCriticalSection CriticalSection;
+
+	// idle importers
+	TArray<TUniquePtr<Assimp::Importer>> IdleImporters;
+};
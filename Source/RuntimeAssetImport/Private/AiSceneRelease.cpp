@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AiSceneRelease.h"
+
+#include <assimp/cimport.h>
+
+#pragma region forward declarations of static functions
+/**
+ * Delete an array and null the pointer to it.
+ * @param[in,out]   Array   pointer to the array
+ */
+template <typename T>
+static void DeleteArray(T*& Array);
+#pragma endregion
+
+void FAiSceneDeleter::operator()(aiScene* const AiScene) const {
+	// the scene is not owned by any importer, so it is simply deleted by
+	// assimp
+	aiReleaseImport(AiScene);
+}
+
+void ReleaseAiMesh(aiScene& AiScene, const unsigned int MeshIndex) {
+	check(MeshIndex < AiScene.mNumMeshes);
+
+	// free the buffers in place, as the destructor of the mesh does, keeping
+	// the mesh itself (its name, material index, etc.)
+	auto& AiMesh = *AiScene.mMeshes[MeshIndex];
+
+	// vertices
+	DeleteArray(AiMesh.mVertices);
+	DeleteArray(AiMesh.mNormals);
+	DeleteArray(AiMesh.mTangents);
+	DeleteArray(AiMesh.mBitangents);
+	for (auto& AiColors : AiMesh.mColors) {
+		DeleteArray(AiColors);
+	}
+	for (auto& AiTextureCoords : AiMesh.mTextureCoords) {
+		DeleteArray(AiTextureCoords);
+	}
+	for (auto& NumUVComponents : AiMesh.mNumUVComponents) {
+		NumUVComponents = 0;
+	}
+	AiMesh.mNumVertices = 0;
+
+	// faces (each face deletes its indices)
+	DeleteArray(AiMesh.mFaces);
+	AiMesh.mNumFaces = 0;
+
+	// bones and morph targets
+	for (auto Bone_i = 0u; Bone_i < AiMesh.mNumBones; ++Bone_i) {
+		delete AiMesh.mBones[Bone_i];
+	}
+	DeleteArray(AiMesh.mBones);
+	AiMesh.mNumBones = 0;
+	for (auto AnimMesh_i = 0u; AnimMesh_i < AiMesh.mNumAnimMeshes;
+	     ++AnimMesh_i) {
+		delete AiMesh.mAnimMeshes[AnimMesh_i];
+	}
+	DeleteArray(AiMesh.mAnimMeshes);
+	AiMesh.mNumAnimMeshes = 0;
+}
+
+void ReleaseAiTextures(aiScene& AiScene) {
+	// free the texels in place, keeping the textures (their file names, etc.)
+	const auto& NumTextures = AiScene.mNumTextures;
+	for (auto i = decltype(NumTextures){0}; i < NumTextures; ++i) {
+		auto& AiTexture = *AiScene.mTextures[i];
+		DeleteArray(AiTexture.pcData);
+		AiTexture.mWidth  = 0;
+		AiTexture.mHeight = 0;
+	}
+}
+
+#pragma region definitions of static functions
+template <typename T>
+static void DeleteArray(T*& Array) {
+	delete[] Array;
+	Array = nullptr;
+}
+#pragma endregion
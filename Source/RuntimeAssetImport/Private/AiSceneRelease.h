@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <assimp/scene.h>
+
+/**
+ * Deleter of a scene taken from an importer with GetOrphanedScene.
+ * The scene is released by assimp itself, which also deletes the private data
+ * assimp attaches to it.
+ */
+struct FAiSceneDeleter {
+	void operator()(aiScene* AiScene) const;
+};
+
+/**
+ * Scene owned by the caller instead of an importer, so that parts of it can be
+ * released while it is converted.
+ */
+using FAiScenePtr = TUniquePtr<aiScene, FAiSceneDeleter>;
+
+/**
+ * Release the vertex and face buffers of a mesh of a scene, once they are no
+ * longer needed. The buffers are freed in place and their counts are set to 0,
+ * so the mesh is left empty and the scene stays valid. Thread-safe for
+ * different meshes.
+ * @param[in,out]   AiScene     scene owning the mesh
+ * @param           MeshIndex   index of the mesh in AiScene.mMeshes
+ */
+void ReleaseAiMesh(aiScene& AiScene, unsigned int MeshIndex);
+
+/**
+ * Release all embedded textures of a scene, once they are no longer needed.
+ * The texels are freed in place and the sizes are set to 0, so the textures
+ * are left empty and the scene stays valid.
+ * @param[in,out]   AiScene   scene owning the textures
+ */
+void ReleaseAiTextures(aiScene& AiScene);
@@ -2,16 +2,28 @@
 
 #include "AssetConstructorHelpers.h"
 
-#include "ImageUtils.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Engine/Texture2D.h"
 #include "LogAssetConstructor.h"
+#include "Tasks/Task.h"
+#include "TextureProcessing.h"
 
 TArray<UMaterialInstanceDynamic*> GenerateMaterialInstances(
     UObject& Owner, const TArray<FLoadedMaterialData>& MaterialDataList,
-    UMaterialInterface& ParentMaterialInterface) {
+    const TArray<FLoadedTextureData>& TextureDataList,
+    UMaterialInterface&               ParentMaterialInterface) {
 	TArray<UMaterialInstanceDynamic*> MaterialInstances;
 	const auto&                       NumMaterials = MaterialDataList.Num();
 	MaterialInstances.AddUninitialized(NumMaterials);
 
+	// material instances using each texture, so that a texture shared by
+	// multiple materials is decoded and uploaded only once
+	using FWeakMaterialInstanceList =
+	    TArray<TWeakObjectPtr<UMaterialInstanceDynamic>>;
+	const auto&                       NumTextures = TextureDataList.Num();
+	TArray<FWeakMaterialInstanceList> MaterialInstancesOfTextures;
+	MaterialInstancesOfTextures.SetNum(NumTextures);
+
 	if (0 == NumMaterials) {
 		UE_LOG(LogAssetConstructor, Display, TEXT("There is no Materials."));
 	}
@@ -53,13 +65,6 @@ TArray<UMaterialInstanceDynamic*> GenerateMaterialInstances(
 			break;
 		}
 		case EColorStatus::TextureIsSet: {
-			// get compressed texture data
-			const auto& CompressedTextureData = MaterialData.CompressedTextureData;
-
-			// get texture
-			UTexture2D* Texture0 =
-			    FImageUtils::ImportBufferAsTexture2D(CompressedTextureData);
-
 			VerifyMaterialParameter(ParentMaterialInterface,
 			                        EMaterialParameterType::Scalar,
 			                        "TextureBlendIntensityForBaseColor");
@@ -67,12 +72,18 @@ TArray<UMaterialInstanceDynamic*> GenerateMaterialInstances(
 			                        EMaterialParameterType::Texture,
 			                        "BaseColorTexture");
 
-			// set to use texture
-			MaterialInstance->SetScalarParameterValue(
-			    "TextureBlendIntensityForBaseColor", 1.0f);
+			// check the texture index
+			const auto& TextureIndex = MaterialData.TextureIndex;
+			if (!TextureDataList.IsValidIndex(TextureIndex)) {
+				UE_LOG(LogAssetConstructor, Error,
+				       TEXT("Texture index %d of material in index %d is out of "
+				            "range, so skip setting the texture."),
+				       TextureIndex, i);
+				break;
+			}
 
-			// set texture
-			MaterialInstance->SetTextureParameterValue("BaseColorTexture", Texture0);
+			// the texture is set after it is decoded
+			MaterialInstancesOfTextures[TextureIndex].Add(MaterialInstance);
 
 			break;
 		}
@@ -93,6 +104,61 @@ TArray<UMaterialInstanceDynamic*> GenerateMaterialInstances(
 		MaterialInstances[i] = MaterialInstance;
 	}
 
+	for (auto i = decltype(NumTextures){0}; i < NumTextures; ++i) {
+		// skip textures used by no material
+		auto& WeakMaterialInstances = MaterialInstancesOfTextures[i];
+		if (WeakMaterialInstances.IsEmpty()) {
+			continue;
+		}
+
+		// Decode the texture and build its platform data on a worker thread,
+		// and then create the texture and set it to the material instances on
+		// the game thread. The texture data is copied, since TextureDataList may
+		// be destroyed before the task runs.
+		namespace Tasks = UE::Tasks;
+		Tasks::Launch(
+		    UE_SOURCE_LOCATION,
+		    [WeakMaterialInstances = MoveTemp(WeakMaterialInstances),
+		     TextureData           = TextureDataList[i], i]() mutable {
+			    // build platform data
+			    bool bSRGB;
+			    auto PlatformData = CreateTexturePlatformData(TextureData, bSRGB);
+			    if (!PlatformData.IsValid()) {
+				    UE_LOG(LogAssetConstructor, Warning,
+				           TEXT("Failed to decode the texture, so skip setting "
+				                "the texture in index %d"),
+				           i);
+				    return;
+			    }
+
+			    ExecuteOnGameThread(
+			        UE_SOURCE_LOCATION,
+			        [WeakMaterialInstances = MoveTemp(WeakMaterialInstances),
+			         PlatformData = MoveTemp(PlatformData), bSRGB]() mutable {
+				        // create texture
+				        UTexture2D* Texture0 = CreateTextureFromPlatformData(
+				            MoveTemp(PlatformData), bSRGB);
+
+				        for (const auto& WeakMaterialInstance : WeakMaterialInstances) {
+					        // material instance may have been destroyed meanwhile
+					        const auto& MaterialInstance = WeakMaterialInstance.Get();
+					        if (nullptr == MaterialInstance) {
+						        continue;
+					        }
+
+					        // set to use texture
+					        MaterialInstance->SetScalarParameterValue(
+					            "TextureBlendIntensityForBaseColor", 1.0f);
+
+					        // set texture
+					        MaterialInstance->SetTextureParameterValue(
+					            "BaseColorTexture", Texture0);
+				        }
+			        });
+		    },
+		    LowLevelTasks::ETaskPriority::BackgroundNormal);
+	}
+
 	return MaterialInstances;
 }
 
@@ -113,3 +179,92 @@ void VerifyMaterialParameter(
 	verifyf(ParameterExists, TEXT("Material %s doesn't have %s parameter."),
 	        *MaterialInterface.GetFName().ToString(), *ParameterName.ToString());
 }
+
+TUniquePtr<FTexturePlatformData>
+    CreateTexturePlatformData(const FLoadedTextureData& TextureData,
+                              bool&                     bSRGB) {
+	// if compressed, decode it into a single mip
+	FLoadedTextureData DecodedTextureData;
+	if (TextureData.GetRawData().IsEmpty() &&
+	    !DecodeTextureData(TextureData.CompressedData.GetData(),
+	                       TextureData.CompressedData.Num(), DecodedTextureData)) {
+		return nullptr;
+	}
+	const auto& RawTextureData =
+	    TextureData.GetRawData().IsEmpty() ? DecodedTextureData : TextureData;
+	const auto& RawData = RawTextureData.GetRawData();
+
+	// get size, format and number of mips
+	const auto& Width   = RawTextureData.RawWidth;
+	const auto& Height  = RawTextureData.RawHeight;
+	const auto& Format  = RawTextureData.RawFormat.GetValue();
+	const auto& NumMips = RawTextureData.NumMips;
+
+	// block-compressed textures are uploaded as they are, so their format
+	// must be supported on this platform (e.g. ASTC is not on most desktops)
+	if (!GPixelFormats[Format].Supported) {
+		UE_LOG(LogAssetConstructor, Error,
+		       TEXT("Pixel format %s of texture is not supported on this "
+		            "platform."),
+		       GPixelFormats[Format].Name);
+		return nullptr;
+	}
+
+	// check the size of the data
+	auto ExpectedSize = int64{0};
+	for (auto Mip_i = 0; Mip_i < NumMips; ++Mip_i) {
+		ExpectedSize += GetTextureMipSize(FMath::Max(1, Width >> Mip_i),
+		                                  FMath::Max(1, Height >> Mip_i), Format);
+	}
+	if (Width <= 0 || Height <= 0 || NumMips <= 0 || RawData.Num() != ExpectedSize) {
+		UE_LOG(LogAssetConstructor, Error,
+		       TEXT("Texture data of %dx%d with %d mips has a wrong size %d."),
+		       Width, Height, NumMips, RawData.Num());
+		return nullptr;
+	}
+
+	// build platform data
+	auto PlatformData         = MakeUnique<FTexturePlatformData>();
+	PlatformData->SizeX       = Width;
+	PlatformData->SizeY       = Height;
+	PlatformData->PixelFormat = Format;
+	PlatformData->SetNumSlices(1);
+
+	// copy each mip
+	auto Offset = int64{0};
+	for (auto Mip_i = 0; Mip_i < NumMips; ++Mip_i) {
+		const auto& MipWidth  = FMath::Max(1, Width >> Mip_i);
+		const auto& MipHeight = FMath::Max(1, Height >> Mip_i);
+		const auto& MipSize   = GetTextureMipSize(MipWidth, MipHeight, Format);
+
+		auto* Mip = new FTexture2DMipMap(MipWidth, MipHeight);
+		PlatformData->Mips.Add(Mip);
+		Mip->BulkData.Lock(LOCK_READ_WRITE);
+		FMemory::Memcpy(Mip->BulkData.Realloc(MipSize),
+		                RawData.GetData() + Offset, MipSize);
+		Mip->BulkData.Unlock();
+
+		Offset += MipSize;
+	}
+
+	bSRGB = RawTextureData.bSRGB;
+
+	return PlatformData;
+}
+
+UTexture2D*
+    CreateTextureFromPlatformData(TUniquePtr<FTexturePlatformData> PlatformData,
+                                  const bool                       bSRGB) {
+	check(IsInGameThread());
+
+	// create texture
+	UTexture2D* Texture =
+	    NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+	Texture->SRGB = bSRGB;
+	Texture->SetPlatformData(PlatformData.Release());
+
+	// upload
+	Texture->UpdateResource();
+
+	return Texture;
+}
@@ -10,8 +10,13 @@
 
 /**
  * Generate material instances from array of material data.
+ * Textures are decoded on worker threads, and each of them is set to the
+ * material instances using it on the game thread once it is ready, so the
+ * returned material instances may not have their textures yet. A texture
+ * shared by multiple materials is decoded and uploaded only once.
  * @param Owner Owner of the material instances
  * @param MaterialDataList array of material data
+ * @param TextureDataList array of texture data referred to by MaterialDataList
  * @param InOutParentMaterialInterface Parent MaterialInterface from which
  *                                the material instance was created
  * @return array of the material instances
@@ -19,8 +24,35 @@
 TArray<UMaterialInstanceDynamic*>
     GenerateMaterialInstances(UObject&                           Owner,
                               const TArray<FLoadedMaterialData>& MaterialDatas,
+                              const TArray<FLoadedTextureData>&  TextureDatas,
                               UMaterialInterface& ParentMaterialInterface);
 
+/**
+ * Build texture platform data from texture data.
+ * Raw texture data (including block-compressed data read from DDS or KTX2) is
+ * copied as it is with all its mips, and compressed texture data is decoded
+ * into a single mip. Thread-safe, so that textures can be decoded on worker
+ * threads.
+ * @param TextureData texture data
+ * @param[out] bSRGB whether the platform data is in sRGB color space
+ * @return the platform data, or nullptr if the texture data is invalid or its
+ *         pixel format is not supported on this platform
+ */
+TUniquePtr<FTexturePlatformData>
+    CreateTexturePlatformData(const FLoadedTextureData& TextureData,
+                              bool&                     bSRGB);
+
+/**
+ * Create a texture from platform data built by CreateTexturePlatformData.
+ * Must be called on the game thread.
+ * @param PlatformData platform data, owned by the texture afterwards
+ * @param bSRGB whether the platform data is in sRGB color space
+ * @return the texture
+ */
+UTexture2D*
+    CreateTextureFromPlatformData(TUniquePtr<FTexturePlatformData> PlatformData,
+                                  bool                             bSRGB);
+
 /**
  * Verify the specified material has the specified parameter.
  * Unreal "verifyf" macro is used for verifying.
@@ -69,6 +101,9 @@ MeshComponentT* ConstructMeshComponentFromMeshData(
 	// number of the NodeList
 	const auto& NumNodeList = NodeList.Num();
 
+	// get section list
+	const auto& SectionList = MeshData.SectionList;
+
 	// list of mesh components to be made
 	TArray<MeshComponentT*> MeshComponentList;
 	MeshComponentList.AddUninitialized(NumNodeList);
@@ -76,9 +111,12 @@ MeshComponentT* ConstructMeshComponentFromMeshData(
 	// get material list
 	const auto& MaterialList = MeshData.MaterialList;
 
+	// get texture list
+	const auto& TextureList = MeshData.TextureList;
+
 	// generate material instances
-	const auto& MaterialInstances =
-	    GenerateMaterialInstances(*Owner, MaterialList, *ParentMaterialInterface);
+	const auto& MaterialInstances = GenerateMaterialInstances(
+	    *Owner, MaterialList, TextureList, *ParentMaterialInterface);
 
 	// construct Mesh Component Tree
 	for (auto Node_i = decltype(NumNodeList){0}; Node_i < NumNodeList; ++Node_i) {
@@ -94,19 +132,22 @@ MeshComponentT* ConstructMeshComponentFromMeshData(
 		// make MeshComponent network addressable
 		MeshComponent->SetNetAddressable();
 
-		// get reference of the sections
-		const auto& Sections = Node.Sections;
+		// get indices of the sections
+		const auto& SectionIndices = Node.SectionIndices;
 
 		// get number of sections
-		const auto& NumSections = Sections.Num();
+		const auto& NumSections = SectionIndices.Num();
 
 		// create mesh sections
 		if constexpr (TypeTests::TAreTypesEqual_V<UProceduralMeshComponent,
 		                                          MeshComponentT>) {
 			for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
 			     ++Section_i) {
-				// get reference of the section
-				const auto& Section = Sections[Section_i];
+				// get reference of the section in full precision
+				const auto& StoredSection = SectionList[SectionIndices[Section_i]];
+				FLoadedMeshSectionData DecodedSection;
+				const auto&            Section =
+				    StoredSection.GetFullPrecision(DecodedSection);
 
 				// CreateCollision parameter
 				constexpr auto CreateCollision = true;
@@ -135,8 +176,11 @@ MeshComponentT* ConstructMeshComponentFromMeshData(
 			// create meshes of Procedural Mesh Component
 			for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
 			     ++Section_i) {
-				// get reference of the section
-				const auto& Section = Sections[Section_i];
+				// get reference of the section in full precision
+				const auto& StoredSection = SectionList[SectionIndices[Section_i]];
+				FLoadedMeshSectionData DecodedSection;
+				const auto&            Section =
+				    StoredSection.GetFullPrecision(DecodedSection);
 
 				// CreateCollision parameter
 				constexpr auto CreateCollision = true;
@@ -0,0 +1,11 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetImportCancellationToken.h"
+
+void FAssetImportCancellationToken::Cancel() {
+	bCanceled = true;
+}
+
+bool FAssetImportCancellationToken::IsCanceled() const {
+	return bCanceled;
+}
@@ -0,0 +1,8 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetImportProfile.h"
+
+bool FAssetImportProfile::ProcessesTextures() const {
+	return MaxTextureSize > 0 || bGenerateTextureMips ||
+	       ETextureCompressionMode::None != TextureCompression;
+}
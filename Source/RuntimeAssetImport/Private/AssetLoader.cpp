@@ -2,37 +2,226 @@
 
 #include "AssetLoader.h"
 
-#include "ImageUtils.h"
+#include "AiImporterPool.h"
+#include "AiSceneRelease.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "BinaryMeshFiles.h"
+#include "CancelableAiProgressHandler.h"
+#include "ExternalTextureCache.h"
+#include "GltfAsset.h"
+#include "Hash/xxhash.h"
 #include "LogAssetLoader.h"
+#include "MeshDataConstruction.h"
+#include "MeshDataDiskCache.h"
+#include "MeshDataMemoryCache.h"
+#include "Misc/Paths.h"
+#include "ObjFile.h"
+#include "PlatformFileAiIOSystem.h"
+#include "RuntimeAssetImportSettings.h"
+#include "TextureContainers.h"
+#include "TextureProcessing.h"
+#include "VertexStreamConversion.h"
 
 #include <assimp/Importer.hpp>
+#include <assimp/config.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 
+#include <atomic>
+
+/**
+ * State shared between the tasks of a batch load.
+ */
+struct FBatchLoadState {
+	// Paths of the files to load
+	TArray<FString> FilePaths;
+
+	// Loaded mesh data, in the same order as FilePaths
+	TArray<FLoadedMeshData> MeshDataList;
+
+	// Results of loading, in the same order as FilePaths
+	TArray<ELoadMeshFromAssetFileResult> Results;
+
+	// Which post-process steps to apply
+	FAssetImportProfile ImportProfile;
+
+	// Index in FilePaths of the next file to be loaded
+	std::atomic<int32> NextFileIndex = 0;
+};
+
+/**
+ * An assimp node and the index of its parent node in FLoadedMeshData::NodeList.
+ */
+struct FAiNodeWithParentIndex {
+	// assimp node
+	const aiNode* AiNode;
+
+	// index of the parent node. -1 for the root node.
+	int ParentNodeIndex;
+};
+
 #pragma region forward declarations of static functions
+/**
+ * Launch tasks that load all files in BatchLoadState.
+ * At most MaxParallelism tasks are launched, and each of them keeps taking the
+ * next unloaded file until all files are taken, so that the load is balanced
+ * even if file sizes vary.
+ * @param   BatchLoadState   state of the batch load. MeshDataList and Results
+ *                           are filled by the tasks.
+ * @param   MaxParallelism   maximum number of tasks. 0 or less means the
+ *                           number of worker threads.
+ * @return  the launched tasks.
+ */
+static TArray<UE::Tasks::FTask>
+    LaunchBatchLoadTasks(const TSharedRef<FBatchLoadState>& BatchLoadState,
+                         int32                              MaxParallelism);
+
+/**
+ * Load mesh data from the asset file without the memory cache.
+ * The disk cache is used if enabled.
+ * @param FilePath Path to the file
+ * @param ImportProfile Which post-process steps to apply
+ * @param LoadOptions progressive delivery and cancellation of the load
+ * @param[out] DependencyFilePaths if not null, full paths of the files other
+ *                                 than the asset that the mesh data is
+ *                                 converted from
+ * @return the mesh data in case of success, unset in case of failure or
+ *         cancellation.
+ */
+static TOptional<FLoadedMeshData> LoadMeshFromAssetFileUncached(
+    const FString& FilePath, const FAssetImportProfile& ImportProfile,
+    const FLoadOptions& LoadOptions         = {},
+    TArray<FString>*    DependencyFilePaths = nullptr);
+
+/**
+ * Load mesh data from the asset data without the memory cache.
+ * The disk cache is used if enabled.
+ * @param AssetData Asset data on memory
+ * @param ImportProfile Which post-process steps to apply
+ * @param LoadOptions progressive delivery and cancellation of the load
+ * @param[out] DependencyFilePaths if not null, full paths of the files that
+ *                                 the mesh data is converted from
+ * @return the mesh data in case of success, unset in case of failure or
+ *         cancellation.
+ */
+static TOptional<FLoadedMeshData> LoadMeshFromAssetDataUncached(
+    const TArray<uint8>& AssetData, const FAssetImportProfile& ImportProfile,
+    const FLoadOptions& LoadOptions         = {},
+    TArray<FString>*    DependencyFilePaths = nullptr);
+
 /**
  * Load Ai(Assimp) Scene
  * @param AiImporter Assimp Importer
  * @param FilePath Path to the file
+ * @param ImportProfile Which post-process steps to apply
+ * @param CancellationToken token to abort parsing, or null
+ * @param[out] ReadFilePaths full paths of the files assimp has read, including
+ *                           FilePath itself
  * @return a valid pointer in case of success, nullptr in case of failure.
  */
-static const aiScene* LoadAiScene(Assimp::Importer& AiImporter,
-                                  const FString&    FilePath);
+static const aiScene*
+    LoadAiScene(Assimp::Importer& AiImporter, const FString& FilePath,
+                const FAssetImportProfile&              ImportProfile,
+                const FAssetImportCancellationTokenPtr& CancellationToken,
+                TArray<FString>&                        ReadFilePaths);
 
 /**
  * Load Ai(Assimp) Scene
  * @param AiImporter Assimp Importer
  * @param AssetData Asset data on memory
+ * @param ImportProfile Which post-process steps to apply
+ * @param CancellationToken token to abort parsing, or null
+ * @param[out] ReadFilePaths full paths of the files assimp has read (e.g.
+ *                           textures referred to by the data)
  * @return a valid pointer in case of success, nullptr in case of failure.
  */
-static const aiScene* LoadAiScene(Assimp::Importer&    AiImporter,
-                                  const TArray<uint8>& AssetData);
+static const aiScene*
+    LoadAiScene(Assimp::Importer& AiImporter, const TArray<uint8>& AssetData,
+                const FAssetImportProfile&              ImportProfile,
+                const FAssetImportCancellationTokenPtr& CancellationToken,
+                TArray<FString>&                        ReadFilePaths);
+
 
 /**
- * Construct mesh data from AiScene
- * @param        AiScene           assimp's scene object.
+ * In auto mode, inspect the data present in the scene that has been read
+ * without post-processing, and apply only the post-process steps that are not
+ * redundant. In other modes, do nothing.
+ * @param AiImporter Assimp Importer which has read AiScene
+ * @param AiScene the scene read by AiImporter, or nullptr if reading failed
+ * @param ImportProfile Which post-process steps to apply
+ * @return a valid pointer in case of success, nullptr in case of failure.
  */
-static FLoadedMeshData ConstructMeshData(const aiScene& AiScene);
+static const aiScene*
+    ApplyAutoPostProcessing(Assimp::Importer&          AiImporter,
+                            const aiScene*             AiScene,
+                            const FAssetImportProfile& ImportProfile);
+
+/**
+ * Decide the post-process steps for auto mode from the data present in the
+ * scene.
+ * @param AiScene the scene read without post-processing
+ * @return the post-process steps
+ */
+static unsigned int GetAutoAiPostProcessSteps(const aiScene& AiScene);
+
+
+/**
+ * Construct mesh data from AiScene, releasing the parts of AiScene that have
+ * been converted (embedded textures, and meshes), so that the scene and the
+ * mesh data are not both held in full at once.
+ * @param[in,out] AiScene          assimp's scene object, owned by the caller
+ *                                 (not by an importer). Its converted meshes
+ *                                 and textures are replaced with empty ones.
+ * @param        ImportProfile     import profile used to load AiScene.
+ * @param        AssetDirectory    directory of the asset file, used to resolve
+ *                                 relative paths of external textures. Empty
+ *                                 for asset data on memory.
+ * @param        LoadOptions       progressive delivery and cancellation of
+ *                                 the load. If canceled, the returned mesh
+ *                                 data is incomplete and must be discarded.
+ */
+static FLoadedMeshData
+    ConstructMeshData(aiScene&                   AiScene,
+                      const FAssetImportProfile& ImportProfile,
+                      const FString&             AssetDirectory,
+                      const FLoadOptions&        LoadOptions);
+
+
+/**
+ * Deliver every node of mesh data that has already been constructed (e.g.
+ * loaded from the disk cache) to a progressive load callback.
+ * @param   MeshData       mesh data whose nodes are delivered
+ * @param   OnNodeLoaded   callback receiving each node. May be unset.
+ */
+static void DeliverAllNodes(const FLoadedMeshData&   MeshData,
+                            const FOnLoadedMeshNode& OnNodeLoaded);
+
+/**
+ * Make the data of a node to deliver progressively, copying its sections and
+ * the materials they use. Only the node, its sections and the material list
+ * of MeshData are read, so the other sections may be written concurrently.
+ * @param   MeshData    mesh data containing the node
+ * @param   NodeIndex   index of the node in MeshData.NodeList
+ * @return  the node data
+ */
+static FLoadedMeshNodeData MakeLoadedMeshNodeData(const FLoadedMeshData& MeshData,
+                                                  int32 NodeIndex);
+
+/**
+ * Process textures as specified by the import profile, in parallel: decode
+ * them if they are processed, downscale them to the maximum size, generate
+ * their mips, compress them, and record their memory size.
+ * Textures that have already been processed (e.g. loaded from the disk cache)
+ * are left as they are, except for their memory size. Once the load is
+ * canceled, the remaining textures are skipped.
+ * @param        ImportProfile   import profile
+ * @param        LoadOptions     cancellation of the load
+ * @param[out]   TextureList     textures to process
+ */
+static void ProcessTextureList(const FAssetImportProfile&  ImportProfile,
+                               const FLoadOptions&         LoadOptions,
+                               TArray<FLoadedTextureData>& TextureList);
 
 /**
  * Transform the coordinate system of an assimp scene to the UE coordinate
@@ -49,51 +238,216 @@ static void TransformToUECoordinateSystem(const aiScene& AiScene);
  */
 static float GetAiUnitScaleFactor(const aiScene& AiScene);
 
+
 /**
- * Generate a transformation matrix to transform from the Ai(Assimp) coordinate
- * system to the UE coordinate system.
- * @param AiScene Ai(Assimp) Scene
+ * Generate material list and texture list from Ai(Assimp) Scene object.
+ * Each unique texture is added to the texture list only once, even if it is
+ * used by multiple materials. External textures are added with only their
+ * SourceFilePath and SourceFilePathInAsset set, and their data is loaded by the
+ * caller.
+ * @param        AiScene          Ai(Assimp) Scene
+ * @param        AssetDirectory   directory to resolve relative paths of
+ *                                external textures against
+ * @param[out]   MeshData         mesh data whose MaterialList and TextureList
+ *                                are generated
+ */
+static void GenerateMaterialList(const aiScene&   AiScene,
+                                 const FString&   AssetDirectory,
+                                 FLoadedMeshData& MeshData);
+
+
+/**
+ * Resolve the path of an external texture as the asset refers to it.
+ * @param   TexturePath      path of the texture in the asset
+ * @param   AssetDirectory   directory to resolve a relative TexturePath
+ *                           against. Empty for asset data on memory.
+ * @return  the full path, or an empty string if the path cannot be resolved
  */
-static aiMatrix4x4t<float> GenerateAi_UE_XformMatrix(const aiScene& AiScene);
+static FString ResolveExternalTexturePath(const FString& TexturePath,
+                                          const FString& AssetDirectory);
 
 /**
- * Generate material list from Ai(Assimp) Scene object.
- * @param AiScene Ai(Assimp) Scene
+ * Resolve the paths of the external textures of mesh data loaded from the
+ * disk cache, which stores them as the asset refers to them.
+ * @param           AssetDirectory   directory of the asset. Empty for asset
+ *                                   data on memory.
+ * @param[in,out]   TextureList      textures, whose SourceFilePath is set
+ *                                   from their SourceFilePathInAsset
+ */
+static void ResolveExternalTexturePaths(const FString&              AssetDirectory,
+                                        TArray<FLoadedTextureData>& TextureList);
+
+/**
+ * Flatten the node tree under AiRootNode into a list, in the order the nodes
+ * are stored in FLoadedMeshData::NodeList (pre-order depth-first).
+ * @param   AiRootNode   assimp's root node.
+ * @return  flattened nodes, each with the index of its parent in the list
+ *          (-1 for the root node).
+ */
+static TArray<FAiNodeWithParentIndex> FlattenAiNodeTree(const aiNode& AiRootNode);
+
+/**
+ * Construct node list and section list of mesh data from AiScene.
+ * The node tree is flattened first so that every node index is known up
+ * front, and every assimp mesh referenced by the nodes is added to the section
+ * list only once. Then the sections are split into ranges of vertices and
+ * faces, and all ranges are converted concurrently. Each section is finished
+ * as soon as its last range is converted, which releases its assimp mesh,
+ * and each node is delivered to LoadOptions.OnNodeLoaded as soon as all its
+ * sections are finished. Once the load is canceled, the remaining ranges are
+ * skipped and no more nodes are delivered.
+ * @param[in,out]   AiScene             assimp's scene object, owned by the
+ *                                      caller. The meshes referenced by the
+ *                                      nodes are released.
+ * @param           bCompactPrecision   whether to store the sections in
+ *                                      compact precision
+ * @param           LoadOptions         progressive delivery and cancellation
+ *                                      of the load
+ * @param[in,out]   MeshData            mesh data whose NodeList and
+ *                                      SectionList are constructed. Its
+ *                                      MaterialList must already be generated.
+ */
+static void ConstructNodeList(aiScene&            AiScene,
+                              bool                bCompactPrecision,
+                              const FLoadOptions& LoadOptions,
+                              FLoadedMeshData&    MeshData);
+
+
+
+/**
+ * Get which vertex attributes are present in an assimp mesh, logging the
+ * absent ones.
+ * @param   AiMesh      assimp's mesh
+ * @param   MeshIndex   index of the mesh in the scene (used for logging)
+ * @param   MeshName    name of the mesh (used for logging)
+ * @return  present vertex attributes
+ */
+static EAiVertexAttributes GetAiVertexAttributes(const aiMesh&  AiMesh,
+                                                 int            MeshIndex,
+                                                 const FString& MeshName);
+
+/**
+ * Convert a range of vertices of an assimp mesh to UE's format, block by
+ * block, converting all present attributes of a block before the next one.
+ * The streams of the present attributes must already be sized to the number
+ * of vertices.
+ * @param        AiMesh       assimp's mesh to convert
+ * @param        Attributes   vertex attributes present in AiMesh
+ * @param        Begin        first vertex to convert
+ * @param        End          one past the last vertex to convert
+ * @param[out]   Section      section whose streams are written
+ */
+static void ConvertAiVertexRange(const aiMesh&             AiMesh,
+                                 const EAiVertexAttributes Attributes,
+                                 int32 Begin, int32 End,
+                                 FLoadedMeshSectionData& Section);
+
+/**
+ * Compact precision version of ConvertAiVertexRange.
+ * The compact streams of the present attributes must already be sized to the
+ * number of vertices.
+ * @param        AiMesh       assimp's mesh to convert
+ * @param        Attributes   vertex attributes present in AiMesh
+ * @param        Begin        first vertex to convert
+ * @param        End          one past the last vertex to convert
+ * @param[out]   Section      section whose compact streams are written
  */
-static TArray<FLoadedMaterialData> GenerateMaterialList(const aiScene& AiScene);
+static void ConvertAiVertexRangeCompact(const aiMesh&             AiMesh,
+                                        const EAiVertexAttributes Attributes,
+                                        int32 Begin, int32 End,
+                                        FLoadedMeshSectionData& Section);
 
 /**
- * Construct mesh data recursively from the AiNode
- * @param        AiScene           assimp's scene object.
- * @param        AiNode            assimp's node object to start treeing.
- * @param[out]   MeshData          constructed mesh data
- * @param        ParentNodeIndex   index of the parent node.
- *                                 if AiNode is the root node, specify -1.
+ * Collapse the attribute streams of a section whose values are the same for
+ * all vertices (e.g. all-white vertex colors) to a single element.
+ * @param   Section   section whose streams are collapsed
  */
-static void ConstructMeshData(const aiScene& AiScene, const aiNode& AiNode,
-                              FLoadedMeshData& MeshData, int ParentNodeIndex);
+static void CollapseConstantStreams(FLoadedMeshSectionData& Section);
 
 /**
- * Convert assimp's matrix to UE's matrix
- * Return transpose of the assimp's matrix as the UE's matrix. (since one is
- * transpose of the other one).
- * @param   AiMatrix4x4   assimp's matrix
- * @return  UE's matrix
+ * Collapse a stream to a single element if all of its elements are equal.
+ * @param   Stream   stream to collapse
+ * @param   Equals   function that tells whether 2 elements are equal
  */
-static FMatrix AiMatrixToUEMatrix(const aiMatrix4x4& AiMatrix4x4);
+template <typename T, typename EqualsT>
+static void CollapseConstantStream(TArray<T>& Stream, EqualsT Equals);
+
+/**
+ * Remove the faces of an assimp mesh that are not triangles (points and lines,
+ * which Triangulate leaves as they are), moving the triangles to the front.
+ * @param[in,out]   AiMesh   assimp's mesh
+ * @return  number of removed faces
+ */
+static unsigned int RemoveNonTriangularAiFaces(aiMesh& AiMesh);
+
+/**
+ * Convert a range of faces of an assimp mesh to UE's triangle format.
+ * Triangles must already be sized to 3 times the number of faces.
+ * @tparam       IndexT      int32, or uint16 for compact precision
+ * @param        AiMesh      assimp's mesh to convert
+ * @param        Begin       first face to convert
+ * @param        End         one past the last face to convert
+ * @param[out]   Triangles   triangles of the section
+ */
+template <typename IndexT>
+static void ConvertAiFaceRange(const aiMesh& AiMesh, int32 Begin, int32 End,
+                               TArray<IndexT>& Triangles);
+
+/**
+ * Try to construct mesh data from a GLB, binary STL, binary little-endian PLY
+ * or OBJ file natively, without assimp. The file is memory-mapped for the
+ * time of the conversion, so that it is read in place without a copy. Only a
+ * GLB that cannot be mapped (e.g. compressed in a pak file) is read into
+ * memory.
+ * If the file is in another format, or is not accepted, or the native loaders
+ * are disabled in the settings, MeshData is left untouched so that the file is
+ * imported with assimp.
+ * @param        FilePath              path to the file
+ * @param        ImportProfile         which post-process steps to apply
+ * @param        LoadOptions           progressive delivery and cancellation
+ *                                     of the load. If canceled, the returned
+ *                                     mesh data is incomplete and must be
+ *                                     discarded.
+ * @param[out]   MeshData              constructed mesh data
+ * @param[out]   DependencyFilePaths   full paths of the other files the mesh
+ *                                     data is converted from (e.g. the
+ *                                     material library of an OBJ), added to
+ *                                     if constructed
+ * @return  whether the mesh data has been constructed
+ */
+static bool TryConstructMeshDataFromFile(const FString&             FilePath,
+                                         const FAssetImportProfile& ImportProfile,
+                                         const FLoadOptions&        LoadOptions,
+                                         FLoadedMeshData&           MeshData,
+                                         TArray<FString>& DependencyFilePaths);
 #pragma endregion
 
 FLoadedMeshData UAssetLoader::LoadMeshFromAssetFile(
     const FString&                FilePath,
-    ELoadMeshFromAssetFileResult& LoadMeshFromAssetFileResult) {
-	// construct Ai(Assimp) Importer
-	Assimp::Importer AiImporter;
+    ELoadMeshFromAssetFileResult& LoadMeshFromAssetFileResult,
+    const FAssetImportProfile&    ImportProfile) {
+	// load through the memory cache if enabled
+	if (FMeshDataMemoryCache::IsEnabled()) {
+		// load (or get shared) mesh data and wait for it
+		const auto& SharedMeshData =
+		    LoadSharedMeshFromAssetFileAsync(FilePath, ImportProfile).GetResult();
+
+		// When a scene fails to load
+		if (!SharedMeshData.IsValid()) {
+			LoadMeshFromAssetFileResult = ELoadMeshFromAssetFileResult::Failure;
+			return {};
+		}
 
-	// load AiScene
-	const auto& AiScene = LoadAiScene(AiImporter, FilePath);
+		// return a copy of the shared mesh data
+		LoadMeshFromAssetFileResult = ELoadMeshFromAssetFileResult::Success;
+		return *SharedMeshData;
+	}
+
+	// load mesh data
+	auto MeshData = LoadMeshFromAssetFileUncached(FilePath, ImportProfile);
 
 	// When a scene fails to load
-	if (nullptr == AiScene) {
+	if (!MeshData.IsSet()) {
 		// assume the result is failure
 		LoadMeshFromAssetFileResult = ELoadMeshFromAssetFileResult::Failure;
 
@@ -104,24 +458,36 @@ FLoadedMeshData UAssetLoader::LoadMeshFromAssetFile(
 	// assume the result is success
 	LoadMeshFromAssetFileResult = ELoadMeshFromAssetFileResult::Success;
 
-	// construct mesh data
-	FLoadedMeshData MeshData = ConstructMeshData(*AiScene);
-
 	// return mesh data
-	return MeshData;
+	return MoveTemp(MeshData.GetValue());
 }
 
 FLoadedMeshData UAssetLoader::LoadMeshFromAssetData(
     const TArray<uint8>&          AssetData,
-    ELoadMeshFromAssetDataResult& LoadMeshFromAssetDataResult) {
-	// construct Ai(Assimp) Importer
-	Assimp::Importer AiImporter;
+    ELoadMeshFromAssetDataResult& LoadMeshFromAssetDataResult,
+    const FAssetImportProfile&    ImportProfile) {
+	// load through the memory cache if enabled
+	if (FMeshDataMemoryCache::IsEnabled()) {
+		// load (or get shared) mesh data and wait for it
+		const auto& SharedMeshData =
+		    LoadSharedMeshFromAssetDataAsync(AssetData, ImportProfile).GetResult();
+
+		// When a scene fails to load
+		if (!SharedMeshData.IsValid()) {
+			LoadMeshFromAssetDataResult = ELoadMeshFromAssetDataResult::Failure;
+			return {};
+		}
 
-	// load AiScene
-	const auto& AiScene = LoadAiScene(AiImporter, AssetData);
+		// return a copy of the shared mesh data
+		LoadMeshFromAssetDataResult = ELoadMeshFromAssetDataResult::Success;
+		return *SharedMeshData;
+	}
+
+	// load mesh data
+	auto MeshData = LoadMeshFromAssetDataUncached(AssetData, ImportProfile);
 
 	// When a scene fails to load
-	if (nullptr == AiScene) {
+	if (!MeshData.IsSet()) {
 		// assume the result is failure
 		LoadMeshFromAssetDataResult = ELoadMeshFromAssetDataResult::Failure;
 
@@ -132,36 +498,738 @@ FLoadedMeshData UAssetLoader::LoadMeshFromAssetData(
 	// assume the result is success
 	LoadMeshFromAssetDataResult = ELoadMeshFromAssetDataResult::Success;
 
-	// construct mesh data
-	FLoadedMeshData MeshData = ConstructMeshData(*AiScene);
-
 	// return mesh data
-	return MeshData;
+	return MoveTemp(MeshData.GetValue());
+}
+
+UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+    UAssetLoader::LoadMeshFromAssetFileAsync(
+        const FString& FilePath, const FAssetImportProfile& ImportProfile,
+        const FAssetImportCancellationTokenPtr& CancellationToken) {
+	namespace Tasks = UE::Tasks;
+
+	// load on a worker thread
+	return Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [FilePath, ImportProfile,
+	     CancellationToken]() -> TOptional<FLoadedMeshData> {
+		    // cancelable loads bypass the memory cache, since a shared load
+		    // cannot be canceled by one of the callers sharing it
+		    if (CancellationToken.IsValid()) {
+			    FLoadOptions LoadOptions;
+			    LoadOptions.CancellationToken = CancellationToken;
+			    return LoadMeshFromAssetFileUncached(FilePath, ImportProfile,
+			                                         LoadOptions);
+		    }
+
+		    // load mesh data synchronously (on this worker thread)
+		    ELoadMeshFromAssetFileResult LoadMeshFromAssetFileResult;
+		    auto MeshData = LoadMeshFromAssetFile(
+		        FilePath, LoadMeshFromAssetFileResult, ImportProfile);
+
+		    // when failed to load, return unset
+		    if (ELoadMeshFromAssetFileResult::Failure ==
+		        LoadMeshFromAssetFileResult) {
+			    return {};
+		    }
+
+		    // return mesh data
+		    return MoveTemp(MeshData);
+	    },
+	    LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+    UAssetLoader::LoadMeshFromAssetDataAsync(
+        TArray<uint8> AssetData, const FAssetImportProfile& ImportProfile,
+        const FAssetImportCancellationTokenPtr& CancellationToken) {
+	namespace Tasks = UE::Tasks;
+
+	// load on a worker thread
+	return Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [AssetData = MoveTemp(AssetData), ImportProfile,
+	     CancellationToken]() -> TOptional<FLoadedMeshData> {
+		    // cancelable loads bypass the memory cache, since a shared load
+		    // cannot be canceled by one of the callers sharing it
+		    if (CancellationToken.IsValid()) {
+			    FLoadOptions LoadOptions;
+			    LoadOptions.CancellationToken = CancellationToken;
+			    return LoadMeshFromAssetDataUncached(AssetData, ImportProfile,
+			                                         LoadOptions);
+		    }
+
+		    // load mesh data synchronously (on this worker thread)
+		    ELoadMeshFromAssetDataResult LoadMeshFromAssetDataResult;
+		    auto MeshData = LoadMeshFromAssetData(
+		        AssetData, LoadMeshFromAssetDataResult, ImportProfile);
+
+		    // when failed to load, return unset
+		    if (ELoadMeshFromAssetDataResult::Failure ==
+		        LoadMeshFromAssetDataResult) {
+			    return {};
+		    }
+
+		    // return mesh data
+		    return MoveTemp(MeshData);
+	    },
+	    LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+UE::Tasks::TTask<FLoadedMeshDataPtr>
+    UAssetLoader::LoadSharedMeshFromAssetFileAsync(
+        const FString& FilePath, const FAssetImportProfile& ImportProfile) {
+	namespace Tasks = UE::Tasks;
+
+	// function to load mesh data into shared mesh data
+	auto LoadFunction = [FilePath, ImportProfile](
+	                        TArray<FString>& DependencyFilePaths)
+	    -> FLoadedMeshDataPtr {
+		auto MeshData = LoadMeshFromAssetFileUncached(
+		    FilePath, ImportProfile, {}, &DependencyFilePaths);
+		if (!MeshData.IsSet()) {
+			return nullptr;
+		}
+		return MakeShared<const FLoadedMeshData, ESPMode::ThreadSafe>(
+		    MoveTemp(MeshData.GetValue()));
+	};
+
+	// make memory cache key (unset if the cache is disabled or the file does
+	// not exist)
+	const auto& MemoryCacheKey =
+	    FMeshDataMemoryCache::IsEnabled()
+	        ? FMeshDataMemoryCache::MakeKey(FilePath, ImportProfile)
+	        : TOptional<FString>();
+
+	// without the cache, just load on a worker thread
+	if (!MemoryCacheKey.IsSet()) {
+		return Tasks::Launch(
+		    UE_SOURCE_LOCATION,
+		    [LoadFunction = MoveTemp(LoadFunction)]() {
+			    TArray<FString> DependencyFilePaths;
+			    return LoadFunction(DependencyFilePaths);
+		    },
+		    LowLevelTasks::ETaskPriority::BackgroundNormal);
+	}
+
+	// find in the cache, or load and add to the cache
+	return FMeshDataMemoryCache::Get().FindOrLoad(MemoryCacheKey.GetValue(),
+	                                              MoveTemp(LoadFunction));
+}
+
+UE::Tasks::TTask<FLoadedMeshDataPtr>
+    UAssetLoader::LoadSharedMeshFromAssetDataAsync(
+        TArray<uint8> AssetData, const FAssetImportProfile& ImportProfile) {
+	namespace Tasks = UE::Tasks;
+
+	// make memory cache key (unset if the cache is disabled)
+	const auto& MemoryCacheKey =
+	    FMeshDataMemoryCache::IsEnabled()
+	        ? FMeshDataMemoryCache::MakeKey(AssetData, ImportProfile)
+	        : TOptional<FString>();
+
+	// function to load mesh data into shared mesh data
+	auto LoadFunction = [AssetData = MoveTemp(AssetData), ImportProfile](
+	                        TArray<FString>& DependencyFilePaths)
+	    -> FLoadedMeshDataPtr {
+		auto MeshData = LoadMeshFromAssetDataUncached(
+		    AssetData, ImportProfile, {}, &DependencyFilePaths);
+		if (!MeshData.IsSet()) {
+			return nullptr;
+		}
+		return MakeShared<const FLoadedMeshData, ESPMode::ThreadSafe>(
+		    MoveTemp(MeshData.GetValue()));
+	};
+
+	// without the cache, just load on a worker thread
+	if (!MemoryCacheKey.IsSet()) {
+		return Tasks::Launch(
+		    UE_SOURCE_LOCATION,
+		    [LoadFunction = MoveTemp(LoadFunction)]() {
+			    TArray<FString> DependencyFilePaths;
+			    return LoadFunction(DependencyFilePaths);
+		    },
+		    LowLevelTasks::ETaskPriority::BackgroundNormal);
+	}
+
+	// find in the cache, or load and add to the cache
+	return FMeshDataMemoryCache::Get().FindOrLoad(MemoryCacheKey.GetValue(),
+	                                              MoveTemp(LoadFunction));
+}
+
+TArray<FLoadedMeshData> UAssetLoader::LoadMeshesFromAssetFiles(
+    const TArray<FString>&                FilePaths,
+    TArray<ELoadMeshFromAssetFileResult>& LoadMeshFromAssetFileResults,
+    const int32                           MaxParallelism,
+    const FAssetImportProfile&            ImportProfile) {
+	// create state of the batch load
+	const auto& BatchLoadState    = MakeShared<FBatchLoadState>();
+	BatchLoadState->FilePaths     = FilePaths;
+	BatchLoadState->ImportProfile = ImportProfile;
+
+	// load all files in parallel and wait for them
+	UE::Tasks::Wait(LaunchBatchLoadTasks(BatchLoadState, MaxParallelism));
+
+	// return results
+	LoadMeshFromAssetFileResults = MoveTemp(BatchLoadState->Results);
+	return MoveTemp(BatchLoadState->MeshDataList);
+}
+
+UE::Tasks::TTask<TArray<TOptional<FLoadedMeshData>>>
+    UAssetLoader::LoadMeshesFromAssetFilesAsync(
+        TArray<FString> FilePaths, const int32 MaxParallelism,
+        const FAssetImportProfile& ImportProfile) {
+	namespace Tasks = UE::Tasks;
+
+	// create state of the batch load
+	const auto& BatchLoadState    = MakeShared<FBatchLoadState>();
+	BatchLoadState->FilePaths     = MoveTemp(FilePaths);
+	BatchLoadState->ImportProfile = ImportProfile;
+
+	// load all files in parallel
+	const auto& BatchLoadTasks =
+	    LaunchBatchLoadTasks(BatchLoadState, MaxParallelism);
+
+	// Task to collect results, invoked after all BatchLoadTasks are completed
+	return Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [BatchLoadState]() {
+		    // number of files
+		    const auto& NumFiles = BatchLoadState->FilePaths.Num();
+
+		    // collect results
+		    TArray<TOptional<FLoadedMeshData>> MeshDataList;
+		    MeshDataList.SetNum(NumFiles);
+		    for (auto i = decltype(NumFiles){0}; i < NumFiles; ++i) {
+			    if (ELoadMeshFromAssetFileResult::Success ==
+			        BatchLoadState->Results[i]) {
+				    MeshDataList[i] = MoveTemp(BatchLoadState->MeshDataList[i]);
+			    }
+		    }
+
+		    return MeshDataList;
+	    },
+	    BatchLoadTasks, LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+    UAssetLoader::LoadMeshFromAssetFileProgressiveAsync(
+        const FString& FilePath, FOnLoadedMeshNode OnNodeLoaded,
+        const FAssetImportProfile&              ImportProfile,
+        const FAssetImportCancellationTokenPtr& CancellationToken) {
+	namespace Tasks = UE::Tasks;
+
+	// options of the load
+	FLoadOptions LoadOptions;
+	LoadOptions.OnNodeLoaded      = MoveTemp(OnNodeLoaded);
+	LoadOptions.CancellationToken = CancellationToken;
+
+	// load on a worker thread, bypassing the memory cache
+	return Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [FilePath, LoadOptions = MoveTemp(LoadOptions), ImportProfile]() {
+		    return LoadMeshFromAssetFileUncached(FilePath, ImportProfile,
+		                                         LoadOptions);
+	    },
+	    LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+    UAssetLoader::LoadMeshFromAssetDataProgressiveAsync(
+        TArray<uint8> AssetData, FOnLoadedMeshNode OnNodeLoaded,
+        const FAssetImportProfile&              ImportProfile,
+        const FAssetImportCancellationTokenPtr& CancellationToken) {
+	namespace Tasks = UE::Tasks;
+
+	// options of the load
+	FLoadOptions LoadOptions;
+	LoadOptions.OnNodeLoaded      = MoveTemp(OnNodeLoaded);
+	LoadOptions.CancellationToken = CancellationToken;
+
+	// load on a worker thread, bypassing the memory cache
+	return Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [AssetData = MoveTemp(AssetData), LoadOptions = MoveTemp(LoadOptions),
+	     ImportProfile]() {
+		    return LoadMeshFromAssetDataUncached(AssetData, ImportProfile,
+		                                         LoadOptions);
+	    },
+	    LowLevelTasks::ETaskPriority::BackgroundNormal);
 }
 
 #pragma region        definitions of static functions
-static constexpr auto AiImportFlags =
-    aiProcess_Triangulate | aiProcess_JoinIdenticalVertices |
+// post-process steps of each profile
+static constexpr unsigned int AiQualityPostProcessSteps =
+    AiRequiredPostProcessSteps | aiProcess_JoinIdenticalVertices |
     aiProcess_CalcTangentSpace | aiProcess_GenSmoothNormals |
     aiProcess_OptimizeMeshes | aiProcess_RemoveRedundantMaterials |
     aiProcess_ImproveCacheLocality | aiProcess_FindInvalidData |
-    aiProcess_EmbedTextures | aiProcess_GenUVCoords |
-    aiProcess_TransformUVCoords | aiProcess_MakeLeftHanded | aiProcess_FlipUVs;
+    aiProcess_GenUVCoords | aiProcess_TransformUVCoords;
+static constexpr unsigned int AiFastPostProcessSteps =
+    AiRequiredPostProcessSteps | aiProcess_GenSmoothNormals |
+    aiProcess_TransformUVCoords;
+static constexpr unsigned int AiCollisionOnlyPostProcessSteps =
+    AiRequiredPostProcessSteps | aiProcess_JoinIdenticalVertices |
+    aiProcess_FindDegenerates;
+
+// EAssetImportPostProcessStep must have the same values as assimp
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::CalcTangentSpace) ==
+              aiProcess_CalcTangentSpace);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::JoinIdenticalVertices) ==
+              aiProcess_JoinIdenticalVertices);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::GenSmoothNormals) ==
+              aiProcess_GenSmoothNormals);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::ImproveCacheLocality) ==
+              aiProcess_ImproveCacheLocality);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::RemoveRedundantMaterials) ==
+              aiProcess_RemoveRedundantMaterials);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::FindDegenerates) ==
+              aiProcess_FindDegenerates);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::FindInvalidData) ==
+              aiProcess_FindInvalidData);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::GenUVCoords) ==
+              aiProcess_GenUVCoords);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::TransformUVCoords) ==
+              aiProcess_TransformUVCoords);
+static_assert(static_cast<unsigned int>(
+                  EAssetImportPostProcessStep::OptimizeMeshes) ==
+              aiProcess_OptimizeMeshes);
+
+static TOptional<FLoadedMeshData> LoadMeshFromAssetFileUncached(
+    const FString& FilePath, const FAssetImportProfile& ImportProfile,
+    const FLoadOptions& LoadOptions, TArray<FString>* DependencyFilePaths) {
+	// make disk cache key (unset if the cache is disabled or the file cannot
+	// be read)
+	const auto& DiskCacheKey =
+	    FMeshDataDiskCache::IsEnabled()
+	        ? FMeshDataDiskCache::MakeKey(FilePath, ImportProfile)
+	        : TOptional<FString>();
+
+	// directory of the asset, which the files it refers to are relative to
+	const auto& AssetFilePath  = FPaths::ConvertRelativePathToFull(FilePath);
+	const auto& AssetDirectory = FPaths::GetPath(AssetFilePath);
+
+	// if canceled before starting, do nothing
+	if (LoadOptions.IsCanceled()) {
+		return {};
+	}
+
+	// files other than the asset that the mesh data is converted from
+	TArray<FString> DependencyFilePathList;
+
+	// if there is a cached entry, use it without importing
+	if (DiskCacheKey.IsSet()) {
+		auto CachedMeshData = FMeshDataDiskCache::Find(
+		    DiskCacheKey.GetValue(), AssetDirectory, DependencyFilePathList);
+		if (CachedMeshData.IsSet()) {
+			// all nodes are ready at once
+			DeliverAllNodes(CachedMeshData.GetValue(), LoadOptions.OnNodeLoaded);
+
+			// load external textures, which are not stored in the cache, from
+			// their paths resolved against this asset
+			ResolveExternalTexturePaths(AssetDirectory,
+			                            CachedMeshData->TextureList);
+			auto& TextureCache = FExternalTextureCache::Get();
+			FinishTextureList(
+			    TextureCache.FindOrLoadAll(CachedMeshData->TextureList),
+			    ImportProfile, LoadOptions, /*out*/ CachedMeshData.GetValue());
+			if (LoadOptions.IsCanceled()) {
+				return {};
+			}
+			if (nullptr != DependencyFilePaths) {
+				*DependencyFilePaths = MoveTemp(DependencyFilePathList);
+			}
+			return CachedMeshData;
+		}
+	}
+
+	// output mesh data
+	FLoadedMeshData MeshData;
+
+	// convert GLB, binary STL, binary PLY and OBJ files natively if possible,
+	// and the others with assimp (which reads the file by itself)
+	if (!TryConstructMeshDataFromFile(FilePath, ImportProfile, LoadOptions,
+	                                  MeshData, DependencyFilePathList)) {
+		// borrow Ai(Assimp) Importer
+		const auto& AiImporter = FAiImporterPool::Get().Borrow();
+
+		// load AiScene, and take it from AiImporter so that it can be released
+		// part by part while converting
+		FAiScenePtr AiScene;
+		if (nullptr != LoadAiScene(*AiImporter, FilePath, ImportProfile,
+		                           LoadOptions.CancellationToken,
+		                           DependencyFilePathList)) {
+			AiScene.Reset(AiImporter->GetOrphanedScene());
+		}
+
+		// the asset itself is covered by the disk cache key
+		DependencyFilePathList.Remove(AssetFilePath);
+
+		// When a scene fails to load, or the load is canceled while parsing
+		if (!AiScene.IsValid() || LoadOptions.IsCanceled()) {
+			// return unset
+			return {};
+		}
+
+		// construct mesh data
+		MeshData =
+		    ConstructMeshData(*AiScene, ImportProfile, AssetDirectory, LoadOptions);
+
+		// release what is left of the scene
+		AiScene.Reset();
+	}
+
+	// discard incomplete mesh data if canceled while constructing
+	if (LoadOptions.IsCanceled()) {
+		return {};
+	}
+
+	// store in the disk cache for later loads
+	if (DiskCacheKey.IsSet()) {
+		FMeshDataDiskCache::Store(DiskCacheKey.GetValue(), MeshData,
+		                          AssetDirectory, DependencyFilePathList);
+	}
+
+	// output the files the mesh data depends on
+	if (nullptr != DependencyFilePaths) {
+		*DependencyFilePaths = MoveTemp(DependencyFilePathList);
+	}
+
+	// return mesh data
+	return MeshData;
+}
+
+static TOptional<FLoadedMeshData> LoadMeshFromAssetDataUncached(
+    const TArray<uint8>& AssetData, const FAssetImportProfile& ImportProfile,
+    const FLoadOptions& LoadOptions, TArray<FString>* DependencyFilePaths) {
+	// make disk cache key (unset if the cache is disabled)
+	const auto& DiskCacheKey =
+	    FMeshDataDiskCache::IsEnabled()
+	        ? FMeshDataDiskCache::MakeKey(AssetData, ImportProfile)
+	        : TOptional<FString>();
+
+	// if canceled before starting, do nothing
+	if (LoadOptions.IsCanceled()) {
+		return {};
+	}
+
+	// files that the mesh data is converted from
+	TArray<FString> DependencyFilePathList;
+
+	// if there is a cached entry, use it without importing
+	if (DiskCacheKey.IsSet()) {
+		auto CachedMeshData = FMeshDataDiskCache::Find(
+		    DiskCacheKey.GetValue(), FString(), DependencyFilePathList);
+		if (CachedMeshData.IsSet()) {
+			// all nodes are ready at once
+			DeliverAllNodes(CachedMeshData.GetValue(), LoadOptions.OnNodeLoaded);
+
+			// load external textures, which are not stored in the cache, from
+			// their paths resolved against this asset
+			ResolveExternalTexturePaths(FString(), CachedMeshData->TextureList);
+			auto& TextureCache = FExternalTextureCache::Get();
+			FinishTextureList(
+			    TextureCache.FindOrLoadAll(CachedMeshData->TextureList),
+			    ImportProfile, LoadOptions, /*out*/ CachedMeshData.GetValue());
+			if (LoadOptions.IsCanceled()) {
+				return {};
+			}
+			if (nullptr != DependencyFilePaths) {
+				*DependencyFilePaths = MoveTemp(DependencyFilePathList);
+			}
+			return CachedMeshData;
+		}
+	}
+
+	// output mesh data
+	FLoadedMeshData MeshData;
+
+	// convert GLB data natively if possible, and the others with assimp
+	if (!GetDefault<URuntimeAssetImportSettings>()->bEnableNativeLoaders ||
+	    !HasGlbSignature(AssetData.GetData(), AssetData.Num()) ||
+	    !TryConstructMeshDataFromGlb(AssetData.GetData(), AssetData.Num(),
+	                                 ImportProfile, LoadOptions, MeshData)) {
+		// borrow Ai(Assimp) Importer
+		const auto& AiImporter = FAiImporterPool::Get().Borrow();
+
+		// load AiScene, and take it from AiImporter so that it can be released
+		// part by part while converting
+		FAiScenePtr AiScene;
+		if (nullptr != LoadAiScene(*AiImporter, AssetData, ImportProfile,
+		                           LoadOptions.CancellationToken,
+		                           DependencyFilePathList)) {
+			AiScene.Reset(AiImporter->GetOrphanedScene());
+		}
+
+		// When a scene fails to load, or the load is canceled while parsing
+		if (!AiScene.IsValid() || LoadOptions.IsCanceled()) {
+			// return unset
+			return {};
+		}
+
+		// construct mesh data
+		MeshData =
+		    ConstructMeshData(*AiScene, ImportProfile, FString(), LoadOptions);
+
+		// release what is left of the scene
+		AiScene.Reset();
+	}
+
+	// discard incomplete mesh data if canceled while constructing
+	if (LoadOptions.IsCanceled()) {
+		return {};
+	}
+
+	// store in the disk cache for later loads
+	if (DiskCacheKey.IsSet()) {
+		FMeshDataDiskCache::Store(DiskCacheKey.GetValue(), MeshData, FString(),
+		                          DependencyFilePathList);
+	}
+
+	// output the files the mesh data depends on
+	if (nullptr != DependencyFilePaths) {
+		*DependencyFilePaths = MoveTemp(DependencyFilePathList);
+	}
+
+	// return mesh data
+	return MeshData;
+}
+
+static const aiScene*
+    LoadAiScene(Assimp::Importer& AiImporter, const FString& FilePath,
+                const FAssetImportProfile&              ImportProfile,
+                const FAssetImportCancellationTokenPtr& CancellationToken,
+                TArray<FString>&                        ReadFilePaths) {
+	// read files through IPlatformFile (the importer takes ownership)
+	auto* const AiIOSystem = new FPlatformFileAiIOSystem;
+	AiImporter.SetIOHandler(AiIOSystem);
+
+	// let FindDegenerates remove degenerate triangles instead of turning them
+	// into lines and points, which cannot be converted to sections
+	AiImporter.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true);
+
+	// abort parsing on cancellation (the importer takes ownership)
+	if (CancellationToken.IsValid()) {
+		AiImporter.SetProgressHandler(
+		    new FCancelableAiProgressHandler(CancellationToken));
+	}
 
-static const aiScene* LoadAiScene(Assimp::Importer& AiImporter,
-                                  const FString&    FilePath) {
 	// import
-	return AiImporter.ReadFile(TCHAR_TO_UTF8(*FilePath), AiImportFlags);
+	const auto& AiScene = AiImporter.ReadFile(
+	    TCHAR_TO_UTF8(*FilePath), GetAiPostProcessSteps(ImportProfile));
+
+	// skip post-processing if canceled while parsing
+	if (CancellationToken.IsValid() && CancellationToken->IsCanceled()) {
+		return nullptr;
+	}
+
+	// post-process (only in auto mode)
+	const auto& PostProcessedAiScene =
+	    ApplyAutoPostProcessing(AiImporter, AiScene, ImportProfile);
+
+	// files read while importing (e.g. the .bin of a .gltf, or the .mtl of an
+	// .obj)
+	ReadFilePaths = AiIOSystem->GetOpenedFilePaths();
+
+	return PostProcessedAiScene;
 }
 
-static const aiScene* LoadAiScene(Assimp::Importer&    AiImporter,
-                                  const TArray<uint8>& AssetData) {
+static const aiScene*
+    LoadAiScene(Assimp::Importer& AiImporter, const TArray<uint8>& AssetData,
+                const FAssetImportProfile&              ImportProfile,
+                const FAssetImportCancellationTokenPtr& CancellationToken,
+                TArray<FString>&                        ReadFilePaths) {
+	// read files referenced from the data (e.g. textures) through
+	// IPlatformFile (the importer takes ownership)
+	auto* const AiIOSystem = new FPlatformFileAiIOSystem;
+	AiImporter.SetIOHandler(AiIOSystem);
+
+	// let FindDegenerates remove degenerate triangles instead of turning them
+	// into lines and points, which cannot be converted to sections
+	AiImporter.SetPropertyBool(AI_CONFIG_PP_FD_REMOVE, true);
+
+	// abort parsing on cancellation (the importer takes ownership)
+	if (CancellationToken.IsValid()) {
+		AiImporter.SetProgressHandler(
+		    new FCancelableAiProgressHandler(CancellationToken));
+	}
+
 	// import
-	return AiImporter.ReadFileFromMemory(&AssetData[0], AssetData.Num(),
-	                                     AiImportFlags);
+	const auto& AiScene = AiImporter.ReadFileFromMemory(
+	    &AssetData[0], AssetData.Num(), GetAiPostProcessSteps(ImportProfile));
+
+	// skip post-processing if canceled while parsing
+	if (CancellationToken.IsValid() && CancellationToken->IsCanceled()) {
+		return nullptr;
+	}
+
+	// post-process (only in auto mode)
+	const auto& PostProcessedAiScene =
+	    ApplyAutoPostProcessing(AiImporter, AiScene, ImportProfile);
+
+	// files read while importing (e.g. the .bin of a .gltf, or the .mtl of an
+	// .obj)
+	ReadFilePaths = AiIOSystem->GetOpenedFilePaths();
+
+	return PostProcessedAiScene;
 }
 
-static FLoadedMeshData ConstructMeshData(const aiScene& AiScene) {
+unsigned int
+    GetAiPostProcessSteps(const FAssetImportProfile& ImportProfile) {
+	switch (ImportProfile.ProfileType) {
+	case EAssetImportProfileType::Quality:
+		return AiQualityPostProcessSteps;
+	case EAssetImportProfileType::Fast:
+		return AiFastPostProcessSteps;
+	case EAssetImportProfileType::CollisionOnly:
+		return AiCollisionOnlyPostProcessSteps;
+	case EAssetImportProfileType::Auto:
+		// decided after reading
+		return 0;
+	case EAssetImportProfileType::Custom:
+		return AiRequiredPostProcessSteps |
+		       static_cast<unsigned int>(ImportProfile.CustomPostProcessSteps);
+	default:
+		verifyf(false, TEXT("Bug. ProfileType is not Quality, Fast, "
+		                    "CollisionOnly, Auto, or Custom."));
+		return AiQualityPostProcessSteps;
+	}
+}
+
+static const aiScene*
+    ApplyAutoPostProcessing(Assimp::Importer&          AiImporter,
+                            const aiScene* const       AiScene,
+                            const FAssetImportProfile& ImportProfile) {
+	// do nothing if not auto mode, or if reading failed
+	if (EAssetImportProfileType::Auto != ImportProfile.ProfileType ||
+	    nullptr == AiScene) {
+		return AiScene;
+	}
+
+	// decide steps from the data present
+	const auto& AiPostProcessSteps = GetAutoAiPostProcessSteps(*AiScene);
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("Auto import profile applies post-process steps 0x%08x."),
+	       AiPostProcessSteps);
+
+	// post-process
+	return AiImporter.ApplyPostProcessing(AiPostProcessSteps);
+}
+
+static unsigned int GetAutoAiPostProcessSteps(const aiScene& AiScene) {
+	// inspect what all meshes already have
+	auto        AllMeshesHaveNormals    = true;
+	auto        AllUVMeshesHaveTangents = true;
+	auto        AllMeshesAreIndexed     = true;
+	const auto& NumMeshes               = AiScene.mNumMeshes;
+	for (auto i = decltype(NumMeshes){0}; i < NumMeshes; ++i) {
+		const auto& AiMesh = *AiScene.mMeshes[i];
+
+		AllMeshesHaveNormals &= AiMesh.HasNormals();
+
+		// tangents can only be calculated for meshes with UVs
+		AllUVMeshesHaveTangents &=
+		    !AiMesh.HasTextureCoords(0) || AiMesh.HasTangentsAndBitangents();
+
+		// if vertices are shared between faces, the mesh is already indexed
+		// (e.g. glTF), otherwise every face has its own vertices (e.g. STL)
+		auto NumFaceIndices = uint64{0};
+		for (auto Face_i = decltype(AiMesh.mNumFaces){0}; Face_i < AiMesh.mNumFaces;
+		     ++Face_i) {
+			NumFaceIndices += AiMesh.mFaces[Face_i].mNumIndices;
+		}
+		AllMeshesAreIndexed &= AiMesh.mNumVertices < NumFaceIndices;
+	}
+
+	return GetAutoAiPostProcessSteps(AllMeshesHaveNormals, AllUVMeshesHaveTangents,
+	                                 AllMeshesAreIndexed);
+}
+
+unsigned int GetAutoAiPostProcessSteps(const bool bAllMeshesHaveNormals,
+                                       const bool bAllUVMeshesHaveTangents,
+                                       const bool bAllMeshesAreIndexed) {
+	// start from the Quality profile and drop redundant steps
+	auto AiPostProcessSteps = AiQualityPostProcessSteps;
+
+	if (bAllMeshesHaveNormals) {
+		AiPostProcessSteps &= ~aiProcess_GenSmoothNormals;
+	}
+	if (bAllUVMeshesHaveTangents) {
+		AiPostProcessSteps &= ~aiProcess_CalcTangentSpace;
+	}
+	if (bAllMeshesAreIndexed) {
+		// formats that are already indexed are made for runtime delivery and
+		// are usually optimized by the exporter, too
+		AiPostProcessSteps &=
+		    ~(aiProcess_JoinIdenticalVertices | aiProcess_ImproveCacheLocality |
+		      aiProcess_OptimizeMeshes);
+	}
+
+	return AiPostProcessSteps;
+}
+
+static TArray<UE::Tasks::FTask>
+    LaunchBatchLoadTasks(const TSharedRef<FBatchLoadState>& BatchLoadState,
+                         const int32                        MaxParallelism) {
+	namespace Tasks = UE::Tasks;
+
+	// number of files
+	const auto& NumFiles = BatchLoadState->FilePaths.Num();
+
+	// prepare output (in the same order as FilePaths)
+	BatchLoadState->MeshDataList.SetNum(NumFiles);
+	BatchLoadState->Results.Init(ELoadMeshFromAssetFileResult::Failure,
+	                             NumFiles);
+
+	// decide number of tasks
+	const auto& NumWorkers = MaxParallelism > 0
+	                             ? MaxParallelism
+	                             : FTaskGraphInterface::Get().GetNumWorkerThreads();
+	const auto& NumTasks = FMath::Min(NumWorkers, NumFiles);
+
+	UE_LOG(LogAssetLoader, Log, TEXT("Loading %d files with %d tasks."),
+	       NumFiles, NumTasks);
+
+	// launch tasks
+	TArray<Tasks::FTask> BatchLoadTasks;
+	BatchLoadTasks.Reserve(NumTasks);
+	for (auto Task_i = decltype(NumTasks){0}; Task_i < NumTasks; ++Task_i) {
+		BatchLoadTasks.Add(Tasks::Launch(
+		    UE_SOURCE_LOCATION,
+		    [BatchLoadState, NumFiles]() {
+			    // keep taking the next file until all files are taken
+			    for (auto File_i = BatchLoadState->NextFileIndex++;
+			         File_i < NumFiles; File_i = BatchLoadState->NextFileIndex++) {
+				    // load mesh from the file (each element is written by only
+				    // one task, so no lock is needed)
+				    BatchLoadState->MeshDataList[File_i] =
+				        UAssetLoader::LoadMeshFromAssetFile(
+				            BatchLoadState->FilePaths[File_i],
+				            BatchLoadState->Results[File_i],
+				            BatchLoadState->ImportProfile);
+			    }
+		    },
+		    LowLevelTasks::ETaskPriority::BackgroundNormal));
+	}
+
+	return BatchLoadTasks;
+}
+
+static FLoadedMeshData
+    ConstructMeshData(aiScene&                   AiScene,
+                      const FAssetImportProfile& ImportProfile,
+                      const FString&             AssetDirectory,
+                      const FLoadOptions&        LoadOptions) {
 	// Transform the coordinate system of Ai(Assimp) Scene to the UE coordinate
 	// system.
 	TransformToUECoordinateSystem(AiScene);
@@ -170,19 +1238,146 @@ static FLoadedMeshData ConstructMeshData(const aiScene& AiScene) {
 	FLoadedMeshData MeshData;
 
 	// make a list of materials
-	MeshData.MaterialList = GenerateMaterialList(AiScene);
+	GenerateMaterialList(AiScene, AssetDirectory, /*out*/ MeshData);
+
+	// embedded textures have been copied into the texture list
+	ReleaseAiTextures(AiScene);
 
-	// construct mesh data from Root Node
-	ConstructMeshData(AiScene, *AiScene.mRootNode, /*out*/ MeshData, -1);
+	// start reading and decoding external textures, while the nodes are
+	// constructed
+	auto& TextureCache = FExternalTextureCache::Get();
+	const auto& ExternalTextureTasks =
+	    TextureCache.FindOrLoadAll(MeshData.TextureList);
+
+	// construct node list and section list from Root Node, delivering each
+	// node as soon as it is converted
+	ConstructNodeList(AiScene, ImportProfile.bCompactPrecision, LoadOptions,
+	                  /*in,out*/ MeshData);
+
+	// wait for external textures, and process all textures
+	FinishTextureList(ExternalTextureTasks, ImportProfile, LoadOptions,
+	                  /*out*/ MeshData);
 
 	// return mesh data
 	return MeshData;
 }
 
+void FinishTextureList(
+    const TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>>& ExternalTextureTasks,
+    const FAssetImportProfile& ImportProfile, const FLoadOptions& LoadOptions,
+    FLoadedMeshData& MeshData) {
+	// skip all textures if canceled. The external textures keep loading into
+	// the texture cache.
+	if (LoadOptions.IsCanceled()) {
+		return;
+	}
+
+	// wait for external textures, and mark materials whose texture failed to
+	// load as errors
+	const auto& FailedTextureIndices = FExternalTextureCache::CopyLoadedData(
+	    ExternalTextureTasks, MeshData.TextureList);
+	if (!FailedTextureIndices.IsEmpty()) {
+		for (auto& MaterialData : MeshData.MaterialList) {
+			if (FailedTextureIndices.Contains(MaterialData.TextureIndex)) {
+				MaterialData.TextureIndex = INDEX_NONE;
+				MaterialData.ColorStatus  = EColorStatus::TextureWasSetButError;
+			}
+		}
+	}
+
+	// process textures
+	ProcessTextureList(ImportProfile, LoadOptions, MeshData.TextureList);
+}
+
+static void DeliverAllNodes(const FLoadedMeshData&   MeshData,
+                            const FOnLoadedMeshNode& OnNodeLoaded) {
+	if (!OnNodeLoaded) {
+		return;
+	}
+
+	for (auto Node_i = 0; Node_i < MeshData.NodeList.Num(); ++Node_i) {
+		OnNodeLoaded(MakeLoadedMeshNodeData(MeshData, Node_i));
+	}
+}
+
+static FLoadedMeshNodeData MakeLoadedMeshNodeData(const FLoadedMeshData& MeshData,
+                                                  const int32 NodeIndex) {
+	FLoadedMeshNodeData NodeData;
+	NodeData.NodeIndex = NodeIndex;
+	NodeData.Node      = MeshData.NodeList[NodeIndex];
+
+	// copy sections, and the materials they use
+	const auto& SectionIndices = NodeData.Node.SectionIndices;
+	NodeData.Sections.Reserve(SectionIndices.Num());
+	for (const auto& SectionIndex : SectionIndices) {
+		const auto& Section = MeshData.SectionList[SectionIndex];
+		NodeData.Sections.Add(Section);
+
+		const auto& MaterialIndex = Section.MaterialIndex;
+		if (MeshData.MaterialList.IsValidIndex(MaterialIndex) &&
+		    !NodeData.MaterialIndices.Contains(MaterialIndex)) {
+			NodeData.MaterialIndices.Add(MaterialIndex);
+			NodeData.Materials.Add(MeshData.MaterialList[MaterialIndex]);
+		}
+	}
+
+	return NodeData;
+}
+
+static void ProcessTextureList(const FAssetImportProfile&  ImportProfile,
+                               const FLoadOptions&         LoadOptions,
+                               TArray<FLoadedTextureData>& TextureList) {
+	ParallelFor(TextureList.Num(), [&](const int32 Texture_i) {
+		// skip the remaining textures if canceled
+		if (LoadOptions.IsCanceled()) {
+			return;
+		}
+
+		auto& TextureData = TextureList[Texture_i];
+
+		// copy the pixels shared with the texture cache to process them
+		if (ImportProfile.ProcessesTextures() &&
+		    TextureData.SharedRawData.IsValid()) {
+			TextureData.RawData = *TextureData.SharedRawData;
+			TextureData.SharedRawData.Reset();
+		}
+
+		// decode compressed textures to process them
+		if (ImportProfile.ProcessesTextures() && TextureData.RawData.IsEmpty() &&
+		    !TextureData.CompressedData.IsEmpty()) {
+			if (DecodeTextureData(TextureData.CompressedData.GetData(),
+			                      TextureData.CompressedData.Num(), TextureData)) {
+				TextureData.CompressedData.Empty();
+			} else {
+				UE_LOG(LogAssetLoader, Warning,
+				       TEXT("Failed to decode texture in index %d, so it is not "
+				            "processed."),
+				       Texture_i);
+			}
+		}
+
+		// downscale
+		DownscaleTexture(TextureData, ImportProfile.MaxTextureSize);
+
+		// generate mips
+		if (ImportProfile.bGenerateTextureMips) {
+			GenerateTextureMips(TextureData);
+		}
+
+		// compress
+		CompressTexture(TextureData, ImportProfile.TextureCompression,
+		                ImportProfile.TextureCompressionFormat);
+
+		// record memory size
+		TextureData.MemorySize = GetTextureMemorySize(TextureData);
+	});
+}
+
 static void TransformToUECoordinateSystem(const aiScene& AiScene) {
 	// Generate a transformation matrix to transform from
 	// the Ai(Assimp) coordinate system to the UE coordinate system.
-	const auto& Ai_UE_XformMatrix = GenerateAi_UE_XformMatrix(AiScene);
+	const auto& Ai_UE_XformMatrix =
+	    GenerateAi_UE_XformMatrix(GetAiUnitScaleFactor(AiScene));
 
 	// get assimp root node
 	auto& AiRootNode = AiScene.mRootNode;
@@ -217,10 +1412,8 @@ static float GetAiUnitScaleFactor(const aiScene& AiScene) {
 	return MetaDataUnitScaleFactor;
 }
 
-static aiMatrix4x4t<float> GenerateAi_UE_XformMatrix(const aiScene& AiScene) {
-	// get AiUnitScaleFactor
-	const float& AiUnitScaleFactor = GetAiUnitScaleFactor(AiScene);
-
+aiMatrix4x4t<float>
+    GenerateAi_UE_XformMatrix(const float AiUnitScaleFactor) {
 	// Generate scaling matrix to convert from Assimp units to UE units
 	aiMatrix4x4t<float> Scale_Ai_UE;
 	aiMatrix4x4t<float>::Scaling(aiVector3t<float>(AiUnitScaleFactor),
@@ -233,12 +1426,16 @@ static aiMatrix4x4t<float> GenerateAi_UE_XformMatrix(const aiScene& AiScene) {
 	return Scale_Ai_UE * Rot_AiYUp_UEZUp;
 }
 
-static TArray<FLoadedMaterialData>
-    GenerateMaterialList(const aiScene& AiScene) {
-	TArray<FLoadedMaterialData> MaterialList;
-	const auto&                 NumMaterials = AiScene.mNumMaterials;
+static void GenerateMaterialList(const aiScene&   AiScene,
+                                 const FString&   AssetDirectory,
+                                 FLoadedMeshData& MeshData) {
+	auto&       MaterialList = MeshData.MaterialList;
+	const auto& NumMaterials = AiScene.mNumMaterials;
 	MaterialList.AddDefaulted(NumMaterials);
 
+	// table of unique textures
+	FAiTextureTable TextureTable;
+
 	if (0 == NumMaterials) {
 		UE_LOG(LogAssetLoader, Display, TEXT("There is no Materials."));
 	}
@@ -321,38 +1518,23 @@ static TArray<FLoadedMaterialData>
 				    AiScene.GetEmbeddedTexture(AiTexture0Path.C_Str());
 
 				if (nullptr == AiTexture0) {
-					// TODO: load from file
-					UE_LOG(LogAssetLoader, Error,
-					       TEXT("Texture %s is not embedded in the file and "
-					            "cannot be read."),
-					       UTF8_TO_TCHAR(AiTexture0Path.C_Str()));
-				} else {
-					// get width and height
-					const auto& Width  = AiTexture0->mWidth;
-					const auto& Height = AiTexture0->mHeight;
-
-					// if NOT compressed data
-					if (Height != 0) {
-						TArray64<uint8> CompressedTextureData;
-
-						FImageView ImageView(AiTexture0->pcData, Width, Height,
-						                     ERawImageFormat::BGRA8);
-						FImageUtils::CompressImage(CompressedTextureData, TEXT("png"),
-						                           ImageView);
-
-						MaterialData.CompressedTextureData =
-						    MoveTemp(CompressedTextureData);
-					}
-					// if compressed data
-					else {
-						// when AiTexture0 is compressed
-						const auto& Size = AiTexture0->mWidth;
-						const auto& SeqData =
-						    reinterpret_cast<const uint8*>(AiTexture0->pcData);
-
-						MaterialData.CompressedTextureData =
-						    decltype(MaterialData.CompressedTextureData)(SeqData, Size);
+					// refer to the external texture file in the texture table
+					const auto& TextureIndex = AddExternalTexture(
+					    UTF8_TO_TCHAR(AiTexture0Path.C_Str()), AssetDirectory,
+					    TextureTable);
+
+					if (INDEX_NONE == TextureIndex) {
+						// set ColorStatus as error
+						MaterialData.ColorStatus = EColorStatus::TextureWasSetButError;
+					} else {
+						MaterialData.TextureIndex = TextureIndex;
 					}
+				} else {
+					// refer to the texture in the texture table
+					MaterialData.TextureIndex = AddEmbeddedTexture(
+					    AiTexture0,
+					    reinterpret_cast<const uint8*>(AiTexture0->pcData),
+					    AiTexture0->mWidth, AiTexture0->mHeight, TextureTable);
 				}
 
 				break;
@@ -365,245 +1547,733 @@ static TArray<FLoadedMaterialData>
 		MaterialList[i] = MaterialData;
 	}
 
-	return MaterialList;
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("%u materials refer to %d unique textures (%d external files, "
+	            "%u embedded textures)."),
+	       NumMaterials, TextureTable.TextureList.Num(),
+	       TextureTable.TextureIndexOfFilePath.Num(), AiScene.mNumTextures);
+
+	// set texture list
+	MeshData.TextureList = MoveTemp(TextureTable.TextureList);
+}
+
+int32 AddEmbeddedTexture(const void* const Source, const uint8* const Data,
+                         const uint32 Width, const uint32 Height,
+                         FAiTextureTable& TextureTable) {
+	// if this texture has already been added, refer to it
+	if (const auto& TextureIndex =
+	        TextureTable.TextureIndexOfSource.Find(Source)) {
+		return *TextureIndex;
+	}
+
+	// make texture data
+	FLoadedTextureData TextureData;
+
+	// if NOT compressed data, pass the BGRA8 pixels through as they are
+	if (Height != 0) {
+		static_assert(sizeof(aiTexel) == 4, "aiTexel must be 4 bytes of BGRA.");
+		const auto& NumBytes =
+		    static_cast<int64>(Width) * Height * sizeof(aiTexel);
+		check(NumBytes <= TNumericLimits<int32>::Max());
+
+		TextureData.RawData.Append(Data, static_cast<int32>(NumBytes));
+		TextureData.RawWidth  = Width;
+		TextureData.RawHeight = Height;
+		TextureData.RawFormat = PF_B8G8R8A8;
+	}
+	// if compressed data
+	else {
+		// when the texture is compressed, Width is the size of the data
+		const auto& Size = Width;
+
+		// block-compressed containers (DDS, KTX2) are passed through without
+		// being decoded, and the others are decoded later. Textures are the
+		// base colors of materials, so legacy DDS is in sRGB color space.
+		if (!ReadPrecompressedTexture(Data, Size,
+		                              /* bUnspecifiedIsSRGB = */ true,
+		                              TextureData)) {
+			TextureData.CompressedData.Append(Data, Size);
+		}
+	}
+
+	// hash of the data, to find identical textures embedded more than once
+	const auto& Bytes = TextureData.RawData.IsEmpty() ? TextureData.CompressedData
+	                                                  : TextureData.RawData;
+	const auto& Hash  = HashCombineFast(
+	    GetTypeHash(FXxHash64::HashBuffer(Bytes.GetData(), Bytes.Num()).Hash),
+	    HashCombineFast(GetTypeHash(Width), GetTypeHash(Height)));
+
+	// if a texture with the same data has already been added, refer to it
+	TArray<int32> CandidateIndices;
+	TextureTable.TextureIndicesOfHash.MultiFind(Hash, CandidateIndices);
+	for (const auto& CandidateIndex : CandidateIndices) {
+		const auto& Candidate = TextureTable.TextureList[CandidateIndex];
+		if (Candidate.RawWidth == TextureData.RawWidth &&
+		    Candidate.RawHeight == TextureData.RawHeight &&
+		    Candidate.RawData == TextureData.RawData &&
+		    Candidate.CompressedData == TextureData.CompressedData) {
+			TextureTable.TextureIndexOfSource.Add(Source, CandidateIndex);
+			return CandidateIndex;
+		}
+	}
+
+	// add new texture
+	const auto& TextureIndex =
+	    TextureTable.TextureList.Add(MoveTemp(TextureData));
+	TextureTable.TextureIndexOfSource.Add(Source, TextureIndex);
+	TextureTable.TextureIndicesOfHash.Add(Hash, TextureIndex);
+
+	return TextureIndex;
 }
 
-static void ConstructMeshData(const aiScene& AiScene, const aiNode& AiNode,
-                              FLoadedMeshData& MeshData, int ParentNodeIndex) {
-	// create node
-	FLoadedMeshNode Node;
+static FString ResolveExternalTexturePath(const FString& TexturePath,
+                                          const FString& AssetDirectory) {
+	// resolve the path relative to the asset
+	auto FilePath = TexturePath;
+	FPaths::NormalizeFilename(FilePath);
+	if (FPaths::IsRelative(FilePath)) {
+		if (AssetDirectory.IsEmpty()) {
+			UE_LOG(LogAssetLoader, Error,
+			       TEXT("Texture %s is not embedded in the asset data, and its "
+			            "relative path cannot be resolved without the asset "
+			            "file."),
+			       *TexturePath);
+			return FString();
+		}
+		FilePath = FPaths::Combine(AssetDirectory, FilePath);
+	}
+	return FPaths::ConvertRelativePathToFull(FilePath);
+}
 
-	// set index of parent node
-	Node.ParentNodeIndex = ParentNodeIndex;
+static void ResolveExternalTexturePaths(const FString&              AssetDirectory,
+                                        TArray<FLoadedTextureData>& TextureList) {
+	for (auto& TextureData : TextureList) {
+		if (!TextureData.SourceFilePathInAsset.IsEmpty()) {
+			TextureData.SourceFilePath = ResolveExternalTexturePath(
+			    TextureData.SourceFilePathInAsset, AssetDirectory);
+		}
+	}
+}
 
-	// get/set node name
-	const auto&   AiNodeName = AiNode.mName;
-	const FString NodeName   = UTF8_TO_TCHAR(AiNodeName.C_Str());
-	Node.Name                = NodeName;
+int32 AddExternalTexture(const FString&   TexturePath,
+                         const FString&   AssetDirectory,
+                         FAiTextureTable& TextureTable) {
+	// resolve the path relative to the asset
+	const auto& FilePath = ResolveExternalTexturePath(TexturePath, AssetDirectory);
+	if (FilePath.IsEmpty()) {
+		return INDEX_NONE;
+	}
 
-	// get/set RelativeTransform
-	const auto& AiTransformMatrix = AiNode.mTransformation;
-	Node.RelativeTransform =
-	    static_cast<FTransform>(AiMatrixToUEMatrix(AiTransformMatrix));
+	// if this file has already been added, refer to it
+	if (const auto& TextureIndex =
+	        TextureTable.TextureIndexOfFilePath.Find(FilePath)) {
+		return *TextureIndex;
+	}
 
-	// get number of mesh sections
-	const auto& NumMeshes = AiNode.mNumMeshes;
+	// add new texture, whose data is loaded later
+	FLoadedTextureData TextureData;
+	TextureData.SourceFilePath        = FilePath;
+	TextureData.SourceFilePathInAsset = TexturePath;
+	const auto& TextureIndex =
+	    TextureTable.TextureList.Add(MoveTemp(TextureData));
+	TextureTable.TextureIndexOfFilePath.Add(FilePath, TextureIndex);
 
-	// reserve capacity of array
-	Node.Sections.AddDefaulted(NumMeshes);
+	return TextureIndex;
+}
 
-	// for each sections
-	for (auto i = decltype(NumMeshes){0}; i < NumMeshes; ++i) {
-		// get assimp mesh
-		const auto& AiMeshIndex = AiNode.mMeshes[i];
-		const auto& AiMesh      = AiScene.mMeshes[AiMeshIndex];
-
-		// get reference of the section
-		auto& Section = Node.Sections[i];
-
-		// convert to unreal Vertex format
-		Section.Vertices = [&AiMesh, MeshIndex = i, NodeName]() {
-			TArray<FVector> Vertices;
-			const auto&     NumVertices = AiMesh->mNumVertices;
-			Vertices.AddUninitialized(NumVertices);
-			const auto& AiVertices = AiMesh->mVertices;
-
-			if (!AiMesh->HasPositions()) {
-				UE_LOG(LogAssetLoader, Display,
-				       TEXT("There is no Vertices in index %d in %s."), MeshIndex,
-				       *NodeName);
-			} else {
-				check(NumVertices > 0 && AiVertices != nullptr);
-				for (auto i = decltype(NumVertices){0}; i < NumVertices; ++i) {
-					const auto& AiVertex = AiVertices[i];
-					Vertices[i]          = {AiVertex.x, AiVertex.y, AiVertex.z};
-				}
-			}
+static TArray<FAiNodeWithParentIndex> FlattenAiNodeTree(const aiNode& AiRootNode) {
+	// flattened nodes
+	TArray<FAiNodeWithParentIndex> FlattenedAiNodes;
+
+	// nodes waiting to be visited
+	TArray<FAiNodeWithParentIndex> AiNodeStack;
+	AiNodeStack.Push({&AiRootNode, -1});
+
+	// visit in pre-order depth-first (the same order as visiting recursively)
+	while (!AiNodeStack.IsEmpty()) {
+		// visit next node
+		const auto AiNodeWithParentIndex = AiNodeStack.Pop(EAllowShrinking::No);
+		const auto NodeIndex = FlattenedAiNodes.Add(AiNodeWithParentIndex);
+
+		// push children in reverse order so that the first child is visited first
+		const auto& AiNode      = *AiNodeWithParentIndex.AiNode;
+		const auto& NumChildren = AiNode.mNumChildren;
+		for (auto i = NumChildren; i > 0; --i) {
+			AiNodeStack.Push({AiNode.mChildren[i - 1], NodeIndex});
+		}
+	}
 
-			return Vertices;
-		}();
+	return FlattenedAiNodes;
+}
 
-		// convert to unreal Triangle format
-		Section.Triangles = [&AiMesh, MeshIndex = i, NodeName]() {
-			TArray<int32> Triangles;
-			const auto&   NumFaces = AiMesh->mNumFaces;
-			const auto&   AiFaces  = AiMesh->mFaces;
+static void ConstructNodeList(aiScene&            AiScene,
+                              const bool          bCompactPrecision,
+                              const FLoadOptions& LoadOptions,
+                              FLoadedMeshData&    MeshData) {
+	// get references of the lists to construct
+	auto& NodeList    = MeshData.NodeList;
+	auto& SectionList = MeshData.SectionList;
 
-			if (!AiMesh->HasFaces()) {
-				UE_LOG(LogAssetLoader, Display,
-				       TEXT("There is no Faces in index %d in %s."), MeshIndex,
-				       *NodeName);
-			} else {
-				check(NumFaces > 0 && AiFaces != nullptr);
+	// flatten node tree so that the index of every node is known up front
+	const auto& FlattenedAiNodes = FlattenAiNodeTree(*AiScene.mRootNode);
 
-				Triangles.AddUninitialized(NumFaces * 3);
-				for (auto i = decltype(NumFaces){0}; i < NumFaces; ++i) {
-					const auto& AiFace = AiFaces[i];
-					checkf(AiFace.mNumIndices == 3,
-					       TEXT("Each face must be triangular."));
+	// number of nodes
+	const auto& NumNodes = FlattenedAiNodes.Num();
 
-					for (int_fast8_t triangle_i = 0; triangle_i < 3; ++triangle_i) {
-						Triangles[3 * i + triangle_i] = AiFace.mIndices[triangle_i];
-					}
-				}
+	// pre-size node list
+	NodeList.SetNum(NumNodes);
+
+	// index in SectionList of each assimp mesh, INDEX_NONE if not referenced
+	// (yet). A mesh referenced by multiple nodes is converted only once.
+	TArray<int32> SectionIndexOfAiMesh;
+	SectionIndexOfAiMesh.Init(INDEX_NONE, AiScene.mNumMeshes);
+
+	// assimp mesh index of each element of SectionList
+	TArray<unsigned int> AiMeshIndexOfSection;
+
+	// indices of the nodes referring to each element of SectionList, to
+	// deliver them once the section is converted
+	TArray<TArray<int32>> NodeIndicesOfSection;
+
+	// set up nodes (serially, since this is cheap compared to the conversion)
+	for (auto Node_i = decltype(NumNodes){0}; Node_i < NumNodes; ++Node_i) {
+		// get assimp node
+		const auto& AiNode = *FlattenedAiNodes[Node_i].AiNode;
+
+		// get reference of the node
+		auto& Node = NodeList[Node_i];
+
+		// set index of parent node
+		Node.ParentNodeIndex = FlattenedAiNodes[Node_i].ParentNodeIndex;
+
+		// get/set node name
+		const auto& AiNodeName = AiNode.mName;
+		Node.Name              = UTF8_TO_TCHAR(AiNodeName.C_Str());
+
+		// get/set RelativeTransform
+		const auto& AiTransformMatrix = AiNode.mTransformation;
+		Node.RelativeTransform =
+		    static_cast<FTransform>(AiMatrixToUEMatrix(AiTransformMatrix));
+
+		// get number of mesh sections
+		const auto& NumMeshes = AiNode.mNumMeshes;
+
+		// reserve capacity of array
+		Node.SectionIndices.Reserve(NumMeshes);
+
+		// for each sections
+		for (auto i = decltype(NumMeshes){0}; i < NumMeshes; ++i) {
+			// get assimp mesh index
+			const auto& AiMeshIndex = AiNode.mMeshes[i];
+
+			// get index in the section list
+			auto& SectionIndex = SectionIndexOfAiMesh[AiMeshIndex];
+
+			// if this mesh is referenced for the first time, add it to the list
+			if (INDEX_NONE == SectionIndex) {
+				SectionIndex = AiMeshIndexOfSection.Add(AiMeshIndex);
+				NodeIndicesOfSection.AddDefaulted();
 			}
 
-			return Triangles;
-		}();
-
-		// convert to unreal Normal format
-		Section.Normals = [&AiMesh, MeshIndex = i, NodeName]() {
-			TArray<FVector> Normals;
-			const auto&     NumNormals =
-			    AiMesh->mNumVertices; // num of Normals == num of Vertices
-			Normals.AddUninitialized(NumNormals);
-			const auto& AiNormals = AiMesh->mNormals;
-
-			if (!AiMesh->HasNormals()) {
-				UE_LOG(LogAssetLoader, Display,
-				       TEXT("There is no Normal data in index %d in %s."), MeshIndex,
-				       *NodeName);
-			} else {
-				check(NumNormals > 0 && AiNormals != nullptr);
-				for (auto i = decltype(NumNormals){0}; i < NumNormals; ++i) {
-					const auto& AiNormal = AiNormals[i];
-					Normals[i]           = {AiNormal.x, AiNormal.y, AiNormal.z};
-				}
+			// refer to the section
+			Node.SectionIndices.Add(SectionIndex);
+			NodeIndicesOfSection[SectionIndex].Add(Node_i);
+		}
+	}
+
+	// number of unique sections
+	const auto& NumSections = AiMeshIndexOfSection.Num();
+
+	// pre-size section list, set materials and make conversion jobs
+	SectionList.SetNum(NumSections);
+
+	// vertex attributes present in each section
+	TArray<EAiVertexAttributes> AttributesOfSection;
+	AttributesOfSection.SetNumUninitialized(NumSections);
+
+	// conversion jobs of all sections
+	TArray<FSectionConversionJob> Jobs;
+
+	for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
+	     ++Section_i) {
+		const auto& AiMeshIndex = AiMeshIndexOfSection[Section_i];
+		auto&       AiMesh      = *AiScene.mMeshes[AiMeshIndex];
+		const auto& MeshName    = FString(UTF8_TO_TCHAR(AiMesh.mName.C_Str()));
+		auto&       Section     = SectionList[Section_i];
+
+		// sections are made of triangles only
+		if (aiPrimitiveType_TRIANGLE != AiMesh.mPrimitiveTypes) {
+			const auto& NumRemovedFaces = RemoveNonTriangularAiFaces(AiMesh);
+			if (0 != NumRemovedFaces) {
+				UE_LOG(LogAssetLoader, Warning,
+				       TEXT("%u points and lines are ignored in index %d in %s."),
+				       NumRemovedFaces, AiMeshIndex, *MeshName);
 			}
+		}
 
-			return Normals;
-		}();
+		// set material
+		Section.MaterialIndex = AiMesh.mMaterialIndex;
 
-		// convert to unreal UV0 format
-		Section.UV0Channel = [&AiMesh, MeshIndex = i, NodeName]() {
-			TArray<FVector2D> UV0Channel;
-			const auto&       NumVertices = AiMesh->mNumVertices;
-			UV0Channel.AddUninitialized(NumVertices);
-			const auto& AiUVChannels = AiMesh->mTextureCoords;
+		// get present vertex attributes
+		AttributesOfSection[Section_i] =
+		    GetAiVertexAttributes(AiMesh, AiMeshIndex, MeshName);
 
-			const auto& NumUVChannels = AiMesh->GetNumUVChannels();
+		// if there is no faces
+		if (!AiMesh.HasFaces()) {
+			UE_LOG(LogAssetLoader, Display,
+			       TEXT("There is no Faces in index %d in %s."), AiMeshIndex,
+			       *MeshName);
+		} else {
+			check(AiMesh.mFaces != nullptr);
+		}
 
-			// if there is no UV Channels
-			if (!AiMesh->HasTextureCoords(0)) {
-				// log
-				UE_LOG(LogAssetLoader, Log,
-				       TEXT("There is no UV channels in index %d in %s."), MeshIndex,
-				       *NodeName);
-			} else {
-				check(NumUVChannels > 0 && AiUVChannels != nullptr);
-				ensureMsgf(
-				    1 == NumUVChannels,
-				    TEXT("Currently only 1 UV channel is supported in index %d in %s."),
-				    MeshIndex, *NodeName);
-
-				const auto& AiUV0Channel = AiUVChannels[0];
-				if (0 == NumVertices || nullptr == AiUV0Channel) {
-					check(0 == NumVertices && nullptr == AiUV0Channel);
-					// log
-					UE_LOG(LogAssetLoader, Warning,
-					       TEXT("The first UV channel exists but there is no vertex or "
-					            "channel "
-					            "data in index %d in %s."),
-					       MeshIndex, *NodeName);
-				} else {
-					for (auto i = decltype(NumVertices){0}; i < NumVertices; ++i) {
-						const auto& AiUV0 = AiUV0Channel[i];
-						UV0Channel[i]     = {AiUV0.x, AiUV0.y};
-					}
-				}
-			}
+		// size streams and add jobs
+		SizeSectionAndAddJobs(
+		    Section_i, AttributesOfSection[Section_i],
+		    static_cast<int32>(AiMesh.mNumVertices),
+		    AiMesh.HasFaces() ? static_cast<int32>(AiMesh.mNumFaces) : 0,
+		    bCompactPrecision, Section, Jobs);
+	}
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("%d nodes refer to %d unique sections out of %u meshes."),
+	       NumNodes, NumSections, AiScene.mNumMeshes);
+
+	// convert all ranges of all sections concurrently, releasing the assimp
+	// mesh of each section once it is converted
+	RunSectionConversionJobs(
+	    Jobs, NodeIndicesOfSection,
+	    [&](const FSectionConversionJob& Job) {
+		    const auto& AiMesh =
+		        *AiScene.mMeshes[AiMeshIndexOfSection[Job.SectionIndex]];
+		    auto& Section = SectionList[Job.SectionIndex];
+
+		    const auto& Attributes = AttributesOfSection[Job.SectionIndex];
+
+		    if (Job.bFaces) {
+			    if (!Section.CompactTriangles.IsEmpty()) {
+				    ConvertAiFaceRange(AiMesh, Job.Begin, Job.End,
+				                       Section.CompactTriangles);
+			    } else {
+				    ConvertAiFaceRange(AiMesh, Job.Begin, Job.End,
+				                       Section.Triangles);
+			    }
+		    } else if (bCompactPrecision) {
+			    ConvertAiVertexRangeCompact(AiMesh, Attributes, Job.Begin, Job.End,
+			                                Section);
+		    } else {
+			    ConvertAiVertexRange(AiMesh, Attributes, Job.Begin, Job.End,
+			                         Section);
+		    }
+	    },
+	    [&](const int32 Section_i) {
+		    ReleaseAiMesh(AiScene, AiMeshIndexOfSection[Section_i]);
+	    },
+	    LoadOptions, MeshData);
+}
+
+void SizeSectionAndAddJobs(const int32                    SectionIndex,
+                           const EAiVertexAttributes      Attributes,
+                           const int32                    NumVertices,
+                           const int32                    NumFaces,
+                           const bool                     bCompactPrecision,
+                           FLoadedMeshSectionData&        Section,
+                           TArray<FSectionConversionJob>& Jobs) {
+	// number of vertices/faces converted by one job. Large meshes are split
+	// into multiple jobs so that they are converted by multiple threads.
+	constexpr auto NumVerticesPerJob = int32{16 * 1024};
+	constexpr auto NumFacesPerJob    = int32{16 * 1024};
+
+	// size present vertex streams (absent streams are left empty)
+	const auto& SizeStream = [Attributes,
+	                          NumVertices](const EAiVertexAttributes Attribute,
+	                                       auto&                     Stream) {
+		if (EnumHasAnyFlags(Attributes, Attribute)) {
+			Stream.SetNumUninitialized(NumVertices);
+		}
+	};
+	if (bCompactPrecision) {
+		SizeStream(EAiVertexAttributes::Vertices, Section.CompactVertices);
+		SizeStream(EAiVertexAttributes::Normals, Section.CompactNormals);
+		SizeStream(EAiVertexAttributes::UV0Channel, Section.CompactUV0Channel);
+		SizeStream(EAiVertexAttributes::VertexColors0,
+		           Section.CompactVertexColors0);
+		SizeStream(EAiVertexAttributes::Tangents, Section.CompactTangents);
+	} else {
+		SizeStream(EAiVertexAttributes::Vertices, Section.Vertices);
+		SizeStream(EAiVertexAttributes::Normals, Section.Normals);
+		SizeStream(EAiVertexAttributes::UV0Channel, Section.UV0Channel);
+		SizeStream(EAiVertexAttributes::VertexColors0, Section.VertexColors0);
+		SizeStream(EAiVertexAttributes::Tangents, Section.Tangents);
+	}
 
-			return UV0Channel;
-		}();
+	// add vertex jobs
+	for (auto Begin = int32{0}; Begin < NumVertices; Begin += NumVerticesPerJob) {
+		Jobs.Add({SectionIndex, false, Begin,
+		          FMath::Min(Begin + NumVerticesPerJob, NumVertices)});
+	}
 
-		// convert to unreal Vertex Color format
-		Section.VertexColors0 = [&AiMesh, MeshIndex = i, NodeName]() {
-			TArray<FLinearColor> VertexColors0;
-			const auto&          NumVertices = AiMesh->mNumVertices;
-			VertexColors0.AddUninitialized(NumVertices);
-			const auto& AiVertexColors = AiMesh->mColors;
+	// if there is no faces
+	if (0 == NumFaces) {
+		return;
+	}
 
-			const auto& NumVertexColorChannels = AiMesh->GetNumColorChannels();
+	// size triangles (16-bit indices if compact and they are enough)
+	if (bCompactPrecision && NumVertices <= TNumericLimits<uint16>::Max()) {
+		Section.CompactTriangles.SetNumUninitialized(NumFaces * 3);
+	} else {
+		Section.Triangles.SetNumUninitialized(NumFaces * 3);
+	}
 
-			// if there is no Vertex Color Channels
-			if (!AiMesh->HasVertexColors(0)) {
-				// log
-				UE_LOG(LogAssetLoader, Verbose,
-				       TEXT("There is no Vertex Color channels in index %d in %s."),
-				       MeshIndex, *NodeName);
-			} else {
-				check(NumVertexColorChannels > 0 && AiVertexColors != nullptr);
-				ensureMsgf(1 == NumVertexColorChannels,
-				           TEXT("Currently only 1 Vertex Color channel is supported in "
-				                "index %d in %s."),
-				           MeshIndex, *NodeName);
-
-				const auto& AiVertexColors0 = AiVertexColors[0];
-				if (0 == NumVertices || nullptr == AiVertexColors0) {
-					check(0 == NumVertices && nullptr == AiVertexColors0);
-					// log
-					UE_LOG(LogAssetLoader, Warning,
-					       TEXT("The first Vertex Color channel exists but there is no "
-					            "vertex or "
-					            "channel data in index %d in %s."),
-					       MeshIndex, *NodeName);
-				} else {
-					for (auto i = decltype(NumVertices){0}; i < NumVertices; ++i) {
-						const auto& AiVertexColor = AiVertexColors0[i];
-						VertexColors0[i]          = {AiVertexColor.r, AiVertexColor.g,
-						                             AiVertexColor.b, AiVertexColor.a};
-					}
-				}
+	// add face jobs
+	for (auto Begin = int32{0}; Begin < NumFaces; Begin += NumFacesPerJob) {
+		Jobs.Add({SectionIndex, true, Begin,
+		          FMath::Min(Begin + NumFacesPerJob, NumFaces)});
+	}
+}
+
+void RunSectionConversionJobs(
+    const TArray<FSectionConversionJob>&             Jobs,
+    const TArray<TArray<int32>>&                     NodeIndicesOfSection,
+    TFunctionRef<void(const FSectionConversionJob&)> ConvertJob,
+    TFunctionRef<void(int32)>                        OnSectionConverted,
+    const FLoadOptions& LoadOptions, FLoadedMeshData& MeshData) {
+	auto& NodeList    = MeshData.NodeList;
+	auto& SectionList = MeshData.SectionList;
+
+	const auto& NumNodes    = NodeList.Num();
+	const auto& NumSections = SectionList.Num();
+
+	// number of jobs left of each section, and number of unfinished sections
+	// of each node
+	const auto& NumJobsLeftOfSection =
+	    MakeUnique<std::atomic<int32>[]>(NumSections);
+	const auto& NumSectionsLeftOfNode = MakeUnique<std::atomic<int32>[]>(NumNodes);
+	for (const auto& Job : Jobs) {
+		++NumJobsLeftOfSection[Job.SectionIndex];
+	}
+	for (auto Node_i = decltype(NumNodes){0}; Node_i < NumNodes; ++Node_i) {
+		NumSectionsLeftOfNode[Node_i] = NodeList[Node_i].SectionIndices.Num();
+	}
+
+	// finish a section whose ranges have all been converted: release its
+	// source, collapse streams whose values are the same for all vertices, and
+	// deliver the nodes whose sections have all been finished
+	const auto& OnNodeLoaded  = LoadOptions.OnNodeLoaded;
+	const auto& FinishSection = [&](const int32 Section_i) {
+		OnSectionConverted(Section_i);
+		CollapseConstantStreams(SectionList[Section_i]);
+
+		// the caller is no longer interested in the nodes if canceled
+		if (LoadOptions.IsCanceled()) {
+			return;
+		}
+
+		for (const auto& Node_i : NodeIndicesOfSection[Section_i]) {
+			if (0 == --NumSectionsLeftOfNode[Node_i] && OnNodeLoaded) {
+				OnNodeLoaded(MakeLoadedMeshNodeData(MeshData, Node_i));
 			}
+		}
+	};
+
+	// deliver nodes without sections, and finish sections without anything to
+	// convert, first
+	if (OnNodeLoaded) {
+		for (auto Node_i = decltype(NumNodes){0}; Node_i < NumNodes; ++Node_i) {
+			if (0 == NumSectionsLeftOfNode[Node_i]) {
+				OnNodeLoaded(MakeLoadedMeshNodeData(MeshData, Node_i));
+			}
+		}
+	}
+	for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
+	     ++Section_i) {
+		if (0 == NumJobsLeftOfSection[Section_i]) {
+			FinishSection(Section_i);
+		}
+	}
 
-			return VertexColors0;
-		}();
-
-		// convert to unreal Tangent format
-		Section.Tangents = [&AiMesh, MeshIndex = i, NodeName]() {
-			TArray<FProcMeshTangent> Tangents;
-			const auto&              NumTangents =
-			    AiMesh->mNumVertices; // num of Tangents == num of Vertices
-			Tangents.AddUninitialized(NumTangents);
-			const auto& AiTangents = AiMesh->mTangents;
-
-			if (!AiMesh->HasTangentsAndBitangents()) {
-				UE_LOG(LogAssetLoader, Display,
-				       TEXT("There is no Tangent data in index %d in %s."), MeshIndex,
-				       *NodeName);
-			} else {
-				check(NumTangents > 0 && AiTangents != nullptr);
-				for (auto i = decltype(NumTangents){0}; i < NumTangents; ++i) {
-					const auto& AiTangent = AiTangents[i];
-					Tangents[i]           = {AiTangent.x, AiTangent.y, AiTangent.z};
-				}
+	// convert all ranges of all sections concurrently. Jobs are in the order
+	// of the sections, which are in the order the nodes first refer to them,
+	// so the first nodes tend to be finished first.
+	ParallelFor(TEXT("RuntimeAssetImport.ConstructNodeList"), Jobs.Num(), 1,
+	            [&](const int32 Job_i) {
+		            // skip the remaining jobs if canceled
+		            if (LoadOptions.IsCanceled()) {
+			            return;
+		            }
+
+		            const auto& Job = Jobs[Job_i];
+		            ConvertJob(Job);
+
+		            // the job converting the last range finishes the section
+		            if (0 == --NumJobsLeftOfSection[Job.SectionIndex]) {
+			            FinishSection(Job.SectionIndex);
+		            }
+	            });
+}
+
+static EAiVertexAttributes GetAiVertexAttributes(const aiMesh&  AiMesh,
+                                                 const int      MeshIndex,
+                                                 const FString& MeshName) {
+	auto Attributes = EAiVertexAttributes::None;
+
+	// vertices
+	if (!AiMesh.HasPositions()) {
+		UE_LOG(LogAssetLoader, Display,
+		       TEXT("There is no Vertices in index %d in %s."), MeshIndex,
+		       *MeshName);
+	} else {
+		check(AiMesh.mNumVertices > 0 && AiMesh.mVertices != nullptr);
+		Attributes |= EAiVertexAttributes::Vertices;
+	}
+
+	// normals
+	if (!AiMesh.HasNormals()) {
+		UE_LOG(LogAssetLoader, Display,
+		       TEXT("There is no Normal data in index %d in %s."), MeshIndex,
+		       *MeshName);
+	} else {
+		check(AiMesh.mNumVertices > 0 && AiMesh.mNormals != nullptr);
+		Attributes |= EAiVertexAttributes::Normals;
+	}
+
+	// UV channel
+	if (!AiMesh.HasTextureCoords(0)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("There is no UV channels in index %d in %s."), MeshIndex,
+		       *MeshName);
+	} else {
+		ensureMsgf(
+		    1 == AiMesh.GetNumUVChannels(),
+		    TEXT("Currently only 1 UV channel is supported in index %d in %s."),
+		    MeshIndex, *MeshName);
+		Attributes |= EAiVertexAttributes::UV0Channel;
+	}
+
+	// vertex color channel
+	if (!AiMesh.HasVertexColors(0)) {
+		UE_LOG(LogAssetLoader, Verbose,
+		       TEXT("There is no Vertex Color channels in index %d in %s."),
+		       MeshIndex, *MeshName);
+	} else {
+		ensureMsgf(1 == AiMesh.GetNumColorChannels(),
+		           TEXT("Currently only 1 Vertex Color channel is supported in "
+		                "index %d in %s."),
+		           MeshIndex, *MeshName);
+		Attributes |= EAiVertexAttributes::VertexColors0;
+	}
+
+	// tangents
+	if (!AiMesh.HasTangentsAndBitangents()) {
+		UE_LOG(LogAssetLoader, Display,
+		       TEXT("There is no Tangent data in index %d in %s."), MeshIndex,
+		       *MeshName);
+	} else {
+		check(AiMesh.mNumVertices > 0 && AiMesh.mTangents != nullptr);
+		Attributes |= EAiVertexAttributes::Tangents;
+	}
+
+	return Attributes;
+}
+
+// assimp's vectors and colors must be tightly packed floats so that they can
+// be converted as flat float arrays
+static_assert(sizeof(ai_real) == sizeof(float),
+              "Assimp built with double precision is not supported.");
+static_assert(sizeof(aiVector3D) == 3 * sizeof(float));
+static_assert(sizeof(FVector) == 3 * sizeof(double));
+static_assert(sizeof(FVector2D) == 2 * sizeof(double));
+static_assert(sizeof(aiVector3D) == sizeof(FVector3f));
+static_assert(sizeof(aiColor4D) == sizeof(FLinearColor));
+static_assert(sizeof(FVector2DHalf) == 2 * sizeof(uint16));
+
+// number of vertices converted at a time, so that a job moves through all
+// streams of its range together instead of sweeping the range once per
+// attribute
+static constexpr int32 VertexBlockSize = 256;
+
+static void ConvertAiVertexRange(const aiMesh&             AiMesh,
+                                 const EAiVertexAttributes Attributes,
+                                 const int32 Begin, const int32 End,
+                                 FLoadedMeshSectionData& Section) {
+	for (auto BlockBegin = Begin; BlockBegin < End;
+	     BlockBegin += VertexBlockSize) {
+		// range of the block
+		const auto& BlockEnd = FMath::Min(BlockBegin + VertexBlockSize, End);
+		const auto& Num      = BlockEnd - BlockBegin;
+
+		// vertices
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Vertices)) {
+			WidenFloatsToDoubles(&AiMesh.mVertices[BlockBegin].x,
+			                     &Section.Vertices[BlockBegin].X,
+			                     3 * int64{Num});
+		}
+
+		// normals
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+			WidenFloatsToDoubles(&AiMesh.mNormals[BlockBegin].x,
+			                     &Section.Normals[BlockBegin].X, 3 * int64{Num});
+		}
+
+		// UV channel (only x and y are used)
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::UV0Channel)) {
+			WidenFloat3sToDouble2s(&AiMesh.mTextureCoords[0][BlockBegin].x,
+			                       &Section.UV0Channel[BlockBegin].X, Num);
+		}
+
+		// vertex colors (same layout, so just copy)
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+			FMemory::Memcpy(&Section.VertexColors0[BlockBegin],
+			                &AiMesh.mColors[0][BlockBegin],
+			                Num * sizeof(FLinearColor));
+		}
+
+		// tangents
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Tangents)) {
+			const auto& AiTangents = AiMesh.mTangents;
+			auto&       Tangents   = Section.Tangents;
+			for (auto i = BlockBegin; i < BlockEnd; ++i) {
+				const auto& AiTangent = AiTangents[i];
+				Tangents[i]           = {AiTangent.x, AiTangent.y, AiTangent.z};
 			}
+		}
+	}
+}
+
+static void ConvertAiVertexRangeCompact(const aiMesh&             AiMesh,
+                                        const EAiVertexAttributes Attributes,
+                                        const int32 Begin, const int32 End,
+                                        FLoadedMeshSectionData& Section) {
+	for (auto BlockBegin = Begin; BlockBegin < End;
+	     BlockBegin += VertexBlockSize) {
+		// range of the block
+		const auto& BlockEnd = FMath::Min(BlockBegin + VertexBlockSize, End);
+		const auto& Num      = BlockEnd - BlockBegin;
+
+		// vertices (same layout, so just copy)
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Vertices)) {
+			FMemory::Memcpy(&Section.CompactVertices[BlockBegin],
+			                &AiMesh.mVertices[BlockBegin],
+			                Num * sizeof(FVector3f));
+		}
+
+		// normals
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+			EncodeOctahedrals(&AiMesh.mNormals[BlockBegin].x,
+			                  &Section.CompactNormals[BlockBegin], Num);
+		}
+
+		// UV channel (only x and y are used)
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::UV0Channel)) {
+			NarrowFloat3sToHalf2s(
+			    &AiMesh.mTextureCoords[0][BlockBegin].x,
+			    &Section.CompactUV0Channel[BlockBegin].X.Encoded, Num);
+		}
+
+		// vertex colors (without sRGB conversion, same as the full precision
+		// path)
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+			QuantizeLinearColors(&AiMesh.mColors[0][BlockBegin].r,
+			                     &Section.CompactVertexColors0[BlockBegin], Num);
+		}
+
+		// tangents
+		if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Tangents)) {
+			EncodeOctahedrals(&AiMesh.mTangents[BlockBegin].x,
+			                  &Section.CompactTangents[BlockBegin], Num);
+		}
+	}
+}
+
+static void CollapseConstantStreams(FLoadedMeshSectionData& Section) {
+	// element types whose operator== is exact
+	const auto& EqualsOperator = [](const auto& A, const auto& B) {
+		return A == B;
+	};
+
+	// full precision streams
+	CollapseConstantStream(Section.Normals, EqualsOperator);
+	CollapseConstantStream(Section.UV0Channel, EqualsOperator);
+	CollapseConstantStream(Section.VertexColors0, EqualsOperator);
+	CollapseConstantStream(
+	    Section.Tangents, [](const FProcMeshTangent& A, const FProcMeshTangent& B) {
+		    return A.TangentX == B.TangentX && A.bFlipTangentY == B.bFlipTangentY;
+	    });
+
+	// compact precision streams
+	CollapseConstantStream(Section.CompactNormals, EqualsOperator);
+	CollapseConstantStream(
+	    Section.CompactUV0Channel,
+	    [](const FVector2DHalf& A, const FVector2DHalf& B) {
+		    return A.X.Encoded == B.X.Encoded && A.Y.Encoded == B.Y.Encoded;
+	    });
+	CollapseConstantStream(Section.CompactVertexColors0, EqualsOperator);
+	CollapseConstantStream(Section.CompactTangents, EqualsOperator);
+}
 
-			return Tangents;
-		}();
+template <typename T, typename EqualsT>
+static void CollapseConstantStream(TArray<T>& Stream, EqualsT Equals) {
+	// nothing to collapse
+	if (Stream.Num() <= 1) {
+		return;
+	}
 
-		// set Material
-		Section.MaterialIndex = AiMesh->mMaterialIndex;
+	// if any element differs from the first one, the stream is not constant
+	const auto& First = Stream[0];
+	for (auto i = 1; i < Stream.Num(); ++i) {
+		if (!Equals(Stream[i], First)) {
+			return;
+		}
 	}
 
-	// add node to node list (MeshData.NodeList)
-	MeshData.NodeList.Add(MoveTemp(Node));
+	// keep only the first element
+	Stream.SetNum(1);
+	Stream.Shrink();
+}
 
-	// get this node's index
-	const auto NodeIndex = MeshData.NodeList.Num() - 1;
+static unsigned int RemoveNonTriangularAiFaces(aiMesh& AiMesh) {
+	const auto& AiFaces  = AiMesh.mFaces;
+	const auto& NumFaces = AiMesh.mNumFaces;
 
-	// Recursively add children's mesh nodes
-	const auto& NumChildren = AiNode.mNumChildren;
-	for (auto i = decltype(NumChildren){0}; i < NumChildren; ++i) {
-		// get assimp child Node
-		const auto& AiChildNode = *AiNode.mChildren[i];
+	// move triangles to the front by swapping, so that the other faces are
+	// still freed with the mesh
+	auto NumTriangles = decltype(NumFaces){0};
+	for (auto i = decltype(NumFaces){0}; i < NumFaces; ++i) {
+		if (3 != AiFaces[i].mNumIndices) {
+			continue;
+		}
+		if (NumTriangles != i) {
+			Swap(AiFaces[NumTriangles].mNumIndices, AiFaces[i].mNumIndices);
+			Swap(AiFaces[NumTriangles].mIndices, AiFaces[i].mIndices);
+		}
+		++NumTriangles;
+	}
 
-		// construct mesh data
-		ConstructMeshData(AiScene, AiChildNode, MeshData, NodeIndex);
+	// only the triangles are counted
+	const auto NumRemovedFaces = NumFaces - NumTriangles;
+	AiMesh.mNumFaces           = NumTriangles;
+	AiMesh.mPrimitiveTypes     = aiPrimitiveType_TRIANGLE;
+
+	return NumRemovedFaces;
+}
+
+template <typename IndexT>
+static void ConvertAiFaceRange(const aiMesh& AiMesh, const int32 Begin,
+                               const int32 End, TArray<IndexT>& Triangles) {
+	const auto& AiFaces = AiMesh.mFaces;
+
+	for (auto i = Begin; i < End; ++i) {
+		const auto& AiFace = AiFaces[i];
+		checkf(AiFace.mNumIndices == 3, TEXT("Each face must be triangular."));
+
+		for (int_fast8_t triangle_i = 0; triangle_i < 3; ++triangle_i) {
+			Triangles[3 * i + triangle_i] =
+			    static_cast<IndexT>(AiFace.mIndices[triangle_i]);
+		}
 	}
 }
 
-static FMatrix AiMatrixToUEMatrix(const aiMatrix4x4& AiMatrix4x4) {
+FMatrix AiMatrixToUEMatrix(const aiMatrix4x4& AiMatrix4x4) {
 	// give a short name
 	const auto& M = AiMatrix4x4;
 
@@ -613,4 +2283,61 @@ static FMatrix AiMatrixToUEMatrix(const aiMatrix4x4& AiMatrix4x4) {
 	        {M.a3, M.b3, M.c3, M.d3},
 	        {M.a4, M.b4, M.c4, M.d4}};
 }
+
+void MirrorAiTransformZ(aiMatrix4x4& AiTransform) {
+	// mirror all base vectors at the local Z axis
+	AiTransform.c1 = -AiTransform.c1;
+	AiTransform.c2 = -AiTransform.c2;
+	AiTransform.c3 = -AiTransform.c3;
+	AiTransform.c4 = -AiTransform.c4;
+
+	// invert the Z axis again to keep the determinant positive (c3 is negated
+	// twice, as assimp does)
+	AiTransform.a3 = -AiTransform.a3;
+	AiTransform.b3 = -AiTransform.b3;
+	AiTransform.c3 = -AiTransform.c3;
+	AiTransform.d3 = -AiTransform.d3;
+}
+
+static bool TryConstructMeshDataFromFile(const FString&             FilePath,
+                                         const FAssetImportProfile& ImportProfile,
+                                         const FLoadOptions&        LoadOptions,
+                                         FLoadedMeshData&           MeshData,
+                                         TArray<FString>& DependencyFilePaths) {
+	// import everything with assimp if the native loaders are disabled
+	if (!GetDefault<URuntimeAssetImportSettings>()->bEnableNativeLoaders) {
+		return false;
+	}
+
+	// map the file so that it is read in place, and keep it mapped until the
+	// conversion is finished
+	FMappedMeshFile MappedFile;
+	TArray64<uint8> FileData;
+	const uint8*    Data = nullptr;
+	int64           Size = 0;
+	if (MapMeshFile(FilePath, MappedFile)) {
+		Data = MappedFile.GetData();
+		Size = MappedFile.GetSize();
+	}
+	// if it cannot be mapped, read it only if it is a GLB
+	else if (ReadGlbFile(FilePath, FileData)) {
+		Data = FileData.GetData();
+		Size = FileData.Num();
+	} else {
+		return false;
+	}
+
+	// GLBs are recognized by their content, as assimp does
+	if (HasGlbSignature(Data, Size)) {
+		return TryConstructMeshDataFromGlb(Data, Size, ImportProfile, LoadOptions,
+		                                   MeshData);
+	}
+
+	return TryConstructMeshDataFromBinaryMeshFile(FilePath, Data, Size,
+	                                              ImportProfile, LoadOptions,
+	                                              MeshData) ||
+	       TryConstructMeshDataFromObjFile(FilePath, Data, Size, ImportProfile,
+	                                       LoadOptions, MeshData,
+	                                       DependencyFilePaths);
+}
 #pragma endregion
@@ -0,0 +1,907 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "BinaryMeshFiles.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformFileManager.h"
+#include "LogAssetLoader.h"
+#include "MeshDataConstruction.h"
+#include "Misc/Paths.h"
+#include "VertexStreamConversion.h"
+
+#include <atomic>
+
+// binary STL header (followed by the number of facets)
+static constexpr int64 StlHeaderSize = 80;
+
+// longest PLY header searched for "end_header"
+static constexpr int64 PlyMaxHeaderSize = 64 * 1024;
+
+/**
+ * Property of a PLY element.
+ */
+struct FPlyProperty {
+	// name (e.g. "x")
+	FString Name;
+
+	// type of a scalar, or of the number of indices of a list (e.g. "float")
+	FString Type;
+
+	// type of the indices of a list, empty for a scalar
+	FString IndexType;
+};
+
+/**
+ * Element of a PLY file.
+ */
+struct FPlyElement {
+	// name (e.g. "vertex")
+	FString Name;
+
+	// number of instances
+	int64 Count = 0;
+
+	// properties in the order they are stored
+	TArray<FPlyProperty> Properties;
+};
+
+/**
+ * The scene assimp's STL or PLY importer makes of a binary file: a chain of
+ * nodes, the last of which refers to the only mesh, and a single material.
+ */
+struct FBinaryMeshScene {
+	// names of the nodes, from the root node down
+	TArray<FString> NodeNames;
+
+	// diffuse color of the material
+	FLinearColor MaterialColor = FLinearColor::White;
+
+	// vertex attributes present in the mesh
+	EAiVertexAttributes Attributes = EAiVertexAttributes::Vertices;
+
+	// number of vertices and triangles of the mesh
+	int32 NumVertices = 0;
+	int32 NumFaces    = 0;
+
+	// whether every vertex is referred to by a face
+	bool bAllVerticesAreReferenced = true;
+};
+
+#pragma region forward declarations of static functions
+/**
+ * Read the next line of a PLY header and split it into tokens.
+ * @param           Data       content of the file
+ * @param           Size       size of Data in bytes
+ * @param[in,out]   Position   start of the line, moved to the next line
+ * @param[out]      Tokens     tokens of the line
+ * @return  whether a whole line has been read
+ */
+static bool ReadPlyHeaderLine(const uint8* Data, int64 Size, int64& Position,
+                              TArray<FString>& Tokens);
+
+/**
+ * Get the size of a PLY scalar type.
+ * @param   Type   type (e.g. "float" or "uchar")
+ * @return  the size in bytes, 0 if unknown
+ */
+static int32 GetPlyTypeSize(const FString& Type);
+
+/**
+ * Whether a PLY scalar type is an integer type.
+ * @param   Type   type (e.g. "uchar")
+ */
+static bool IsPlyIntegerType(const FString& Type);
+
+/**
+ * Set the offsets of a group of vertex properties, checking that either all
+ * or none of them are present with the given type.
+ * @param        Vertex     vertex element
+ * @param        Names      names of the properties of the group
+ * @param        TypeSize   size of their type: 4 for float, or 1 for uchar
+ * @param[out]   Offsets    offsets of the properties in a vertex, INDEX_NONE
+ *                          if absent
+ * @return  whether the group is all present or all absent, and of the type
+ */
+static bool SetPlyPropertyOffsets(const FPlyElement&             Vertex,
+                                  TArrayView<const TCHAR* const> Names,
+                                  int32 TypeSize, int32* Offsets);
+
+/**
+ * Whether every face of a PLY file is a triangle whose indices are in range.
+ * The faces are checked in chunks concurrently.
+ * @param   File   parsed file whose faces are inside the data
+ */
+static bool AreAllPlyFacesTriangles(const FPlyFile& File);
+
+/**
+ * Read a little-endian 32-bit unsigned integer.
+ * @param   Data   first byte
+ */
+static uint32 ReadUInt32(const uint8* Data);
+
+/**
+ * Try to construct mesh data from a parsed binary STL or PLY file, as assimp
+ * would with the post-process steps of the import profile. Files needing
+ * steps that are not reproduced (e.g. JoinIdenticalVertices for STL in auto
+ * mode, or normals to be generated) are left to assimp.
+ * @tparam       FileT           FStlFile or FPlyFile
+ * @param        File            parsed file
+ * @param        Scene           the scene assimp's importer makes of the file
+ * @param        ImportProfile   which post-process steps to apply
+ * @param        LoadOptions     progressive delivery and cancellation of the
+ *                               load
+ * @param[out]   MeshData        constructed mesh data, untouched if not
+ *                               constructed
+ * @return  whether the mesh data has been constructed
+ */
+template <typename FileT>
+static bool TryConstructMeshDataFromBinaryMesh(
+    const FileT& File, const FBinaryMeshScene& Scene,
+    const FAssetImportProfile& ImportProfile, const FLoadOptions& LoadOptions,
+    FLoadedMeshData& MeshData);
+
+/**
+ * Whether assimp's FindInvalidData step would change the mesh of a binary STL
+ * or PLY file: any position or normal of a vertex referred to by a face is
+ * NaN or infinite, a normal is zero, or all positions are identical. The
+ * vertices are checked in chunks concurrently.
+ * @tparam   FileT   FStlFile or FPlyFile
+ * @param    File    parsed file
+ * @param    Scene   the scene assimp's importer makes of the file
+ */
+template <typename FileT>
+static bool HasInvalidBinaryMeshData(const FileT&            File,
+                                     const FBinaryMeshScene& Scene);
+
+/**
+ * Convert a range of vertices of a binary STL or PLY file to UE's format, as
+ * assimp would store them after its MakeLeftHanded step.
+ * The streams of the present attributes must already be sized to the number
+ * of vertices.
+ * @tparam       FileT        FStlFile or FPlyFile
+ * @param        File         parsed file
+ * @param        Attributes   vertex attributes present in the mesh
+ * @param        Begin        first vertex to convert
+ * @param        End          one past the last vertex to convert
+ * @param[out]   Section      section whose streams are written
+ */
+template <typename FileT>
+static void ConvertBinaryMeshVertexRange(const FileT&        File,
+                                         EAiVertexAttributes Attributes,
+                                         int32 Begin, int32 End,
+                                         FLoadedMeshSectionData& Section);
+
+/**
+ * Compact precision version of ConvertBinaryMeshVertexRange.
+ * @tparam       FileT        FStlFile or FPlyFile
+ * @param        File         parsed file
+ * @param        Attributes   vertex attributes present in the mesh
+ * @param        Begin        first vertex to convert
+ * @param        End          one past the last vertex to convert
+ * @param[out]   Section      section whose compact streams are written
+ */
+template <typename FileT>
+static void ConvertBinaryMeshVertexRangeCompact(const FileT&        File,
+                                                EAiVertexAttributes Attributes,
+                                                int32 Begin, int32 End,
+                                                FLoadedMeshSectionData& Section);
+
+/**
+ * Convert a range of triangles of a binary STL or PLY file to UE's triangle
+ * format. Triangles must already be sized to 3 times the number of faces.
+ * @tparam       IndexT      int32, or uint16 for compact precision
+ * @tparam       FileT       FStlFile or FPlyFile
+ * @param        File        parsed file
+ * @param        Begin       first triangle to convert
+ * @param        End         one past the last triangle to convert
+ * @param[out]   Triangles   triangles of the section
+ */
+template <typename IndexT, typename FileT>
+static void ConvertBinaryMeshFaceRange(const FileT& File, int32 Begin, int32 End,
+                                       TArray<IndexT>& Triangles);
+#pragma endregion
+
+FLinearColor FStlFile::GetColor(const int32 Index) const {
+	const auto& Facet = Facets + Index / 3 * FacetSize;
+	const auto& Attribute =
+	    static_cast<uint16>(Facet[48] | static_cast<uint16>(Facet[49]) << 8);
+
+	// facets without a color keep the default color
+	if (0 == (Attribute & (1 << 15))) {
+		return DefaultColor;
+	}
+
+	// 5 bits per channel, red first in Materialise files and blue first in
+	// others
+	const auto& InvMax = 1.0f / 31.0f;
+	const auto& Low    = (Attribute & 0x1fu) * InvMax;
+	const auto& Middle = ((Attribute & (0x1fu << 5)) >> 5u) * InvMax;
+	const auto& High   = ((Attribute & (0x1fu << 10)) >> 10u) * InvMax;
+	return bIsMaterialise ? FLinearColor(Low, Middle, High, 1.0f)
+	                      : FLinearColor(High, Middle, Low, 1.0f);
+}
+
+FLinearColor FPlyFile::GetColor(const int32 Index) const {
+	const auto& Vertex = Vertices + Index * VertexStride;
+	const auto& Normalize = [Vertex](const int32 Offset) {
+		return static_cast<float>(Vertex[Offset]) / 255.0f;
+	};
+
+	return FLinearColor(
+	    Normalize(ColorOffsets[0]), Normalize(ColorOffsets[1]),
+	    Normalize(ColorOffsets[2]),
+	    INDEX_NONE == ColorOffsets[3] ? 1.0f : Normalize(ColorOffsets[3]));
+}
+
+bool MapMeshFile(const FString& FilePath, FMappedMeshFile& File) {
+	// get platform file (top of the chain, so pak files are included)
+	auto& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	auto OpenMappedResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (OpenMappedResult.HasError()) {
+		return false;
+	}
+	File.Handle = OpenMappedResult.StealValue();
+	File.Region.Reset(File.Handle->MapRegion(0, File.Handle->GetFileSize()));
+	return File.Region.IsValid();
+}
+
+bool ParseBinaryStl(const uint8* const Data, const int64 Size, FStlFile& File) {
+	// the size must be that of the header and the facets it announces
+	if (Size < StlHeaderSize + 4) {
+		return false;
+	}
+	const auto& NumFacets = ReadUInt32(Data + StlHeaderSize);
+	if (StlHeaderSize + 4 + FStlFile::FacetSize * NumFacets != Size ||
+	    0 == NumFacets) {
+		return false;
+	}
+	if (NumFacets > static_cast<uint32>(TNumericLimits<int32>::Max() / 3)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("STL has too many facets (%u) for a section."), NumFacets);
+		return false;
+	}
+	File.Facets    = Data + StlHeaderSize + 4;
+	File.NumFacets = static_cast<int32>(NumFacets);
+
+	// search the header for a default color the same way as assimp does
+	// (which may read past the header into the number of facets)
+	const auto& InvByte   = 1.0f / 255.0f;
+	const auto* Cursor    = Data;
+	const auto& HeaderEnd = Data + StlHeaderSize;
+	while (Cursor < HeaderEnd) {
+		if ('C' == *Cursor++ && 'O' == *Cursor++ && 'L' == *Cursor++ &&
+		    'O' == *Cursor++ && 'R' == *Cursor++ && '=' == *Cursor++) {
+			File.bIsMaterialise = true;
+			File.DefaultColor   = FLinearColor(
+			    Cursor[0] * InvByte, Cursor[1] * InvByte, Cursor[2] * InvByte,
+			    Cursor[3] * InvByte);
+			break;
+		}
+	}
+
+	// whether any facet has a color, checked in chunks concurrently
+	constexpr auto    NumFacetsPerChunk = int32{64 * 1024};
+	std::atomic<bool> bHasFacetColors   = false;
+	ParallelFor((File.NumFacets + NumFacetsPerChunk - 1) / NumFacetsPerChunk,
+	            [&](const int32 Chunk_i) {
+		            const auto& Begin = Chunk_i * NumFacetsPerChunk;
+		            const auto& End =
+		                FMath::Min(Begin + NumFacetsPerChunk, File.NumFacets);
+		            for (auto i = Begin; i < End && !bHasFacetColors; ++i) {
+			            // bit 15 of the attribute at the end of the facet
+			            const auto& Facet = File.Facets + i * FStlFile::FacetSize;
+			            if (0 != (Facet[49] & 0x80)) {
+				            bHasFacetColors = true;
+			            }
+		            }
+	            });
+	File.bHasFacetColors = bHasFacetColors;
+
+	return true;
+}
+
+bool ParseBinaryPly(const uint8* const Data, const int64 Size, FPlyFile& File) {
+	// magic line
+	auto            Position = int64{0};
+	TArray<FString> Tokens;
+	if (!ReadPlyHeaderLine(Data, Size, Position, Tokens) || 1 != Tokens.Num() ||
+	    TEXT("ply") != Tokens[0]) {
+		return false;
+	}
+
+	// read header lines up to "end_header"
+	auto                bIsBinaryLittleEndian = false;
+	TArray<FPlyElement> Elements;
+	for (;;) {
+		if (!ReadPlyHeaderLine(Data, Size, Position, Tokens)) {
+			UE_LOG(LogAssetLoader, Log, TEXT("PLY header has no end_header."));
+			return false;
+		}
+		if (Tokens.IsEmpty()) {
+			continue;
+		}
+
+		const auto& Keyword = Tokens[0];
+		if (TEXT("end_header") == Keyword) {
+			break;
+		}
+		if (TEXT("format") == Keyword) {
+			bIsBinaryLittleEndian =
+			    Tokens.Num() >= 2 && TEXT("binary_little_endian") == Tokens[1];
+		} else if (TEXT("comment") == Keyword || TEXT("obj_info") == Keyword) {
+			// assimp uses the texture of a TextureFile comment
+			if (Tokens.Num() >= 2 && TEXT("TextureFile") == Tokens[1]) {
+				UE_LOG(LogAssetLoader, Log,
+				       TEXT("PLY has a texture, so it is imported with assimp."));
+				return false;
+			}
+		} else if (TEXT("element") == Keyword && 3 == Tokens.Num()) {
+			auto& Element = Elements.AddDefaulted_GetRef();
+			Element.Name  = Tokens[1];
+			LexFromString(Element.Count, *Tokens[2]);
+		} else if (TEXT("property") == Keyword && !Elements.IsEmpty() &&
+		           3 == Tokens.Num()) {
+			Elements.Last().Properties.Add({Tokens[2], Tokens[1], FString()});
+		} else if (TEXT("property") == Keyword && !Elements.IsEmpty() &&
+		           5 == Tokens.Num() && TEXT("list") == Tokens[1]) {
+			Elements.Last().Properties.Add({Tokens[4], Tokens[2], Tokens[3]});
+		} else {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("PLY header has an unsupported line (%s), so it is "
+			            "imported with assimp."),
+			       *FString::Join(Tokens, TEXT(" ")));
+			return false;
+		}
+	}
+
+	// ASCII and big-endian files are imported with assimp
+	if (!bIsBinaryLittleEndian) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("PLY is not binary little-endian, so it is imported with "
+		            "assimp."));
+		return false;
+	}
+
+	// a vertex element followed by a face element
+	if (2 != Elements.Num() || TEXT("vertex") != Elements[0].Name ||
+	    TEXT("face") != Elements[1].Name) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("PLY does not consist of a vertex element and a face "
+		            "element, so it is imported with assimp."));
+		return false;
+	}
+	const auto& VertexElement = Elements[0];
+	const auto& FaceElement   = Elements[1];
+	if (VertexElement.Count <= 0 || FaceElement.Count <= 0 ||
+	    VertexElement.Count > TNumericLimits<int32>::Max() ||
+	    FaceElement.Count > TNumericLimits<int32>::Max() / 3) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("PLY has no faces, or too many vertices (%lld) or faces "
+		            "(%lld) for a section, so it is imported with assimp."),
+		       VertexElement.Count, FaceElement.Count);
+		return false;
+	}
+
+	// vertex properties: only positions, normals and colors, all scalars
+	static const TCHAR* const PositionNames[] = {TEXT("x"), TEXT("y"), TEXT("z")};
+	static const TCHAR* const NormalNames[]   = {TEXT("nx"), TEXT("ny"),
+	                                             TEXT("nz")};
+	static const TCHAR* const ColorNames[]    = {TEXT("red"), TEXT("green"),
+	                                             TEXT("blue")};
+	static const TCHAR* const AlphaNames[]    = {TEXT("alpha")};
+	for (const auto& Property : VertexElement.Properties) {
+		if (!Property.IndexType.IsEmpty() ||
+		    (!MakeArrayView(PositionNames).Contains(Property.Name) &&
+		     !MakeArrayView(NormalNames).Contains(Property.Name) &&
+		     !MakeArrayView(ColorNames).Contains(Property.Name) &&
+		     !MakeArrayView(AlphaNames).Contains(Property.Name))) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("PLY has an unsupported vertex property (%s), so it is "
+			            "imported with assimp."),
+			       *Property.Name);
+			return false;
+		}
+	}
+	if (!SetPlyPropertyOffsets(VertexElement, PositionNames, sizeof(float),
+	                           File.PositionOffsets) ||
+	    INDEX_NONE == File.PositionOffsets[0] ||
+	    !SetPlyPropertyOffsets(VertexElement, NormalNames, sizeof(float),
+	                           File.NormalOffsets) ||
+	    !SetPlyPropertyOffsets(VertexElement, ColorNames, sizeof(uint8),
+	                           File.ColorOffsets) ||
+	    !SetPlyPropertyOffsets(VertexElement, AlphaNames, sizeof(uint8),
+	                           File.ColorOffsets + 3) ||
+	    (INDEX_NONE == File.ColorOffsets[0] && INDEX_NONE != File.ColorOffsets[3])) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("PLY has incomplete positions, normals or colors, or ones of "
+		            "unsupported types, so it is imported with assimp."));
+		return false;
+	}
+	File.VertexStride = 0;
+	for (const auto& Property : VertexElement.Properties) {
+		File.VertexStride += GetPlyTypeSize(Property.Type);
+	}
+
+	// face property: a single list of 32-bit indices
+	const auto& FaceProperties = FaceElement.Properties;
+	if (1 != FaceProperties.Num() ||
+	    (TEXT("vertex_indices") != FaceProperties[0].Name &&
+	     TEXT("vertex_index") != FaceProperties[0].Name) ||
+	    !IsPlyIntegerType(FaceProperties[0].Type) ||
+	    !IsPlyIntegerType(FaceProperties[0].IndexType) ||
+	    4 != GetPlyTypeSize(FaceProperties[0].IndexType)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("PLY faces are not a single list of 32-bit vertex indices, "
+		            "so it is imported with assimp."));
+		return false;
+	}
+	File.FaceSizeSize = GetPlyTypeSize(FaceProperties[0].Type);
+	File.FaceStride   = File.FaceSizeSize + 3 * sizeof(uint32);
+
+	// the elements must be inside the file (assuming triangles)
+	const auto& VertexDataSize = File.VertexStride * VertexElement.Count;
+	const auto& FaceDataSize   = File.FaceStride * FaceElement.Count;
+	if (Size - Position < VertexDataSize + FaceDataSize) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("PLY is too small for its vertices and faces."));
+		return false;
+	}
+	File.Vertices    = Data + Position;
+	File.NumVertices = static_cast<int32>(VertexElement.Count);
+	File.Faces       = File.Vertices + VertexDataSize;
+	File.NumFaces    = static_cast<int32>(FaceElement.Count);
+
+	// polygons are triangulated by assimp
+	if (!AreAllPlyFacesTriangles(File)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("PLY has a face that is not a triangle or whose indices are "
+		            "out of range, so it is imported with assimp."));
+		return false;
+	}
+
+	return true;
+}
+
+bool TryConstructMeshDataFromBinaryMeshFile(
+    const FString& FilePath, const uint8* const Data, const int64 Size,
+    const FAssetImportProfile& ImportProfile, const FLoadOptions& LoadOptions,
+    FLoadedMeshData& MeshData) {
+	// assimp picks the importer by the extension of the file
+	const auto& Extension = FPaths::GetExtension(FilePath);
+	const auto& bIsStl = Extension.Equals(TEXT("stl"), ESearchCase::IgnoreCase);
+	const auto& bIsPly = Extension.Equals(TEXT("ply"), ESearchCase::IgnoreCase);
+	if (!bIsStl && !bIsPly) {
+		return false;
+	}
+
+	// post-process steps must be reproducible (decided later in auto mode)
+	const auto& AiPostProcessSteps = GetAiPostProcessSteps(ImportProfile);
+	if (0 != (AiPostProcessSteps & ~NativePostProcessSteps)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("%s is imported with assimp, since post-process steps "
+		            "0x%08x are not reproduced by the native loader."),
+		       *Extension.ToUpper(), AiPostProcessSteps & ~NativePostProcessSteps);
+		return false;
+	}
+
+	if (bIsStl) {
+		FStlFile File;
+		if (!ParseBinaryStl(Data, Size, File)) {
+			return false;
+		}
+
+		// a root node with a child node referring to the mesh, whose vertices
+		// are those of its facets. The color in the header of a Materialise
+		// file is that of the material if no facet has a color.
+		FBinaryMeshScene Scene;
+		Scene.NodeNames     = {TEXT("<STL_BINARY>"), FString()};
+		Scene.MaterialColor = File.bIsMaterialise && !File.bHasFacetColors
+		                          ? File.DefaultColor
+		                          : FLinearColor::White;
+		Scene.Attributes =
+		    EAiVertexAttributes::Vertices | EAiVertexAttributes::Normals;
+		if (File.bHasFacetColors) {
+			Scene.Attributes |= EAiVertexAttributes::VertexColors0;
+		}
+		Scene.NumVertices = 3 * File.NumFacets;
+		Scene.NumFaces    = File.NumFacets;
+
+		return TryConstructMeshDataFromBinaryMesh(File, Scene, ImportProfile,
+		                                          LoadOptions, MeshData);
+	}
+
+	FPlyFile File;
+	if (!ParseBinaryPly(Data, Size, File)) {
+		return false;
+	}
+
+	// a root node referring to the mesh
+	FBinaryMeshScene Scene;
+	Scene.NodeNames  = {FString()};
+	Scene.Attributes = EAiVertexAttributes::Vertices;
+	if (File.HasNormals()) {
+		Scene.Attributes |= EAiVertexAttributes::Normals;
+	}
+	if (File.HasColors()) {
+		Scene.Attributes |= EAiVertexAttributes::VertexColors0;
+	}
+	Scene.NumVertices               = File.NumVertices;
+	Scene.NumFaces                  = File.NumFaces;
+	Scene.bAllVerticesAreReferenced = false;
+
+	return TryConstructMeshDataFromBinaryMesh(File, Scene, ImportProfile,
+	                                          LoadOptions, MeshData);
+}
+
+#pragma region definitions of static functions
+static bool ReadPlyHeaderLine(const uint8* const Data, const int64 Size,
+                              int64& Position, TArray<FString>& Tokens) {
+	// find the end of the line within the longest header
+	const auto& SearchEnd = FMath::Min(Size, PlyMaxHeaderSize);
+	auto        LineEnd   = Position;
+	while (LineEnd < SearchEnd && '\n' != Data[LineEnd]) {
+		++LineEnd;
+	}
+	if (LineEnd >= SearchEnd) {
+		return false;
+	}
+
+	// split the line (without "\r\n" or "\n") at whitespace
+	const FString Line(static_cast<int32>(LineEnd - Position),
+	                   reinterpret_cast<const ANSICHAR*>(Data + Position));
+	Line.ParseIntoArrayWS(Tokens);
+
+	Position = LineEnd + 1;
+	return true;
+}
+
+static int32 GetPlyTypeSize(const FString& Type) {
+	if (TEXT("char") == Type || TEXT("int8") == Type || TEXT("uchar") == Type ||
+	    TEXT("uint8") == Type) {
+		return 1;
+	}
+	if (TEXT("short") == Type || TEXT("int16") == Type || TEXT("ushort") == Type ||
+	    TEXT("uint16") == Type) {
+		return 2;
+	}
+	if (TEXT("int") == Type || TEXT("int32") == Type || TEXT("uint") == Type ||
+	    TEXT("uint32") == Type || TEXT("float") == Type ||
+	    TEXT("float32") == Type) {
+		return 4;
+	}
+	if (TEXT("double") == Type || TEXT("float64") == Type) {
+		return 8;
+	}
+	return 0;
+}
+
+static bool IsPlyIntegerType(const FString& Type) {
+	return 0 != GetPlyTypeSize(Type) && TEXT("float") != Type &&
+	       TEXT("float32") != Type && TEXT("double") != Type &&
+	       TEXT("float64") != Type;
+}
+
+static bool SetPlyPropertyOffsets(const FPlyElement&             Vertex,
+                                  TArrayView<const TCHAR* const> Names,
+                                  const int32 TypeSize, int32* const Offsets) {
+	auto NumPresent = 0;
+	for (auto Name_i = 0; Name_i < Names.Num(); ++Name_i) {
+		auto& Offset = Offsets[Name_i];
+		Offset       = INDEX_NONE;
+
+		auto PropertyOffset = 0;
+		for (const auto& Property : Vertex.Properties) {
+			if (Names[Name_i] == Property.Name) {
+				// a duplicate or a property of another type is not supported
+				if (INDEX_NONE != Offset ||
+				    TypeSize != GetPlyTypeSize(Property.Type) ||
+				    (sizeof(float) == TypeSize &&
+				     IsPlyIntegerType(Property.Type)) ||
+				    (sizeof(uint8) == TypeSize && TEXT("uchar") != Property.Type &&
+				     TEXT("uint8") != Property.Type)) {
+					return false;
+				}
+				Offset = PropertyOffset;
+			}
+			PropertyOffset += GetPlyTypeSize(Property.Type);
+		}
+
+		if (INDEX_NONE != Offset) {
+			++NumPresent;
+		}
+	}
+
+	return 0 == NumPresent || Names.Num() == NumPresent;
+}
+
+static bool AreAllPlyFacesTriangles(const FPlyFile& File) {
+	// number of indices of a face
+	const auto& GetFaceSize = [&File](const uint8* const Face) -> uint32 {
+		switch (File.FaceSizeSize) {
+		case 1:
+			return Face[0];
+		case 2:
+			return Face[0] | static_cast<uint32>(Face[1]) << 8;
+		default:
+			return ReadUInt32(Face);
+		}
+	};
+
+	// a face of another size would move the ones after it, so the chunk
+	// containing the first such face finds it at its expected place
+	constexpr auto    NumFacesPerChunk = int32{64 * 1024};
+	std::atomic<bool> bAreAllTriangles = true;
+	ParallelFor((File.NumFaces + NumFacesPerChunk - 1) / NumFacesPerChunk,
+	            [&](const int32 Chunk_i) {
+		            const auto& Begin = Chunk_i * NumFacesPerChunk;
+		            const auto& End =
+		                FMath::Min(Begin + NumFacesPerChunk, File.NumFaces);
+		            for (auto i = Begin; i < End && bAreAllTriangles; ++i) {
+			            const auto& Face = File.Faces + i * File.FaceStride;
+			            if (3 != GetFaceSize(Face)) {
+				            bAreAllTriangles = false;
+				            break;
+			            }
+			            for (auto Corner = 0; Corner < 3; ++Corner) {
+				            if (File.GetIndex(3 * int64{i} + Corner) >=
+				                static_cast<uint32>(File.NumVertices)) {
+					            bAreAllTriangles = false;
+				            }
+			            }
+		            }
+	            });
+
+	return bAreAllTriangles;
+}
+
+static uint32 ReadUInt32(const uint8* const Data) {
+	return static_cast<uint32>(Data[0]) | static_cast<uint32>(Data[1]) << 8 |
+	       static_cast<uint32>(Data[2]) << 16 |
+	       static_cast<uint32>(Data[3]) << 24;
+}
+
+template <typename FileT>
+static bool TryConstructMeshDataFromBinaryMesh(
+    const FileT& File, const FBinaryMeshScene& Scene,
+    const FAssetImportProfile& ImportProfile, const FLoadOptions& LoadOptions,
+    FLoadedMeshData& MeshData) {
+	const auto& bHasNormals =
+	    EnumHasAnyFlags(Scene.Attributes, EAiVertexAttributes::Normals);
+
+	// decide steps from the data present in auto mode, the same way as for
+	// assimp's scene (there are no UVs, so no tangents are needed)
+	auto AiPostProcessSteps = GetAiPostProcessSteps(ImportProfile);
+	if (EAssetImportProfileType::Auto == ImportProfile.ProfileType) {
+		AiPostProcessSteps = GetAutoAiPostProcessSteps(
+		    bHasNormals, true, Scene.NumVertices < 3 * int64{Scene.NumFaces});
+
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("Auto import profile applies post-process steps 0x%08x."),
+		       AiPostProcessSteps);
+
+		if (0 != (AiPostProcessSteps & ~NativePostProcessSteps)) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("Mesh file is imported with assimp, since post-process "
+			            "steps 0x%08x are not reproduced by the native loader."),
+			       AiPostProcessSteps & ~NativePostProcessSteps);
+			return false;
+		}
+	}
+
+	// the steps that are not reproduced must not change anything
+	if ((0 != (AiPostProcessSteps & aiProcess_GenSmoothNormals) &&
+	     !bHasNormals) ||
+	    (0 != (AiPostProcessSteps & aiProcess_FindInvalidData) &&
+	     HasInvalidBinaryMeshData(File, Scene))) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("Mesh file needs normals or invalid data to be fixed, so it "
+		            "is imported with assimp."));
+		return false;
+	}
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("Mesh file is converted by the native loader, without assimp."));
+
+	// the only material, as GenerateMaterialList makes it
+	auto& MaterialData       = MeshData.MaterialList.AddDefaulted_GetRef();
+	MaterialData.ColorStatus = EColorStatus::ColorIsSet;
+	MaterialData.Color       = Scene.MaterialColor;
+
+	// set up the chain of nodes, the last of which refers to the section
+	const auto& NumNodes = Scene.NodeNames.Num();
+	auto&       NodeList = MeshData.NodeList;
+	NodeList.SetNum(NumNodes);
+	for (auto Node_i = decltype(NumNodes){0}; Node_i < NumNodes; ++Node_i) {
+		auto& Node           = NodeList[Node_i];
+		Node.Name            = Scene.NodeNames[Node_i];
+		Node.ParentNodeIndex = Node_i - 1;
+
+		// identity, post-processed as assimp does, and transformed to the UE
+		// coordinate system for the root node (there is no UnitScaleFactor)
+		auto AiTransform = aiMatrix4x4();
+		MirrorAiTransformZ(AiTransform);
+		if (0 == Node_i) {
+			AiTransform = GenerateAi_UE_XformMatrix(1.0f) * AiTransform;
+		}
+		Node.RelativeTransform =
+		    static_cast<FTransform>(AiMatrixToUEMatrix(AiTransform));
+	}
+	NodeList.Last().SectionIndices.Add(0);
+	const TArray<TArray<int32>> NodeIndicesOfSection = {{NumNodes - 1}};
+
+	// set up the section and make conversion jobs
+	auto& Section         = MeshData.SectionList.AddDefaulted_GetRef();
+	Section.MaterialIndex = 0;
+	TArray<FSectionConversionJob> Jobs;
+	SizeSectionAndAddJobs(0, Scene.Attributes, Scene.NumVertices, Scene.NumFaces,
+	                      ImportProfile.bCompactPrecision, Section, Jobs);
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("Mesh file has %d vertices and %d triangles, converted in %d "
+	            "jobs."),
+	       Scene.NumVertices, Scene.NumFaces, Jobs.Num());
+
+	// convert all ranges concurrently, straight from the mapped file
+	RunSectionConversionJobs(
+	    Jobs, NodeIndicesOfSection,
+	    [&](const FSectionConversionJob& Job) {
+		    if (Job.bFaces) {
+			    if (!Section.CompactTriangles.IsEmpty()) {
+				    ConvertBinaryMeshFaceRange(File, Job.Begin, Job.End,
+				                               Section.CompactTriangles);
+			    } else {
+				    ConvertBinaryMeshFaceRange(File, Job.Begin, Job.End,
+				                               Section.Triangles);
+			    }
+		    } else if (ImportProfile.bCompactPrecision) {
+			    ConvertBinaryMeshVertexRangeCompact(File, Scene.Attributes,
+			                                        Job.Begin, Job.End, Section);
+		    } else {
+			    ConvertBinaryMeshVertexRange(File, Scene.Attributes, Job.Begin,
+			                                 Job.End, Section);
+		    }
+	    },
+	    [](int32) {}, LoadOptions, MeshData);
+
+	return true;
+}
+
+template <typename FileT>
+static bool HasInvalidBinaryMeshData(const FileT&            File,
+                                     const FBinaryMeshScene& Scene) {
+	const auto& NumVertices = Scene.NumVertices;
+
+	// number of vertices/faces checked by one task
+	constexpr auto NumPerChunk = int32{64 * 1024};
+	const auto&    NumChunksOf = [](const int32 Num) {
+		return (Num + NumPerChunk - 1) / NumPerChunk;
+	};
+
+	// mark the vertices referred to by faces, since FindInvalidData skips the
+	// others
+	TUniquePtr<std::atomic<bool>[]> bIsVertexReferenced;
+	if (!Scene.bAllVerticesAreReferenced) {
+		bIsVertexReferenced = MakeUnique<std::atomic<bool>[]>(NumVertices);
+		ParallelFor(NumChunksOf(Scene.NumFaces), [&](const int32 Chunk_i) {
+			const auto& Begin = 3 * int64{Chunk_i} * NumPerChunk;
+			const auto& End =
+			    3 * FMath::Min(int64{Chunk_i + 1} * NumPerChunk,
+			                   int64{Scene.NumFaces});
+			for (auto i = Begin; i < End; ++i) {
+				bIsVertexReferenced[File.GetIndex(i)].store(
+				    true, std::memory_order_relaxed);
+			}
+		});
+	}
+
+	// check the vectors of the referenced vertices as FindInvalidData does,
+	// which compares each of them with the vertex before it (referenced or
+	// not) to find whether all of them are identical
+	const auto& IsInvalid = [&](const auto& GetVector, const bool bMayBeIdentical,
+	                            const bool bMayBeZero) {
+		std::atomic<bool>  bHasInvalidVector = false;
+		std::atomic<bool>  bAnyDiffers       = false;
+		std::atomic<int64> NumChecked        = 0;
+		ParallelFor(NumChunksOf(NumVertices), [&](const int32 Chunk_i) {
+			const auto& Begin = Chunk_i * NumPerChunk;
+			const auto& End   = FMath::Min(Begin + NumPerChunk, NumVertices);
+			auto        NumCheckedInChunk = int64{0};
+			for (auto i = Begin; i < End && !bHasInvalidVector; ++i) {
+				if (bIsVertexReferenced.IsValid() &&
+				    !bIsVertexReferenced[i].load(std::memory_order_relaxed)) {
+					continue;
+				}
+				++NumCheckedInChunk;
+
+				const FVector3f Vector = GetVector(i);
+				if (!FMath::IsFinite(Vector.X) || !FMath::IsFinite(Vector.Y) ||
+				    !FMath::IsFinite(Vector.Z) ||
+				    (!bMayBeZero && 0.0f == Vector.X && 0.0f == Vector.Y &&
+				     0.0f == Vector.Z)) {
+					bHasInvalidVector = true;
+				}
+				if (0 < i && Vector != GetVector(i - 1)) {
+					bAnyDiffers = true;
+				}
+			}
+			NumChecked += NumCheckedInChunk;
+		});
+		return bHasInvalidVector ||
+		       (!bMayBeIdentical && NumChecked > 1 && !bAnyDiffers);
+	};
+
+	// positions
+	if (IsInvalid([&File](const int32 Index) { return File.GetPosition(Index); },
+	              false, true)) {
+		return true;
+	}
+
+	// normals (may be identical, but not zero)
+	return EnumHasAnyFlags(Scene.Attributes, EAiVertexAttributes::Normals) &&
+	       IsInvalid([&File](const int32 Index) { return File.GetNormal(Index); },
+	                 true, false);
+}
+
+template <typename FileT>
+static void ConvertBinaryMeshVertexRange(const FileT&              File,
+                                         const EAiVertexAttributes Attributes,
+                                         const int32 Begin, const int32 End,
+                                         FLoadedMeshSectionData& Section) {
+	// vertices (Z is negated by MakeLeftHanded)
+	for (auto i = Begin; i < End; ++i) {
+		const auto& Vertex  = File.GetPosition(i);
+		Section.Vertices[i] = FVector(Vertex.X, Vertex.Y, -Vertex.Z);
+	}
+
+	// normals
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Normal = File.GetNormal(i);
+			Section.Normals[i] = FVector(Normal.X, Normal.Y, -Normal.Z);
+		}
+	}
+
+	// vertex colors
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+		for (auto i = Begin; i < End; ++i) {
+			Section.VertexColors0[i] = File.GetColor(i);
+		}
+	}
+}
+
+template <typename FileT>
+static void ConvertBinaryMeshVertexRangeCompact(
+    const FileT& File, const EAiVertexAttributes Attributes, const int32 Begin,
+    const int32 End, FLoadedMeshSectionData& Section) {
+	// vertices (Z is negated by MakeLeftHanded)
+	for (auto i = Begin; i < End; ++i) {
+		const auto& Vertex         = File.GetPosition(i);
+		Section.CompactVertices[i] = FVector3f(Vertex.X, Vertex.Y, -Vertex.Z);
+	}
+
+	// normals
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Normal = File.GetNormal(i);
+			Section.CompactNormals[i] =
+			    EncodeOctahedral(Normal.X, Normal.Y, -Normal.Z);
+		}
+	}
+
+	// vertex colors (without sRGB conversion, same as the full precision path)
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+		for (auto i = Begin; i < End; ++i) {
+			Section.CompactVertexColors0[i] = File.GetColor(i).ToFColor(false);
+		}
+	}
+}
+
+template <typename IndexT, typename FileT>
+static void ConvertBinaryMeshFaceRange(const FileT& File, const int32 Begin,
+                                       const int32 End, TArray<IndexT>& Triangles) {
+	for (auto i = 3 * int64{Begin}; i < 3 * int64{End}; ++i) {
+		Triangles[i] = static_cast<IndexT>(File.GetIndex(i));
+	}
+}
+#pragma endregion
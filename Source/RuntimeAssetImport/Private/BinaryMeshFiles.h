@@ -0,0 +1,264 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Async/MappedFileHandle.h"
+#include "CoreMinimal.h"
+
+struct FAssetImportProfile;
+struct FLoadedMeshData;
+struct FLoadOptions;
+
+/**
+ * A mesh file mapped into memory, so that its data is read in place.
+ */
+struct FMappedMeshFile {
+	// mapped file (must outlive Region)
+	TUniquePtr<IMappedFileHandle> Handle;
+
+	// region covering the whole file
+	TUniquePtr<IMappedFileRegion> Region;
+
+public:
+	/**
+	 * Get the content of the file.
+	 */
+	const uint8* GetData() const {
+		return Region->GetMappedPtr();
+	}
+
+	/**
+	 * Get the size of the file in bytes.
+	 */
+	int64 GetSize() const {
+		return Region->GetMappedSize();
+	}
+};
+
+/**
+ * Binary STL file. Each facet is a normal, 3 vertices (3 floats each) and a
+ * 16-bit attribute, in 50 bytes. The facets do not share vertices: vertex i is
+ * corner i % 3 of facet i / 3.
+ */
+struct FStlFile {
+	// first facet
+	const uint8* Facets = nullptr;
+
+	// number of facets
+	int32 NumFacets = 0;
+
+	// whether the header has a default color ("COLOR=", written by
+	// Materialise), which also swaps red and blue of the facet colors
+	bool bIsMaterialise = false;
+
+	// color of the vertices of facets without a color: the one in the header,
+	// or 0.6 gray (alpha included) as assimp's STL importer defaults to
+	FLinearColor DefaultColor = FLinearColor(0.6f, 0.6f, 0.6f, 0.6f);
+
+	// whether any facet has a color (bit 15 of its attribute)
+	bool bHasFacetColors = false;
+
+public:
+	// size of a facet in bytes
+	static constexpr int64 FacetSize = 50;
+
+	/**
+	 * Get the position of a vertex.
+	 * @param   Index   index of the vertex
+	 */
+	FVector3f GetPosition(const int32 Index) const {
+		FVector3f Position;
+		FMemory::Memcpy(&Position,
+		                Facets + Index / 3 * FacetSize + 12 + Index % 3 * 12,
+		                sizeof(Position));
+		return Position;
+	}
+
+	/**
+	 * Get the normal of a vertex (that of its facet).
+	 * @param   Index   index of the vertex
+	 */
+	FVector3f GetNormal(const int32 Index) const {
+		FVector3f Normal;
+		FMemory::Memcpy(&Normal, Facets + Index / 3 * FacetSize, sizeof(Normal));
+		return Normal;
+	}
+
+	/**
+	 * Get the color of a vertex, as assimp's STL importer reads it from the
+	 * attribute of its facet.
+	 * @param   Index   index of the vertex
+	 */
+	FLinearColor GetColor(int32 Index) const;
+
+	/**
+	 * Get the index of the vertex at a corner of a facet.
+	 * @param   CornerIndex   3 times the index of the facet, plus the corner
+	 */
+	uint32 GetIndex(const int64 CornerIndex) const {
+		return static_cast<uint32>(CornerIndex);
+	}
+};
+
+/**
+ * Binary little-endian PLY file with a vertex element followed by a face
+ * element of triangles. Offsets of absent properties are INDEX_NONE.
+ */
+struct FPlyFile {
+	// first vertex
+	const uint8* Vertices = nullptr;
+
+	// bytes from the start of one vertex to the next
+	int64 VertexStride = 0;
+
+	// number of vertices
+	int32 NumVertices = 0;
+
+	// offsets in a vertex of x, y and z (float)
+	int32 PositionOffsets[3] = {INDEX_NONE, INDEX_NONE, INDEX_NONE};
+
+	// offsets in a vertex of nx, ny and nz (float)
+	int32 NormalOffsets[3] = {INDEX_NONE, INDEX_NONE, INDEX_NONE};
+
+	// offsets in a vertex of red, green, blue and alpha (uchar)
+	int32 ColorOffsets[4] = {INDEX_NONE, INDEX_NONE, INDEX_NONE, INDEX_NONE};
+
+	// first face
+	const uint8* Faces = nullptr;
+
+	// bytes from the start of one face to the next
+	int64 FaceStride = 0;
+
+	// number of faces
+	int32 NumFaces = 0;
+
+	// size in bytes of the number of indices at the start of a face (1, 2 or
+	// 4), which the 32-bit indices follow
+	int32 FaceSizeSize = 0;
+
+public:
+	/**
+	 * Whether the vertices have normals.
+	 */
+	bool HasNormals() const {
+		return INDEX_NONE != NormalOffsets[0];
+	}
+
+	/**
+	 * Whether the vertices have colors.
+	 */
+	bool HasColors() const {
+		return INDEX_NONE != ColorOffsets[0];
+	}
+
+	/**
+	 * Get the position of a vertex.
+	 * @param   Index   index of the vertex
+	 */
+	FVector3f GetPosition(const int32 Index) const {
+		return ReadFloat3(Index, PositionOffsets);
+	}
+
+	/**
+	 * Get the normal of a vertex. The vertices must have normals.
+	 * @param   Index   index of the vertex
+	 */
+	FVector3f GetNormal(const int32 Index) const {
+		return ReadFloat3(Index, NormalOffsets);
+	}
+
+	/**
+	 * Get the color of a vertex, as assimp's PLY importer normalizes it (alpha
+	 * is 1 if absent). The vertices must have colors.
+	 * @param   Index   index of the vertex
+	 */
+	FLinearColor GetColor(int32 Index) const;
+
+	/**
+	 * Get the index of the vertex at a corner of a face.
+	 * @param   CornerIndex   3 times the index of the face, plus the corner
+	 */
+	uint32 GetIndex(const int64 CornerIndex) const {
+		uint32 Index;
+		FMemory::Memcpy(&Index,
+		                Faces + CornerIndex / 3 * FaceStride + FaceSizeSize +
+		                    CornerIndex % 3 * sizeof(uint32),
+		                sizeof(Index));
+		return Index;
+	}
+
+private:
+	/**
+	 * Read 3 float properties of a vertex.
+	 * @param   Index     index of the vertex
+	 * @param   Offsets   offsets of the properties in a vertex
+	 */
+	FVector3f ReadFloat3(const int32 Index, const int32 (&Offsets)[3]) const {
+		const auto& Vertex = Vertices + Index * VertexStride;
+		FVector3f   Vector;
+		FMemory::Memcpy(&Vector.X, Vertex + Offsets[0], sizeof(float));
+		FMemory::Memcpy(&Vector.Y, Vertex + Offsets[1], sizeof(float));
+		FMemory::Memcpy(&Vector.Z, Vertex + Offsets[2], sizeof(float));
+		return Vector;
+	}
+};
+
+/**
+ * Map a file into memory.
+ * @param        FilePath   path to the file
+ * @param[out]   File       mapped file
+ * @return  whether the file has been mapped. false if it cannot be read or
+ *          the platform does not support mapping.
+ */
+bool MapMeshFile(const FString& FilePath, FMappedMeshFile& File);
+
+/**
+ * Parse a binary STL file, detected as assimp's STL importer does: by the
+ * size of the file, which must be that of the number of facets in the header.
+ * Unlike assimp, whose 32-bit size check misses them, files larger than 4 GiB
+ * are accepted, too.
+ * @param        Data   content of the file. Must outlive File.
+ * @param        Size   size of Data in bytes
+ * @param[out]   File   parsed file
+ * @return  whether Data is a binary STL with facets. If not, it should be
+ *          imported with assimp (e.g. ASCII STL).
+ */
+bool ParseBinaryStl(const uint8* Data, int64 Size, FStlFile& File);
+
+/**
+ * Parse a binary little-endian PLY file.
+ * Only files that the native loader converts exactly as assimp does are
+ * accepted: the elements are a vertex element and a face element with a
+ * single list of 32-bit indices, every face is a triangle whose indices are in
+ * range, and the only vertex properties are float x, y, z, nx, ny, nz and
+ * uchar red, green, blue, alpha.
+ * @param        Data   content of the file. Must outlive File.
+ * @param        Size   size of Data in bytes
+ * @param[out]   File   parsed file
+ * @return  whether Data is accepted. If not, the reason is logged, and it
+ *          should be imported with assimp.
+ */
+bool ParseBinaryPly(const uint8* Data, int64 Size, FPlyFile& File);
+
+/**
+ * Try to construct mesh data from a binary STL or binary little-endian PLY
+ * file natively, without assimp. Its vertices are converted in place by all
+ * cores, with the same result as assimp (see
+ * TryConstructMeshDataFromBinaryMesh).
+ * If the file is in another format, or is not accepted, MeshData is left
+ * untouched so that the file is imported with assimp.
+ * @param        FilePath        path to the file, whose extension tells the
+ *                               format as it does to assimp
+ * @param        Data            content of the file
+ * @param        Size            size of Data in bytes
+ * @param        ImportProfile   which post-process steps to apply
+ * @param        LoadOptions     progressive delivery and cancellation of the
+ *                               load. If canceled, the returned mesh data is
+ *                               incomplete and must be discarded.
+ * @param[out]   MeshData        constructed mesh data
+ * @return  whether the mesh data has been constructed
+ */
+bool TryConstructMeshDataFromBinaryMeshFile(
+    const FString& FilePath, const uint8* Data, int64 Size,
+    const FAssetImportProfile& ImportProfile, const FLoadOptions& LoadOptions,
+    FLoadedMeshData& MeshData);
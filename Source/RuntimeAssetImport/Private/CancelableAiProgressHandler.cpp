@@ -0,0 +1,14 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CancelableAiProgressHandler.h"
+
+FCancelableAiProgressHandler::FCancelableAiProgressHandler(
+    FAssetImportCancellationTokenPtr InCancellationToken)
+    : CancellationToken(MoveTemp(InCancellationToken)) {
+	check(CancellationToken.IsValid());
+}
+
+bool FCancelableAiProgressHandler::Update(float /* Percentage */) {
+	// returning false requests the importer to abort
+	return !CancellationToken->IsCanceled();
+}
@@ -0,0 +1,30 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AssetImportCancellationToken.h"
+#include "CoreMinimal.h"
+
+#include <assimp/ProgressHandler.hpp>
+
+/**
+ * Assimp progress handler that asks the importer to abort once a cancellation
+ * token is canceled. Importers that report their progress stop parsing early;
+ * the others run to the end, and the caller discards their scene.
+ */
+class FCancelableAiProgressHandler : public Assimp::ProgressHandler {
+public:
+	/**
+	 * @param   InCancellationToken   token to watch
+	 */
+	explicit FCancelableAiProgressHandler(
+	    FAssetImportCancellationTokenPtr InCancellationToken);
+
+public:
+	/* Assimp::ProgressHandler implementation */
+	virtual bool Update(float Percentage) override;
+
+	/* internal fields */
+private:
+	FAssetImportCancellationTokenPtr CancellationToken;
+};
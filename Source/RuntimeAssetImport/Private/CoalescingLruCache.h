@@ -0,0 +1,285 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "Containers/LruCache.h"
+#include "CoreMinimal.h"
+#include "HAL/FileManager.h"
+#include "LogAssetLoader.h"
+#include "Tasks/Task.h"
+
+#include <atomic>
+
+/**
+ * In-process cache of immutable values loaded on worker threads, which is the
+ * common part of the memory cache of mesh data and the external texture cache.
+ * Values are reference-counted, so a caller keeps its value alive even after
+ * the entry is evicted. The cache is bounded by the total allocated size of the
+ * values and the least recently used entries are evicted first. Concurrent
+ * requests for the same key are coalesced onto one in-flight load.
+ * An entry may record the size and modification time of the files it was
+ * loaded from other than the ones its key identifies, and is found only if
+ * none of them has changed.
+ * All functions are thread-safe.
+ * @tparam  ValueT   type of the values, which has GetAllocatedSize()
+ */
+template <typename ValueT>
+class TCoalescingLruCache {
+public:
+	/**
+	 * Immutable value shared between the cache and the callers.
+	 */
+	using FValuePtr = TSharedPtr<const ValueT, ESPMode::ThreadSafe>;
+
+	/**
+	 * Task whose result is a value, or null on failure.
+	 */
+	using FTask = UE::Tasks::TTask<FValuePtr>;
+
+public:
+	/**
+	 * @param   InName         name of the cache in logs (e.g. "memory cache")
+	 * @param   InGetMaxSize   function that returns the maximum total size of
+	 *                         the cached values in bytes, read on every add
+	 *                         so that changes to the settings take effect
+	 */
+	TCoalescingLruCache(const TCHAR* InName, TFunction<SIZE_T()> InGetMaxSize)
+	    : Name(InName), GetMaxSize(MoveTemp(InGetMaxSize)) {}
+
+	/**
+	 * Find the value of Key, or start loading it.
+	 * If the value is cached and none of the files it depends on has changed,
+	 * a completed task is returned. If another load of the same key is in
+	 * flight, its task is returned. Otherwise StartLoad is called with the lock
+	 * held, and the task it returns is registered as in flight.
+	 * @param   Key         key of the value
+	 * @param   StartLoad   function that starts a load whose task ends by
+	 *                      calling FinishLoad with Key. It may instead return a
+	 *                      completed task (e.g. if the file cannot be opened),
+	 *                      which is neither registered nor has to call
+	 *                      FinishLoad.
+	 * @return  task whose result is the value, or null on failure.
+	 */
+	FTask FindOrLoad(const FString& Key, TFunctionRef<FTask()> StartLoad);
+
+	/**
+	 * Finish a load started by FindOrLoad, adding its value to the cache.
+	 * Called by the load task as its last step.
+	 * @param   Key                   key passed to FindOrLoad
+	 * @param   Value                 loaded value, or null on failure, which
+	 *                                is not cached
+	 * @param   DependencyFilePaths   full paths of the files Value was loaded
+	 *                                from other than the ones Key identifies
+	 * @return  Value
+	 */
+	FValuePtr FinishLoad(const FString& Key, FValuePtr Value,
+	                     const TArray<FString>& DependencyFilePaths = {});
+
+	/**
+	 * Get the number of loads that have been started, that is, the requests
+	 * that were neither found in the cache nor joined an in-flight load.
+	 */
+	uint64 GetNumLoads() const {
+		return NumLoads.load();
+	}
+
+	/* internal types */
+private:
+	// a file an entry depends on, as it was when the entry was loaded
+	struct FDependency {
+		// full path of the file
+		FString FilePath;
+
+		// size of the file, or -1 if it did not exist
+		int64 FileSize = -1;
+
+		// modification time of the file
+		FDateTime ModificationTime;
+	};
+
+	// cached value and the files it depends on
+	struct FEntry {
+		// value
+		FValuePtr Value;
+
+		// files other than the ones the key identifies that Value was loaded
+		// from
+		TArray<FDependency> Dependencies;
+	};
+
+	/* internal functions */
+private:
+	/**
+	 * Record a file as it is now.
+	 * @param   FilePath   full path of the file
+	 * @return  the size and modification time of the file
+	 */
+	static FDependency StatDependency(const FString& FilePath);
+
+	/**
+	 * Add an entry to the cache and evict least recently used entries until
+	 * the cache fits in the limit. CriticalSection must be locked.
+	 * @param   Key     key of the entry
+	 * @param   Entry   entry to add
+	 */
+	void AddAndEvict(const FString& Key, FEntry Entry);
+
+	/**
+	 * Remove an entry from the cache. CriticalSection must be locked.
+	 * @param   Key   key of the entry
+	 */
+	void Remove(const FString& Key);
+
+	/* internal fields */
+private:
+	// name of the cache in logs
+	const TCHAR* Name;
+
+	// function that returns the maximum total size in bytes
+	TFunction<SIZE_T()> GetMaxSize;
+
+	// lock for all fields below
+	FCriticalSection CriticalSection;
+
+	// cached entries in order of use
+	TLruCache<FString, FEntry> Entries{TNumericLimits<int32>::Max()};
+
+	// total allocated size of the cached values
+	SIZE_T TotalSize = 0;
+
+	// loads in flight
+	TMap<FString, FTask> InFlightLoads;
+
+	// number of loads that have been started
+	std::atomic<uint64> NumLoads{0};
+};
+
+template <typename ValueT>
+typename TCoalescingLruCache<ValueT>::FTask
+    TCoalescingLruCache<ValueT>::FindOrLoad(const FString&        Key,
+                                            TFunctionRef<FTask()> StartLoad) {
+	FScopeLock ScopeLock(&CriticalSection);
+
+	// if cached and up to date, return it
+	if (const auto& CachedEntry = Entries.FindAndTouch(Key)) {
+		const auto& ChangedDependency =
+		    CachedEntry->Dependencies.FindByPredicate(
+		        [](const FDependency& Dependency) {
+			        const auto& CurrentDependency =
+			            StatDependency(Dependency.FilePath);
+			        return CurrentDependency.FileSize != Dependency.FileSize ||
+			               CurrentDependency.ModificationTime !=
+			                   Dependency.ModificationTime;
+		        });
+		if (nullptr == ChangedDependency) {
+			UE_LOG(LogAssetLoader, Verbose, TEXT("%s hit: %s"), Name, *Key);
+			return UE::Tasks::MakeCompletedTask<FValuePtr>(CachedEntry->Value);
+		}
+
+		// outdated, so load again
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("%s entry %s is outdated, since %s has changed."), Name,
+		       *Key, *ChangedDependency->FilePath);
+		Remove(Key);
+	}
+
+	// if being loaded by another caller, wait for the same load
+	if (const auto& InFlightLoad = InFlightLoads.Find(Key)) {
+		UE_LOG(LogAssetLoader, Verbose, TEXT("%s joined in-flight load: %s"),
+		       Name, *Key);
+		return *InFlightLoad;
+	}
+
+	// Start the load. Its task cannot finish before it is registered to
+	// InFlightLoads, since FinishLoad locks CriticalSection, which is held here
+	// until then.
+	auto LoadTask = StartLoad();
+	if (LoadTask.IsCompleted()) {
+		return LoadTask;
+	}
+
+	// register as in flight
+	InFlightLoads.Add(Key, LoadTask);
+	++NumLoads;
+
+	return LoadTask;
+}
+
+template <typename ValueT>
+typename TCoalescingLruCache<ValueT>::FValuePtr
+    TCoalescingLruCache<ValueT>::FinishLoad(
+        const FString& Key, FValuePtr Value,
+        const TArray<FString>& DependencyFilePaths) {
+	// record the files the value depends on as they are now (outside the lock)
+	FEntry Entry;
+	if (Value.IsValid()) {
+		Entry.Value = Value;
+		Entry.Dependencies.Reserve(DependencyFilePaths.Num());
+		for (const auto& DependencyFilePath : DependencyFilePaths) {
+			Entry.Dependencies.Add(StatDependency(DependencyFilePath));
+		}
+	}
+
+	FScopeLock ScopeLock(&CriticalSection);
+
+	// no longer in flight
+	InFlightLoads.Remove(Key);
+
+	// cache only successful loads
+	if (Value.IsValid()) {
+		AddAndEvict(Key, MoveTemp(Entry));
+	}
+
+	return Value;
+}
+
+template <typename ValueT>
+typename TCoalescingLruCache<ValueT>::FDependency
+    TCoalescingLruCache<ValueT>::StatDependency(const FString& FilePath) {
+	// a file that does not exist is recorded too, so that the entry is
+	// outdated once the file is created
+	const auto& StatData = IFileManager::Get().GetStatData(*FilePath);
+	if (!StatData.bIsValid || StatData.bIsDirectory) {
+		return {FilePath};
+	}
+
+	return {FilePath, StatData.FileSize, StatData.ModificationTime};
+}
+
+template <typename ValueT>
+void TCoalescingLruCache<ValueT>::AddAndEvict(const FString& Key,
+                                              FEntry         Entry) {
+	// maximum size of the cache in bytes
+	const auto& MaxSize = GetMaxSize();
+
+	// get size of the new entry
+	const auto& Size = Entry.Value->GetAllocatedSize();
+
+	// if the entry alone does not fit, do not cache it
+	if (Size > MaxSize) {
+		UE_LOG(LogAssetLoader, Log, TEXT("%s (%llu bytes) is too large for %s."),
+		       *Key, static_cast<uint64>(Size), Name);
+		return;
+	}
+
+	// replace existing entry if any
+	Remove(Key);
+
+	// add
+	Entries.Add(Key, MoveTemp(Entry));
+	TotalSize += Size;
+
+	// evict from the least recently used
+	while (TotalSize > MaxSize) {
+		const auto& EvictedEntry = Entries.RemoveLeastRecent();
+		TotalSize -= EvictedEntry.Value->GetAllocatedSize();
+	}
+}
+
+template <typename ValueT>
+void TCoalescingLruCache<ValueT>::Remove(const FString& Key) {
+	if (const auto& ExistingEntry = Entries.Find(Key)) {
+		TotalSize -= ExistingEntry->Value->GetAllocatedSize();
+		Entries.Remove(Key);
+	}
+}
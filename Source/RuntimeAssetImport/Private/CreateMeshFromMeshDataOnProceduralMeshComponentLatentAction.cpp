@@ -10,7 +10,8 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
         const FLoadedMeshData&    InMeshData,
         UMaterialInterface&       InOutParentMaterialInterface,
         UProceduralMeshComponent& InOutTargetProceduralMeshComponent)
-    : ExecutionFunction(InLatentInfo.ExecutionFunction),
+    : TargetProceduralMeshComponent(&InOutTargetProceduralMeshComponent),
+      ExecutionFunction(InLatentInfo.ExecutionFunction),
       OutputLink(InLatentInfo.Linkage),
       CallbackTarget(InLatentInfo.CallbackTarget) {
 	namespace Tasks = UE::Tasks;
@@ -19,8 +20,11 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 	// (because there must be a root node)
 	check(!InMeshData.NodeList.IsEmpty());
 
-	// change state to running
-	IsRunning = true;
+	// shared state and weak target, captured by the tasks instead of this
+	// latent action and the component, either of which may be destroyed
+	// before the tasks run
+	const auto& SharedState = State;
+	const auto& WeakTarget  = TargetProceduralMeshComponent;
 
 	// get node list
 	const auto& NodeList = InMeshData.NodeList;
@@ -28,13 +32,19 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 	// number of the NodeList
 	const auto& NumNodeList = NodeList.Num();
 
+	// get section list
+	const auto& SectionList = InMeshData.SectionList;
+
 	// get material list
 	const auto& MaterialList = InMeshData.MaterialList;
 
+	// get texture list
+	const auto& TextureList = InMeshData.TextureList;
+
 	// generate material instances
-	auto MaterialInstances =
-	    GenerateMaterialInstances(InOutTargetProceduralMeshComponent,
-	                              MaterialList, InOutParentMaterialInterface);
+	auto MaterialInstances = GenerateMaterialInstances(
+	    InOutTargetProceduralMeshComponent, MaterialList, TextureList,
+	    InOutParentMaterialInterface);
 
 	// index of a mesh section in InOutTargetProceduralMeshComponent
 	int32 MeshSectionIndex = 0;
@@ -133,17 +143,19 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 		    },
 		    ParentCalcTFTask, LowLevelTasks::ETaskPriority::BackgroundNormal);
 
-		// get reference of the sections
-		const auto& Sections = Node.Sections;
+		// get indices of the sections
+		const auto& SectionIndices = Node.SectionIndices;
 
 		// get number of sections
-		const auto& NumSections = Sections.Num();
+		const auto& NumSections = SectionIndices.Num();
 
 		// create mesh sections
 		for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
 		     ++Section_i) {
-			// get reference of the section
-			const auto& Section = Sections[Section_i];
+			// get reference of the section in full precision
+			const auto& StoredSection = SectionList[SectionIndices[Section_i]];
+			FLoadedMeshSectionData DecodedSection;
+			const auto& Section = StoredSection.GetFullPrecision(DecodedSection);
 
 			// get Vertices relative to my parent node
 			const auto& Vertices = Section.Vertices;
@@ -158,7 +170,12 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 			// is completed.
 			auto CalcVerticesRelativeToTargetTask = Tasks::Launch(
 			    UE_SOURCE_LOCATION,
-			    [CalcTFTask, Vertices]() mutable {
+			    [CalcTFTask, Vertices, SharedState]() mutable {
+				    // skip if canceled
+				    if (SharedState->bCanceled) {
+					    return decltype(Vertices){};
+				    }
+
 				    // CalcTFTask should be completed
 				    check(CalcTFTask.IsCompleted());
 
@@ -181,7 +198,12 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 			// is completed.
 			auto CalcNormalsRelativeToTargetTask = Tasks::Launch(
 			    UE_SOURCE_LOCATION,
-			    [CalcTFTask, Normals]() mutable {
+			    [CalcTFTask, Normals, SharedState]() mutable {
+				    // skip if canceled
+				    if (SharedState->bCanceled) {
+					    return decltype(Normals){};
+				    }
+
 				    // CalcTFTask should be completed
 				    check(CalcTFTask.IsCompleted());
 
@@ -207,7 +229,12 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 			// is completed.
 			auto CalcTangentsRelativeToTargetTask = Tasks::Launch(
 			    UE_SOURCE_LOCATION,
-			    [CalcTFTask, Tangents]() mutable {
+			    [CalcTFTask, Tangents, SharedState]() mutable {
+				    // skip if canceled
+				    if (SharedState->bCanceled) {
+					    return decltype(Tangents){};
+				    }
+
 				    // CalcTFTask should be completed
 				    check(CalcTFTask.IsCompleted());
 
@@ -237,10 +264,15 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 			// and CalcTangentsRelativeToTargetTask are completed.
 			auto CreateMeshSectionTask_GameThread = Tasks::Launch(
 			    UE_SOURCE_LOCATION,
-			    [=, &InOutTargetProceduralMeshComponent]() mutable {
+			    [=]() mutable {
 				    ExecuteOnGameThread(
-				        UE_SOURCE_LOCATION,
-				        [=, &InOutTargetProceduralMeshComponent]() mutable {
+				        UE_SOURCE_LOCATION, [=]() mutable {
+					        // skip if canceled, or the target has been destroyed
+					        const auto& Target = WeakTarget.Get();
+					        if (SharedState->bCanceled || nullptr == Target) {
+						        return;
+					        }
+
 					        // CalcVerticesRelativeToTargetTask should be completed
 					        check(CalcVerticesRelativeToTargetTask.IsCompleted());
 					        // CalcNormalsRelativeToTargetTask should be completed
@@ -261,8 +293,7 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 					            CalcTangentsRelativeToTargetTask.GetResult();
 
 					        // create mesh section
-					        InOutTargetProceduralMeshComponent
-					            .CreateMeshSection_LinearColor(
+					        Target->CreateMeshSection_LinearColor(
 					                MeshSectionIndex, VerticesRelativeToTarget,
 					                Section.Triangles, NormalsRelativeToTarget,
 					                Section.UV0Channel, Section.VertexColors0,
@@ -299,19 +330,40 @@ FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
 	// Task when all create mesh section completed.
 	Tasks::Launch(
 	    UE_SOURCE_LOCATION,
-	    [&]() {
+	    [SharedState]() {
 		    // Put latent node into completion state
-		    IsRunning = false;
+		    SharedState->bFinished = true;
 	    },
 	    CreateMeshSectionTasks, LowLevelTasks::ETaskPriority::Normal);
 }
 
 void FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
     UpdateOperation(FLatentResponse& Response) {
-	Response.FinishAndTriggerIf(IsRunning == false, ExecutionFunction, OutputLink,
+	// if the target has been destroyed, nothing is left to construct
+	if (!TargetProceduralMeshComponent.IsValid()) {
+		Cancel();
+		Response.DoneIf(true);
+		return;
+	}
+
+	Response.FinishAndTriggerIf(State->bFinished, ExecutionFunction, OutputLink,
 	                            CallbackTarget);
 }
 
+void FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
+    NotifyObjectDestroyed() {
+	Cancel();
+}
+
+void FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::
+    NotifyActionAborted() {
+	Cancel();
+}
+
 void FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::Finish() {
-	IsRunning = false;
+	State->bFinished = true;
+}
+
+void FCreateMeshFromMeshDataOnProceduralMeshComponentLatentAction::Cancel() {
+	State->bCanceled = true;
 }
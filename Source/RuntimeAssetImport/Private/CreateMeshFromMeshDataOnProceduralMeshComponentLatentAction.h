@@ -6,6 +6,8 @@
 #include "LoadedMeshData.h"
 #include "ProceduralMeshComponent.h"
 
+#include <atomic>
+
 /**
  * Internal class for
  * AssetConstructor::CreateMeshFromMeshDataOnProceduralMeshComponent
@@ -22,14 +24,40 @@ public:
 	// this function is called every frame to check if it has finished.
 	virtual void UpdateOperation(FLatentResponse& Response) override;
 
+	// called when the object owning the latent action is destroyed.
+	virtual void NotifyObjectDestroyed() override;
+
+	// called when the latent action is removed before finishing.
+	virtual void NotifyActionAborted() override;
+
+	/* internal types */
+private:
+	/**
+	 * State shared with the tasks, which may outlive this latent action.
+	 */
+	struct FState {
+		// whether all mesh sections have been created
+		std::atomic<bool> bFinished = false;
+
+		// whether the construction has been canceled. Pending tasks skip their
+		// work and release their data.
+		std::atomic<bool> bCanceled = false;
+	};
+
 	/* internal functions */
 private:
 	// finish latent action
 	void Finish();
 
+	// cancel the pending tasks
+	void Cancel();
+
 	/* internal fields */
 private:
-	bool IsRunning = false;
+	TSharedRef<FState, ESPMode::ThreadSafe> State =
+	    MakeShared<FState, ESPMode::ThreadSafe>();
+
+	TWeakObjectPtr<UProceduralMeshComponent> TargetProceduralMeshComponent;
 
 	FName          ExecutionFunction;
 	int32          OutputLink;
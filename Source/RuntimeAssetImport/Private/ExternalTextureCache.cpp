@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExternalTextureCache.h"
+
+#include "Async/AsyncFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "LogAssetLoader.h"
+#include "RuntimeAssetImportSettings.h"
+#include "TextureContainers.h"
+#include "TextureProcessing.h"
+
+FExternalTextureCache& FExternalTextureCache::Get() {
+	static FExternalTextureCache Instance;
+	return Instance;
+}
+
+FExternalTextureCache::FExternalTextureCache()
+    : Cache(TEXT("texture cache"), [] {
+	      return SIZE_T(GetDefault<URuntimeAssetImportSettings>()
+	                        ->MaxTextureCacheSizeMB) *
+	             1024 * 1024;
+      }) {}
+
+UE::Tasks::TTask<FLoadedTextureDataPtr>
+    FExternalTextureCache::FindOrLoad(const FString& FilePath) {
+	namespace Tasks = UE::Tasks;
+
+	// get modification time and size
+	const auto& StatData = IFileManager::Get().GetStatData(*FilePath);
+	if (!StatData.bIsValid || StatData.bIsDirectory) {
+		UE_LOG(LogAssetLoader, Error, TEXT("Texture file %s does not exist."),
+		       *FilePath);
+		return Tasks::MakeCompletedTask<FLoadedTextureDataPtr>();
+	}
+
+	// make key, so that a modified file is read again
+	const auto& Key =
+	    FString::Printf(TEXT("%s|%lld|%lld"), *FilePath,
+	                    StatData.ModificationTime.GetTicks(), StatData.FileSize);
+
+	return Cache.FindOrLoad(Key, [this, &Key, &FilePath, &StatData] {
+		return StartLoad(Key, FilePath, StatData.FileSize);
+	});
+}
+
+UE::Tasks::TTask<FLoadedTextureDataPtr>
+    FExternalTextureCache::StartLoad(const FString& Key, const FString& FilePath,
+                                     int64 FileSize) {
+	namespace Tasks = UE::Tasks;
+
+	// start reading the whole file asynchronously. The event is triggered
+	// when the read is completed (possibly before ReadRequest returns).
+	TUniquePtr<IAsyncReadFileHandle> ReadHandle(
+	    FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*FilePath));
+	if (!ReadHandle.IsValid()) {
+		UE_LOG(LogAssetLoader, Error, TEXT("Failed to open texture file %s."),
+		       *FilePath);
+		return Tasks::MakeCompletedTask<FLoadedTextureDataPtr>();
+	}
+	Tasks::FTaskEvent  ReadCompletedEvent(UE_SOURCE_LOCATION);
+	FAsyncFileCallBack ReadCallback =
+	    [ReadCompletedEvent](bool, IAsyncReadRequest*) mutable {
+		    ReadCompletedEvent.Trigger();
+	    };
+	TUniquePtr<IAsyncReadRequest> ReadRequest(ReadHandle->ReadRequest(
+	    0, FileSize, AIOP_Normal, &ReadCallback));
+
+	// task to decode the file once it is read, and add it to the cache
+	return Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [this, Key, FilePath, FileSize, ReadHandle = MoveTemp(ReadHandle),
+	     ReadRequest = MoveTemp(ReadRequest)]() mutable {
+		    // take the read data (owned by this task from now on). The request
+		    // must be deleted before the handle.
+		    ReadRequest->WaitCompletion();
+		    uint8* const FileData = ReadRequest->GetReadResults();
+		    ReadRequest.Reset();
+		    ReadHandle.Reset();
+
+		    // decode, unless the blocks of a DDS or KTX2 file can be passed
+		    // through as they are
+		    FLoadedTextureDataPtr TextureData;
+		    if (nullptr == FileData) {
+			    UE_LOG(LogAssetLoader, Error,
+			           TEXT("Failed to read texture file %s."), *FilePath);
+		    } else {
+			    FLoadedTextureData DecodedTextureData;
+			    DecodedTextureData.SourceFilePath = FilePath;
+			    // external textures are the base colors of materials
+			    if (ReadPrecompressedTexture(FileData, FileSize,
+			                                 /* bUnspecifiedIsSRGB = */ true,
+			                                 DecodedTextureData) ||
+			        DecodeTextureData(FileData, FileSize, DecodedTextureData)) {
+				    TextureData = MakeShared<const FLoadedTextureData,
+				                             ESPMode::ThreadSafe>(
+				        MoveTemp(DecodedTextureData));
+			    } else {
+				    UE_LOG(LogAssetLoader, Error,
+				           TEXT("Failed to decode texture file %s."), *FilePath);
+			    }
+			    FMemory::Free(FileData);
+		    }
+
+		    return Cache.FinishLoad(Key, MoveTemp(TextureData));
+	    },
+	    Tasks::Prerequisites(ReadCompletedEvent),
+	    LowLevelTasks::ETaskPriority::BackgroundNormal);
+}
+
+TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>>
+    FExternalTextureCache::FindOrLoadAll(
+        const TArray<FLoadedTextureData>& TextureList) {
+	TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>> Tasks;
+	Tasks.Reserve(TextureList.Num());
+
+	for (const auto& TextureData : TextureList) {
+		Tasks.Add(TextureData.SourceFilePath.IsEmpty()
+		              ? UE::Tasks::MakeCompletedTask<FLoadedTextureDataPtr>()
+		              : FindOrLoad(TextureData.SourceFilePath));
+	}
+
+	return Tasks;
+}
+
+TArray<int32> FExternalTextureCache::CopyLoadedData(
+    const TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>>& Tasks,
+    TArray<FLoadedTextureData>&                            TextureList) {
+	check(Tasks.Num() == TextureList.Num());
+
+	TArray<int32> FailedTextureIndices;
+	const auto&   NumTextures = TextureList.Num();
+	for (auto i = decltype(NumTextures){0}; i < NumTextures; ++i) {
+		// skip embedded textures
+		auto& TextureData = TextureList[i];
+		if (TextureData.SourceFilePath.IsEmpty()) {
+			continue;
+		}
+
+		// share the loaded pixels instead of copying them, keeping the path
+		// the asset refers to the file by (the same file may be referred to
+		// differently by other assets)
+		const auto& LoadedTextureData = Tasks[i].GetResult();
+		if (!LoadedTextureData.IsValid()) {
+			FailedTextureIndices.Add(i);
+			continue;
+		}
+		TextureData.CompressedData.Empty();
+		TextureData.RawData.Empty();
+		TextureData.SharedRawData = TSharedPtr<const TArray<uint8>,
+		                                       ESPMode::ThreadSafe>(
+		    LoadedTextureData, &LoadedTextureData->GetRawData());
+		TextureData.RawWidth   = LoadedTextureData->RawWidth;
+		TextureData.RawHeight  = LoadedTextureData->RawHeight;
+		TextureData.RawFormat  = LoadedTextureData->RawFormat;
+		TextureData.NumMips    = LoadedTextureData->NumMips;
+		TextureData.bSRGB      = LoadedTextureData->bSRGB;
+		TextureData.MemorySize = LoadedTextureData->MemorySize;
+	}
+
+	return FailedTextureIndices;
+}
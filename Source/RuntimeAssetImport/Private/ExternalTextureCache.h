@@ -0,0 +1,100 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoalescingLruCache.h"
+#include "CoreMinimal.h"
+#include "LoadedTextureData.h"
+
+/**
+ * Immutable texture data shared between multiple owners (the cache and the
+ * loads that refer to the same texture file).
+ */
+using FLoadedTextureDataPtr =
+    TSharedPtr<const FLoadedTextureData, ESPMode::ThreadSafe>;
+
+/**
+ * In-process cache of external textures, that is, image files referenced from
+ * assets instead of being embedded in them.
+ * Files are identified by absolute path, modification time and size, so a
+ * texture shared by multiple assets (e.g. a texture atlas) is read and decoded
+ * only once. Files are read with asynchronous file I/O and decoded on worker
+ * threads, into uncompressed pixels.
+ * The cache is bounded by URuntimeAssetImportSettings::MaxTextureCacheSizeMB
+ * and the least recently used entries are evicted first. Concurrent requests
+ * for the same file are coalesced onto one in-flight load.
+ * All functions are thread-safe.
+ */
+class FExternalTextureCache {
+public:
+	/**
+	 * Get the process-wide instance.
+	 */
+	static FExternalTextureCache& Get();
+
+	FExternalTextureCache();
+
+public:
+	/**
+	 * Find the decoded texture of a file, or load it.
+	 * If the texture is cached, a completed task is returned. If another load
+	 * of the same file is in flight, its task is returned. Otherwise the file
+	 * is read asynchronously and decoded on a worker thread.
+	 * @param   FilePath   absolute path to the texture file
+	 * @return  task whose result is the texture data (with SourceFilePath set
+	 *          to FilePath), or null if the file cannot be read or decoded.
+	 */
+	UE::Tasks::TTask<FLoadedTextureDataPtr> FindOrLoad(const FString& FilePath);
+
+	/**
+	 * Start loading every external texture of a texture list, that is, every
+	 * texture whose SourceFilePath is set. All of them are read and decoded in
+	 * parallel.
+	 * @param   TextureList   texture list of mesh data
+	 * @return  a task for each element of TextureList. The tasks of embedded
+	 *          textures are completed with null.
+	 */
+	TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>>
+	    FindOrLoadAll(const TArray<FLoadedTextureData>& TextureList);
+
+	/**
+	 * Wait for the tasks made by FindOrLoadAll, and set the loaded data to the
+	 * external textures of the texture list. Their pixels are shared with the
+	 * cache through SharedRawData rather than copied.
+	 * @param        Tasks         tasks made by FindOrLoadAll from TextureList
+	 * @param[out]   TextureList   texture list passed to FindOrLoadAll
+	 * @return  indices in TextureList of the external textures that failed to
+	 *          load.
+	 */
+	static TArray<int32>
+	    CopyLoadedData(const TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>>& Tasks,
+	                   TArray<FLoadedTextureData>& TextureList);
+
+	/**
+	 * Get the number of files that have been read since the process started,
+	 * that is, the requests that were neither found in the cache nor joined
+	 * an in-flight load.
+	 */
+	uint64 GetNumLoads() const {
+		return Cache.GetNumLoads();
+	}
+
+	/* internal functions */
+private:
+	/**
+	 * Start reading a texture file asynchronously, and decoding it on a worker
+	 * thread once it is read. Called by the cache with its lock held.
+	 * @param   Key        key of the file in the cache
+	 * @param   FilePath   absolute path to the texture file
+	 * @param   FileSize   size of the file in bytes
+	 * @return  task whose result is the texture data, or a completed task
+	 *          with null if the file cannot be opened.
+	 */
+	UE::Tasks::TTask<FLoadedTextureDataPtr>
+	    StartLoad(const FString& Key, const FString& FilePath, int64 FileSize);
+
+	/* internal fields */
+private:
+	// decoded textures, keyed by path, modification time and size
+	TCoalescingLruCache<FLoadedTextureData> Cache;
+};
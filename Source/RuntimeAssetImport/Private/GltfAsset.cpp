@@ -0,0 +1,2123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GltfAsset.h"
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "LogAssetLoader.h"
+#include "MeshDataConstruction.h"
+#include "MeshoptDecoding.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "VertexStreamConversion.h"
+
+#include <assimp/quaternion.h>
+
+// GLB header and chunk types
+static constexpr uint32 GlbMagic         = 0x46546C67; // "glTF"
+static constexpr uint32 GlbVersion       = 2;
+static constexpr int64  GlbHeaderSize    = 12;
+static constexpr uint32 GlbChunkTypeJson = 0x4E4F534A; // "JSON"
+static constexpr uint32 GlbChunkTypeBin  = 0x004E4942; // "BIN\0"
+
+// component types of accessors
+static constexpr int32 GltfByte          = 5120;
+static constexpr int32 GltfUnsignedByte  = 5121;
+static constexpr int32 GltfShort         = 5122;
+static constexpr int32 GltfUnsignedShort = 5123;
+static constexpr int32 GltfUnsignedInt   = 5125;
+static constexpr int32 GltfFloat         = 5126;
+
+// primitive mode of triangle lists
+static constexpr int32 GltfTriangles = 4;
+
+// extensions that change what assimp imports in ways the native loader does
+// not reproduce
+static const TCHAR* const UnsupportedGltfExtensions[] = {
+    TEXT("KHR_draco_mesh_compression"),
+    TEXT("KHR_texture_transform"),
+    TEXT("KHR_texture_basisu"),
+    TEXT("EXT_texture_webp"),
+    TEXT("KHR_materials_pbrSpecularGlossiness"),
+};
+
+// extensions that the native loader decodes, so they may be required
+static const TCHAR* const RequirableGltfExtensions[] = {
+    TEXT("EXT_meshopt_compression"),
+    TEXT("KHR_mesh_quantization"),
+};
+
+/**
+ * Top-level arrays of a glTF document and its binary chunk, used while parsing.
+ */
+struct FGltfDocument {
+	TArray<TSharedPtr<FJsonValue>> Accessors;
+	TArray<TSharedPtr<FJsonValue>> BufferViews;
+	TArray<TSharedPtr<FJsonValue>> Textures;
+	TArray<TSharedPtr<FJsonValue>> Images;
+
+	// binary chunk, nullptr if absent
+	const uint8* BinData = nullptr;
+	int64        BinSize = 0;
+
+	// decoded buffer views (see FGltfAsset)
+	TArrayView<const TArray<uint8>> DecodedBufferViews;
+
+	// whether KHR_mesh_quantization is used, so that attributes may be
+	// integers
+	bool bIsQuantized = false;
+};
+
+/**
+ * Buffer view compressed with EXT_meshopt_compression, to be decoded.
+ */
+struct FMeshoptBufferView {
+	// index of the buffer view
+	int32 BufferViewIndex = INDEX_NONE;
+
+	// compressed data in the binary chunk
+	const uint8* Data = nullptr;
+	int64        Size = 0;
+
+	// encoding of the data and filter applied after decoding
+	EMeshoptMode   Mode   = EMeshoptMode::Attributes;
+	EMeshoptFilter Filter = EMeshoptFilter::None;
+
+	// number and size in bytes of the elements
+	int32 Count      = 0;
+	int32 ByteStride = 0;
+
+	// byteLength of the buffer view (at least Count * ByteStride)
+	int32 ByteLength = 0;
+};
+
+/**
+ * A glTF primitive converted as a section, with the vertices it uses in the
+ * order assimp's glTF importer stores them: in the order the indices first use
+ * them.
+ */
+struct FGltfPrimitiveSection {
+	// primitive
+	const FGltfPrimitive* Primitive = nullptr;
+
+	// index in Primitive of each vertex of the section. Empty if every vertex
+	// has the same index in both.
+	TArray<uint32> VertexIndices;
+
+	// index in the section of each vertex of Primitive (the inverse of
+	// VertexIndices). Empty if VertexIndices is empty.
+	TArray<uint32> SectionVertexIndices;
+
+	// number of vertices and triangles of the section
+	int32 NumVertices = 0;
+	int32 NumFaces    = 0;
+
+	// whether the indices are in range and make whole triangles
+	bool bIsSupported = false;
+
+	// whether assimp's FindInvalidData step would change the section
+	bool bHasInvalidData = false;
+
+public:
+	/**
+	 * Get the index in Primitive of a vertex of the section.
+	 */
+	uint32 GetVertexIndex(const int32 Index) const {
+		return VertexIndices.IsEmpty() ? Index : VertexIndices[Index];
+	}
+};
+
+/**
+ * A glTF node and the index of its parent node in FLoadedMeshData::NodeList.
+ */
+struct FGltfNodeWithParentIndex {
+	// index of the glTF node. INDEX_NONE for the "ROOT" node that assimp adds
+	// if the scene does not have exactly one root node.
+	int32 GltfNodeIndex;
+
+	// index of the parent node. -1 for the root node.
+	int32 ParentNodeIndex;
+};
+
+#pragma region forward declarations of static functions
+/**
+ * Get an array field of a JSON object.
+ * @param   Object   JSON object
+ * @param   Field    name of the field
+ * @return  the array, empty if the field is absent or not an array
+ */
+static TArray<TSharedPtr<FJsonValue>> GetArrayField(const FJsonObject& Object,
+                                                     const FString&     Field);
+
+/**
+ * Get a non-negative integer field of a JSON object.
+ * @param        Object   JSON object
+ * @param        Field    name of the field
+ * @param[out]   Value    the value, if present
+ * @return  whether the field is present and a non-negative integer
+ */
+static bool TryGetIndexField(const FJsonObject& Object, const FString& Field,
+                             int32& Value);
+
+/**
+ * Get an extension of a JSON object (e.g. of a buffer view).
+ * @param   Object      JSON object
+ * @param   Extension   name of the extension
+ * @return  the extension object, nullptr if absent
+ */
+static TSharedPtr<FJsonObject> GetExtensionField(const FJsonObject& Object,
+                                                 const FString&     Extension);
+
+/**
+ * Read an array of a fixed number of floats, the same way as assimp does.
+ * @param        Value   JSON value
+ * @param        Num     number of floats
+ * @param[out]   Floats  the floats, empty if Value is not an array of Num
+ *                       numbers
+ */
+static void ReadFloats(const FJsonValue& Value, int32 Num, TArray<float>& Floats);
+
+/**
+ * Decode the buffer views compressed with EXT_meshopt_compression that the
+ * primitives of the meshes read, concurrently (each buffer view is a single
+ * stream, decoded by one worker).
+ * @param        Document             document
+ * @param        Meshes               JSON values of the meshes
+ * @param[out]   DecodedBufferViews   decoded data of each buffer view, empty
+ *                                    for those not decoded
+ * @return  whether the compressed buffer views are valid and decoded
+ */
+static bool DecodeMeshoptBufferViews(const FGltfDocument& Document,
+                                     const TArray<TSharedPtr<FJsonValue>>& Meshes,
+                                     TArray<TArray<uint8>>& DecodedBufferViews);
+
+/**
+ * Read a buffer view compressed with EXT_meshopt_compression.
+ * @param        Document          document
+ * @param        BufferViewIndex   index of the buffer view
+ * @param        Extension         its EXT_meshopt_compression object
+ * @param[out]   BufferView        the buffer view to decode
+ * @return  whether the extension is valid, and its data is in the binary
+ *          chunk
+ */
+static bool ReadMeshoptBufferView(const FGltfDocument& Document,
+                                  int32                BufferViewIndex,
+                                  const FJsonObject&   Extension,
+                                  FMeshoptBufferView&  BufferView);
+
+/**
+ * Resolve an accessor to a view of its elements in the binary chunk (or in a
+ * decoded buffer view).
+ * @param        Document        document
+ * @param        AccessorIndex   index of the accessor
+ * @param        NumComponents   required number of components
+ * @param[out]   Accessor        the view
+ * @return  whether the accessor is valid, is not sparse, has the required
+ *          number of components, and is float, 8- or 16-bit integer, or (if
+ *          NumComponents is 1) unsigned int.
+ */
+static bool ResolveAccessor(const FGltfDocument& Document, int32 AccessorIndex,
+                            int32 NumComponents, FGltfAccessor& Accessor);
+
+/**
+ * Resolve a range of a buffer view in the binary chunk, or the decoded data of
+ * a buffer view compressed with EXT_meshopt_compression.
+ * @param        Document          document
+ * @param        BufferViewIndex   index of the buffer view
+ * @param[out]   Data              start of the buffer view
+ * @param[out]   ByteLength        length of the buffer view
+ * @param[out]   ByteStride        byteStride of the buffer view, 0 if absent
+ * @return  whether the buffer view is inside the binary chunk, or decoded
+ */
+static bool ResolveBufferView(const FGltfDocument& Document, int32 BufferViewIndex,
+                              const uint8*& Data, int64& ByteLength,
+                              int64& ByteStride);
+
+/**
+ * Whether the component type of an attribute is allowed: float, or an integer
+ * type that KHR_mesh_quantization allows for the attribute if the asset uses
+ * the extension (assets without it keep going through assimp as before).
+ * @param   Name           name of the attribute (e.g. "NORMAL")
+ * @param   Accessor       accessor of the attribute
+ * @param   bIsQuantized   whether the asset uses KHR_mesh_quantization
+ */
+static bool IsAllowedAttributeType(const FString&       Name,
+                                   const FGltfAccessor& Accessor,
+                                   bool                 bIsQuantized);
+
+/**
+ * Parse a primitive.
+ * @param        Document     document
+ * @param        Object       JSON object of the primitive
+ * @param[out]   Primitive    parsed primitive
+ * @return  whether the primitive is accepted
+ */
+static bool ParsePrimitive(const FGltfDocument& Document, const FJsonObject& Object,
+                           FGltfPrimitive& Primitive);
+
+/**
+ * Parse a material.
+ * @param        Document   document
+ * @param        Object     JSON object of the material
+ * @param[out]   Material   parsed material
+ * @return  whether the material is accepted
+ */
+static bool ParseMaterial(const FGltfDocument& Document, const FJsonObject& Object,
+                          FGltfMaterial& Material);
+
+/**
+ * Make a texture info (e.g. baseColorTexture) canonical, so that texture infos
+ * that make the same assimp material properties are equal: the texture index
+ * is replaced with the source and sampler of the texture, and default values
+ * are omitted.
+ * @param   Document      document
+ * @param   TextureInfo   JSON object of the texture info
+ * @return  whether the texture of the texture info is valid and accepted
+ */
+static bool CanonicalizeTextureInfo(const FGltfDocument& Document,
+                                    FJsonObject&         TextureInfo);
+
+/**
+ * Remove a field if its value equals the default value.
+ * @param   Object         JSON object
+ * @param   Field          name of the field
+ * @param   DefaultValue   default value (compared in canonical form)
+ */
+static void RemoveDefaultField(FJsonObject& Object, const FString& Field,
+                               const FString& DefaultValue);
+
+/**
+ * Append the canonical form of a JSON value: fields sorted by name, and
+ * numbers as single precision floats (as assimp reads them).
+ * @param        Value   JSON value
+ * @param[out]   Out     string to append to
+ */
+static void AppendCanonicalJson(const FJsonValue& Value, FString& Out);
+
+/**
+ * Check that the nodes reachable from a node do not refer to themselves, and
+ * mark them.
+ * @param           Nodes       all nodes
+ * @param           NodeIndex   node to visit
+ * @param[in,out]   States      state of each node: 0 not visited, 1 being
+ *                              visited, 2 visited
+ * @return  false if a node refers to itself (which assimp rejects)
+ */
+static bool VisitNodes(const TArray<FGltfNode>& Nodes, int32 NodeIndex,
+                       TArray<uint8>& States);
+
+/**
+ * Read a little-endian 32-bit unsigned integer.
+ * @param   Data   data to read from
+ */
+static uint32 ReadUInt32(const uint8* Data);
+
+/**
+ * Collect the materials of the meshes under a glTF node, in the order
+ * assimp's glTF importer reads them (and so orders its materials): each node
+ * reads its children before its mesh, and each node and mesh is read once.
+ * @param           Asset             glTF asset
+ * @param           NodeIndex         index of the node
+ * @param[in,out]   bIsNodeRead       whether each node has been read
+ * @param[in,out]   bIsMeshRead       whether each mesh has been read
+ * @param[in,out]   MaterialIndices   indices of the materials read so far
+ */
+static void CollectGltfMaterialsInAiOrder(const FGltfAsset& Asset, int32 NodeIndex,
+                                          TArray<bool>&  bIsNodeRead,
+                                          TArray<bool>&  bIsMeshRead,
+                                          TArray<int32>& MaterialIndices);
+
+/**
+ * Flatten the node tree of a glTF asset, as assimp's glTF importer makes it,
+ * into a list in pre-order depth-first (see FlattenAiNodeTree).
+ * @param   Asset   glTF asset
+ * @return  flattened nodes, each with the index of its parent in the list
+ *          (-1 for the root node).
+ */
+static TArray<FGltfNodeWithParentIndex> FlattenGltfNodeTree(const FGltfAsset& Asset);
+
+/**
+ * Make the transform assimp's glTF importer gives a node: its matrix, or its
+ * translation, rotation and scale multiplied in this order.
+ * @param   Node   glTF node
+ * @return  the transform
+ */
+static aiMatrix4x4 MakeGltfNodeAiTransform(const FGltfNode& Node);
+
+/**
+ * Prepare a glTF primitive for conversion: order its vertices as assimp's
+ * glTF importer does, and check whether it is supported and whether assimp's
+ * FindInvalidData step would change it.
+ * @param           bFindInvalidData   whether to check for invalid data
+ * @param[in,out]   GltfSection        section whose Primitive is set, and
+ *                                     whose other members are set
+ */
+static void PrepareGltfSection(bool                   bFindInvalidData,
+                               FGltfPrimitiveSection& GltfSection);
+
+/**
+ * Whether assimp's FindInvalidData step would change a glTF primitive: any
+ * position, UV, normal, tangent or bitangent is NaN or infinite, a normal is
+ * zero, or all positions, UVs, tangents or bitangents are identical.
+ * @param   GltfSection   prepared section
+ */
+static bool HasInvalidGltfData(const FGltfPrimitiveSection& GltfSection);
+
+/**
+ * Convert a range of vertices of a glTF primitive to UE's format, as assimp
+ * would store them after its MakeLeftHanded and FlipUVs steps.
+ * The streams of the present attributes must already be sized to the number
+ * of vertices.
+ * @param        GltfSection   prepared section to convert
+ * @param        Attributes    vertex attributes present in the primitive
+ * @param        Begin         first vertex to convert
+ * @param        End           one past the last vertex to convert
+ * @param[out]   Section       section whose streams are written
+ */
+static void ConvertGltfVertexRange(const FGltfPrimitiveSection& GltfSection,
+                                   EAiVertexAttributes Attributes, int32 Begin,
+                                   int32 End, FLoadedMeshSectionData& Section);
+
+/**
+ * Compact precision version of ConvertGltfVertexRange.
+ * @param        GltfSection   prepared section to convert
+ * @param        Attributes    vertex attributes present in the primitive
+ * @param        Begin         first vertex to convert
+ * @param        End           one past the last vertex to convert
+ * @param[out]   Section       section whose compact streams are written
+ */
+static void ConvertGltfVertexRangeCompact(const FGltfPrimitiveSection& GltfSection,
+                                          EAiVertexAttributes Attributes,
+                                          int32 Begin, int32 End,
+                                          FLoadedMeshSectionData& Section);
+
+/**
+ * Convert a range of triangles of a glTF primitive to UE's triangle format.
+ * Triangles must already be sized to 3 times the number of faces.
+ * @tparam       IndexT        int32, or uint16 for compact precision
+ * @param        GltfSection   prepared section to convert
+ * @param        Begin         first triangle to convert
+ * @param        End           one past the last triangle to convert
+ * @param[out]   Triangles     triangles of the section
+ */
+template <typename IndexT>
+static void ConvertGltfFaceRange(const FGltfPrimitiveSection& GltfSection,
+                                 int32 Begin, int32 End,
+                                 TArray<IndexT>& Triangles);
+
+/**
+ * Get the V texture coordinate assimp ends up with for a glTF one: its glTF
+ * importer flips V, and the FlipUVs step flips it back, which rounds V.
+ * @param   V   glTF V texture coordinate
+ * @return  the V texture coordinate
+ */
+static float FlipBackAiV(float V);
+#pragma endregion
+
+uint32 FGltfAccessor::GetIndex(const int64 Index) const {
+	const auto& Element = Data + Index * ByteStride;
+	switch (ComponentType) {
+	case GltfUnsignedByte:
+		return *Element;
+	case GltfUnsignedShort:
+		return *reinterpret_cast<const uint16*>(Element);
+	default:
+		checkf(GltfUnsignedInt == ComponentType,
+		       TEXT("Bug. An index accessor must be of unsigned integers."));
+		return *reinterpret_cast<const uint32*>(Element);
+	}
+}
+
+void FGltfAccessor::Dequantize(const int64 Index, FVector4f& Floats) const {
+	// normalized signed integers are clamped so that the minimum is -1
+	const auto& Element = Data + Index * ByteStride;
+	const auto& Convert = [&](const auto* const Components, const float Max) {
+		for (auto i = 0; i < NumComponents; ++i) {
+			Floats[i] = bNormalized ? FMath::Max(Components[i] / Max, -1.0f)
+			                        : static_cast<float>(Components[i]);
+		}
+	};
+	switch (ComponentType) {
+	case GltfByte:
+		Convert(reinterpret_cast<const int8*>(Element), 127.0f);
+		break;
+	case GltfUnsignedByte:
+		Convert(Element, 255.0f);
+		break;
+	case GltfShort:
+		Convert(reinterpret_cast<const int16*>(Element), 32767.0f);
+		break;
+	default:
+		checkf(GltfUnsignedShort == ComponentType,
+		       TEXT("Bug. A dequantized accessor must be of 8- or 16-bit "
+		            "integers."));
+		Convert(reinterpret_cast<const uint16*>(Element), 65535.0f);
+		break;
+	}
+}
+
+bool HasGlbSignature(const uint8* const Data, const int64 Size) {
+	return Size >= GlbHeaderSize && GlbMagic == ReadUInt32(Data) &&
+	       GlbVersion == ReadUInt32(Data + 4);
+}
+
+bool ReadGlbFile(const FString& FilePath, TArray64<uint8>& Data) {
+	const TUniquePtr<FArchive> Reader(
+	    IFileManager::Get().CreateFileReader(*FilePath));
+	if (!Reader.IsValid() || Reader->TotalSize() < GlbHeaderSize) {
+		return false;
+	}
+
+	// read the header only, and the rest if it is a GLB
+	uint8 Header[GlbHeaderSize];
+	Reader->Serialize(Header, GlbHeaderSize);
+	if (Reader->IsError() || !HasGlbSignature(Header, GlbHeaderSize)) {
+		return false;
+	}
+
+	Data.SetNumUninitialized(Reader->TotalSize());
+	FMemory::Memcpy(Data.GetData(), Header, GlbHeaderSize);
+	Reader->Serialize(Data.GetData() + GlbHeaderSize,
+	                  Data.Num() - GlbHeaderSize);
+	return !Reader->IsError();
+}
+
+bool ParseGlb(const uint8* const Data, const int64 Size, FGltfAsset& Asset) {
+	// header
+	if (!HasGlbSignature(Data, Size)) {
+		return false;
+	}
+	const auto& Length = int64{ReadUInt32(Data + 8)};
+	if (Length > Size) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("GLB is truncated (%lld bytes of %lld)."), Size, Length);
+		return false;
+	}
+
+	// JSON chunk
+	constexpr auto ChunkHeaderSize = int64{8};
+	if (Length < GlbHeaderSize + ChunkHeaderSize) {
+		return false;
+	}
+	const auto& JsonLength = int64{ReadUInt32(Data + GlbHeaderSize)};
+	const auto& JsonData   = Data + GlbHeaderSize + ChunkHeaderSize;
+	if (GlbChunkTypeJson != ReadUInt32(Data + GlbHeaderSize + 4) ||
+	    GlbHeaderSize + ChunkHeaderSize + JsonLength > Length) {
+		UE_LOG(LogAssetLoader, Warning, TEXT("GLB has no valid JSON chunk."));
+		return false;
+	}
+
+	// binary chunk (optional), after the JSON chunk padded to 4 bytes
+	FGltfDocument Document;
+	const auto& BinChunkOffset =
+	    GlbHeaderSize + ChunkHeaderSize + Align(JsonLength, 4);
+	if (BinChunkOffset + ChunkHeaderSize <= Length &&
+	    GlbChunkTypeBin == ReadUInt32(Data + BinChunkOffset + 4)) {
+		Document.BinSize = ReadUInt32(Data + BinChunkOffset);
+		Document.BinData = Data + BinChunkOffset + ChunkHeaderSize;
+		if (BinChunkOffset + ChunkHeaderSize + Document.BinSize > Length) {
+			UE_LOG(LogAssetLoader, Warning, TEXT("GLB has no valid BIN chunk."));
+			return false;
+		}
+	}
+
+	// parse JSON
+	const FUTF8ToTCHAR JsonText(reinterpret_cast<const ANSICHAR*>(JsonData),
+	                            static_cast<int32>(JsonLength));
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(
+	        TJsonReaderFactory<>::Create(
+	            FString(JsonText.Length(), JsonText.Get())),
+	        Root) ||
+	    !Root.IsValid()) {
+		UE_LOG(LogAssetLoader, Warning, TEXT("Failed to parse JSON of GLB."));
+		return false;
+	}
+
+	// extensions
+	for (const auto& Extension :
+	     GetArrayField(*Root, TEXT("extensionsRequired"))) {
+		auto bIsRequirable = false;
+		for (const auto& RequirableExtension : RequirableGltfExtensions) {
+			bIsRequirable |= Extension->AsString() == RequirableExtension;
+		}
+		if (!bIsRequirable) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("GLB requires %s, so it is imported with assimp."),
+			       *Extension->AsString());
+			return false;
+		}
+	}
+	for (const auto& Extension : GetArrayField(*Root, TEXT("extensionsUsed"))) {
+		for (const auto& UnsupportedExtension : UnsupportedGltfExtensions) {
+			if (Extension->AsString() == UnsupportedExtension) {
+				UE_LOG(LogAssetLoader, Log,
+				       TEXT("GLB uses %s, so it is imported with assimp."),
+				       UnsupportedExtension);
+				return false;
+			}
+		}
+		Document.bIsQuantized |=
+		    Extension->AsString() == TEXT("KHR_mesh_quantization");
+	}
+
+	// every buffer must be the binary chunk, except fallbacks of buffer views
+	// compressed with EXT_meshopt_compression (which are not read)
+	const auto& Buffers = GetArrayField(*Root, TEXT("buffers"));
+	for (auto Buffer_i = 0; Buffer_i < Buffers.Num(); ++Buffer_i) {
+		const auto& BufferObject = Buffers[Buffer_i]->AsObject();
+		auto        bIsFallback  = false;
+		if (BufferObject.IsValid()) {
+			if (const auto& Extension = GetExtensionField(
+			        *BufferObject, TEXT("EXT_meshopt_compression"))) {
+				Extension->TryGetBoolField(TEXT("fallback"), bIsFallback);
+			}
+		}
+		if (!bIsFallback &&
+		    (0 != Buffer_i || nullptr == Document.BinData ||
+		     !BufferObject.IsValid() || BufferObject->HasField(TEXT("uri")))) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("GLB refers to external buffers, so it is imported "
+			            "with assimp."));
+			return false;
+		}
+	}
+
+	Document.Accessors   = GetArrayField(*Root, TEXT("accessors"));
+	Document.BufferViews = GetArrayField(*Root, TEXT("bufferViews"));
+	Document.Textures    = GetArrayField(*Root, TEXT("textures"));
+	Document.Images      = GetArrayField(*Root, TEXT("images"));
+
+	// decode compressed geometry before the accessors are resolved
+	const auto& MeshValues = GetArrayField(*Root, TEXT("meshes"));
+	if (!DecodeMeshoptBufferViews(Document, MeshValues,
+	                              Asset.DecodedBufferViews)) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("GLB has a buffer view compressed with "
+		            "EXT_meshopt_compression that cannot be decoded."));
+		return false;
+	}
+	Document.DecodedBufferViews = Asset.DecodedBufferViews;
+
+	// images (only embedded images can be referenced, which is checked by the
+	// materials)
+	for (const auto& ImageValue : Document.Images) {
+		auto&       Image = Asset.Images.AddDefaulted_GetRef();
+		int32       BufferViewIndex;
+		int64       ByteStride;
+		const auto& ImageObject = ImageValue->AsObject();
+		if (ImageObject.IsValid() &&
+		    TryGetIndexField(*ImageObject, TEXT("bufferView"), BufferViewIndex) &&
+		    !ResolveBufferView(Document, BufferViewIndex, Image.Data, Image.Size,
+		                       ByteStride)) {
+			return false;
+		}
+	}
+
+	// materials
+	for (const auto& MaterialValue : GetArrayField(*Root, TEXT("materials"))) {
+		const auto& MaterialObject = MaterialValue->AsObject();
+		if (!MaterialObject.IsValid() ||
+		    !ParseMaterial(Document, *MaterialObject,
+		                   Asset.Materials.AddDefaulted_GetRef())) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("GLB has a material not supported by the native "
+			            "loader, so it is imported with assimp."));
+			return false;
+		}
+	}
+	FGltfMaterial DefaultMaterial;
+	ParseMaterial(Document, FJsonObject(), DefaultMaterial);
+	Asset.DefaultMaterialKey = MoveTemp(DefaultMaterial.Key);
+
+	// meshes
+	for (const auto& MeshValue : MeshValues) {
+		const auto& MeshObject = MeshValue->AsObject();
+		auto&       Mesh       = Asset.Meshes.AddDefaulted_GetRef();
+		if (!MeshObject.IsValid()) {
+			return false;
+		}
+		for (const auto& PrimitiveValue :
+		     GetArrayField(*MeshObject, TEXT("primitives"))) {
+			const auto& PrimitiveObject = PrimitiveValue->AsObject();
+			if (!PrimitiveObject.IsValid() ||
+			    !ParsePrimitive(Document, *PrimitiveObject,
+			                    Mesh.Primitives.AddDefaulted_GetRef())) {
+				UE_LOG(LogAssetLoader, Log,
+				       TEXT("GLB has a primitive not supported by the native "
+				            "loader, so it is imported with assimp."));
+				return false;
+			}
+			const auto& MaterialIndex = Mesh.Primitives.Last().MaterialIndex;
+			if (MaterialIndex != INDEX_NONE &&
+			    !Asset.Materials.IsValidIndex(MaterialIndex)) {
+				return false;
+			}
+		}
+	}
+
+	// nodes
+	const auto& NodeValues = GetArrayField(*Root, TEXT("nodes"));
+	for (auto Node_i = 0; Node_i < NodeValues.Num(); ++Node_i) {
+		const auto& NodeObject = NodeValues[Node_i]->AsObject();
+		auto&       Node       = Asset.Nodes.AddDefaulted_GetRef();
+		if (!NodeObject.IsValid()) {
+			return false;
+		}
+
+		// name (assimp uses the id if the name is empty, and cannot hold
+		// names of 1024 bytes or more)
+		if (!NodeObject->TryGetStringField(TEXT("name"), Node.Name) ||
+		    Node.Name.IsEmpty()) {
+			Node.Name = FString::Printf(TEXT("nodes[%d]"), Node_i);
+		}
+		if (FTCHARToUTF8(*Node.Name).Length() >= 1024) {
+			return false;
+		}
+
+		// transform (TRS is not read if there is a matrix)
+		if (const auto& MatrixValue = NodeObject->TryGetField(TEXT("matrix"));
+		    MatrixValue.IsValid() && EJson::Array == MatrixValue->Type) {
+			ReadFloats(*MatrixValue, 16, Node.Matrix);
+		} else {
+			if (const auto& Value = NodeObject->TryGetField(TEXT("translation"))) {
+				ReadFloats(*Value, 3, Node.Translation);
+			}
+			if (const auto& Value = NodeObject->TryGetField(TEXT("rotation"))) {
+				ReadFloats(*Value, 4, Node.Rotation);
+			}
+			if (const auto& Value = NodeObject->TryGetField(TEXT("scale"))) {
+				ReadFloats(*Value, 3, Node.Scale);
+			}
+		}
+
+		// children and mesh
+		for (const auto& ChildValue :
+		     GetArrayField(*NodeObject, TEXT("children"))) {
+			double Child;
+			if (!ChildValue->TryGetNumber(Child) || Child < 0 ||
+			    Child >= NodeValues.Num()) {
+				return false;
+			}
+			Node.Children.Add(static_cast<int32>(Child));
+		}
+		if (TryGetIndexField(*NodeObject, TEXT("mesh"), Node.MeshIndex) &&
+		    !Asset.Meshes.IsValidIndex(Node.MeshIndex)) {
+			return false;
+		}
+	}
+
+	// root nodes of the default scene (the first scene if not specified)
+	const auto& Scenes     = GetArrayField(*Root, TEXT("scenes"));
+	auto        SceneIndex = 0;
+	TryGetIndexField(*Root, TEXT("scene"), SceneIndex);
+	if (!Scenes.IsValidIndex(SceneIndex) ||
+	    !Scenes[SceneIndex]->AsObject().IsValid()) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("GLB has no scene, so it is imported with assimp."));
+		return false;
+	}
+	for (const auto& NodeValue :
+	     GetArrayField(*Scenes[SceneIndex]->AsObject(), TEXT("nodes"))) {
+		double RootNodeIndex;
+		if (!NodeValue->TryGetNumber(RootNodeIndex) || RootNodeIndex < 0 ||
+		    RootNodeIndex >= Asset.Nodes.Num()) {
+			return false;
+		}
+		Asset.RootNodeIndices.Add(static_cast<int32>(RootNodeIndex));
+	}
+
+	// the nodes must not refer to themselves
+	TArray<uint8> NodeStates;
+	NodeStates.SetNumZeroed(Asset.Nodes.Num());
+	for (const auto& RootNodeIndex : Asset.RootNodeIndices) {
+		if (!VisitNodes(Asset.Nodes, RootNodeIndex, NodeStates)) {
+			UE_LOG(LogAssetLoader, Warning,
+			       TEXT("GLB has a node that refers to itself."));
+			return false;
+		}
+	}
+
+	// assimp also reads the nodes referred to by skins and animations, along
+	// with their meshes and materials, which are not supported
+	TArray<double> OtherNodeIndices;
+	for (const auto& SkinValue : GetArrayField(*Root, TEXT("skins"))) {
+		if (const auto& SkinObject = SkinValue->AsObject()) {
+			for (const auto& JointValue : GetArrayField(*SkinObject, TEXT("joints"))) {
+				OtherNodeIndices.Add(JointValue->AsNumber());
+			}
+		}
+	}
+	for (const auto& AnimationValue : GetArrayField(*Root, TEXT("animations"))) {
+		if (const auto& AnimationObject = AnimationValue->AsObject()) {
+			for (const auto& ChannelValue :
+			     GetArrayField(*AnimationObject, TEXT("channels"))) {
+				const auto& ChannelObject = ChannelValue->AsObject();
+				const TSharedPtr<FJsonObject>* TargetObject;
+				double                         TargetNode;
+				if (ChannelObject.IsValid() &&
+				    ChannelObject->TryGetObjectField(TEXT("target"),
+				                                     TargetObject) &&
+				    (*TargetObject)->TryGetNumberField(TEXT("node"), TargetNode)) {
+					OtherNodeIndices.Add(TargetNode);
+				}
+			}
+		}
+	}
+	for (const auto& OtherNodeIndex : OtherNodeIndices) {
+		if (OtherNodeIndex < 0 || OtherNodeIndex >= Asset.Nodes.Num() ||
+		    2 != NodeStates[static_cast<int32>(OtherNodeIndex)]) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("GLB has skins or animations referring to nodes "
+			            "outside of the scene, so it is imported with assimp."));
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool TryConstructMeshDataFromGlb(const uint8* const         Data,
+                                 const int64                Size,
+                                 const FAssetImportProfile& ImportProfile,
+                                 const FLoadOptions&        LoadOptions,
+                                 FLoadedMeshData&           MeshData) {
+	// post-process steps to reproduce (decided after inspecting the meshes in
+	// auto mode)
+	const auto& bAutoProfile =
+	    EAssetImportProfileType::Auto == ImportProfile.ProfileType;
+	auto AiPostProcessSteps = GetAiPostProcessSteps(ImportProfile);
+	if (0 != (AiPostProcessSteps & ~NativePostProcessSteps)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("GLB is imported with assimp, since post-process steps "
+		            "0x%08x are not reproduced by the native loader."),
+		       AiPostProcessSteps & ~NativePostProcessSteps);
+		return false;
+	}
+
+	// parse
+	FGltfAsset Asset;
+	if (!ParseGlb(Data, Size, Asset)) {
+		return false;
+	}
+
+	// flatten node tree so that the index of every node is known up front
+	const auto& FlattenedGltfNodes = FlattenGltfNodeTree(Asset);
+	const auto& NumNodes           = FlattenedGltfNodes.Num();
+
+	// a section for each primitive of each mesh the nodes refer to, in the
+	// order the nodes first refer to them (as assimp's meshes are referred to)
+	TArray<int32> FirstSectionIndexOfMesh;
+	FirstSectionIndexOfMesh.Init(INDEX_NONE, Asset.Meshes.Num());
+	TArray<FGltfPrimitiveSection> GltfSections;
+	for (const auto& GltfNodeWithParentIndex : FlattenedGltfNodes) {
+		const auto& GltfNodeIndex = GltfNodeWithParentIndex.GltfNodeIndex;
+		const auto& MeshIndex =
+		    INDEX_NONE == GltfNodeIndex ? INDEX_NONE
+		                                : Asset.Nodes[GltfNodeIndex].MeshIndex;
+		if (INDEX_NONE == MeshIndex ||
+		    INDEX_NONE != FirstSectionIndexOfMesh[MeshIndex]) {
+			continue;
+		}
+
+		FirstSectionIndexOfMesh[MeshIndex] = GltfSections.Num();
+		for (const auto& Primitive : Asset.Meshes[MeshIndex].Primitives) {
+			GltfSections.AddDefaulted_GetRef().Primitive = &Primitive;
+		}
+	}
+	const auto& NumSections = GltfSections.Num();
+	if (0 == NumSections) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("GLB has no meshes, so it is imported with assimp."));
+		return false;
+	}
+
+	// order vertices and check data of all sections concurrently
+	const auto& bFindInvalidData =
+	    bAutoProfile || 0 != (AiPostProcessSteps & aiProcess_FindInvalidData);
+	ParallelFor(NumSections, [&](const int32 Section_i) {
+		PrepareGltfSection(bFindInvalidData, GltfSections[Section_i]);
+	});
+
+	// inspect what all sections have
+	auto bAllSectionsAreSupported   = true;
+	auto bAllSectionsHaveNormals    = true;
+	auto bAllUVSectionsHaveTangents = true;
+	auto bAllSectionsAreIndexed     = true;
+	auto bAnySectionLacksTangents   = false;
+	auto bAnySectionHasInvalidData  = false;
+	for (const auto& GltfSection : GltfSections) {
+		const auto& Primitive = *GltfSection.Primitive;
+		bAllSectionsAreSupported &= GltfSection.bIsSupported;
+		bAllSectionsHaveNormals &= Primitive.Normals.IsSet();
+		bAllUVSectionsHaveTangents &=
+		    !Primitive.TexCoords0.IsSet() || Primitive.Tangents.IsSet();
+		bAllSectionsAreIndexed &=
+		    GltfSection.NumVertices < 3 * int64{GltfSection.NumFaces};
+		bAnySectionLacksTangents |= Primitive.Normals.IsSet() &&
+		                            Primitive.TexCoords0.IsSet() &&
+		                            !Primitive.Tangents.IsSet();
+		bAnySectionHasInvalidData |= GltfSection.bHasInvalidData;
+	}
+	if (!bAllSectionsAreSupported) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("GLB has a primitive whose indices are out of range or do "
+		            "not make whole triangles, so it is imported with assimp."));
+		return false;
+	}
+
+	// decide steps from the data present in auto mode, the same way as for
+	// assimp's scene
+	if (bAutoProfile) {
+		AiPostProcessSteps = GetAutoAiPostProcessSteps(bAllSectionsHaveNormals,
+		                                               bAllUVSectionsHaveTangents,
+		                                               bAllSectionsAreIndexed);
+
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("Auto import profile applies post-process steps 0x%08x."),
+		       AiPostProcessSteps);
+
+		if (0 != (AiPostProcessSteps & ~NativePostProcessSteps)) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("GLB is imported with assimp, since post-process steps "
+			            "0x%08x are not reproduced by the native loader."),
+			       AiPostProcessSteps & ~NativePostProcessSteps);
+			return false;
+		}
+	}
+
+	// the steps that are not reproduced must not change anything
+	if ((0 != (AiPostProcessSteps & aiProcess_GenSmoothNormals) &&
+	     !bAllSectionsHaveNormals) ||
+	    (0 != (AiPostProcessSteps & aiProcess_CalcTangentSpace) &&
+	     bAnySectionLacksTangents) ||
+	    (0 != (AiPostProcessSteps & aiProcess_FindInvalidData) &&
+	     bAnySectionHasInvalidData)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("GLB needs normals, tangents or invalid data to be "
+		            "fixed, so it is imported with assimp."));
+		return false;
+	}
+
+	// materials in the order assimp's glTF importer reads them, followed by
+	// the default material for primitives without a material
+	TArray<bool> bIsNodeRead;
+	TArray<bool> bIsMeshRead;
+	bIsNodeRead.SetNumZeroed(Asset.Nodes.Num());
+	bIsMeshRead.SetNumZeroed(Asset.Meshes.Num());
+	TArray<int32> GltfMaterialIndexOfAiMaterial;
+	for (const auto& RootNodeIndex : Asset.RootNodeIndices) {
+		CollectGltfMaterialsInAiOrder(Asset, RootNodeIndex, bIsNodeRead,
+		                              bIsMeshRead, GltfMaterialIndexOfAiMaterial);
+	}
+	GltfMaterialIndexOfAiMaterial.Add(INDEX_NONE);
+	const auto& NumAiMaterials = GltfMaterialIndexOfAiMaterial.Num();
+
+	// index of the assimp material of a primitive
+	const auto& GetAiMaterialIndex = [&](const FGltfPrimitive& Primitive) {
+		return INDEX_NONE == Primitive.MaterialIndex
+		           ? NumAiMaterials - 1
+		           : GltfMaterialIndexOfAiMaterial.Find(Primitive.MaterialIndex);
+	};
+
+	// key of the properties of an assimp material
+	const auto& GetAiMaterialKey =
+	    [&](const int32 AiMaterial_i) -> const FString& {
+		const auto& GltfMaterialIndex =
+		    GltfMaterialIndexOfAiMaterial[AiMaterial_i];
+		return INDEX_NONE == GltfMaterialIndex
+		           ? Asset.DefaultMaterialKey
+		           : Asset.Materials[GltfMaterialIndex].Key;
+	};
+
+	// index in MaterialList of each assimp material, and the other way round.
+	// RemoveRedundantMaterials removes the materials no mesh refers to, and
+	// merges the materials with the same properties into the first one.
+	TArray<int32> MaterialIndexOfAiMaterial;
+	TArray<int32> AiMaterialIndexOfMaterial;
+	MaterialIndexOfAiMaterial.Init(INDEX_NONE, NumAiMaterials);
+	if (0 != (AiPostProcessSteps & aiProcess_RemoveRedundantMaterials)) {
+		TArray<bool> bIsAiMaterialReferenced;
+		bIsAiMaterialReferenced.SetNumZeroed(NumAiMaterials);
+		for (const auto& GltfSection : GltfSections) {
+			bIsAiMaterialReferenced[GetAiMaterialIndex(*GltfSection.Primitive)] =
+			    true;
+		}
+
+		for (auto AiMaterial_i = 0; AiMaterial_i < NumAiMaterials;
+		     ++AiMaterial_i) {
+			if (!bIsAiMaterialReferenced[AiMaterial_i]) {
+				continue;
+			}
+
+			auto& MaterialIndex = MaterialIndexOfAiMaterial[AiMaterial_i];
+			for (auto Other_i = 0; Other_i < AiMaterial_i; ++Other_i) {
+				if (bIsAiMaterialReferenced[Other_i] &&
+				    GetAiMaterialKey(Other_i) == GetAiMaterialKey(AiMaterial_i)) {
+					MaterialIndex = MaterialIndexOfAiMaterial[Other_i];
+					break;
+				}
+			}
+			if (INDEX_NONE == MaterialIndex) {
+				MaterialIndex = AiMaterialIndexOfMaterial.Add(AiMaterial_i);
+			}
+		}
+	} else {
+		for (auto AiMaterial_i = 0; AiMaterial_i < NumAiMaterials;
+		     ++AiMaterial_i) {
+			MaterialIndexOfAiMaterial[AiMaterial_i] =
+			    AiMaterialIndexOfMaterial.Add(AiMaterial_i);
+		}
+	}
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("GLB is converted by the native loader, without assimp."));
+
+	// make material list and texture list, as GenerateMaterialList does
+	FAiTextureTable     TextureTable;
+	const FGltfMaterial DefaultGltfMaterial;
+	for (const auto& AiMaterial_i : AiMaterialIndexOfMaterial) {
+		const auto& GltfMaterialIndex = GltfMaterialIndexOfAiMaterial[AiMaterial_i];
+		const auto& GltfMaterial      = INDEX_NONE == GltfMaterialIndex
+		                                    ? DefaultGltfMaterial
+		                                    : Asset.Materials[GltfMaterialIndex];
+		auto&       MaterialData      = MeshData.MaterialList.AddDefaulted_GetRef();
+
+		if (INDEX_NONE == GltfMaterial.BaseColorImageIndex) {
+			MaterialData.ColorStatus = EColorStatus::ColorIsSet;
+			MaterialData.Color       = GltfMaterial.BaseColorFactor;
+		} else {
+			// images are compressed (e.g. PNG), as assimp embeds them
+			const auto& Image = Asset.Images[GltfMaterial.BaseColorImageIndex];
+			MaterialData.ColorStatus  = EColorStatus::TextureIsSet;
+			MaterialData.TextureIndex = AddEmbeddedTexture(
+			    &Image, Image.Data, static_cast<uint32>(Image.Size), 0,
+			    TextureTable);
+		}
+	}
+	MeshData.TextureList = MoveTemp(TextureTable.TextureList);
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("%d materials refer to %d unique embedded textures."),
+	       MeshData.MaterialList.Num(), MeshData.TextureList.Num());
+
+	// set up nodes
+	auto& NodeList = MeshData.NodeList;
+	NodeList.SetNum(NumNodes);
+	TArray<TArray<int32>> NodeIndicesOfSection;
+	NodeIndicesOfSection.SetNum(NumSections);
+	for (auto Node_i = decltype(NumNodes){0}; Node_i < NumNodes; ++Node_i) {
+		const auto& GltfNodeIndex = FlattenedGltfNodes[Node_i].GltfNodeIndex;
+		auto&       Node          = NodeList[Node_i];
+
+		// set index of parent node
+		Node.ParentNodeIndex = FlattenedGltfNodes[Node_i].ParentNodeIndex;
+
+		// name and transform ("ROOT" and identity for the added root node)
+		auto AiTransform = aiMatrix4x4();
+		if (INDEX_NONE == GltfNodeIndex) {
+			Node.Name = TEXT("ROOT");
+		} else {
+			const auto& GltfNode = Asset.Nodes[GltfNodeIndex];
+			Node.Name            = GltfNode.Name;
+			AiTransform          = MakeGltfNodeAiTransform(GltfNode);
+		}
+
+		// post-process as assimp does, and transform the coordinate system of
+		// the root node to the UE coordinate system (glTF has no
+		// UnitScaleFactor)
+		MirrorAiTransformZ(AiTransform);
+		if (0 == Node_i) {
+			AiTransform = GenerateAi_UE_XformMatrix(1.0f) * AiTransform;
+		}
+		Node.RelativeTransform =
+		    static_cast<FTransform>(AiMatrixToUEMatrix(AiTransform));
+
+		// refer to the sections of the primitives of the mesh
+		const auto& MeshIndex =
+		    INDEX_NONE == GltfNodeIndex ? INDEX_NONE
+		                                : Asset.Nodes[GltfNodeIndex].MeshIndex;
+		if (INDEX_NONE == MeshIndex) {
+			continue;
+		}
+		const auto& NumPrimitives = Asset.Meshes[MeshIndex].Primitives.Num();
+		for (auto i = 0; i < NumPrimitives; ++i) {
+			const auto& SectionIndex = FirstSectionIndexOfMesh[MeshIndex] + i;
+			Node.SectionIndices.Add(SectionIndex);
+			NodeIndicesOfSection[SectionIndex].Add(Node_i);
+		}
+	}
+
+	// set up sections and make conversion jobs
+	auto& SectionList = MeshData.SectionList;
+	SectionList.SetNum(NumSections);
+	TArray<EAiVertexAttributes> AttributesOfSection;
+	AttributesOfSection.SetNumUninitialized(NumSections);
+	TArray<FSectionConversionJob> Jobs;
+	for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
+	     ++Section_i) {
+		const auto& GltfSection = GltfSections[Section_i];
+		const auto& Primitive   = *GltfSection.Primitive;
+		auto&       Section     = SectionList[Section_i];
+
+		// set material
+		Section.MaterialIndex =
+		    MaterialIndexOfAiMaterial[GetAiMaterialIndex(Primitive)];
+
+		// get present vertex attributes
+		auto& Attributes = AttributesOfSection[Section_i];
+		Attributes       = EAiVertexAttributes::Vertices;
+		if (Primitive.Normals.IsSet()) {
+			Attributes |= EAiVertexAttributes::Normals;
+		}
+		if (Primitive.TexCoords0.IsSet()) {
+			Attributes |= EAiVertexAttributes::UV0Channel;
+		}
+		if (Primitive.Colors0.IsSet()) {
+			Attributes |= EAiVertexAttributes::VertexColors0;
+		}
+		if (Primitive.Tangents.IsSet()) {
+			Attributes |= EAiVertexAttributes::Tangents;
+		}
+
+		// size streams and add jobs
+		SizeSectionAndAddJobs(Section_i, Attributes, GltfSection.NumVertices,
+		                      GltfSection.NumFaces,
+		                      ImportProfile.bCompactPrecision, Section, Jobs);
+	}
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("%d nodes refer to %d unique sections out of %d meshes."),
+	       NumNodes, NumSections, Asset.Meshes.Num());
+
+	// convert all ranges of all sections concurrently, straight from the GLB,
+	// releasing the vertex order of each section once it is converted
+	RunSectionConversionJobs(
+	    Jobs, NodeIndicesOfSection,
+	    [&](const FSectionConversionJob& Job) {
+		    const auto& GltfSection = GltfSections[Job.SectionIndex];
+		    auto&       Section     = SectionList[Job.SectionIndex];
+
+		    const auto& Attributes = AttributesOfSection[Job.SectionIndex];
+
+		    if (Job.bFaces) {
+			    if (!Section.CompactTriangles.IsEmpty()) {
+				    ConvertGltfFaceRange(GltfSection, Job.Begin, Job.End,
+				                         Section.CompactTriangles);
+			    } else {
+				    ConvertGltfFaceRange(GltfSection, Job.Begin, Job.End,
+				                         Section.Triangles);
+			    }
+		    } else if (ImportProfile.bCompactPrecision) {
+			    ConvertGltfVertexRangeCompact(GltfSection, Attributes, Job.Begin,
+			                                  Job.End, Section);
+		    } else {
+			    ConvertGltfVertexRange(GltfSection, Attributes, Job.Begin,
+			                           Job.End, Section);
+		    }
+	    },
+	    [&](const int32 Section_i) {
+		    GltfSections[Section_i].VertexIndices.Empty();
+		    GltfSections[Section_i].SectionVertexIndices.Empty();
+	    },
+	    LoadOptions, MeshData);
+
+	// process textures (all of them are embedded)
+	FinishTextureList({}, ImportProfile, LoadOptions, /*out*/ MeshData);
+
+	return true;
+}
+
+#pragma region definitions of static functions
+static TArray<TSharedPtr<FJsonValue>> GetArrayField(const FJsonObject& Object,
+                                                     const FString&     Field) {
+	const TArray<TSharedPtr<FJsonValue>>* Array;
+	if (Object.TryGetArrayField(Field, Array)) {
+		return *Array;
+	}
+	return {};
+}
+
+static bool TryGetIndexField(const FJsonObject& Object, const FString& Field,
+                             int32& Value) {
+	double Number;
+	if (!Object.TryGetNumberField(Field, Number) || Number < 0 ||
+	    Number > TNumericLimits<int32>::Max() || Number != FMath::Floor(Number)) {
+		return false;
+	}
+	Value = static_cast<int32>(Number);
+	return true;
+}
+
+static TSharedPtr<FJsonObject> GetExtensionField(const FJsonObject& Object,
+                                                 const FString& Extension) {
+	const TSharedPtr<FJsonObject>* Extensions;
+	const TSharedPtr<FJsonObject>* ExtensionObject;
+	if (Object.TryGetObjectField(TEXT("extensions"), Extensions) &&
+	    (*Extensions)->TryGetObjectField(Extension, ExtensionObject)) {
+		return *ExtensionObject;
+	}
+	return nullptr;
+}
+
+static void ReadFloats(const FJsonValue& Value, const int32 Num,
+                       TArray<float>& Floats) {
+	Floats.Reset();
+
+	const TArray<TSharedPtr<FJsonValue>>* Array;
+	if (!Value.TryGetArray(Array) || Array->Num() != Num) {
+		return;
+	}
+	for (const auto& Element : *Array) {
+		double Number;
+		if (!Element->TryGetNumber(Number)) {
+			Floats.Reset();
+			return;
+		}
+		Floats.Add(static_cast<float>(Number));
+	}
+}
+
+static bool DecodeMeshoptBufferViews(
+    const FGltfDocument& Document, const TArray<TSharedPtr<FJsonValue>>& Meshes,
+    TArray<TArray<uint8>>& DecodedBufferViews) {
+	// buffer views of the attributes and indices of the primitives (others,
+	// e.g. of animations, are not read)
+	TArray<bool> bIsBufferViewRead;
+	bIsBufferViewRead.Init(false, Document.BufferViews.Num());
+	const auto& MarkAccessor = [&](const FJsonValue& Value) {
+		int32 AccessorIndex;
+		int32 BufferViewIndex;
+		if (Value.TryGetNumber(AccessorIndex) &&
+		    Document.Accessors.IsValidIndex(AccessorIndex) &&
+		    Document.Accessors[AccessorIndex]->Type == EJson::Object &&
+		    TryGetIndexField(*Document.Accessors[AccessorIndex]->AsObject(),
+		                     TEXT("bufferView"), BufferViewIndex) &&
+		    bIsBufferViewRead.IsValidIndex(BufferViewIndex)) {
+			bIsBufferViewRead[BufferViewIndex] = true;
+		}
+	};
+	for (const auto& MeshValue : Meshes) {
+		const auto& MeshObject = MeshValue->AsObject();
+		if (!MeshObject.IsValid()) {
+			continue;
+		}
+		for (const auto& PrimitiveValue :
+		     GetArrayField(*MeshObject, TEXT("primitives"))) {
+			const auto& PrimitiveObject = PrimitiveValue->AsObject();
+			const TSharedPtr<FJsonObject>* Attributes;
+			if (!PrimitiveObject.IsValid()) {
+				continue;
+			}
+			if (PrimitiveObject->TryGetObjectField(TEXT("attributes"),
+			                                       Attributes)) {
+				for (const auto& Attribute : (*Attributes)->Values) {
+					MarkAccessor(*Attribute.Value);
+				}
+			}
+			if (const auto& Indices =
+			        PrimitiveObject->TryGetField(TEXT("indices"))) {
+				MarkAccessor(*Indices);
+			}
+		}
+	}
+
+	// compressed buffer views among them
+	TArray<FMeshoptBufferView> MeshoptBufferViews;
+	for (auto BufferView_i = 0; BufferView_i < Document.BufferViews.Num();
+	     ++BufferView_i) {
+		const auto& Object = Document.BufferViews[BufferView_i]->AsObject();
+		if (!bIsBufferViewRead[BufferView_i] || !Object.IsValid()) {
+			continue;
+		}
+		if (const auto& Extension =
+		        GetExtensionField(*Object, TEXT("EXT_meshopt_compression"))) {
+			if (!ReadMeshoptBufferView(Document, BufferView_i, *Extension,
+			                           MeshoptBufferViews.AddDefaulted_GetRef())) {
+				return false;
+			}
+		}
+	}
+	if (MeshoptBufferViews.IsEmpty()) {
+		return true;
+	}
+
+	// decode each of them on a worker
+	DecodedBufferViews.SetNum(Document.BufferViews.Num());
+	TArray<bool> bIsDecoded;
+	bIsDecoded.Init(false, MeshoptBufferViews.Num());
+	ParallelFor(MeshoptBufferViews.Num(), [&](const int32 i) {
+		const auto& BufferView = MeshoptBufferViews[i];
+		auto&       Decoded = DecodedBufferViews[BufferView.BufferViewIndex];
+
+		// bytes after the elements (if any) are zero
+		const auto& DecodedSize = int64{BufferView.Count} * BufferView.ByteStride;
+		Decoded.SetNumUninitialized(BufferView.ByteLength);
+		FMemory::Memzero(Decoded.GetData() + DecodedSize,
+		                 BufferView.ByteLength - DecodedSize);
+
+		bIsDecoded[i] = DecodeMeshoptData(
+		    BufferView.Data, BufferView.Size, BufferView.Mode, BufferView.Filter,
+		    BufferView.Count, BufferView.ByteStride, Decoded.GetData());
+	});
+
+	return !bIsDecoded.Contains(false);
+}
+
+static bool ReadMeshoptBufferView(const FGltfDocument& Document,
+                                  const int32          BufferViewIndex,
+                                  const FJsonObject&   Extension,
+                                  FMeshoptBufferView&  BufferView) {
+	BufferView.BufferViewIndex = BufferViewIndex;
+
+	// compressed data, which must be in the binary chunk
+	int32 Buffer;
+	int32 ByteOffset = 0;
+	int32 ByteLength;
+	if (!TryGetIndexField(Extension, TEXT("buffer"), Buffer) || 0 != Buffer ||
+	    nullptr == Document.BinData ||
+	    !TryGetIndexField(Extension, TEXT("byteLength"), ByteLength) ||
+	    (Extension.HasField(TEXT("byteOffset")) &&
+	     !TryGetIndexField(Extension, TEXT("byteOffset"), ByteOffset)) ||
+	    int64{ByteOffset} + ByteLength > Document.BinSize) {
+		return false;
+	}
+	BufferView.Data = Document.BinData + ByteOffset;
+	BufferView.Size = ByteLength;
+
+	// mode and filter
+	static const TMap<FString, EMeshoptMode> MeshoptModes = {
+	    {TEXT("ATTRIBUTES"), EMeshoptMode::Attributes},
+	    {TEXT("TRIANGLES"), EMeshoptMode::Triangles},
+	    {TEXT("INDICES"), EMeshoptMode::Indices}};
+	static const TMap<FString, EMeshoptFilter> MeshoptFilters = {
+	    {TEXT("NONE"), EMeshoptFilter::None},
+	    {TEXT("OCTAHEDRAL"), EMeshoptFilter::Octahedral},
+	    {TEXT("QUATERNION"), EMeshoptFilter::Quaternion},
+	    {TEXT("EXPONENTIAL"), EMeshoptFilter::Exponential}};
+	FString Mode;
+	FString Filter = TEXT("NONE");
+	Extension.TryGetStringField(TEXT("mode"), Mode);
+	Extension.TryGetStringField(TEXT("filter"), Filter);
+	const auto& ModeValue   = MeshoptModes.Find(Mode);
+	const auto& FilterValue = MeshoptFilters.Find(Filter);
+	if (nullptr == ModeValue || nullptr == FilterValue) {
+		return false;
+	}
+	BufferView.Mode   = *ModeValue;
+	BufferView.Filter = *FilterValue;
+
+	// elements, which must fit in the buffer view
+	return TryGetIndexField(Extension, TEXT("count"), BufferView.Count) &&
+	       TryGetIndexField(Extension, TEXT("byteStride"),
+	                        BufferView.ByteStride) &&
+	       TryGetIndexField(
+	           *Document.BufferViews[BufferViewIndex]->AsObject(),
+	           TEXT("byteLength"), BufferView.ByteLength) &&
+	       int64{BufferView.Count} * BufferView.ByteStride <=
+	           BufferView.ByteLength;
+}
+
+static bool ResolveAccessor(const FGltfDocument& Document,
+                            const int32          AccessorIndex,
+                            const int32          NumComponents,
+                            FGltfAccessor&       Accessor) {
+	if (!Document.Accessors.IsValidIndex(AccessorIndex)) {
+		return false;
+	}
+	const auto& Object = Document.Accessors[AccessorIndex]->AsObject();
+	if (!Object.IsValid() || Object->HasField(TEXT("sparse"))) {
+		return false;
+	}
+
+	// type
+	static const TMap<FString, int32> NumComponentsOfType = {
+	    {TEXT("SCALAR"), 1}, {TEXT("VEC2"), 2}, {TEXT("VEC3"), 3},
+	    {TEXT("VEC4"), 4},   {TEXT("MAT2"), 4}, {TEXT("MAT3"), 9},
+	    {TEXT("MAT4"), 16}};
+	FString Type;
+	auto    bNormalized = false;
+	Object->TryGetStringField(TEXT("type"), Type);
+	Object->TryGetBoolField(TEXT("normalized"), bNormalized);
+	const auto& NumComponentsOfAccessor = NumComponentsOfType.Find(Type);
+	if (nullptr == NumComponentsOfAccessor ||
+	    *NumComponentsOfAccessor != NumComponents) {
+		return false;
+	}
+	Accessor.NumComponents = NumComponents;
+	Accessor.bNormalized   = bNormalized;
+
+	// component type (unsigned int only for indices, and only 8- and 16-bit
+	// integers normalized)
+	if (!TryGetIndexField(*Object, TEXT("componentType"),
+	                      Accessor.ComponentType)) {
+		return false;
+	}
+	int64 ComponentSize;
+	switch (Accessor.ComponentType) {
+	case GltfByte:
+	case GltfUnsignedByte:
+		ComponentSize = 1;
+		break;
+	case GltfShort:
+	case GltfUnsignedShort:
+		ComponentSize = 2;
+		break;
+	case GltfUnsignedInt:
+		if (1 != NumComponents || bNormalized) {
+			return false;
+		}
+		ComponentSize = sizeof(uint32);
+		break;
+	case GltfFloat:
+		if (bNormalized) {
+			return false;
+		}
+		ComponentSize = sizeof(float);
+		break;
+	default:
+		return false;
+	}
+
+	// count and offset
+	auto ByteOffset = 0;
+	if (!TryGetIndexField(*Object, TEXT("count"), Accessor.Count) ||
+	    (Object->HasField(TEXT("byteOffset")) &&
+	     !TryGetIndexField(*Object, TEXT("byteOffset"), ByteOffset))) {
+		return false;
+	}
+
+	// buffer view
+	int32        BufferViewIndex;
+	const uint8* BufferViewData;
+	int64        ByteLength;
+	int64        ByteStride;
+	if (!TryGetIndexField(*Object, TEXT("bufferView"), BufferViewIndex) ||
+	    !ResolveBufferView(Document, BufferViewIndex, BufferViewData, ByteLength,
+	                       ByteStride)) {
+		return false;
+	}
+	const auto& ElementSize = ComponentSize * NumComponents;
+	Accessor.ByteStride     = 0 == ByteStride ? ElementSize : ByteStride;
+	Accessor.Data           = BufferViewData + ByteOffset;
+
+	// every element must be inside the buffer view, and aligned
+	const auto& End =
+	    Accessor.Count > 0
+	        ? ByteOffset + (Accessor.Count - 1) * Accessor.ByteStride + ElementSize
+	        : ByteOffset;
+	return Accessor.ByteStride >= ElementSize && End <= ByteLength &&
+	       IsAligned(Accessor.Data, ComponentSize) &&
+	       0 == Accessor.ByteStride % ComponentSize;
+}
+
+static bool ResolveBufferView(const FGltfDocument& Document,
+                              const int32 BufferViewIndex, const uint8*& Data,
+                              int64& ByteLength, int64& ByteStride) {
+	if (!Document.BufferViews.IsValidIndex(BufferViewIndex) ||
+	    nullptr == Document.BinData) {
+		return false;
+	}
+	const auto& Object = Document.BufferViews[BufferViewIndex]->AsObject();
+	if (!Object.IsValid()) {
+		return false;
+	}
+
+	int32 Buffer;
+	int32 ByteOffset = 0;
+	int32 Length;
+	int32 Stride = 0;
+	if (!TryGetIndexField(*Object, TEXT("buffer"), Buffer) ||
+	    !TryGetIndexField(*Object, TEXT("byteLength"), Length) ||
+	    (Object->HasField(TEXT("byteOffset")) &&
+	     !TryGetIndexField(*Object, TEXT("byteOffset"), ByteOffset)) ||
+	    (Object->HasField(TEXT("byteStride")) &&
+	     !TryGetIndexField(*Object, TEXT("byteStride"), Stride))) {
+		return false;
+	}
+	ByteLength = Length;
+	ByteStride = Stride;
+
+	// a compressed buffer view is read from its decoded data (its buffer is a
+	// fallback, which is not read)
+	if (GetExtensionField(*Object, TEXT("EXT_meshopt_compression")).IsValid()) {
+		if (!Document.DecodedBufferViews.IsValidIndex(BufferViewIndex) ||
+		    Document.DecodedBufferViews[BufferViewIndex].Num() != Length) {
+			return false;
+		}
+		Data = Document.DecodedBufferViews[BufferViewIndex].GetData();
+		return true;
+	}
+
+	Data = Document.BinData + ByteOffset;
+	return 0 == Buffer && int64{ByteOffset} + Length <= Document.BinSize;
+}
+
+static bool IsAllowedAttributeType(const FString&       Name,
+                                   const FGltfAccessor& Accessor,
+                                   const bool           bIsQuantized) {
+	const auto& ComponentType = Accessor.ComponentType;
+	if (GltfFloat == ComponentType) {
+		return true;
+	}
+	if (!bIsQuantized || GltfUnsignedInt == ComponentType) {
+		return false;
+	}
+
+	// normalized signed integers for unit vectors, normalized unsigned ones
+	// for colors, and any for positions and texture coordinates
+	const auto& bIsSigned =
+	    GltfByte == ComponentType || GltfShort == ComponentType;
+	if (TEXT("NORMAL") == Name || TEXT("TANGENT") == Name) {
+		return bIsSigned && Accessor.bNormalized;
+	}
+	if (TEXT("COLOR_0") == Name) {
+		return !bIsSigned && Accessor.bNormalized;
+	}
+	return true;
+}
+
+static bool ParsePrimitive(const FGltfDocument& Document,
+                           const FJsonObject& Object, FGltfPrimitive& Primitive) {
+	// only triangle lists without extensions (e.g. compression)
+	auto Mode = GltfTriangles;
+	if ((Object.HasField(TEXT("mode")) &&
+	     !TryGetIndexField(Object, TEXT("mode"), Mode)) ||
+	    GltfTriangles != Mode || Object.HasField(TEXT("extensions"))) {
+		return false;
+	}
+
+	// attributes
+	const TSharedPtr<FJsonObject>* Attributes;
+	if (!Object.TryGetObjectField(TEXT("attributes"), Attributes)) {
+		return false;
+	}
+	const auto& TryResolveAttribute = [&](const TCHAR* const Name,
+	                                      const int32        NumComponents,
+	                                      TOptional<FGltfAccessor>& Accessor) {
+		int32 AccessorIndex;
+		if (!(*Attributes)->HasField(Name)) {
+			return true;
+		}
+		if (!TryGetIndexField(**Attributes, Name, AccessorIndex) ||
+		    !ResolveAccessor(Document, AccessorIndex, NumComponents,
+		                     Accessor.Emplace()) ||
+		    !IsAllowedAttributeType(Name, *Accessor, Document.bIsQuantized)) {
+			return false;
+		}
+		return true;
+	};
+
+	TOptional<FGltfAccessor> Positions;
+	if (!(*Attributes)->HasField(TEXT("POSITION")) ||
+	    !TryResolveAttribute(TEXT("POSITION"), 3, Positions) ||
+	    !TryResolveAttribute(TEXT("NORMAL"), 3, Primitive.Normals) ||
+	    !TryResolveAttribute(TEXT("TANGENT"), 4, Primitive.Tangents) ||
+	    !TryResolveAttribute(TEXT("TEXCOORD_0"), 2, Primitive.TexCoords0) ||
+	    !TryResolveAttribute(TEXT("COLOR_0"), 4, Primitive.Colors0)) {
+		return false;
+	}
+	Primitive.Positions = Positions.GetValue();
+
+	// further sets without the first one are rejected by assimp
+	if (((*Attributes)->HasField(TEXT("TEXCOORD_1")) &&
+	     !Primitive.TexCoords0.IsSet()) ||
+	    ((*Attributes)->HasField(TEXT("COLOR_1")) && !Primitive.Colors0.IsSet())) {
+		return false;
+	}
+
+	// assimp ignores attributes whose count differs from POSITION, and tangents
+	// without normals
+	const auto& NumVertices = Primitive.Positions.Count;
+	for (auto* const Accessor :
+	     {&Primitive.Normals, &Primitive.Tangents, &Primitive.TexCoords0,
+	      &Primitive.Colors0}) {
+		if (Accessor->IsSet() && (*Accessor)->Count != NumVertices) {
+			Accessor->Reset();
+		}
+	}
+	if (!Primitive.Normals.IsSet()) {
+		Primitive.Tangents.Reset();
+	}
+
+	// indices
+	int32 IndicesIndex;
+	if (TryGetIndexField(Object, TEXT("indices"), IndicesIndex) &&
+	    (!ResolveAccessor(Document, IndicesIndex, 1, Primitive.Indices.Emplace()) ||
+	     (GltfUnsignedByte != Primitive.Indices->ComponentType &&
+	      GltfUnsignedShort != Primitive.Indices->ComponentType &&
+	      GltfUnsignedInt != Primitive.Indices->ComponentType) ||
+	     Primitive.Indices->bNormalized)) {
+		return false;
+	}
+
+	// material
+	if (Object.HasField(TEXT("material")) &&
+	    !TryGetIndexField(Object, TEXT("material"), Primitive.MaterialIndex)) {
+		return false;
+	}
+
+	return true;
+}
+
+static bool ParseMaterial(const FGltfDocument& Document,
+                          const FJsonObject& Object, FGltfMaterial& Material) {
+	// copy the material to make it canonical (without the name, which is not
+	// compared by assimp)
+	const auto& Canonical = MakeShared<FJsonObject>(Object);
+	Canonical->RemoveField(TEXT("name"));
+
+	// base color factor and texture
+	const TSharedPtr<FJsonObject>* Pbr;
+	if (Canonical->TryGetObjectField(TEXT("pbrMetallicRoughness"), Pbr)) {
+		// copy the nested object, too
+		const auto& PbrCopy = MakeShared<FJsonObject>(**Pbr);
+		Canonical->SetObjectField(TEXT("pbrMetallicRoughness"), PbrCopy);
+
+		TArray<float> BaseColorFactor;
+		if (const auto& Value = PbrCopy->TryGetField(TEXT("baseColorFactor"))) {
+			ReadFloats(*Value, 4, BaseColorFactor);
+		}
+		if (!BaseColorFactor.IsEmpty()) {
+			Material.BaseColorFactor =
+			    FLinearColor(BaseColorFactor[0], BaseColorFactor[1],
+			                 BaseColorFactor[2], BaseColorFactor[3]);
+		}
+
+		for (const auto& Field :
+		     {TEXT("baseColorTexture"), TEXT("metallicRoughnessTexture")}) {
+			const TSharedPtr<FJsonObject>* TextureInfo;
+			if (PbrCopy->TryGetObjectField(Field, TextureInfo)) {
+				const auto& TextureInfoCopy = MakeShared<FJsonObject>(**TextureInfo);
+				PbrCopy->SetObjectField(Field, TextureInfoCopy);
+
+				auto TextureIndex = INDEX_NONE;
+				TryGetIndexField(*TextureInfoCopy, TEXT("index"), TextureIndex);
+				if (!CanonicalizeTextureInfo(Document, *TextureInfoCopy)) {
+					return false;
+				}
+
+				// base color image (only images in the binary chunk are
+				// supported)
+				int32 ImageIndex;
+				if (FCString::Strcmp(Field, TEXT("baseColorTexture")) == 0 &&
+				    INDEX_NONE != TextureIndex &&
+				    TryGetIndexField(*Document.Textures[TextureIndex]->AsObject(),
+				                     TEXT("source"), ImageIndex)) {
+					const auto& Image = Document.Images.IsValidIndex(ImageIndex)
+					                        ? Document.Images[ImageIndex]->AsObject()
+					                        : nullptr;
+					if (!Image.IsValid() || !Image->HasField(TEXT("bufferView"))) {
+						return false;
+					}
+					Material.BaseColorImageIndex = ImageIndex;
+				}
+			}
+		}
+
+		RemoveDefaultField(*PbrCopy, TEXT("baseColorFactor"), TEXT("[1,1,1,1]"));
+		RemoveDefaultField(*PbrCopy, TEXT("metallicFactor"), TEXT("1"));
+		RemoveDefaultField(*PbrCopy, TEXT("roughnessFactor"), TEXT("1"));
+		if (PbrCopy->Values.IsEmpty()) {
+			Canonical->RemoveField(TEXT("pbrMetallicRoughness"));
+		}
+	}
+
+	// other textures
+	for (const auto& Field : {TEXT("normalTexture"), TEXT("occlusionTexture"),
+	                          TEXT("emissiveTexture")}) {
+		const TSharedPtr<FJsonObject>* TextureInfo;
+		if (Canonical->TryGetObjectField(Field, TextureInfo)) {
+			const auto& TextureInfoCopy = MakeShared<FJsonObject>(**TextureInfo);
+			Canonical->SetObjectField(Field, TextureInfoCopy);
+			if (!CanonicalizeTextureInfo(Document, *TextureInfoCopy)) {
+				return false;
+			}
+			RemoveDefaultField(*TextureInfoCopy, TEXT("scale"), TEXT("1"));
+			RemoveDefaultField(*TextureInfoCopy, TEXT("strength"), TEXT("1"));
+		}
+	}
+
+	// other factors
+	RemoveDefaultField(*Canonical, TEXT("emissiveFactor"), TEXT("[0,0,0]"));
+	RemoveDefaultField(*Canonical, TEXT("alphaMode"), TEXT("\"OPAQUE\""));
+	RemoveDefaultField(*Canonical, TEXT("alphaCutoff"), TEXT("0.5"));
+	RemoveDefaultField(*Canonical, TEXT("doubleSided"), TEXT("false"));
+
+	// make key
+	AppendCanonicalJson(FJsonValueObject(Canonical), Material.Key);
+
+	return true;
+}
+
+static bool CanonicalizeTextureInfo(const FGltfDocument& Document,
+                                    FJsonObject&         TextureInfo) {
+	// replace the texture index with the source and sampler of the texture
+	int32 TextureIndex;
+	if (TryGetIndexField(TextureInfo, TEXT("index"), TextureIndex)) {
+		if (!Document.Textures.IsValidIndex(TextureIndex)) {
+			return false;
+		}
+		const auto& Texture = Document.Textures[TextureIndex]->AsObject();
+		if (!Texture.IsValid() || Texture->HasField(TEXT("extensions"))) {
+			return false;
+		}
+		TextureInfo.RemoveField(TEXT("index"));
+		for (const auto& Field : {TEXT("source"), TEXT("sampler")}) {
+			if (const auto& Value = Texture->TryGetField(Field)) {
+				TextureInfo.SetField(Field, Value);
+			}
+		}
+	}
+
+	RemoveDefaultField(TextureInfo, TEXT("texCoord"), TEXT("0"));
+
+	return true;
+}
+
+static void RemoveDefaultField(FJsonObject& Object, const FString& Field,
+                               const FString& DefaultValue) {
+	if (const auto& Value = Object.TryGetField(Field)) {
+		FString CanonicalValue;
+		AppendCanonicalJson(*Value, CanonicalValue);
+		if (CanonicalValue == DefaultValue) {
+			Object.RemoveField(Field);
+		}
+	}
+}
+
+static void AppendCanonicalJson(const FJsonValue& Value, FString& Out) {
+	switch (Value.Type) {
+	case EJson::Object: {
+		const auto& Object = Value.AsObject();
+		TArray<FString> Fields;
+		Object->Values.GetKeys(Fields);
+		Fields.Sort();
+
+		Out += TEXT('{');
+		for (const auto& Field : Fields) {
+			if (Out[Out.Len() - 1] != TEXT('{')) {
+				Out += TEXT(',');
+			}
+			Out += FString::Printf(TEXT("\"%s\":"), *Field.ReplaceCharWithEscapedChar());
+			AppendCanonicalJson(*Object->Values[Field], Out);
+		}
+		Out += TEXT('}');
+		break;
+	}
+	case EJson::Array: {
+		Out += TEXT('[');
+		const auto& Array = Value.AsArray();
+		for (auto i = 0; i < Array.Num(); ++i) {
+			if (i > 0) {
+				Out += TEXT(',');
+			}
+			AppendCanonicalJson(*Array[i], Out);
+		}
+		Out += TEXT(']');
+		break;
+	}
+	case EJson::Number:
+		Out += FString::Printf(TEXT("%.9g"), static_cast<float>(Value.AsNumber()));
+		break;
+	case EJson::String:
+		Out += FString::Printf(TEXT("\"%s\""),
+		                       *Value.AsString().ReplaceCharWithEscapedChar());
+		break;
+	case EJson::Boolean:
+		Out += Value.AsBool() ? TEXT("true") : TEXT("false");
+		break;
+	default:
+		Out += TEXT("null");
+		break;
+	}
+}
+
+static bool VisitNodes(const TArray<FGltfNode>& Nodes, const int32 NodeIndex,
+                       TArray<uint8>& States) {
+	auto& State = States[NodeIndex];
+	if (1 == State) {
+		return false;
+	}
+	if (2 == State) {
+		return true;
+	}
+
+	State = 1;
+	for (const auto& ChildIndex : Nodes[NodeIndex].Children) {
+		if (!VisitNodes(Nodes, ChildIndex, States)) {
+			return false;
+		}
+	}
+	States[NodeIndex] = 2;
+
+	return true;
+}
+
+static uint32 ReadUInt32(const uint8* const Data) {
+	return static_cast<uint32>(Data[0]) | static_cast<uint32>(Data[1]) << 8 |
+	       static_cast<uint32>(Data[2]) << 16 |
+	       static_cast<uint32>(Data[3]) << 24;
+}
+
+static void CollectGltfMaterialsInAiOrder(const FGltfAsset& Asset,
+                                          const int32       NodeIndex,
+                                          TArray<bool>&     bIsNodeRead,
+                                          TArray<bool>&     bIsMeshRead,
+                                          TArray<int32>&    MaterialIndices) {
+	// each node is read once
+	if (bIsNodeRead[NodeIndex]) {
+		return;
+	}
+	bIsNodeRead[NodeIndex] = true;
+
+	// children first
+	const auto& Node = Asset.Nodes[NodeIndex];
+	for (const auto& ChildIndex : Node.Children) {
+		CollectGltfMaterialsInAiOrder(Asset, ChildIndex, bIsNodeRead, bIsMeshRead,
+		                              MaterialIndices);
+	}
+
+	// then the mesh, once
+	if (INDEX_NONE == Node.MeshIndex || bIsMeshRead[Node.MeshIndex]) {
+		return;
+	}
+	bIsMeshRead[Node.MeshIndex] = true;
+	for (const auto& Primitive : Asset.Meshes[Node.MeshIndex].Primitives) {
+		if (INDEX_NONE != Primitive.MaterialIndex) {
+			MaterialIndices.AddUnique(Primitive.MaterialIndex);
+		}
+	}
+}
+
+static TArray<FGltfNodeWithParentIndex> FlattenGltfNodeTree(const FGltfAsset& Asset) {
+	// flattened nodes
+	TArray<FGltfNodeWithParentIndex> FlattenedGltfNodes;
+
+	// nodes waiting to be visited
+	TArray<FGltfNodeWithParentIndex> GltfNodeStack;
+
+	// a single root node is the root, and multiple (or no) root nodes get a
+	// "ROOT" node as their parent
+	const auto& RootNodeIndices = Asset.RootNodeIndices;
+	if (1 == RootNodeIndices.Num()) {
+		GltfNodeStack.Push({RootNodeIndices[0], -1});
+	} else {
+		FlattenedGltfNodes.Add({INDEX_NONE, -1});
+		for (auto i = RootNodeIndices.Num(); i > 0; --i) {
+			GltfNodeStack.Push({RootNodeIndices[i - 1], 0});
+		}
+	}
+
+	// visit in pre-order depth-first. A node referred to by multiple parents
+	// is visited under each of them, as assimp copies it.
+	while (!GltfNodeStack.IsEmpty()) {
+		// visit next node
+		const auto GltfNodeWithParentIndex = GltfNodeStack.Pop(EAllowShrinking::No);
+		const auto NodeIndex = FlattenedGltfNodes.Add(GltfNodeWithParentIndex);
+
+		// push children in reverse order so that the first child is visited first
+		const auto& Children =
+		    Asset.Nodes[GltfNodeWithParentIndex.GltfNodeIndex].Children;
+		for (auto i = Children.Num(); i > 0; --i) {
+			GltfNodeStack.Push({Children[i - 1], NodeIndex});
+		}
+	}
+
+	return FlattenedGltfNodes;
+}
+
+static aiMatrix4x4 MakeGltfNodeAiTransform(const FGltfNode& Node) {
+	// matrix (column-major)
+	if (!Node.Matrix.IsEmpty()) {
+		const auto& M = Node.Matrix;
+		return aiMatrix4x4(M[0], M[4], M[8], M[12], M[1], M[5], M[9], M[13],
+		                   M[2], M[6], M[10], M[14], M[3], M[7], M[11], M[15]);
+	}
+
+	// translation, rotation and scale, multiplied in the same order as
+	// assimp does so that the result is identical
+	aiMatrix4x4 AiTransform;
+	if (!Node.Translation.IsEmpty()) {
+		const auto& T = Node.Translation;
+		aiMatrix4x4 AiTranslation;
+		aiMatrix4x4::Translation(aiVector3D(T[0], T[1], T[2]), AiTranslation);
+		AiTransform = AiTransform * AiTranslation;
+	}
+	if (!Node.Rotation.IsEmpty()) {
+		// glTF stores x, y, z, w, and aiQuaternion takes w, x, y, z
+		const auto& R = Node.Rotation;
+		AiTransform   = AiTransform *
+		              aiMatrix4x4(aiQuaternion(R[3], R[0], R[1], R[2]).GetMatrix());
+	}
+	if (!Node.Scale.IsEmpty()) {
+		const auto& S = Node.Scale;
+		aiMatrix4x4 AiScaling;
+		aiMatrix4x4::Scaling(aiVector3D(S[0], S[1], S[2]), AiScaling);
+		AiTransform = AiTransform * AiScaling;
+	}
+
+	return AiTransform;
+}
+
+static void PrepareGltfSection(const bool             bFindInvalidData,
+                               FGltfPrimitiveSection& GltfSection) {
+	const auto& Primitive      = *GltfSection.Primitive;
+	const auto& NumAllVertices = Primitive.Positions.Count;
+
+	if (Primitive.Indices.IsSet()) {
+		// indices must be in range and make whole triangles
+		const auto& Indices = Primitive.Indices.GetValue();
+		if (0 == Indices.Count || 0 != Indices.Count % 3) {
+			return;
+		}
+
+		// order the vertices in the order the indices first use them
+		auto& VertexIndices        = GltfSection.VertexIndices;
+		auto& SectionVertexIndices = GltfSection.SectionVertexIndices;
+		SectionVertexIndices.Init(MAX_uint32, NumAllVertices);
+		VertexIndices.Reserve(NumAllVertices);
+		auto bIsIdentity = true;
+		for (auto i = int64{0}; i < Indices.Count; ++i) {
+			const auto& Index = Indices.GetIndex(i);
+			if (Index >= static_cast<uint32>(NumAllVertices)) {
+				return;
+			}
+
+			auto& SectionVertexIndex = SectionVertexIndices[Index];
+			if (MAX_uint32 == SectionVertexIndex) {
+				SectionVertexIndex = VertexIndices.Add(Index);
+				bIsIdentity &= Index == SectionVertexIndex;
+			}
+		}
+		GltfSection.NumVertices = VertexIndices.Num();
+		GltfSection.NumFaces    = Indices.Count / 3;
+
+		// the vertex order is not needed if it is the same
+		if (bIsIdentity) {
+			VertexIndices.Empty();
+			SectionVertexIndices.Empty();
+		}
+	} else {
+		// vertices must make whole triangles
+		if (0 == NumAllVertices || 0 != NumAllVertices % 3) {
+			return;
+		}
+		GltfSection.NumVertices = NumAllVertices;
+		GltfSection.NumFaces    = NumAllVertices / 3;
+	}
+	GltfSection.bIsSupported = true;
+
+	if (bFindInvalidData) {
+		GltfSection.bHasInvalidData = HasInvalidGltfData(GltfSection);
+	}
+}
+
+static bool HasInvalidGltfData(const FGltfPrimitiveSection& GltfSection) {
+	const auto& Primitive   = *GltfSection.Primitive;
+	const auto& NumVertices = GltfSection.NumVertices;
+
+	// check the vectors of all vertices as FindInvalidData does
+	const auto& IsInvalid = [&](const auto& GetVector, const bool bMayBeIdentical,
+	                            const bool bMayBeZero) {
+		const FVector3f First = GetVector(GltfSection.GetVertexIndex(0));
+		auto bAreAllIdentical = true;
+		for (auto i = 0; i < NumVertices; ++i) {
+			const FVector3f Vector = GetVector(GltfSection.GetVertexIndex(i));
+			if (!FMath::IsFinite(Vector.X) || !FMath::IsFinite(Vector.Y) ||
+			    !FMath::IsFinite(Vector.Z)) {
+				return true;
+			}
+			if (!bMayBeZero && 0.0f == Vector.X && 0.0f == Vector.Y &&
+			    0.0f == Vector.Z) {
+				return true;
+			}
+			bAreAllIdentical &= Vector == First;
+		}
+		return !bMayBeIdentical && NumVertices > 1 && bAreAllIdentical;
+	};
+	const auto& GetVec3 = [](const FGltfAccessor& Accessor) {
+		return [&Accessor](const uint32 Index) {
+			const auto& V = Accessor.GetFloats(Index);
+			return FVector3f(V[0], V[1], V[2]);
+		};
+	};
+
+	// positions
+	if (IsInvalid(GetVec3(Primitive.Positions), false, true)) {
+		return true;
+	}
+
+	// UVs, as assimp's glTF importer stores them (V flipped, before FlipUVs)
+	if (Primitive.TexCoords0.IsSet() &&
+	    IsInvalid(
+	        [&TexCoords0 = Primitive.TexCoords0.GetValue()](const uint32 Index) {
+		        const auto& UV = TexCoords0.GetFloats(Index);
+		        return FVector3f(UV[0], 1.0f - UV[1], 0.0f);
+	        },
+	        false, true)) {
+		return true;
+	}
+
+	// normals (may be identical, but not zero)
+	if (Primitive.Normals.IsSet() &&
+	    IsInvalid(GetVec3(Primitive.Normals.GetValue()), true, false)) {
+		return true;
+	}
+
+	// tangents, and bitangents as assimp's glTF importer calculates them
+	if (Primitive.Tangents.IsSet()) {
+		const auto& Normals  = Primitive.Normals.GetValue();
+		const auto& Tangents = Primitive.Tangents.GetValue();
+		if (IsInvalid(GetVec3(Tangents), false, true) ||
+		    IsInvalid(
+		        [&Normals, &Tangents](const uint32 Index) {
+			        const auto& N = Normals.GetFloats(Index);
+			        const auto& T = Tangents.GetFloats(Index);
+			        const auto& Bitangent = (aiVector3D(N[0], N[1], N[2]) ^
+			                                 aiVector3D(T[0], T[1], T[2])) *
+			                                T[3];
+			        return FVector3f(Bitangent.x, Bitangent.y, Bitangent.z);
+		        },
+		        false, true)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void ConvertGltfVertexRange(const FGltfPrimitiveSection& GltfSection,
+                                   const EAiVertexAttributes    Attributes,
+                                   const int32 Begin, const int32 End,
+                                   FLoadedMeshSectionData& Section) {
+	const auto& Primitive = *GltfSection.Primitive;
+
+	// vertices (Z is negated by MakeLeftHanded)
+	for (auto i = Begin; i < End; ++i) {
+		const auto& Vertex =
+		    Primitive.Positions.GetFloats(GltfSection.GetVertexIndex(i));
+		Section.Vertices[i] = FVector(Vertex[0], Vertex[1], -Vertex[2]);
+	}
+
+	// normals
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Normal =
+			    Primitive.Normals->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.Normals[i] = FVector(Normal[0], Normal[1], -Normal[2]);
+		}
+	}
+
+	// UV channel
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::UV0Channel)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& UV0 =
+			    Primitive.TexCoords0->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.UV0Channel[i] = FVector2D(UV0[0], FlipBackAiV(UV0[1]));
+		}
+	}
+
+	// vertex colors
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Color =
+			    Primitive.Colors0->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.VertexColors0[i] =
+			    FLinearColor(Color[0], Color[1], Color[2], Color[3]);
+		}
+	}
+
+	// tangents
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Tangents)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Tangent =
+			    Primitive.Tangents->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.Tangents[i] = {Tangent[0], Tangent[1], -Tangent[2]};
+		}
+	}
+}
+
+static void ConvertGltfVertexRangeCompact(const FGltfPrimitiveSection& GltfSection,
+                                          const EAiVertexAttributes Attributes,
+                                          const int32 Begin, const int32 End,
+                                          FLoadedMeshSectionData& Section) {
+	const auto& Primitive = *GltfSection.Primitive;
+
+	// vertices (Z is negated by MakeLeftHanded)
+	for (auto i = Begin; i < End; ++i) {
+		const auto& Vertex =
+		    Primitive.Positions.GetFloats(GltfSection.GetVertexIndex(i));
+		Section.CompactVertices[i] = FVector3f(Vertex[0], Vertex[1], -Vertex[2]);
+	}
+
+	// normals
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Normal =
+			    Primitive.Normals->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.CompactNormals[i] =
+			    EncodeOctahedral(Normal[0], Normal[1], -Normal[2]);
+		}
+	}
+
+	// UV channel
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::UV0Channel)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& UV0 =
+			    Primitive.TexCoords0->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.CompactUV0Channel[i] =
+			    FVector2DHalf(UV0[0], FlipBackAiV(UV0[1]));
+		}
+	}
+
+	// vertex colors (without sRGB conversion, same as the full precision path)
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Color =
+			    Primitive.Colors0->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.CompactVertexColors0[i] =
+			    FLinearColor(Color[0], Color[1], Color[2], Color[3])
+			        .ToFColor(false);
+		}
+	}
+
+	// tangents
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Tangents)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Tangent =
+			    Primitive.Tangents->GetFloats(GltfSection.GetVertexIndex(i));
+			Section.CompactTangents[i] =
+			    EncodeOctahedral(Tangent[0], Tangent[1], -Tangent[2]);
+		}
+	}
+}
+
+template <typename IndexT>
+static void ConvertGltfFaceRange(const FGltfPrimitiveSection& GltfSection,
+                                 const int32 Begin, const int32 End,
+                                 TArray<IndexT>& Triangles) {
+	const auto& Indices              = GltfSection.Primitive->Indices;
+	const auto& SectionVertexIndices = GltfSection.SectionVertexIndices;
+
+	for (auto i = 3 * int64{Begin}; i < 3 * int64{End}; ++i) {
+		// index in the primitive (consecutive vertices if not indexed)
+		auto Index = Indices.IsSet() ? Indices->GetIndex(i)
+		                             : static_cast<uint32>(i);
+
+		// index in the section
+		if (!SectionVertexIndices.IsEmpty()) {
+			Index = SectionVertexIndices[Index];
+		}
+
+		Triangles[i] = static_cast<IndexT>(Index);
+	}
+}
+
+static float FlipBackAiV(const float V) {
+	// keep the compiler from folding 1 - (1 - V) into V
+	const volatile auto ImportedV = 1.0f - V;
+	return 1.0f - ImportedV;
+}
+#pragma endregion
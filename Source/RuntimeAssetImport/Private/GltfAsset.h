@@ -0,0 +1,243 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetImportProfile;
+struct FLoadedMeshData;
+struct FLoadOptions;
+
+/**
+ * View of the elements of a glTF accessor, in the binary chunk of a GLB or in
+ * a buffer view decoded from it. Its layout has been validated: every element
+ * is inside the buffer view, and aligned to the size of its components.
+ */
+struct FGltfAccessor {
+	// first element
+	const uint8* Data = nullptr;
+
+	// bytes from the start of one element to the next
+	int64 ByteStride = 0;
+
+	// number of elements
+	int32 Count = 0;
+
+	// component type (5120: byte, 5121: unsigned byte, 5122: short,
+	// 5123: unsigned short, 5125: unsigned int, 5126: float)
+	int32 ComponentType = 0;
+
+	// number of components of each element (1 for SCALAR, 2 for VEC2, ...)
+	int32 NumComponents = 0;
+
+	// whether integer components are normalized to [0, 1] or [-1, 1]
+	bool bNormalized = false;
+
+public:
+	/**
+	 * Get the components of an element of a float accessor, or of an integer
+	 * accessor dequantized as glTF specifies (KHR_mesh_quantization).
+	 * @param   Index   index of the element
+	 * @return  the components. Those beyond NumComponents are 0.
+	 */
+	FVector4f GetFloats(const int64 Index) const {
+		FVector4f Floats(0.0f, 0.0f, 0.0f, 0.0f);
+		if (5126 == ComponentType) {
+			FMemory::Memcpy(&Floats, Data + Index * ByteStride,
+			                NumComponents * sizeof(float));
+		} else {
+			Dequantize(Index, Floats);
+		}
+		return Floats;
+	}
+
+	/**
+	 * Get an element of a SCALAR accessor of unsigned integers (indices).
+	 * @param   Index   index of the element
+	 * @return  the element
+	 */
+	uint32 GetIndex(int64 Index) const;
+
+private:
+	/**
+	 * Convert the components of an element of an integer accessor to floats.
+	 * @param        Index    index of the element
+	 * @param[out]   Floats   the components
+	 */
+	void Dequantize(int64 Index, FVector4f& Floats) const;
+};
+
+/**
+ * Primitive of a glTF mesh, with the attributes read by assimp's glTF
+ * importer. An attribute whose number of elements differs from POSITION is
+ * unset, since assimp ignores it, and so are tangents without normals.
+ * Attributes are float, or of the integer types KHR_mesh_quantization allows
+ * if the asset uses it.
+ */
+struct FGltfPrimitive {
+	// POSITION (VEC3)
+	FGltfAccessor Positions;
+
+	// NORMAL (VEC3)
+	TOptional<FGltfAccessor> Normals;
+
+	// TANGENT (VEC4)
+	TOptional<FGltfAccessor> Tangents;
+
+	// TEXCOORD_0 (VEC2)
+	TOptional<FGltfAccessor> TexCoords0;
+
+	// COLOR_0 (VEC4)
+	TOptional<FGltfAccessor> Colors0;
+
+	// indices (unsigned integer SCALAR), unset if not indexed
+	TOptional<FGltfAccessor> Indices;
+
+	// index of the material, INDEX_NONE for the default material
+	int32 MaterialIndex = INDEX_NONE;
+};
+
+/**
+ * glTF mesh.
+ */
+struct FGltfMesh {
+	// primitives, each of which becomes one assimp mesh
+	TArray<FGltfPrimitive> Primitives;
+};
+
+/**
+ * glTF node. The components of its transform are empty if absent.
+ */
+struct FGltfNode {
+	// name, or the id assimp names unnamed nodes with ("nodes[<index>]")
+	FString Name;
+
+	// column-major 4x4 matrix (16 floats)
+	TArray<float> Matrix;
+
+	// translation (3 floats), used if Matrix is empty
+	TArray<float> Translation;
+
+	// rotation quaternion x, y, z, w (4 floats), used if Matrix is empty
+	TArray<float> Rotation;
+
+	// scale (3 floats), used if Matrix is empty
+	TArray<float> Scale;
+
+	// indices of the child nodes
+	TArray<int32> Children;
+
+	// index of the mesh, INDEX_NONE if none
+	int32 MeshIndex = INDEX_NONE;
+};
+
+/**
+ * glTF material, as far as it matters for the loaded mesh data.
+ */
+struct FGltfMaterial {
+	// canonical form of the properties assimp imports (all but the name, and
+	// with default values omitted), equal for materials that assimp's
+	// RemoveRedundantMaterials step merges
+	FString Key;
+
+	// pbrMetallicRoughness.baseColorFactor
+	FLinearColor BaseColorFactor = FLinearColor::White;
+
+	// index of the image of pbrMetallicRoughness.baseColorTexture, INDEX_NONE
+	// if none
+	int32 BaseColorImageIndex = INDEX_NONE;
+};
+
+/**
+ * glTF image embedded in the binary chunk of a GLB.
+ */
+struct FGltfImage {
+	// encoded image (e.g. PNG)
+	const uint8* Data = nullptr;
+
+	// size of Data in bytes
+	int64 Size = 0;
+};
+
+/**
+ * Parsed GLB (binary glTF 2.0) asset, whose accessors and images refer to its
+ * binary chunk without being copied, or to the buffer views decoded from it.
+ * Only assets that the native loader converts exactly as assimp does, or that
+ * assimp cannot decode, are accepted: every buffer is the binary chunk (or a
+ * fallback of EXT_meshopt_compression, which is not read), every primitive is
+ * a list of triangles with float or quantized (KHR_mesh_quantization)
+ * attributes, every image is embedded, and no other extension that changes
+ * geometry or materials (Draco compression, texture transforms, ...) is used.
+ */
+struct FGltfAsset {
+	// root nodes of the default scene
+	TArray<int32> RootNodeIndices;
+
+	// all nodes
+	TArray<FGltfNode> Nodes;
+
+	// all meshes
+	TArray<FGltfMesh> Meshes;
+
+	// all materials
+	TArray<FGltfMaterial> Materials;
+
+	// key of the default material, which assimp adds after all materials for
+	// primitives without a material
+	FString DefaultMaterialKey;
+
+	// all images
+	TArray<FGltfImage> Images;
+
+	// data of each buffer view compressed with EXT_meshopt_compression that
+	// the primitives read, decoded (empty for the other buffer views)
+	TArray<TArray<uint8>> DecodedBufferViews;
+};
+
+/**
+ * Whether data starts with the header of a GLB (binary glTF 2.0).
+ * @param   Data   data
+ * @param   Size   size of Data in bytes
+ */
+bool HasGlbSignature(const uint8* Data, int64 Size);
+
+/**
+ * Read a file if it is a GLB, for files that cannot be memory-mapped. Only the
+ * header is read from other files.
+ * @param        FilePath   path to the file
+ * @param[out]   Data       content of the file, if it is a GLB
+ * @return  whether the file is a GLB and has been read.
+ */
+bool ReadGlbFile(const FString& FilePath, TArray64<uint8>& Data);
+
+/**
+ * Parse a GLB. Buffer views compressed with EXT_meshopt_compression are
+ * decoded concurrently.
+ * @param        Data    content of the GLB. Must outlive Asset.
+ * @param        Size    size of Data in bytes
+ * @param[out]   Asset   parsed asset
+ * @return  whether the GLB is valid and accepted (see FGltfAsset). If not, the
+ *          reason is logged, and the asset should be imported with assimp.
+ */
+bool ParseGlb(const uint8* Data, int64 Size, FGltfAsset& Asset);
+
+/**
+ * Construct mesh data from a GLB natively, without assimp, if the result is
+ * identical to what assimp makes of it: the asset is accepted by ParseGlb, and
+ * the post-process steps of the import profile are either reproduced
+ * (Triangulate, MakeLeftHanded, FlipUVs and RemoveRedundantMaterials) or
+ * would not change anything. Otherwise, MeshData is left untouched so that the
+ * asset is imported with assimp.
+ * @param        Data            content of the GLB
+ * @param        Size            size of Data in bytes
+ * @param        ImportProfile   which post-process steps to apply
+ * @param        LoadOptions     progressive delivery and cancellation of the
+ *                               load. If canceled, the returned mesh data is
+ *                               incomplete and must be discarded.
+ * @param[out]   MeshData        constructed mesh data
+ * @return  whether the mesh data has been constructed
+ */
+bool TryConstructMeshDataFromGlb(const uint8* Data, int64 Size,
+                                 const FAssetImportProfile& ImportProfile,
+                                 const FLoadOptions&        LoadOptions,
+                                 FLoadedMeshData&           MeshData);
@@ -0,0 +1,194 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LoadMeshFromAssetAsyncAction.h"
+
+#include "AssetLoader.h"
+#include "MeshDataMemoryCache.h"
+
+#pragma region forward declarations of static functions
+/**
+ * Broadcast the result of the load task to the output pins on the game thread
+ * and mark the action as ready to destroy.
+ * @tparam  AsyncActionT   ULoadMeshFromAssetFileAsyncAction or
+ *                         ULoadMeshFromAssetDataAsyncAction
+ * @param   AsyncAction    the async action that started LoadTask.
+ * @param   LoadTask       task returned by UAssetLoader::Load*Async.
+ */
+template <typename AsyncActionT>
+static void BroadcastOnGameThreadWhenCompleted(
+    AsyncActionT&                                        AsyncAction,
+    const UE::Tasks::TTask<TOptional<FLoadedMeshData>>& LoadTask);
+
+/**
+ * Make a callback for progressive loads that broadcasts each node to the
+ * OnNodeLoaded pin on the game thread.
+ * @tparam  AsyncActionT   ULoadMeshFromAssetFileAsyncAction or
+ *                         ULoadMeshFromAssetDataAsyncAction
+ * @param   AsyncAction    the async action starting the load.
+ * @return  the callback, or unset if nothing is bound to OnNodeLoaded.
+ */
+template <typename AsyncActionT>
+static FOnLoadedMeshNode MakeBroadcastNodeOnGameThread(AsyncActionT& AsyncAction);
+#pragma endregion
+
+ULoadMeshFromAssetFileAsyncAction*
+    ULoadMeshFromAssetFileAsyncAction::LoadMeshFromAssetFileAsync(
+        UObject* const WorldContextObject, const FString& FilePath,
+        const FAssetImportProfile& ImportProfile) {
+	// create action
+	const auto& Action    = NewObject<ULoadMeshFromAssetFileAsyncAction>();
+	Action->FilePath      = FilePath;
+	Action->ImportProfile = ImportProfile;
+	Action->CancellationToken =
+	    MakeShared<FAssetImportCancellationToken, ESPMode::ThreadSafe>();
+
+	// keep the action alive until it finishes
+	Action->RegisterWithGameInstance(WorldContextObject);
+
+	return Action;
+}
+
+void ULoadMeshFromAssetFileAsyncAction::Activate() {
+	// start loading on a worker thread (progressively if nodes are listened
+	// to). Loads through the memory cache cannot be canceled.
+	auto        OnNodeLoadedCallback = MakeBroadcastNodeOnGameThread(*this);
+	const auto& LoadTask =
+	    OnNodeLoadedCallback
+	        ? UAssetLoader::LoadMeshFromAssetFileProgressiveAsync(
+	              FilePath, MoveTemp(OnNodeLoadedCallback), ImportProfile,
+	              CancellationToken)
+	        : UAssetLoader::LoadMeshFromAssetFileAsync(
+	              FilePath, ImportProfile,
+	              FMeshDataMemoryCache::IsEnabled()
+	                  ? FAssetImportCancellationTokenPtr()
+	                  : CancellationToken);
+
+	// hand the result back to the game thread
+	BroadcastOnGameThreadWhenCompleted(*this, LoadTask);
+}
+
+void ULoadMeshFromAssetFileAsyncAction::Cancel() {
+	CancellationToken->Cancel();
+}
+
+bool ULoadMeshFromAssetFileAsyncAction::IsCanceled() const {
+	return CancellationToken->IsCanceled();
+}
+
+ULoadMeshFromAssetDataAsyncAction*
+    ULoadMeshFromAssetDataAsyncAction::LoadMeshFromAssetDataAsync(
+        UObject* const WorldContextObject, const TArray<uint8>& AssetData,
+        const FAssetImportProfile& ImportProfile) {
+	// create action
+	const auto& Action    = NewObject<ULoadMeshFromAssetDataAsyncAction>();
+	Action->AssetData     = AssetData;
+	Action->ImportProfile = ImportProfile;
+	Action->CancellationToken =
+	    MakeShared<FAssetImportCancellationToken, ESPMode::ThreadSafe>();
+
+	// keep the action alive until it finishes
+	Action->RegisterWithGameInstance(WorldContextObject);
+
+	return Action;
+}
+
+void ULoadMeshFromAssetDataAsyncAction::Activate() {
+	// start loading on a worker thread (progressively if nodes are listened
+	// to). Loads through the memory cache cannot be canceled. The data is no
+	// longer needed here.
+	auto        OnNodeLoadedCallback = MakeBroadcastNodeOnGameThread(*this);
+	const auto& LoadTask =
+	    OnNodeLoadedCallback
+	        ? UAssetLoader::LoadMeshFromAssetDataProgressiveAsync(
+	              MoveTemp(AssetData), MoveTemp(OnNodeLoadedCallback),
+	              ImportProfile, CancellationToken)
+	        : UAssetLoader::LoadMeshFromAssetDataAsync(
+	              MoveTemp(AssetData), ImportProfile,
+	              FMeshDataMemoryCache::IsEnabled()
+	                  ? FAssetImportCancellationTokenPtr()
+	                  : CancellationToken);
+
+	// hand the result back to the game thread
+	BroadcastOnGameThreadWhenCompleted(*this, LoadTask);
+}
+
+void ULoadMeshFromAssetDataAsyncAction::Cancel() {
+	CancellationToken->Cancel();
+}
+
+bool ULoadMeshFromAssetDataAsyncAction::IsCanceled() const {
+	return CancellationToken->IsCanceled();
+}
+
+#pragma region definitions of static functions
+template <typename AsyncActionT>
+static void BroadcastOnGameThreadWhenCompleted(
+    AsyncActionT&                                        AsyncAction,
+    const UE::Tasks::TTask<TOptional<FLoadedMeshData>>& LoadTask) {
+	namespace Tasks = UE::Tasks;
+
+	// the action may be destroyed by the time loading finishes (e.g. the game
+	// instance is shut down), so hold it weakly
+	TWeakObjectPtr<AsyncActionT> WeakAsyncAction(&AsyncAction);
+
+	// Task to broadcast the result on game thread, invoked after LoadTask is
+	// completed.
+	Tasks::Launch(
+	    UE_SOURCE_LOCATION,
+	    [WeakAsyncAction, LoadTask]() mutable {
+		    ExecuteOnGameThread(
+		        UE_SOURCE_LOCATION, [WeakAsyncAction, LoadTask]() mutable {
+			        // LoadTask should be completed
+			        check(LoadTask.IsCompleted());
+
+			        // get action
+			        const auto& AsyncAction = WeakAsyncAction.Get();
+
+			        // if the action is already destroyed, nobody is listening
+			        if (nullptr == AsyncAction) {
+				        return;
+			        }
+
+			        // get loaded mesh data
+			        auto& LoadedMeshData = LoadTask.GetResult();
+
+			        // broadcast the result (dropped if canceled)
+			        if (LoadedMeshData.IsSet() && !AsyncAction->IsCanceled()) {
+				        AsyncAction->OnSuccess.Broadcast(LoadedMeshData.GetValue());
+			        } else {
+				        AsyncAction->OnFailure.Broadcast({});
+			        }
+
+			        // the action has finished
+			        AsyncAction->SetReadyToDestroy();
+		        });
+	    },
+	    LoadTask, LowLevelTasks::ETaskPriority::Normal);
+}
+
+template <typename AsyncActionT>
+static FOnLoadedMeshNode MakeBroadcastNodeOnGameThread(AsyncActionT& AsyncAction) {
+	// nothing to do if nobody is listening
+	if (!AsyncAction.OnNodeLoaded.IsBound()) {
+		return {};
+	}
+
+	// the action may be destroyed while loading, so hold it weakly
+	TWeakObjectPtr<AsyncActionT> WeakAsyncAction(&AsyncAction);
+
+	return [WeakAsyncAction](FLoadedMeshNodeData&& NodeData) {
+		ExecuteOnGameThread(
+		    UE_SOURCE_LOCATION,
+		    [WeakAsyncAction, NodeData = MoveTemp(NodeData)]() {
+			    // if the action is already destroyed or canceled, nobody is
+			    // listening
+			    const auto& AsyncAction = WeakAsyncAction.Get();
+			    if (nullptr == AsyncAction || AsyncAction->IsCanceled()) {
+				    return;
+			    }
+
+			    AsyncAction->OnNodeLoaded.Broadcast(NodeData);
+		    });
+	};
+}
+#pragma endregion
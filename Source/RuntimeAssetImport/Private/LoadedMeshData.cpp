@@ -1,3 +1,21 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "LoadedMeshData.h"
+
+SIZE_T FLoadedMeshData::GetAllocatedSize() const {
+	auto AllocatedSize =
+	    NodeList.GetAllocatedSize() + SectionList.GetAllocatedSize() +
+	    MaterialList.GetAllocatedSize() + TextureList.GetAllocatedSize();
+
+	for (const auto& Node : NodeList) {
+		AllocatedSize += Node.GetAllocatedSize();
+	}
+	for (const auto& Section : SectionList) {
+		AllocatedSize += Section.GetAllocatedSize();
+	}
+	for (const auto& TextureData : TextureList) {
+		AllocatedSize += TextureData.GetAllocatedSize();
+	}
+
+	return AllocatedSize;
+}
@@ -1,3 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "LoadedMeshNode.h"
+
+SIZE_T FLoadedMeshNode::GetAllocatedSize() const {
+	return Name.GetAllocatedSize() + SectionIndices.GetAllocatedSize();
+}
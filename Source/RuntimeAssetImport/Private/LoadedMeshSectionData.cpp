@@ -1,3 +1,147 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "LoadedMeshSectionData.h"
+
+#include "VertexStreamConversion.h"
+
+#pragma region forward declarations of static functions
+/**
+ * Expand a stream that has a single element for all vertices (constant
+ * stream) to one element per vertex. Other streams are left as they are.
+ * @param   Stream        stream to expand
+ * @param   NumVertices   number of vertices
+ */
+template <typename T>
+static void ExpandConstantStream(TArray<T>& Stream, int32 NumVertices);
+#pragma endregion
+
+SIZE_T FLoadedMeshSectionData::GetAllocatedSize() const {
+	return Vertices.GetAllocatedSize() + Triangles.GetAllocatedSize() +
+	       Normals.GetAllocatedSize() + UV0Channel.GetAllocatedSize() +
+	       VertexColors0.GetAllocatedSize() + Tangents.GetAllocatedSize() +
+	       CompactVertices.GetAllocatedSize() +
+	       CompactTriangles.GetAllocatedSize() +
+	       CompactNormals.GetAllocatedSize() +
+	       CompactUV0Channel.GetAllocatedSize() +
+	       CompactVertexColors0.GetAllocatedSize() +
+	       CompactTangents.GetAllocatedSize();
+}
+
+bool FLoadedMeshSectionData::IsCompact() const {
+	return !CompactVertices.IsEmpty();
+}
+
+bool FLoadedMeshSectionData::IsFullPrecision() const {
+	// a stream is per vertex if it is absent or has the number of vertices
+	const auto& NumVertices = Vertices.Num();
+	const auto& IsPerVertex = [NumVertices](const auto& Stream) {
+		return Stream.IsEmpty() || NumVertices == Stream.Num();
+	};
+
+	return !IsCompact() && IsPerVertex(Normals) && IsPerVertex(UV0Channel) &&
+	       IsPerVertex(VertexColors0) && IsPerVertex(Tangents);
+}
+
+FLoadedMeshSectionData FLoadedMeshSectionData::ToFullPrecision() const {
+	// if already in full precision, just copy
+	if (IsFullPrecision()) {
+		return *this;
+	}
+
+	// if not compact, just expand constant streams
+	if (!IsCompact()) {
+		const auto& NumVertices = Vertices.Num();
+		auto        FullSection = *this;
+		ExpandConstantStream(FullSection.Normals, NumVertices);
+		ExpandConstantStream(FullSection.UV0Channel, NumVertices);
+		ExpandConstantStream(FullSection.VertexColors0, NumVertices);
+		ExpandConstantStream(FullSection.Tangents, NumVertices);
+		return FullSection;
+	}
+
+	FLoadedMeshSectionData FullSection;
+	FullSection.MaterialIndex = MaterialIndex;
+	const auto& NumVertices   = CompactVertices.Num();
+
+	// vertices
+	FullSection.Vertices.SetNumUninitialized(NumVertices);
+	WidenFloatsToDoubles(&CompactVertices.GetData()->X,
+	                     &FullSection.Vertices.GetData()->X,
+	                     3 * int64{NumVertices});
+
+	// triangles (uint16 only if there are fewer than 65536 vertices)
+	if (!CompactTriangles.IsEmpty()) {
+		FullSection.Triangles = TArray<int32>(CompactTriangles);
+	} else {
+		FullSection.Triangles = Triangles;
+	}
+
+	// normals
+	FullSection.Normals.SetNumUninitialized(CompactNormals.Num());
+	for (auto i = 0; i < CompactNormals.Num(); ++i) {
+		FullSection.Normals[i] = FVector(DecodeOctahedral(CompactNormals[i]));
+	}
+
+	// UV channel
+	FullSection.UV0Channel.SetNumUninitialized(CompactUV0Channel.Num());
+	for (auto i = 0; i < CompactUV0Channel.Num(); ++i) {
+		FullSection.UV0Channel[i] = FVector2D(FVector2f(CompactUV0Channel[i]));
+	}
+
+	// vertex colors
+	FullSection.VertexColors0.SetNumUninitialized(CompactVertexColors0.Num());
+	for (auto i = 0; i < CompactVertexColors0.Num(); ++i) {
+		FullSection.VertexColors0[i] =
+		    CompactVertexColors0[i].ReinterpretAsLinear();
+	}
+
+	// tangents
+	FullSection.Tangents.SetNumUninitialized(CompactTangents.Num());
+	for (auto i = 0; i < CompactTangents.Num(); ++i) {
+		FullSection.Tangents[i] = FProcMeshTangent(
+		    FVector(DecodeOctahedral(CompactTangents[i])), false);
+	}
+
+	// expand constant streams
+	ExpandConstantStream(FullSection.Normals, NumVertices);
+	ExpandConstantStream(FullSection.UV0Channel, NumVertices);
+	ExpandConstantStream(FullSection.VertexColors0, NumVertices);
+	ExpandConstantStream(FullSection.Tangents, NumVertices);
+
+	return FullSection;
+}
+
+const FLoadedMeshSectionData& FLoadedMeshSectionData::GetFullPrecision(
+    FLoadedMeshSectionData& Storage) const {
+	// if already in full precision, refer to this section as it is
+	if (IsFullPrecision()) {
+		return *this;
+	}
+
+	Storage = ToFullPrecision();
+	return Storage;
+}
+
+bool FLoadedMeshSectionData::HasNormals() const {
+	return !Normals.IsEmpty() || !CompactNormals.IsEmpty();
+}
+
+bool FLoadedMeshSectionData::HasUV0Channel() const {
+	return !UV0Channel.IsEmpty() || !CompactUV0Channel.IsEmpty();
+}
+
+bool FLoadedMeshSectionData::HasVertexColors0() const {
+	return !VertexColors0.IsEmpty() || !CompactVertexColors0.IsEmpty();
+}
+
+bool FLoadedMeshSectionData::HasTangents() const {
+	return !Tangents.IsEmpty() || !CompactTangents.IsEmpty();
+}
+
+template <typename T>
+static void ExpandConstantStream(TArray<T>& Stream, const int32 NumVertices) {
+	if (1 == Stream.Num() && NumVertices > 1) {
+		const auto Value = Stream[0];
+		Stream.Init(Value, NumVertices);
+	}
+}
@@ -0,0 +1,8 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LoadedTextureData.h"
+
+SIZE_T FLoadedTextureData::GetAllocatedSize() const {
+	return CompressedData.GetAllocatedSize() + RawData.GetAllocatedSize() +
+	       (SharedRawData.IsValid() ? SharedRawData->GetAllocatedSize() : 0);
+}
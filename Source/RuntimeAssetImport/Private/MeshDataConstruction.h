@@ -0,0 +1,237 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AssetImportCancellationToken.h"
+#include "AssetImportProfile.h"
+#include "AssetLoader.h"
+#include "CoreMinimal.h"
+#include "ExternalTextureCache.h"
+#include "LoadedMeshData.h"
+
+#include <assimp/matrix4x4.h>
+#include <assimp/postprocess.h>
+
+// Types and functions shared by the conversion of assimp scenes in AssetLoader
+// and the native loaders (GltfAsset and BinaryMeshFiles), which must construct
+// the same mesh data as assimp.
+
+/**
+ * Options of a single load that are not part of the import profile.
+ */
+struct FLoadOptions {
+	// Callback receiving each node as soon as it is converted, or unset not to
+	// deliver nodes progressively
+	FOnLoadedMeshNode OnNodeLoaded;
+
+	// Token to cancel the load, or null if it cannot be canceled
+	FAssetImportCancellationTokenPtr CancellationToken;
+
+public:
+	/**
+	 * Whether the load has been canceled.
+	 */
+	bool IsCanceled() const {
+		return CancellationToken.IsValid() && CancellationToken->IsCanceled();
+	}
+};
+
+/**
+ * Table of the unique textures of a scene, used while generating the material
+ * list.
+ */
+struct FAiTextureTable {
+	// unique textures
+	TArray<FLoadedTextureData> TextureList;
+
+	// index in TextureList of each embedded texture already added, by its
+	// source (e.g. assimp texture)
+	TMap<const void*, int32> TextureIndexOfSource;
+
+	// indices in TextureList of the textures, by hash of their data
+	TMultiMap<uint32, int32> TextureIndicesOfHash;
+
+	// index in TextureList of each external texture file already added
+	TMap<FString, int32> TextureIndexOfFilePath;
+};
+
+/**
+ * Vertex attributes present in an assimp mesh.
+ */
+enum class EAiVertexAttributes : uint8 {
+	None          = 0,
+	Vertices      = 1 << 0,
+	Normals       = 1 << 1,
+	UV0Channel    = 1 << 2,
+	VertexColors0 = 1 << 3,
+	Tangents      = 1 << 4,
+};
+ENUM_CLASS_FLAGS(EAiVertexAttributes);
+
+/**
+ * A range of vertices or faces of a section, converted as one job.
+ */
+struct FSectionConversionJob {
+	// index of the section in FLoadedMeshData::SectionList
+	int32 SectionIndex;
+
+	// whether the range is of faces (true) or of vertices (false)
+	bool bFaces;
+
+	// range to convert [Begin, End)
+	int32 Begin;
+	int32 End;
+};
+
+// post-process steps the loaded data always relies on. Textures are not
+// embedded by assimp, so that external texture files are read through the
+// texture cache instead of by every import that refers to them.
+static constexpr unsigned int AiRequiredPostProcessSteps =
+    aiProcess_Triangulate | aiProcess_MakeLeftHanded | aiProcess_FlipUVs;
+
+// post-process steps the native loaders reproduce, or that do not change the
+// assets they accept (unless checked otherwise)
+static constexpr unsigned int NativePostProcessSteps =
+    AiRequiredPostProcessSteps | aiProcess_RemoveRedundantMaterials |
+    aiProcess_GenSmoothNormals | aiProcess_CalcTangentSpace |
+    aiProcess_FindInvalidData | aiProcess_GenUVCoords |
+    aiProcess_TransformUVCoords;
+/**
+ * Get the post-process steps to pass to the Assimp Importer when reading.
+ * @param ImportProfile Which post-process steps to apply
+ * @return the post-process steps. In auto mode, this is 0 (nothing) since the
+ *         steps are decided after reading by ApplyAutoPostProcessing.
+ */
+unsigned int GetAiPostProcessSteps(const FAssetImportProfile& ImportProfile);
+
+/**
+ * Decide the post-process steps for auto mode from what all meshes have.
+ * @param bAllMeshesHaveNormals      whether all meshes have normals
+ * @param bAllUVMeshesHaveTangents   whether all meshes with UVs have tangents
+ * @param bAllMeshesAreIndexed       whether all meshes share vertices between
+ *                                   faces
+ * @return the post-process steps
+ */
+unsigned int GetAutoAiPostProcessSteps(bool bAllMeshesHaveNormals,
+                                       bool bAllUVMeshesHaveTangents,
+                                       bool bAllMeshesAreIndexed);
+
+/**
+ * Finish the texture list of mesh data: copy the loaded external textures into
+ * it, mark the materials whose texture failed to load as errors, and process
+ * the textures as specified by the import profile.
+ * @param        ExternalTextureTasks   tasks made by
+ *                                      FExternalTextureCache::FindOrLoadAll
+ *                                      from the texture list of MeshData
+ * @param        ImportProfile          import profile used to load MeshData
+ * @param        LoadOptions            cancellation of the load
+ * @param[out]   MeshData               mesh data whose texture list is
+ *                                      finished
+ */
+void FinishTextureList(
+    const TArray<UE::Tasks::TTask<FLoadedTextureDataPtr>>& ExternalTextureTasks,
+    const FAssetImportProfile& ImportProfile, const FLoadOptions& LoadOptions,
+    FLoadedMeshData& MeshData);
+
+/**
+ * Generate a transformation matrix to transform from the Ai(Assimp) coordinate
+ * system to the UE coordinate system.
+ * @param AiUnitScaleFactor UnitScaleFactor of the scene (see
+ *                          GetAiUnitScaleFactor)
+ */
+aiMatrix4x4t<float> GenerateAi_UE_XformMatrix(float AiUnitScaleFactor);
+
+/**
+ * Add an embedded texture to the texture table, unless the same texture or a
+ * texture with the same data has already been added.
+ * Width and Height follow aiTexture: if Height is 0, Data is a compressed
+ * image (e.g. PNG) of Width bytes, otherwise Width * Height BGRA8 texels.
+ * @param        Source         source of the texture (e.g. assimp texture),
+ *                              which identifies the same texture
+ * @param        Data           data of the texture
+ * @param        Width          width, or size of Data if compressed
+ * @param        Height         height, or 0 if compressed
+ * @param[out]   TextureTable   texture table to add to
+ * @return  index of the texture in the texture list
+ */
+int32 AddEmbeddedTexture(const void* Source, const uint8* Data, uint32 Width,
+                         uint32 Height, FAiTextureTable& TextureTable);
+
+/**
+ * Add an external texture to the texture table, unless the same file has
+ * already been added. Its data is read later through the texture cache.
+ * @param        TexturePath      path of the texture in the asset
+ * @param        AssetDirectory   directory to resolve a relative TexturePath
+ *                                against
+ * @param[out]   TextureTable     texture table to add to
+ * @return  index of the texture in the texture list, or INDEX_NONE if the path
+ *          cannot be resolved
+ */
+int32 AddExternalTexture(const FString& TexturePath,
+                         const FString& AssetDirectory,
+                         FAiTextureTable& TextureTable);
+
+/**
+ * Size the streams of a section, and add the jobs converting its vertices and
+ * faces. Large sections are split into multiple jobs so that they are
+ * converted by multiple threads.
+ * @param           SectionIndex        index of the section in
+ *                                      FLoadedMeshData::SectionList
+ * @param           Attributes          vertex attributes present in the
+ *                                      section
+ * @param           NumVertices         number of vertices
+ * @param           NumFaces            number of triangles
+ * @param           bCompactPrecision   whether to store the section in
+ *                                      compact precision
+ * @param[out]      Section             section whose streams are sized
+ * @param[in,out]   Jobs                conversion jobs to add to
+ */
+void SizeSectionAndAddJobs(int32 SectionIndex, EAiVertexAttributes Attributes,
+                           int32 NumVertices, int32 NumFaces,
+                           bool                           bCompactPrecision,
+                           FLoadedMeshSectionData&        Section,
+                           TArray<FSectionConversionJob>& Jobs);
+
+/**
+ * Run the conversion jobs of all sections concurrently.
+ * Each section is finished as soon as its last job is run: OnSectionConverted
+ * is called with it, and its streams whose values are the same for all
+ * vertices are collapsed. Each node is delivered to LoadOptions.OnNodeLoaded as
+ * soon as all its sections are finished. Once the load is canceled, the
+ * remaining jobs are skipped and no more nodes are delivered.
+ * @param           Jobs                   conversion jobs of all sections
+ * @param           NodeIndicesOfSection   indices of the nodes referring to
+ *                                         each section
+ * @param           ConvertJob             converts a job. Called concurrently.
+ * @param           OnSectionConverted     called with the index of each
+ *                                         section once it is converted (e.g.
+ *                                         to release its source). Called
+ *                                         concurrently.
+ * @param           LoadOptions            progressive delivery and
+ *                                         cancellation of the load
+ * @param[in,out]   MeshData               mesh data whose NodeList is set up,
+ *                                         and whose SectionList is sized and
+ *                                         converted
+ */
+void RunSectionConversionJobs(
+    const TArray<FSectionConversionJob>&             Jobs,
+    const TArray<TArray<int32>>&                     NodeIndicesOfSection,
+    TFunctionRef<void(const FSectionConversionJob&)> ConvertJob,
+    TFunctionRef<void(int32)>                        OnSectionConverted,
+    const FLoadOptions& LoadOptions, FLoadedMeshData& MeshData);
+
+/**
+ * Convert assimp's matrix to UE's matrix
+ * Return transpose of the assimp's matrix as the UE's matrix. (since one is
+ * transpose of the other one).
+ * @param   AiMatrix4x4   assimp's matrix
+ * @return  UE's matrix
+ */
+FMatrix AiMatrixToUEMatrix(const aiMatrix4x4& AiMatrix4x4);
+
+/**
+ * Mirror a node transform at its local Z axis, as assimp's MakeLeftHanded
+ * step does.
+ * @param[in,out]   AiTransform   transform to mirror
+ */
+void MirrorAiTransformZ(aiMatrix4x4& AiTransform);
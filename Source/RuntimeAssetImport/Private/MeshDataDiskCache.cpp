@@ -0,0 +1,656 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MeshDataDiskCache.h"
+
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Hash/xxhash.h"
+#include "LogAssetLoader.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "RuntimeAssetImportSettings.h"
+
+#include <type_traits>
+
+// magic number at the head of cache files ("RAIM")
+static constexpr uint32 CacheFileMagic = 0x4D494152;
+
+// version of the cache file layout. Increment this whenever the layout or the
+// conversion result changes, so that old entries are ignored.
+static constexpr uint32 CacheFileVersion = 11;
+
+// extension of cache files
+static const TCHAR* const CacheFileExtension = TEXT(".raimesh");
+
+// whether elements of type T can be serialized as raw memory
+template <typename T>
+struct TIsRawSerializable {
+	static constexpr bool Value = std::is_trivially_copyable_v<T>;
+};
+
+// FFloat16 declares its own copy constructor, but is just a uint16
+template <>
+struct TIsRawSerializable<FVector2DHalf> {
+	static constexpr bool Value = true;
+};
+
+/**
+ * A file other than the asset that a cache entry was converted from, as it was
+ * when the entry was stored.
+ */
+struct FCacheDependency {
+	// path relative to the directory of the asset, or the full path for asset
+	// data on memory
+	FString FilePath;
+
+	// size of the file
+	int64 FileSize = 0;
+
+	// modification time of the file
+	FDateTime ModificationTime;
+};
+
+// lock for eviction, so that only one thread scans the directory at a time
+static FCriticalSection EvictionCriticalSection;
+
+#pragma region forward declarations of static functions
+/**
+ * Make a cache key from the content hash, the import profile and whether the
+ * native loaders are enabled.
+ * @param   ContentHash     hash of the content of the asset
+ * @param   ImportProfile   import profile used to load the asset
+ * @return  the key
+ */
+static FString MakeKeyFromContentHash(const FXxHash128&          ContentHash,
+                                      const FAssetImportProfile& ImportProfile);
+
+/**
+ * Serialize (save or load) the header of a cache file: its magic number,
+ * version and dependencies. On loading, the archive is set to error if the
+ * magic number or version does not match.
+ * @param   Ar             archive to save to / load from
+ * @param   Dependencies   dependencies to save / load into
+ */
+static void SerializeHeader(FArchive& Ar, TArray<FCacheDependency>& Dependencies);
+
+/**
+ * Find a dependency of a cache entry whose file has changed (or been deleted)
+ * since the entry was stored.
+ * @param   Dependencies     dependencies of the entry
+ * @param   AssetDirectory   directory to resolve their paths against. Empty
+ *                           for asset data on memory.
+ * @return  the full path of the changed file, or unset if none has changed.
+ */
+static TOptional<FString>
+    FindChangedDependency(const TArray<FCacheDependency>& Dependencies,
+                          const FString&                  AssetDirectory);
+
+/**
+ * Get the full path of a dependency of a cache entry.
+ * @param   Dependency       dependency of the entry
+ * @param   AssetDirectory   directory to resolve its path against. Empty for
+ *                           asset data on memory.
+ * @return  the full path of the file
+ */
+static FString GetDependencyFilePath(const FCacheDependency& Dependency,
+                                     const FString&          AssetDirectory);
+
+/**
+ * Serialize (save or load) mesh data.
+ * @param   Ar         archive to save to / load from
+ * @param   MeshData   mesh data to save / load into
+ */
+static void SerializeMeshData(FArchive& Ar, FLoadedMeshData& MeshData);
+
+/**
+ * Check that every index in loaded mesh data refers to an existing element,
+ * so that a corrupt entry whose sizes still match is never used: the parent
+ * of each node precedes it, and the sections of nodes, the materials of
+ * sections, the textures of materials and the vertices of triangles exist.
+ * The attribute streams of each section must also be absent, constant or per
+ * vertex.
+ * @param   MeshData   mesh data to check
+ * @return  whether the mesh data is consistent
+ */
+static bool IsValidMeshData(const FLoadedMeshData& MeshData);
+
+/**
+ * Check that all indices are less than a number of elements.
+ * @tparam  IndexT    int32 or uint16
+ * @param   Indices   indices to check
+ * @param   Num       number of elements
+ * @return  whether all indices are in [0, Num)
+ */
+template <typename IndexT>
+static bool AreIndicesInRange(const TArray<IndexT>& Indices, int32 Num);
+
+/**
+ * Serialize (save or load) an array of trivially copyable elements as one raw
+ * block of memory.
+ * @param   Ar      archive to save to / load from
+ * @param   Array   array to save / load into
+ */
+template <typename T>
+static void SerializeRawArray(FArchive& Ar, TArray<T>& Array);
+#pragma endregion
+
+bool FMeshDataDiskCache::IsEnabled() {
+	return GetDefault<URuntimeAssetImportSettings>()->bEnableDiskCache;
+}
+
+TOptional<FString>
+    FMeshDataDiskCache::MakeKey(const FString&             FilePath,
+                                const FAssetImportProfile& ImportProfile) {
+	// get platform file (top of the chain, so pak files are included)
+	auto& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// hash the mapped file if possible to avoid copying it
+	auto OpenMappedResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (OpenMappedResult.HasValue()) {
+		const auto& MappedFileHandle = OpenMappedResult.GetValue();
+		TUniquePtr<IMappedFileRegion> MappedFileRegion(
+		    MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+
+		if (MappedFileRegion.IsValid()) {
+			return MakeKeyFromContentHash(
+			    FXxHash128::HashBuffer(MappedFileRegion->GetMappedPtr(),
+			                           MappedFileRegion->GetMappedSize()),
+			    ImportProfile);
+		}
+	}
+
+	// otherwise, read the whole file
+	TArray64<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *FilePath, FILEREAD_Silent)) {
+		return {};
+	}
+
+	return MakeKeyFromContentHash(
+	    FXxHash128::HashBuffer(FileData.GetData(), FileData.Num()),
+	    ImportProfile);
+}
+
+FString FMeshDataDiskCache::MakeKey(const TArray<uint8>&       AssetData,
+                                    const FAssetImportProfile& ImportProfile) {
+	return MakeKeyFromContentHash(
+	    FXxHash128::HashBuffer(AssetData.GetData(), AssetData.Num()),
+	    ImportProfile);
+}
+
+TOptional<FLoadedMeshData>
+    FMeshDataDiskCache::Find(const FString& Key, const FString& AssetDirectory,
+                             TArray<FString>& DependencyFilePaths) {
+	// get path of the cache file
+	const auto& CacheFilePath = GetCacheFilePath(Key);
+
+	// open cache file (arrays are read from the file directly into the mesh
+	// data, without reading the whole file into memory first)
+	TUniquePtr<FArchive> Reader(
+	    IFileManager::Get().CreateFileReader(*CacheFilePath, FILEREAD_Silent));
+	if (!Reader.IsValid()) {
+		// cache miss
+		return {};
+	}
+
+	// read the header first, so that the mesh data is not read if any file
+	// the entry depends on has changed
+	TArray<FCacheDependency> Dependencies;
+	SerializeHeader(*Reader, Dependencies);
+	if (!Reader->IsError()) {
+		const auto& ChangedFilePath =
+		    FindChangedDependency(Dependencies, AssetDirectory);
+		if (ChangedFilePath.IsSet()) {
+			// cache miss (the entry is overwritten by the caller)
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("Cache file %s is outdated, since %s has changed."),
+			       *CacheFilePath, *ChangedFilePath.GetValue());
+			return {};
+		}
+	}
+
+	// deserialize
+	FLoadedMeshData MeshData;
+	if (!Reader->IsError()) {
+		SerializeMeshData(*Reader, MeshData);
+	}
+	const auto& IsValidEntry = !Reader->IsError() && Reader->Close();
+	Reader.Reset();
+
+	// if the entry is broken or in an old layout, delete it
+	if (!IsValidEntry) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("Cache file %s is invalid and will be deleted."),
+		       *CacheFilePath);
+		IFileManager::Get().Delete(*CacheFilePath, false, false, true);
+		return {};
+	}
+
+	// mark as recently used
+	IFileManager::Get().SetTimeStamp(*CacheFilePath, FDateTime::UtcNow());
+
+	UE_LOG(LogAssetLoader, Log, TEXT("Loaded mesh data from cache file %s."),
+	       *CacheFilePath);
+
+	// output the files the entry depends on
+	DependencyFilePaths.Reset(Dependencies.Num());
+	for (const auto& Dependency : Dependencies) {
+		DependencyFilePaths.Add(
+		    GetDependencyFilePath(Dependency, AssetDirectory));
+	}
+
+	return MoveTemp(MeshData);
+}
+
+void FMeshDataDiskCache::Store(const FString&         Key,
+                               const FLoadedMeshData& MeshData,
+                               const FString&         AssetDirectory,
+                               const TArray<FString>& DependencyFilePaths) {
+	// get platform file (top of the chain, so pak files are included)
+	auto& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// record the files the mesh data depends on as they are now, relative to
+	// the asset directory so that they are found next to a copy of the asset
+	TArray<FCacheDependency> Dependencies;
+	Dependencies.Reserve(DependencyFilePaths.Num());
+	for (const auto& DependencyFilePath : DependencyFilePaths) {
+		const auto& StatData = PlatformFile.GetStatData(*DependencyFilePath);
+		if (!StatData.bIsValid) {
+			// an entry whose files cannot be checked is not stored
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("Mesh data is not cached, since %s cannot be checked."),
+			       *DependencyFilePath);
+			return;
+		}
+
+		auto FilePath = DependencyFilePath;
+		if (!AssetDirectory.IsEmpty()) {
+			FPaths::MakePathRelativeTo(FilePath, *(AssetDirectory + TEXT("/")));
+		}
+		Dependencies.Add(
+		    {MoveTemp(FilePath), StatData.FileSize, StatData.ModificationTime});
+	}
+
+	// write to a temporary file first, and then rename it, so that other
+	// threads or processes never see a partially written entry
+	const auto& CacheFilePath = GetCacheFilePath(Key);
+	const auto& TempFilePath  = FPaths::CreateTempFilename(
+	    *GetCacheDirectory(), TEXT("tmp"), CacheFileExtension);
+
+	// serialize directly into the file (SerializeMeshData is shared with
+	// loading, so it takes a non-const reference, but never modifies MeshData
+	// when saving)
+	TUniquePtr<FArchive> Writer(
+	    IFileManager::Get().CreateFileWriter(*TempFilePath, FILEWRITE_Silent));
+	if (!Writer.IsValid()) {
+		UE_LOG(LogAssetLoader, Warning, TEXT("Failed to create cache file %s."),
+		       *TempFilePath);
+		return;
+	}
+	SerializeHeader(*Writer, Dependencies);
+	SerializeMeshData(*Writer, const_cast<FLoadedMeshData&>(MeshData));
+	const auto& IsWritten = !Writer->IsError() && Writer->Close();
+	Writer.Reset();
+
+	if (!IsWritten) {
+		UE_LOG(LogAssetLoader, Warning, TEXT("Failed to write cache file %s."),
+		       *TempFilePath);
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		return;
+	}
+	if (!IFileManager::Get().Move(*CacheFilePath, *TempFilePath, true, true)) {
+		UE_LOG(LogAssetLoader, Warning, TEXT("Failed to write cache file %s."),
+		       *CacheFilePath);
+		IFileManager::Get().Delete(*TempFilePath, false, false, true);
+		return;
+	}
+
+	// keep the cache in the limit
+	EvictLeastRecentlyUsed();
+}
+
+FString FMeshDataDiskCache::GetCacheDirectory() {
+	// get directory in the settings
+	const auto& DiskCacheDirectory =
+	    GetDefault<URuntimeAssetImportSettings>()->DiskCacheDirectory;
+
+	// a relative path is relative to the Saved directory
+	return FPaths::ConvertRelativePathToFull(
+	    FPaths::ProjectSavedDir(), DiskCacheDirectory);
+}
+
+FString FMeshDataDiskCache::GetCacheFilePath(const FString& Key) {
+	return FPaths::Combine(GetCacheDirectory(), Key + CacheFileExtension);
+}
+
+void FMeshDataDiskCache::EvictLeastRecentlyUsed() {
+	FScopeLock ScopeLock(&EvictionCriticalSection);
+
+	// maximum size of the cache in bytes
+	const auto& MaxDiskCacheSize =
+	    int64{GetDefault<URuntimeAssetImportSettings>()->MaxDiskCacheSizeMB} *
+	    1024 * 1024;
+
+	// list entries
+	struct FCacheEntry {
+		FString   FilePath;
+		int64     FileSize;
+		FDateTime LastUsed;
+	};
+	TArray<FCacheEntry> CacheEntries;
+	int64               TotalSize = 0;
+	const auto&         CacheDirectory = GetCacheDirectory();
+	IFileManager::Get().IterateDirectoryStat(
+	    *CacheDirectory,
+	    [&](const TCHAR* const FilenameOrDirectory, const FFileStatData& StatData) {
+		    if (!StatData.bIsDirectory &&
+		        FStringView(FilenameOrDirectory).EndsWith(CacheFileExtension)) {
+			    CacheEntries.Add(
+			        {FilenameOrDirectory, StatData.FileSize, StatData.ModificationTime});
+			    TotalSize += StatData.FileSize;
+		    }
+		    return true;
+	    });
+
+	// nothing to do if the cache fits in the limit
+	if (TotalSize <= MaxDiskCacheSize) {
+		return;
+	}
+
+	// delete from the least recently used
+	CacheEntries.Sort([](const FCacheEntry& A, const FCacheEntry& B) {
+		return A.LastUsed < B.LastUsed;
+	});
+	for (const auto& CacheEntry : CacheEntries) {
+		if (TotalSize <= MaxDiskCacheSize) {
+			break;
+		}
+
+		if (IFileManager::Get().Delete(*CacheEntry.FilePath, false, false, true)) {
+			UE_LOG(LogAssetLoader, Log, TEXT("Evicted cache file %s."),
+			       *CacheEntry.FilePath);
+			TotalSize -= CacheEntry.FileSize;
+		}
+	}
+}
+
+#pragma region definitions of static functions
+static FString MakeKeyFromContentHash(const FXxHash128&          ContentHash,
+                                      const FAssetImportProfile& ImportProfile) {
+	// entries converted by the native loaders are kept apart from those
+	// imported with assimp, since they may differ in the last bit (OBJ)
+	const auto& LoaderTag =
+	    GetDefault<URuntimeAssetImportSettings>()->bEnableNativeLoaders
+	        ? TEXT("native")
+	        : TEXT("assimp");
+
+	// version is a part of the key, so that entries of old versions are never
+	// read and are evicted eventually
+	return FString::Printf(TEXT("%016llx%016llx_%08x_%s_v%u"),
+	                       ContentHash.HighPart, ContentHash.LowPart,
+	                       GetTypeHash(ImportProfile), LoaderTag,
+	                       CacheFileVersion);
+}
+
+static void SerializeHeader(FArchive&                 Ar,
+                            TArray<FCacheDependency>& Dependencies) {
+	// magic number and version
+	auto Magic   = CacheFileMagic;
+	auto Version = CacheFileVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() &&
+	    (CacheFileMagic != Magic || CacheFileVersion != Version)) {
+		Ar.SetError();
+		return;
+	}
+
+	// dependencies
+	auto NumDependencies = Dependencies.Num();
+	Ar << NumDependencies;
+	if (Ar.IsLoading()) {
+		if (NumDependencies < 0) {
+			Ar.SetError();
+			return;
+		}
+		Dependencies.SetNum(NumDependencies);
+	}
+	for (auto& Dependency : Dependencies) {
+		Ar << Dependency.FilePath;
+		Ar << Dependency.FileSize;
+		Ar << Dependency.ModificationTime;
+	}
+}
+
+static TOptional<FString>
+    FindChangedDependency(const TArray<FCacheDependency>& Dependencies,
+                          const FString&                  AssetDirectory) {
+	// get platform file (top of the chain, so pak files are included)
+	auto& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	for (const auto& Dependency : Dependencies) {
+		const auto& FilePath =
+		    GetDependencyFilePath(Dependency, AssetDirectory);
+
+		const auto& StatData = PlatformFile.GetStatData(*FilePath);
+		if (!StatData.bIsValid || StatData.FileSize != Dependency.FileSize ||
+		    StatData.ModificationTime != Dependency.ModificationTime) {
+			return FilePath;
+		}
+	}
+
+	return {};
+}
+
+static FString GetDependencyFilePath(const FCacheDependency& Dependency,
+                                     const FString&          AssetDirectory) {
+	return AssetDirectory.IsEmpty()
+	           ? Dependency.FilePath
+	           : FPaths::ConvertRelativePathToFull(AssetDirectory,
+	                                               Dependency.FilePath);
+}
+
+static void SerializeMeshData(FArchive& Ar, FLoadedMeshData& MeshData) {
+	// node list
+	auto NumNodes = MeshData.NodeList.Num();
+	Ar << NumNodes;
+	if (Ar.IsLoading()) {
+		if (NumNodes < 0) {
+			Ar.SetError();
+			return;
+		}
+		MeshData.NodeList.SetNum(NumNodes);
+	}
+	for (auto& Node : MeshData.NodeList) {
+		Ar << Node.Name;
+		Ar << Node.RelativeTransform;
+		SerializeRawArray(Ar, Node.SectionIndices);
+		Ar << Node.ParentNodeIndex;
+	}
+
+	// section list
+	auto NumSections = MeshData.SectionList.Num();
+	Ar << NumSections;
+	if (Ar.IsLoading()) {
+		if (NumSections < 0) {
+			Ar.SetError();
+			return;
+		}
+		MeshData.SectionList.SetNum(NumSections);
+	}
+	for (auto& Section : MeshData.SectionList) {
+		SerializeRawArray(Ar, Section.Vertices);
+		SerializeRawArray(Ar, Section.Triangles);
+		SerializeRawArray(Ar, Section.Normals);
+		SerializeRawArray(Ar, Section.UV0Channel);
+		SerializeRawArray(Ar, Section.VertexColors0);
+		SerializeRawArray(Ar, Section.Tangents);
+		SerializeRawArray(Ar, Section.CompactVertices);
+		SerializeRawArray(Ar, Section.CompactTriangles);
+		SerializeRawArray(Ar, Section.CompactNormals);
+		SerializeRawArray(Ar, Section.CompactUV0Channel);
+		SerializeRawArray(Ar, Section.CompactVertexColors0);
+		SerializeRawArray(Ar, Section.CompactTangents);
+		Ar << Section.MaterialIndex;
+	}
+
+	// material list
+	auto NumMaterials = MeshData.MaterialList.Num();
+	Ar << NumMaterials;
+	if (Ar.IsLoading()) {
+		if (NumMaterials < 0) {
+			Ar.SetError();
+			return;
+		}
+		MeshData.MaterialList.SetNum(NumMaterials);
+	}
+	for (auto& MaterialData : MeshData.MaterialList) {
+		Ar << MaterialData.Color;
+		Ar << MaterialData.TextureIndex;
+		auto ColorStatus = static_cast<int32>(MaterialData.ColorStatus);
+		Ar << ColorStatus;
+		MaterialData.ColorStatus = static_cast<EColorStatus>(ColorStatus);
+	}
+
+	// texture list
+	auto NumTextures = MeshData.TextureList.Num();
+	Ar << NumTextures;
+	if (Ar.IsLoading()) {
+		if (NumTextures < 0) {
+			Ar.SetError();
+			return;
+		}
+		MeshData.TextureList.SetNum(NumTextures);
+	}
+	for (auto& TextureData : MeshData.TextureList) {
+		// external textures are not stored, but read again by the caller after
+		// loading, so that modified files are not missed. Their paths are
+		// stored as the asset refers to them, and resolved by the caller
+		// against the directory of the asset, since byte-identical assets in
+		// other directories share the entry.
+		Ar << TextureData.SourceFilePathInAsset;
+		if (!TextureData.SourceFilePathInAsset.IsEmpty()) {
+			continue;
+		}
+
+		SerializeRawArray(Ar, TextureData.CompressedData);
+		SerializeRawArray(Ar, TextureData.RawData);
+		Ar << TextureData.RawWidth;
+		Ar << TextureData.RawHeight;
+		Ar << TextureData.RawFormat;
+		Ar << TextureData.NumMips;
+		Ar << TextureData.bSRGB;
+		Ar << TextureData.MemorySize;
+	}
+
+	// reject a corrupt entry whose sizes still match
+	if (Ar.IsLoading() && !Ar.IsError() && !IsValidMeshData(MeshData)) {
+		Ar.SetError();
+	}
+}
+
+static bool IsValidMeshData(const FLoadedMeshData& MeshData) {
+	const auto& NumSections  = MeshData.SectionList.Num();
+	const auto& NumMaterials = MeshData.MaterialList.Num();
+	const auto& NumTextures  = MeshData.TextureList.Num();
+
+	// nodes (the root has no parent, and the others are created after their
+	// parents)
+	const auto& NodeList = MeshData.NodeList;
+	for (auto Node_i = 1; Node_i < NodeList.Num(); ++Node_i) {
+		const auto& ParentNodeIndex = NodeList[Node_i].ParentNodeIndex;
+		if (ParentNodeIndex < 0 || Node_i <= ParentNodeIndex) {
+			return false;
+		}
+	}
+	for (const auto& Node : NodeList) {
+		if (!AreIndicesInRange(Node.SectionIndices, NumSections)) {
+			return false;
+		}
+	}
+
+	// sections
+	for (const auto& Section : MeshData.SectionList) {
+		if (Section.MaterialIndex < 0 || NumMaterials <= Section.MaterialIndex) {
+			return false;
+		}
+
+		// attribute streams are absent, constant or per vertex
+		const auto& NumVertices = Section.IsCompact()
+		                              ? Section.CompactVertices.Num()
+		                              : Section.Vertices.Num();
+		const auto& IsValidStream = [NumVertices](const auto& Stream) {
+			return Stream.Num() <= 1 || NumVertices == Stream.Num();
+		};
+		if (!IsValidStream(Section.Normals) ||
+		    !IsValidStream(Section.UV0Channel) ||
+		    !IsValidStream(Section.VertexColors0) ||
+		    !IsValidStream(Section.Tangents) ||
+		    !IsValidStream(Section.CompactNormals) ||
+		    !IsValidStream(Section.CompactUV0Channel) ||
+		    !IsValidStream(Section.CompactVertexColors0) ||
+		    !IsValidStream(Section.CompactTangents)) {
+			return false;
+		}
+
+		// triangles
+		if (0 != Section.Triangles.Num() % 3 ||
+		    0 != Section.CompactTriangles.Num() % 3 ||
+		    !AreIndicesInRange(Section.Triangles, NumVertices) ||
+		    !AreIndicesInRange(Section.CompactTriangles, NumVertices)) {
+			return false;
+		}
+	}
+
+	// materials
+	for (const auto& MaterialData : MeshData.MaterialList) {
+		switch (MaterialData.ColorStatus) {
+		case EColorStatus::TextureIsSet:
+			if (MaterialData.TextureIndex < 0 ||
+			    NumTextures <= MaterialData.TextureIndex) {
+				return false;
+			}
+			break;
+		case EColorStatus::None:
+		case EColorStatus::ColorIsSet:
+		case EColorStatus::TextureWasSetButError:
+			break;
+		default:
+			return false;
+		}
+	}
+
+	return true;
+}
+
+template <typename IndexT>
+static bool AreIndicesInRange(const TArray<IndexT>& Indices, const int32 Num) {
+	for (const auto& Index : Indices) {
+		if (static_cast<int64>(Index) < 0 || Num <= static_cast<int64>(Index)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+template <typename T>
+static void SerializeRawArray(FArchive& Ar, TArray<T>& Array) {
+	static_assert(TIsRawSerializable<T>::Value,
+	              "Only trivially copyable elements can be serialized raw.");
+
+	// number of elements
+	auto Num = Array.Num();
+	Ar << Num;
+
+	if (Ar.IsLoading()) {
+		// reject broken sizes before allocating
+		if (Num < 0 ||
+		    Ar.TotalSize() - Ar.Tell() < static_cast<int64>(Num) * sizeof(T)) {
+			Ar.SetError();
+			return;
+		}
+		Array.SetNumUninitialized(Num);
+	}
+
+	// elements as one block
+	Ar.Serialize(Array.GetData(), static_cast<int64>(Num) * sizeof(T));
+}
+#pragma endregion
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AssetImportProfile.h"
+#include "CoreMinimal.h"
+#include "LoadedMeshData.h"
+
+/**
+ * Persistent on-disk cache of converted mesh data.
+ * Each entry is a file in the cache directory named after a key made from the
+ * content hash of the source asset, the import profile and whether the native
+ * loaders are enabled. Entries are stored in a versioned binary layout where
+ * vertex streams are written as raw arrays, so loading an entry is a few
+ * memcpys instead of an assimp import.
+ * External textures are stored as their paths in the asset only, and the
+ * caller must resolve those paths against the directory of the asset and load
+ * the textures after finding an entry.
+ * The other files an asset was converted from (e.g. the .bin of a .gltf, or
+ * the .mtl of an .obj) are recorded in the entry with their size and
+ * modification time, and an entry is found only if none of them has changed.
+ * They are recorded relative to the directory of the asset, so that the same
+ * asset in another directory is checked against its own files.
+ * The cache is bounded by URuntimeAssetImportSettings::MaxDiskCacheSizeMB and
+ * the least recently used entries are evicted first.
+ * All functions are thread-safe.
+ */
+class FMeshDataDiskCache {
+public:
+	/**
+	 * Whether the disk cache is enabled in the project settings.
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Make a cache key for an asset file.
+	 * @param   FilePath        Path to the asset file.
+	 * @param   ImportProfile   Import profile used to load the file.
+	 * @return  the key, or unset if the file cannot be read.
+	 */
+	static TOptional<FString> MakeKey(const FString&             FilePath,
+	                                  const FAssetImportProfile& ImportProfile);
+
+	/**
+	 * Make a cache key for asset data on memory.
+	 * @param   AssetData       Asset data on memory.
+	 * @param   ImportProfile   Import profile used to load the data.
+	 * @return  the key
+	 */
+	static FString MakeKey(const TArray<uint8>&       AssetData,
+	                       const FAssetImportProfile& ImportProfile);
+
+	/**
+	 * Find cached mesh data.
+	 * @param        Key                   key made by MakeKey
+	 * @param        AssetDirectory        directory of the asset file, which
+	 *                                     the files the entry depends on are
+	 *                                     relative to. Empty for asset data on
+	 *                                     memory.
+	 * @param[out]   DependencyFilePaths   full paths of the files the entry
+	 *                                     depends on, set if it is found
+	 * @return  the cached mesh data, or unset if there is no valid entry or
+	 *          any file it depends on has changed.
+	 */
+	static TOptional<FLoadedMeshData>
+	    Find(const FString& Key, const FString& AssetDirectory,
+	         TArray<FString>& DependencyFilePaths);
+
+	/**
+	 * Store mesh data in the cache, and evict old entries if the cache has
+	 * grown larger than the limit.
+	 * @param   Key                   key made by MakeKey
+	 * @param   MeshData              mesh data to store
+	 * @param   AssetDirectory        directory of the asset file. Empty for
+	 *                                asset data on memory.
+	 * @param   DependencyFilePaths   full paths of the files other than the
+	 *                                asset that MeshData was converted from
+	 */
+	static void Store(const FString& Key, const FLoadedMeshData& MeshData,
+	                  const FString&         AssetDirectory,
+	                  const TArray<FString>& DependencyFilePaths);
+
+	/* internal functions */
+private:
+	// get absolute path of the cache directory
+	static FString GetCacheDirectory();
+
+	// get absolute path of the cache file of Key
+	static FString GetCacheFilePath(const FString& Key);
+
+	// delete least recently used entries until the cache fits in the limit
+	static void EvictLeastRecentlyUsed();
+};
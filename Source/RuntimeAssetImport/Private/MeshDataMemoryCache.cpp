@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MeshDataMemoryCache.h"
+
+#include "HAL/FileManager.h"
+#include "Hash/xxhash.h"
+#include "Misc/Paths.h"
+#include "RuntimeAssetImportSettings.h"
+
+FMeshDataMemoryCache& FMeshDataMemoryCache::Get() {
+	static FMeshDataMemoryCache Instance;
+	return Instance;
+}
+
+FMeshDataMemoryCache::FMeshDataMemoryCache()
+    : Cache(TEXT("memory cache"), [] {
+	      return SIZE_T(GetDefault<URuntimeAssetImportSettings>()
+	                        ->MaxMemoryCacheSizeMB) *
+	             1024 * 1024;
+      }) {}
+
+bool FMeshDataMemoryCache::IsEnabled() {
+	return GetDefault<URuntimeAssetImportSettings>()->bEnableMemoryCache;
+}
+
+TOptional<FString>
+    FMeshDataMemoryCache::MakeKey(const FString&             FilePath,
+                                  const FAssetImportProfile& ImportProfile) {
+	// get modification time and size
+	const auto& StatData = IFileManager::Get().GetStatData(*FilePath);
+	if (!StatData.bIsValid || StatData.bIsDirectory) {
+		return {};
+	}
+
+	// make the path absolute, so that different relative paths to the same
+	// file share the entry
+	return FString::Printf(TEXT("file:%s|%lld|%lld|%08x"),
+	                       *FPaths::ConvertRelativePathToFull(FilePath),
+	                       StatData.ModificationTime.GetTicks(),
+	                       StatData.FileSize, GetTypeHash(ImportProfile));
+}
+
+FString FMeshDataMemoryCache::MakeKey(const TArray<uint8>&       AssetData,
+                                      const FAssetImportProfile& ImportProfile) {
+	// hash content
+	const auto& ContentHash =
+	    FXxHash128::HashBuffer(AssetData.GetData(), AssetData.Num());
+
+	return FString::Printf(TEXT("data:%016llx%016llx|%08x"),
+	                       ContentHash.HighPart, ContentHash.LowPart,
+	                       GetTypeHash(ImportProfile));
+}
+
+UE::Tasks::TTask<FLoadedMeshDataPtr>
+    FMeshDataMemoryCache::FindOrLoad(const FString& Key,
+                                     FLoadFunction  LoadFunction) {
+	return Cache.FindOrLoad(Key, [this, &Key, &LoadFunction] {
+		// task to load and add to the cache
+		return UE::Tasks::Launch(
+		    UE_SOURCE_LOCATION,
+		    [this, Key, LoadFunction = MoveTemp(LoadFunction)]() {
+			    // load
+			    TArray<FString> DependencyFilePaths;
+			    auto            MeshData = LoadFunction(DependencyFilePaths);
+
+			    // the mesh data also depends on the external textures read
+			    // into it
+			    if (MeshData.IsValid()) {
+				    for (const auto& TextureData : MeshData->TextureList) {
+					    const auto& TextureFilePath = TextureData.SourceFilePath;
+					    if (!TextureFilePath.IsEmpty()) {
+						    DependencyFilePaths.AddUnique(TextureFilePath);
+					    }
+				    }
+			    }
+
+			    return Cache.FinishLoad(Key, MoveTemp(MeshData),
+			                            DependencyFilePaths);
+		    },
+		    LowLevelTasks::ETaskPriority::BackgroundNormal);
+	});
+}
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AssetImportProfile.h"
+#include "CoalescingLruCache.h"
+#include "CoreMinimal.h"
+#include "LoadedMeshData.h"
+#include "Tasks/Task.h"
+
+/**
+ * In-process cache of loaded mesh data shared between callers.
+ * Entries are immutable and reference-counted, so a caller keeps its data
+ * alive even after the entry is evicted. The cache is bounded by
+ * URuntimeAssetImportSettings::MaxMemoryCacheSizeMB and the least recently
+ * used entries are evicted first. Concurrent requests for the same key are
+ * coalesced onto one in-flight load.
+ * Each entry records the size and modification time of the files it was
+ * converted from other than the asset (e.g. the .bin of a .gltf, the .mtl of
+ * an .obj and external textures), and is found only if none of them has
+ * changed, in the same way as the disk cache.
+ * All functions are thread-safe.
+ */
+class FMeshDataMemoryCache {
+public:
+	/**
+	 * Function that loads mesh data, returning null on failure.
+	 * @param[out]   DependencyFilePaths   full paths of the files other than
+	 *                                     the asset that the mesh data was
+	 *                                     converted from
+	 */
+	using FLoadFunction = TUniqueFunction<FLoadedMeshDataPtr(
+	    TArray<FString>& DependencyFilePaths)>;
+
+public:
+	/**
+	 * Get the process-wide instance.
+	 */
+	static FMeshDataMemoryCache& Get();
+
+	FMeshDataMemoryCache();
+
+	/**
+	 * Whether the memory cache is enabled in the project settings.
+	 */
+	static bool IsEnabled();
+
+	/**
+	 * Make a cache key for an asset file from its path, modification time and
+	 * size.
+	 * @param   FilePath        Path to the asset file.
+	 * @param   ImportProfile   Import profile used to load the file.
+	 * @return  the key, or unset if the file does not exist.
+	 */
+	static TOptional<FString> MakeKey(const FString&             FilePath,
+	                                  const FAssetImportProfile& ImportProfile);
+
+	/**
+	 * Make a cache key for asset data on memory from its content hash.
+	 * @param   AssetData       Asset data on memory.
+	 * @param   ImportProfile   Import profile used to load the data.
+	 * @return  the key
+	 */
+	static FString MakeKey(const TArray<uint8>&       AssetData,
+	                       const FAssetImportProfile& ImportProfile);
+
+public:
+	/**
+	 * Find the mesh data of Key, or load it with LoadFunction.
+	 * If the data is cached and none of the files it depends on has changed,
+	 * a completed task is returned. If another load of the same key is in
+	 * flight, its task is returned. Otherwise LoadFunction is launched on a
+	 * worker thread and its result is added to the cache.
+	 * @param   Key            key made by MakeKey
+	 * @param   LoadFunction   function that loads the mesh data. Failures are
+	 *                         not cached.
+	 * @return  task whose result is the mesh data, or null on failure.
+	 */
+	UE::Tasks::TTask<FLoadedMeshDataPtr> FindOrLoad(const FString& Key,
+	                                                FLoadFunction LoadFunction);
+
+	/* internal fields */
+private:
+	// cached mesh data
+	TCoalescingLruCache<FLoadedMeshData> Cache;
+};
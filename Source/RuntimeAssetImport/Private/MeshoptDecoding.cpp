@@ -0,0 +1,555 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MeshoptDecoding.h"
+
+// headers of the encoded streams (the low 4 bits are the version)
+static constexpr uint8 MeshoptVertexHeader   = 0xA0;
+static constexpr uint8 MeshoptIndexHeader    = 0xE0;
+static constexpr uint8 MeshoptSequenceHeader = 0xD0;
+
+// vertex codec: each byte of the vertices of a block is encoded as groups of
+// 16 deltas, a group reads at most 24 bytes, a block has at most 256 vertices
+// (and 8 KiB), and the stream ends with the first vertex padded to 32 bytes
+static constexpr int32 VertexByteGroupSize        = 16;
+static constexpr int64 VertexByteGroupDecodeLimit = 24;
+static constexpr int32 VertexBlockSizeBytes       = 8192;
+static constexpr int32 VertexBlockMaxSize         = 256;
+static constexpr int64 VertexTailMaxSize          = 32;
+
+// index codec: the stream ends with a table of 16 codes for the most common
+// triangles
+static constexpr int64 IndexCodeTableSize = 16;
+
+// index sequence codec: the stream ends with 4 bytes of padding
+static constexpr int64 IndexSequenceTailSize = 4;
+
+#pragma region forward declarations of static functions
+/**
+ * Decode vertex data (mode ATTRIBUTES).
+ * @param        Data         compressed data
+ * @param        Size         size of Data in bytes
+ * @param        Count        number of vertices
+ * @param        ByteStride   size of a vertex in bytes (a multiple of 4, up to
+ *                            256)
+ * @param[out]   Vertices     decoded vertices
+ * @return  whether Data is valid
+ */
+static bool DecodeVertexBuffer(const uint8* Data, int64 Size, int32 Count,
+                               int32 ByteStride, uint8* Vertices);
+
+/**
+ * Decode a block of vertices: each of their bytes as a sequence of deltas from
+ * the same byte of the previous vertex.
+ * @param           Data          start of the block
+ * @param           DataEnd       end of the compressed data
+ * @param[out]      Vertices      decoded vertices
+ * @param           NumVertices   number of vertices of the block
+ * @param           ByteStride    size of a vertex in bytes
+ * @param[in,out]   LastVertex    previous vertex, updated to the last vertex
+ *                                of the block
+ * @return  the end of the block, nullptr if it is truncated
+ */
+static const uint8* DecodeVertexBlock(const uint8* Data, const uint8* DataEnd,
+                                      uint8* Vertices, int32 NumVertices,
+                                      int32 ByteStride, uint8* LastVertex);
+
+/**
+ * Decode groups of 16 bytes, each encoded with 0, 2, 4 or 8 bits per byte as
+ * the 2-bit modes before them say.
+ * @param        Data       start of the modes
+ * @param        DataEnd    end of the compressed data
+ * @param[out]   Bytes      decoded bytes
+ * @param        NumBytes   number of bytes (a multiple of 16)
+ * @return  the end of the groups, nullptr if they are truncated
+ */
+static const uint8* DecodeByteGroups(const uint8* Data, const uint8* DataEnd,
+                                     uint8* Bytes, int32 NumBytes);
+
+/**
+ * Decode a group of 16 bytes. Bytes that do not fit in 2 or 4 bits are
+ * stored whole after the packed bits.
+ * @param        Data       start of the group
+ * @param[out]   Bytes      decoded bytes
+ * @param        BitsLog2   mode of the group: 0 for zeros, 1 for 2 bits, 2 for
+ *                          4 bits, 3 for whole bytes
+ * @return  the end of the group
+ */
+static const uint8* DecodeByteGroup(const uint8* Data, uint8* Bytes,
+                                    int32 BitsLog2);
+
+/**
+ * Decode triangle indices (mode TRIANGLES), which refer to recent edges and
+ * vertices through FIFOs.
+ * @param        Data        compressed data
+ * @param        Size        size of Data in bytes
+ * @param        Count       number of indices (a multiple of 3)
+ * @param        IndexSize   size of an index in bytes (2 or 4)
+ * @param[out]   Indices     decoded indices
+ * @return  whether Data is valid
+ */
+static bool DecodeIndexBuffer(const uint8* Data, int64 Size, int32 Count,
+                              int32 IndexSize, uint8* Indices);
+
+/**
+ * Decode indices that are not triangles (mode INDICES), each a delta from one
+ * of the last two indices.
+ * @param        Data        compressed data
+ * @param        Size        size of Data in bytes
+ * @param        Count       number of indices
+ * @param        IndexSize   size of an index in bytes (2 or 4)
+ * @param[out]   Indices     decoded indices
+ * @return  whether Data is valid
+ */
+static bool DecodeIndexSequence(const uint8* Data, int64 Size, int32 Count,
+                                int32 IndexSize, uint8* Indices);
+
+/**
+ * Decode a variable-length integer (7 bits per byte, up to 5 bytes).
+ * @param[in,out]   Data   start of the integer, moved past it
+ */
+static uint32 DecodeVByte(const uint8*& Data);
+
+/**
+ * Decode a zigzag-encoded delta from the last index.
+ * @param[in,out]   Data   start of the delta, moved past it
+ * @param           Last   last index
+ */
+static uint32 DecodeIndexDelta(const uint8*& Data, uint32 Last);
+
+/**
+ * Write an index.
+ * @param[out]   Indices     indices
+ * @param        Index_i     position of the index
+ * @param        IndexSize   size of an index in bytes (2 or 4)
+ * @param        Index       index to write
+ */
+static void WriteIndex(uint8* Indices, int64 Index_i, int32 IndexSize,
+                       uint32 Index);
+
+/**
+ * Reconstruct unit vectors from their octahedral encoding, keeping the fourth
+ * component.
+ * @tparam          T       component type (int8 or int16)
+ * @param[in,out]   Data    vectors of 4 components
+ * @param           Count   number of vectors
+ */
+template <typename T>
+static void DecodeOctahedralFilter(T* Data, int32 Count);
+
+/**
+ * Reconstruct unit quaternions from 3 of their components, the fourth being
+ * the largest.
+ * @param[in,out]   Data    quaternions of 4 components
+ * @param           Count   number of quaternions
+ */
+static void DecodeQuaternionFilter(int16* Data, int32 Count);
+
+/**
+ * Reconstruct floats from 24-bit mantissas and 8-bit exponents.
+ * @param[in,out]   Data    floats
+ * @param           Count   number of floats
+ */
+static void DecodeExponentialFilter(uint32* Data, int64 Count);
+#pragma endregion
+
+bool DecodeMeshoptData(const uint8* const Data, const int64 Size,
+                       const EMeshoptMode Mode, const EMeshoptFilter Filter,
+                       const int32 Count, const int32 ByteStride,
+                       uint8* const Decoded) {
+	// decode
+	switch (Mode) {
+	case EMeshoptMode::Attributes:
+		if (ByteStride <= 0 || 0 != ByteStride % 4 || ByteStride > 256 ||
+		    !DecodeVertexBuffer(Data, Size, Count, ByteStride, Decoded)) {
+			return false;
+		}
+		break;
+	case EMeshoptMode::Triangles:
+		if ((2 != ByteStride && 4 != ByteStride) || 0 != Count % 3 ||
+		    EMeshoptFilter::None != Filter ||
+		    !DecodeIndexBuffer(Data, Size, Count, ByteStride, Decoded)) {
+			return false;
+		}
+		break;
+	default:
+		if ((2 != ByteStride && 4 != ByteStride) ||
+		    EMeshoptFilter::None != Filter ||
+		    !DecodeIndexSequence(Data, Size, Count, ByteStride, Decoded)) {
+			return false;
+		}
+		break;
+	}
+
+	// apply filter
+	switch (Filter) {
+	case EMeshoptFilter::Octahedral:
+		if (4 == ByteStride) {
+			DecodeOctahedralFilter(reinterpret_cast<int8*>(Decoded), Count);
+		} else if (8 == ByteStride) {
+			DecodeOctahedralFilter(reinterpret_cast<int16*>(Decoded), Count);
+		} else {
+			return false;
+		}
+		break;
+	case EMeshoptFilter::Quaternion:
+		if (8 != ByteStride) {
+			return false;
+		}
+		DecodeQuaternionFilter(reinterpret_cast<int16*>(Decoded), Count);
+		break;
+	case EMeshoptFilter::Exponential:
+		DecodeExponentialFilter(reinterpret_cast<uint32*>(Decoded),
+		                        int64{Count} * ByteStride / 4);
+		break;
+	default:
+		break;
+	}
+
+	return true;
+}
+
+#pragma region definitions of static functions
+static bool DecodeVertexBuffer(const uint8* const Data, const int64 Size,
+                               const int32 Count, const int32 ByteStride,
+                               uint8* const Vertices) {
+	// header (version 0 only)
+	if (Size < 1 + ByteStride || MeshoptVertexHeader != Data[0]) {
+		return false;
+	}
+
+	// the first vertex is the last bytes of the stream, and each block
+	// continues from the last vertex of the previous one
+	const auto& DataEnd = Data + Size;
+	uint8       LastVertex[256];
+	FMemory::Memcpy(LastVertex, DataEnd - ByteStride, ByteStride);
+
+	// blocks of up to 8 KiB of whole groups
+	const auto& BlockSize = FMath::Min(
+	    VertexBlockSizeBytes / ByteStride & ~(VertexByteGroupSize - 1),
+	    VertexBlockMaxSize);
+	auto Block = Data + 1;
+	for (auto Vertex_i = 0; Vertex_i < Count; Vertex_i += BlockSize) {
+		Block = DecodeVertexBlock(Block, DataEnd,
+		                          Vertices + int64{Vertex_i} * ByteStride,
+		                          FMath::Min(BlockSize, Count - Vertex_i),
+		                          ByteStride, LastVertex);
+		if (nullptr == Block) {
+			return false;
+		}
+	}
+
+	// only the first vertex (padded) must follow the blocks
+	const auto& TailSize = FMath::Max(int64{ByteStride}, VertexTailMaxSize);
+	return DataEnd - Block == TailSize;
+}
+
+static const uint8* DecodeVertexBlock(const uint8* Data,
+                                      const uint8* const DataEnd,
+                                      uint8* const Vertices,
+                                      const int32 NumVertices,
+                                      const int32 ByteStride,
+                                      uint8* const LastVertex) {
+	uint8 Deltas[VertexBlockMaxSize];
+	const auto& NumAlignedVertices = Align(NumVertices, VertexByteGroupSize);
+	for (auto Byte_i = 0; Byte_i < ByteStride; ++Byte_i) {
+		Data = DecodeByteGroups(Data, DataEnd, Deltas, NumAlignedVertices);
+		if (nullptr == Data) {
+			return nullptr;
+		}
+
+		// add zigzag-encoded deltas
+		auto Previous = LastVertex[Byte_i];
+		for (auto i = 0; i < NumVertices; ++i) {
+			const auto& Delta = Deltas[i];
+			Previous =
+			    static_cast<uint8>(Previous + ((Delta >> 1) ^ -(Delta & 1)));
+			Vertices[int64{i} * ByteStride + Byte_i] = Previous;
+		}
+		LastVertex[Byte_i] = Previous;
+	}
+
+	return Data;
+}
+
+static const uint8* DecodeByteGroups(const uint8* Data,
+                                     const uint8* const DataEnd,
+                                     uint8* const Bytes, const int32 NumBytes) {
+	// modes of the groups, 4 in each byte
+	const auto&       NumGroups = NumBytes / VertexByteGroupSize;
+	const auto* const Modes     = Data;
+	if (DataEnd - Data < (NumGroups + 3) / 4) {
+		return nullptr;
+	}
+	Data += (NumGroups + 3) / 4;
+
+	// groups (the encoder pads the stream so that a group is read whole
+	// without checking each byte)
+	for (auto Group_i = 0; Group_i < NumGroups; ++Group_i) {
+		if (DataEnd - Data < VertexByteGroupDecodeLimit) {
+			return nullptr;
+		}
+		const auto& BitsLog2 = Modes[Group_i / 4] >> (Group_i % 4 * 2) & 3;
+		Data = DecodeByteGroup(Data, Bytes + Group_i * VertexByteGroupSize,
+		                       BitsLog2);
+	}
+
+	return Data;
+}
+
+static const uint8* DecodeByteGroup(const uint8* const Data,
+                                    uint8* const Bytes, const int32 BitsLog2) {
+	switch (BitsLog2) {
+	case 0:
+		FMemory::Memzero(Bytes, VertexByteGroupSize);
+		return Data;
+	case 3:
+		FMemory::Memcpy(Bytes, Data, VertexByteGroupSize);
+		return Data + VertexByteGroupSize;
+	default: {
+		// packed bits (most significant first), where all ones stands for the
+		// next whole byte after them
+		const auto& Bits   = 1 << BitsLog2;
+		const auto& Escape = (1 << Bits) - 1;
+		auto        Extra  = Data + VertexByteGroupSize * Bits / 8;
+		for (auto i = 0; i < VertexByteGroupSize; ++i) {
+			const auto& Value =
+			    Data[i * Bits / 8] >> (8 - Bits - i * Bits % 8) & Escape;
+			Bytes[i] = Escape == Value ? *Extra++ : static_cast<uint8>(Value);
+		}
+		return Extra;
+	}
+	}
+}
+
+static bool DecodeIndexBuffer(const uint8* const Data, const int64 Size,
+                              const int32 Count, const int32 IndexSize,
+                              uint8* const Indices) {
+	// header (versions 0 and 1), a code per triangle, and the code table
+	const auto& NumTriangles = Count / 3;
+	if (Size < 1 + NumTriangles + IndexCodeTableSize ||
+	    MeshoptIndexHeader != (Data[0] & 0xF0) || (Data[0] & 0x0F) > 1) {
+		return false;
+	}
+	const auto& Version  = Data[0] & 0x0F;
+	const auto& MaxFec   = Version >= 1 ? 13 : 15;
+	auto        Code     = Data + 1;
+	auto        Extra    = Code + NumTriangles;
+	const auto& ExtraEnd = Data + Size - IndexCodeTableSize;
+	const auto& Table    = ExtraEnd;
+
+	// FIFOs of recent edges and vertices, the next new vertex, and the last
+	// vertex written as a delta
+	uint32 EdgeFifo[16][2];
+	uint32 VertexFifo[16];
+	FMemory::Memset(EdgeFifo, 0xFF, sizeof(EdgeFifo));
+	FMemory::Memset(VertexFifo, 0xFF, sizeof(VertexFifo));
+	auto       EdgeFifoOffset   = 0;
+	auto       VertexFifoOffset = 0;
+	uint32     Next             = 0;
+	uint32     Last             = 0;
+	const auto PushEdge = [&](const uint32 A, const uint32 B) {
+		EdgeFifo[EdgeFifoOffset][0] = A;
+		EdgeFifo[EdgeFifoOffset][1] = B;
+		EdgeFifoOffset              = (EdgeFifoOffset + 1) & 15;
+	};
+	const auto PushVertex = [&](const uint32 V, const bool bPush = true) {
+		VertexFifo[VertexFifoOffset] = V;
+		VertexFifoOffset = (VertexFifoOffset + (bPush ? 1 : 0)) & 15;
+	};
+
+	for (auto Triangle_i = 0; Triangle_i < NumTriangles; ++Triangle_i) {
+		// a triangle reads at most 16 bytes, which the code table guarantees
+		if (Extra > ExtraEnd) {
+			return false;
+		}
+
+		const auto& CodeTri = *Code++;
+		uint32      A, B, C;
+		if (CodeTri < 0xF0) {
+			// an edge from the FIFO, and a vertex that is new, from the FIFO,
+			// or written
+			const auto& Fe  = CodeTri >> 4;
+			const auto& Fec = CodeTri & 15;
+			A               = EdgeFifo[(EdgeFifoOffset - 1 - Fe) & 15][0];
+			B               = EdgeFifo[(EdgeFifoOffset - 1 - Fe) & 15][1];
+			if (Fec < MaxFec) {
+				C = 0 == Fec ? Next++
+				             : VertexFifo[(VertexFifoOffset - 1 - Fec) & 15];
+				PushVertex(C, 0 == Fec);
+			} else {
+				// 13 and 14 are the last vertex minus and plus 1
+				C = Last = 15 == Fec ? DecodeIndexDelta(Extra, Last)
+				                     : Last + (13 == Fec ? -1 : 1);
+				PushVertex(C);
+			}
+			PushEdge(C, B);
+			PushEdge(A, C);
+		} else {
+			// a new vertex (or a written one for 0xFF) and two vertices that
+			// are new, from the FIFO, or written, coded in the table or in
+			// the next byte
+			const auto& CodeAux =
+			    CodeTri < 0xFE ? Table[CodeTri & 15] : *Extra++;
+			const auto& Feb = CodeAux >> 4;
+			const auto& Fec = CodeAux & 15;
+			if (CodeTri >= 0xFE && 0 == CodeAux) {
+				Next = 0;
+			}
+			A = 0xFF == CodeTri ? 0 : Next++;
+			B = 0 == Feb ? Next++ : VertexFifo[(VertexFifoOffset - Feb) & 15];
+			C = 0 == Fec ? Next++ : VertexFifo[(VertexFifoOffset - Fec) & 15];
+			if (0xFF == CodeTri) {
+				A = Last = DecodeIndexDelta(Extra, Last);
+			}
+			if (CodeTri >= 0xFE && 15 == Feb) {
+				B = Last = DecodeIndexDelta(Extra, Last);
+			}
+			if (CodeTri >= 0xFE && 15 == Fec) {
+				C = Last = DecodeIndexDelta(Extra, Last);
+			}
+			PushVertex(A);
+			PushVertex(B, 0 == Feb || 15 == Feb);
+			PushVertex(C, 0 == Fec || 15 == Fec);
+			PushEdge(B, A);
+			PushEdge(C, B);
+			PushEdge(A, C);
+		}
+
+		WriteIndex(Indices, 3 * int64{Triangle_i}, IndexSize, A);
+		WriteIndex(Indices, 3 * int64{Triangle_i} + 1, IndexSize, B);
+		WriteIndex(Indices, 3 * int64{Triangle_i} + 2, IndexSize, C);
+	}
+
+	// all data must have been read up to the code table
+	return Extra == ExtraEnd;
+}
+
+static bool DecodeIndexSequence(const uint8* const Data, const int64 Size,
+                                const int32 Count, const int32 IndexSize,
+                                uint8* const Indices) {
+	// header (versions 0 and 1), at least a byte per index, and the tail
+	if (Size < 1 + Count + IndexSequenceTailSize ||
+	    MeshoptSequenceHeader != (Data[0] & 0xF0) || (Data[0] & 0x0F) > 1) {
+		return false;
+	}
+	auto        Encoded    = Data + 1;
+	const auto& EncodedEnd = Data + Size - IndexSequenceTailSize;
+
+	// each index is a delta from one of the last two indices (chosen by the
+	// lowest bit)
+	uint32 Last[2] = {0, 0};
+	for (auto i = 0; i < Count; ++i) {
+		// an index reads at most 5 bytes, which the tail guarantees
+		if (Encoded >= EncodedEnd) {
+			return false;
+		}
+		const auto& Value    = DecodeVByte(Encoded);
+		auto&       Baseline = Last[Value & 1];
+		Baseline += (Value >> 2) ^ (0u - (Value >> 1 & 1));
+		WriteIndex(Indices, i, IndexSize, Baseline);
+	}
+
+	// all data must have been read up to the tail
+	return Encoded == EncodedEnd;
+}
+
+static uint32 DecodeVByte(const uint8*& Data) {
+	const auto& Lead = *Data++;
+	if (Lead < 128) {
+		return Lead;
+	}
+
+	// up to 4 more bytes, so that malformed data does not read further
+	uint32 Value = Lead & 127;
+	for (auto Shift = 7; Shift <= 28; Shift += 7) {
+		const auto& Group = *Data++;
+		Value |= static_cast<uint32>(Group & 127) << Shift;
+		if (Group < 128) {
+			break;
+		}
+	}
+	return Value;
+}
+
+static uint32 DecodeIndexDelta(const uint8*& Data, const uint32 Last) {
+	const auto& Value = DecodeVByte(Data);
+	return Last + ((Value >> 1) ^ (0u - (Value & 1)));
+}
+
+static void WriteIndex(uint8* const Indices, const int64 Index_i,
+                       const int32 IndexSize, const uint32 Index) {
+	if (2 == IndexSize) {
+		const auto& ShortIndex = static_cast<uint16>(Index);
+		FMemory::Memcpy(Indices + Index_i * 2, &ShortIndex, sizeof(ShortIndex));
+	} else {
+		FMemory::Memcpy(Indices + Index_i * 4, &Index, sizeof(Index));
+	}
+}
+
+template <typename T>
+static void DecodeOctahedralFilter(T* const Data, const int32 Count) {
+	constexpr auto Max = static_cast<float>(TNumericLimits<T>::Max());
+	const auto&    Round = [](const float Value) {
+		return static_cast<T>(
+		    static_cast<int32>(Value + (Value >= 0.0f ? 0.5f : -0.5f)));
+	};
+	for (auto i = 0; i < Count; ++i) {
+		auto* const V = Data + 4 * int64{i};
+
+		// z is reconstructed from x and y, which are folded for the lower half
+		auto        X = static_cast<float>(V[0]);
+		auto        Y = static_cast<float>(V[1]);
+		const auto& Z =
+		    static_cast<float>(V[2]) - FMath::Abs(X) - FMath::Abs(Y);
+		const auto& Fold = FMath::Min(Z, 0.0f);
+		X += X >= 0.0f ? Fold : -Fold;
+		Y += Y >= 0.0f ? Fold : -Fold;
+
+		// normalize and round
+		const auto& Scale = Max / FMath::Sqrt(X * X + Y * Y + Z * Z);
+		V[0]              = Round(X * Scale);
+		V[1]              = Round(Y * Scale);
+		V[2]              = Round(Z * Scale);
+	}
+}
+
+static void DecodeQuaternionFilter(int16* const Data, const int32 Count) {
+	const auto& Scale = 1.0f / FMath::Sqrt(2.0f);
+	for (auto i = 0; i < Count; ++i) {
+		auto* const Q = Data + 4 * int64{i};
+
+		// the fourth short has the scale in its upper bits and the index of
+		// the omitted (largest) component in its 2 lowest bits
+		const auto& ComponentScale = Scale / static_cast<float>(Q[3] | 3);
+		const auto& X              = Q[0] * ComponentScale;
+		const auto& Y              = Q[1] * ComponentScale;
+		const auto& Z              = Q[2] * ComponentScale;
+		const auto& WW             = 1.0f - X * X - Y * Y - Z * Z;
+		const auto& W              = FMath::Sqrt(FMath::Max(WW, 0.0f));
+		const auto& Largest        = Q[3] & 3;
+
+		// round
+		const auto& Round = [](const float Value) {
+			return static_cast<int16>(static_cast<int32>(
+			    Value * 32767.0f + (Value >= 0.0f ? 0.5f : -0.5f)));
+		};
+		Q[(Largest + 1) & 3] = Round(X);
+		Q[(Largest + 2) & 3] = Round(Y);
+		Q[(Largest + 3) & 3] = Round(Z);
+		Q[Largest]           = Round(W);
+	}
+}
+
+static void DecodeExponentialFilter(uint32* const Data, const int64 Count) {
+	for (auto i = int64{0}; i < Count; ++i) {
+		// 24-bit signed mantissa, 8-bit signed exponent (as ldexp does)
+		const auto& Mantissa  = static_cast<int32>(Data[i] << 8) >> 8;
+		const auto& Exponent  = static_cast<int32>(Data[i]) >> 24;
+		const auto& ScaleBits = static_cast<uint32>(Exponent + 127) << 23;
+		float       Scale;
+		FMemory::Memcpy(&Scale, &ScaleBits, sizeof(Scale));
+		const auto& Value = Scale * static_cast<float>(Mantissa);
+		FMemory::Memcpy(&Data[i], &Value, sizeof(Value));
+	}
+}
+#pragma endregion
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * How the data of a buffer view compressed with EXT_meshopt_compression is
+ * encoded ("mode" of the extension).
+ */
+enum class EMeshoptMode : uint8 {
+	// vertex attributes, or any other data of a multiple of 4 bytes per element
+	Attributes,
+
+	// indices of triangles
+	Triangles,
+
+	// indices of anything else
+	Indices,
+};
+
+/**
+ * How decoded attributes are transformed further ("filter" of the extension).
+ */
+enum class EMeshoptFilter : uint8 {
+	// none
+	None,
+
+	// octahedral encoding of unit vectors (4 bytes or 4 shorts)
+	Octahedral,
+
+	// quaternions with 3 components and the index of the fourth (4 shorts)
+	Quaternion,
+
+	// floats with a shared exponent (4 bytes per component)
+	Exponential,
+};
+
+/**
+ * Decode the data of a buffer view compressed with EXT_meshopt_compression.
+ * The data is validated while it is decoded, so that a malformed stream is
+ * rejected instead of being read out of bounds.
+ * @param        Data         compressed data
+ * @param        Size         size of Data in bytes
+ * @param        Mode         encoding of Data
+ * @param        Filter       filter to apply after decoding (Attributes only)
+ * @param        Count        number of elements
+ * @param        ByteStride   size of an element in bytes: a multiple of 4 up
+ *                            to 256 for Attributes, 2 or 4 for indices
+ * @param[out]   Decoded      Count * ByteStride bytes of decoded elements
+ * @return  whether Data is valid and has been decoded
+ */
+bool DecodeMeshoptData(const uint8* Data, int64 Size, EMeshoptMode Mode,
+                       EMeshoptFilter Filter, int32 Count, int32 ByteStride,
+                       uint8* Decoded);
@@ -0,0 +1,1861 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ObjFile.h"
+
+#include "Async/ParallelFor.h"
+#include "ExternalTextureCache.h"
+#include "LogAssetLoader.h"
+#include "MeshDataConstruction.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#include <cstring>
+
+// size of the chunks an OBJ file is split into to be parsed concurrently, each
+// of which is extended to the end of its last line
+static constexpr int64 ObjChunkSize = 1024 * 1024;
+
+// size of the first chunk, which is counted before the others, so that a file
+// with statements that are not supported near its start is rejected without
+// reading the rest of it
+static constexpr int64 ObjPrefixSize = 64 * 1024;
+
+// smallest OBJ file that assimp's importer reads
+static constexpr int64 ObjMinSize = 16;
+
+// number of digits after the decimal point that assimp's fast_atof reads
+// (AI_FAST_ATOF_RELAVANT_DECIMALS)
+static constexpr int32 ObjMaxFractionDigits = 15;
+
+// scale of the digits after the decimal point by their number, the same
+// doubles as assimp's fast_atof_table
+static constexpr double ObjFractionScales[ObjMaxFractionDigits + 1] = {
+    0.0,   1e-1,  1e-2,  1e-3,  1e-4,  1e-5,  1e-6,  1e-7,
+    1e-8,  1e-9,  1e-10, 1e-11, 1e-12, 1e-13, 1e-14, 1e-15};
+
+// pi as assimp's Triangulate step compares the angles of quads with
+// (AI_MATH_PI_F)
+static constexpr float AiMathPiF = 3.1415926538f;
+
+// bits of the kinds of indices that the corners of a face have besides the
+// position ("v", "v/vt", "v//vn" or "v/vt/vn")
+static constexpr uint8 ObjCornerHasTexCoord = 1 << 0;
+static constexpr uint8 ObjCornerHasNormal   = 1 << 1;
+
+// post-process steps the native OBJ loader reproduces, or that do not change
+// the files it accepts (unless checked otherwise). FindInvalidData is left to
+// assimp.
+static constexpr unsigned int ObjPostProcessSteps =
+    NativePostProcessSteps & ~aiProcess_FindInvalidData;
+
+/**
+ * Kind of a line of an OBJ file, decided by its first character as assimp's
+ * OBJ parser does.
+ */
+enum class EObjStatement : uint8 {
+	// empty line, comment, or a statement that assimp ignores (e.g. "s")
+	Ignored,
+
+	// "v"
+	Position,
+
+	// "vt"
+	TexCoord,
+
+	// "vn"
+	Normal,
+
+	// "f"
+	Face,
+
+	// "o" or "g"
+	Object,
+
+	// "mtllib"
+	MaterialLibrary,
+
+	// "usemtl"
+	Material,
+
+	// a statement that the native loader leaves to assimp
+	Unsupported,
+};
+
+/**
+ * Numbers of the elements of an OBJ file, in a chunk or in all chunks before
+ * it.
+ */
+struct FObjCounts {
+	int64 NumPositions = 0;
+	int64 NumColors    = 0;
+	int64 NumTexCoords = 0;
+	int64 NumNormals   = 0;
+	int64 NumCorners   = 0;
+	int64 NumTriangles = 0;
+};
+
+/**
+ * "o", "g", "mtllib" or "usemtl" statement in a chunk of an OBJ file.
+ */
+struct FObjNamedStatement {
+	// kind of the statement (Object, MaterialLibrary or Material)
+	EObjStatement Statement = EObjStatement::Object;
+
+	// name of the object, material library or material
+	FString Name;
+
+	// numbers of the corners and triangles in the chunk before the statement
+	int64 NumCornersBefore   = 0;
+	int64 NumTrianglesBefore = 0;
+};
+
+/**
+ * Chunk of whole lines of an OBJ file.
+ */
+struct FObjChunk {
+	// lines of the chunk [Begin, End)
+	const uint8* Begin = nullptr;
+	const uint8* End   = nullptr;
+
+	// numbers of the elements in the chunk
+	FObjCounts Counts;
+
+	// numbers of the elements in the chunks before this one
+	FObjCounts First;
+
+	// kinds of indices of the first corners of the faces, as a bit
+	// (1 << kinds) for each combination found
+	uint8 CornerLayouts = 0;
+
+	// "o", "g", "mtllib" and "usemtl" statements
+	TArray<FObjNamedStatement> NamedStatements;
+
+	// first triangle of each quad, which is split again once all positions
+	// have been read
+	TArray<int32> QuadTriangles;
+
+	// why the chunk is not accepted, null if it is
+	const TCHAR* RejectionReason = nullptr;
+};
+
+/**
+ * Properties of a material of an OBJ file that assimp imports, with the
+ * defaults of assimp's OBJ material.
+ */
+struct FObjMaterialProperties {
+	// "Ka", "Kd", "Ks", "Ke" and "Tf"
+	FVector3f Ambient     = FVector3f::ZeroVector;
+	FVector3f Diffuse     = FVector3f(0.6f);
+	FVector3f Specular    = FVector3f::ZeroVector;
+	FVector3f Emissive    = FVector3f::ZeroVector;
+	FVector3f Transparent = FVector3f::OneVector;
+
+	// "Ns", "d" (or 1 - "Tr") and "Ni"
+	float Shininess       = 0.0f;
+	float Opacity         = 1.0f;
+	float RefractionIndex = 1.0f;
+
+	// "illum"
+	int32 IlluminationModel = 1;
+
+	// "map_Kd"
+	FString DiffuseTexturePath;
+};
+
+#pragma region forward declarations of static functions
+/**
+ * Split an OBJ file into chunks of whole lines. The first chunk is at most
+ * ObjPrefixSize long, and the others ObjChunkSize.
+ * @param        Data     content of the file
+ * @param        Size     size of Data in bytes
+ * @param[out]   Chunks   chunks covering the whole file
+ */
+static void SplitObjIntoChunks(const uint8* Data, int64 Size,
+                               TArray<FObjChunk>& Chunks);
+
+/**
+ * Find the end of a line (searched with memchr, which the C runtime
+ * vectorizes).
+ * @param   Line   start of the line
+ * @param   End    end of the data
+ * @return  the "\n" at the end of the line, or End if it is the last line
+ */
+static const uint8* FindObjLineEnd(const uint8* Line, const uint8* End);
+
+/**
+ * Count the statements of a chunk of an OBJ file, and find its named
+ * statements. Sets RejectionReason if the chunk is not accepted.
+ * @param[in,out]   Chunk   chunk to count
+ */
+static void CountObjChunk(FObjChunk& Chunk);
+
+/**
+ * Read the statements of a chunk of an OBJ file into their place in the
+ * parsed file, whose arrays are sized for all chunks. Sets RejectionReason if
+ * the chunk is not accepted.
+ * @param[in,out]   Chunk           chunk to read, whose counts of the chunks
+ *                                  before it are set
+ * @param           CornerLayout    kinds of indices of all corners
+ * @param           Total           numbers of the elements of the file
+ * @param[out]      File            parsed file
+ */
+static void ReadObjChunk(FObjChunk& Chunk, uint8 CornerLayout,
+                         const FObjCounts& Total, FObjFile& File);
+
+/**
+ * Make the objects, meshes and materials of an OBJ file from the named
+ * statements of its chunks, following them in order as assimp's parser does.
+ * @param        Chunks             counted chunks, whose counts of the chunks
+ *                                  before them are set
+ * @param        Total              numbers of the elements of the file
+ * @param        LibraryMaterials   materials of the library referred to by the
+ *                                  first statement, null if it does not refer
+ *                                  to one
+ * @param[out]   File               parsed file whose Objects, Meshes and
+ *                                  Materials are set
+ * @return  whether every object has a unique name, and the material library
+ *          is referred to only by the first statement. If not, the reason is
+ *          logged.
+ */
+static bool MakeObjObjects(const TArray<FObjChunk>&    Chunks,
+                           const FObjCounts&           Total,
+                           const TArray<FObjMaterial>* LibraryMaterials,
+                           FObjFile&                   File);
+
+/**
+ * Make a material of an OBJ file as assimp's OBJ importer makes it.
+ * @param   Name         name of the material
+ * @param   Properties   properties read from the material library
+ * @return  the material, whose key is made from all the properties
+ */
+static FObjMaterial MakeObjMaterial(const FString&                Name,
+                                    const FObjMaterialProperties& Properties);
+
+/**
+ * Generate the normals of the corners of an OBJ file that has none, as
+ * assimp's GenSmoothNormals step does: each corner gets the normal of its
+ * face (of the last triangle if a quad is split), and those are averaged at
+ * each position of each mesh.
+ * @param[in,out]   File   parsed file without normals, whose Normals and
+ *                         CornerNormalIndices are set (one normal for each
+ *                         corner)
+ */
+static void GenerateObjNormals(FObjFile& File);
+
+/**
+ * Decide the kind of a line by its first character, as assimp's OBJ parser
+ * does, and skip its keyword.
+ * @param[in,out]   Cursor            start of the line, moved past the keyword
+ * @param           LineEnd           end of the line (without "\r\n")
+ * @param[out]      RejectionReason   why the line is not supported, set if
+ *                                    Unsupported
+ * @return  the kind of the line
+ */
+static EObjStatement ClassifyObjLine(const uint8*& Cursor, const uint8* LineEnd,
+                                     const TCHAR*& RejectionReason);
+
+/**
+ * Whether a character separates the tokens of an OBJ statement.
+ * @param   Char   character
+ */
+static bool IsObjSpace(uint8 Char);
+
+/**
+ * Count the tokens of a statement up to a comment.
+ * @param   Cursor   start of the tokens (after the keyword)
+ * @param   End      end of the line
+ * @return  the number of tokens
+ */
+static int32 CountObjTokens(const uint8* Cursor, const uint8* End);
+
+/**
+ * Get the kinds of indices of the first corner of a face.
+ * @param   Cursor   start of the corners (after the keyword)
+ * @param   End      end of the line
+ * @return  ObjCornerHasTexCoord and ObjCornerHasNormal, or'ed
+ */
+static uint8 GetObjCornerLayout(const uint8* Cursor, const uint8* End);
+
+/**
+ * Parse the name of an "o", "g", "mtllib", "usemtl", "newmtl" or "map_Kd"
+ * statement, which must be a single token with nothing after it, so that
+ * assimp reads all of them the same way.
+ * @param        Cursor   start of the name (after the keyword)
+ * @param        End      end of the line
+ * @param[out]   Name     the name
+ * @return  whether the name is a single token
+ */
+static bool ParseObjName(const uint8* Cursor, const uint8* End, FString& Name);
+
+/**
+ * Parse the numbers of a "v", "vt" or "vn" statement, or of a property of a
+ * material library, up to a comment.
+ * @param        Cursor   start of the numbers (after the keyword)
+ * @param        End      end of the line
+ * @param[out]   Values   the numbers
+ * @param        MaxNum   capacity of Values
+ * @return  the number of numbers, INDEX_NONE if there are more than MaxNum or
+ *          any is not accepted by ParseObjFloat
+ */
+static int32 ParseObjFloats(const uint8* Cursor, const uint8* End,
+                            float* Values, int32 MaxNum);
+
+/**
+ * Parse a number with the same arithmetic as assimp's fast_atof: the integer
+ * part is converted to float, the first 15 digits after the decimal point are
+ * scaled in double and added in float, and the result is multiplied by the
+ * power of 10 of the exponent in float.
+ * Only numbers that assimp counts as numbers and reads to their end are
+ * accepted: they start with a digit or a sign, the integer part has at most 19
+ * digits, and there is no "nan", "inf" or decimal comma.
+ * @param[in,out]   Cursor   start of the number, moved past it
+ * @param           End      end of the line
+ * @param[out]      Value    the number
+ * @return  whether the number is accepted
+ */
+static bool ParseObjFloat(const uint8*& Cursor, const uint8* End, float& Value);
+
+/**
+ * Parse an index of a corner of a face, and resolve it to a 0-based index.
+ * Only indices that assimp reads the same way are accepted: a positive number,
+ * or a negative one counting back from the elements read so far, without
+ * leading zeros and in range.
+ * @param[in,out]   Cursor      start of the index, moved past it
+ * @param           End         end of the line
+ * @param           NumBefore   number of elements read before the face
+ * @param           NumTotal    number of elements in the file
+ * @param[out]      Index       the 0-based index
+ * @return  whether the index is accepted
+ */
+static bool ParseObjIndex(const uint8*& Cursor, const uint8* End,
+                          int64 NumBefore, int64 NumTotal, int32& Index);
+
+/**
+ * Find the corner of a quad that assimp's Triangulate step fans it from: the
+ * concave corner if any, or the first one. The angles are computed with the
+ * same arithmetic as assimp (mirroring Z by MakeLeftHanded first does not
+ * change them).
+ * @param   File          parsed file
+ * @param   FirstCorner   first corner of the quad
+ * @return  the corner (0 to 3)
+ */
+static int32 FindObjQuadStartCorner(const FObjFile& File, int32 FirstCorner);
+
+/**
+ * Convert a range of vertices of the section of an OBJ mesh to UE's format,
+ * as assimp would store them after its MakeLeftHanded and FlipUVs steps.
+ * The streams of the present attributes must already be sized to the number
+ * of corners of the mesh.
+ * @param        File         parsed file
+ * @param        Mesh         mesh of the section
+ * @param        Attributes   vertex attributes present in the section
+ * @param        Begin        first vertex to convert
+ * @param        End          one past the last vertex to convert
+ * @param[out]   Section      section whose streams are written
+ */
+static void ConvertObjVertexRange(const FObjFile&     File,
+                                  const FObjMesh&     Mesh,
+                                  EAiVertexAttributes Attributes, int32 Begin,
+                                  int32 End, FLoadedMeshSectionData& Section);
+
+/**
+ * Compact precision version of ConvertObjVertexRange.
+ * @param        File         parsed file
+ * @param        Mesh         mesh of the section
+ * @param        Attributes   vertex attributes present in the section
+ * @param        Begin        first vertex to convert
+ * @param        End          one past the last vertex to convert
+ * @param[out]   Section      section whose compact streams are written
+ */
+static void ConvertObjVertexRangeCompact(const FObjFile&     File,
+                                         const FObjMesh&     Mesh,
+                                         EAiVertexAttributes Attributes,
+                                         int32 Begin, int32 End,
+                                         FLoadedMeshSectionData& Section);
+
+/**
+ * Convert a range of triangles of an OBJ mesh to UE's triangle format.
+ * Triangles must already be sized to 3 times the number of triangles of the
+ * mesh.
+ * @tparam       IndexT      int32, or uint16 for compact precision
+ * @param        File        parsed file
+ * @param        Mesh        mesh of the section
+ * @param        Begin       first triangle to convert
+ * @param        End         one past the last triangle to convert
+ * @param[out]   Triangles   triangles of the section
+ */
+template <typename IndexT>
+static void ConvertObjFaceRange(const FObjFile& File, const FObjMesh& Mesh,
+                                int32 Begin, int32 End,
+                                TArray<IndexT>& Triangles);
+#pragma endregion
+
+bool ParseObj(const uint8* const Data, const int64 Size,
+              TFunctionRef<bool(const FString&, TArray<FObjMaterial>&)>
+                  LoadMaterialLibrary,
+              FObjFile& File) {
+	// assimp rejects files that are too small, and a byte order mark may be
+	// read differently
+	if (Size < ObjMinSize) {
+		return false;
+	}
+	if (Size >= 3 && 0xEF == Data[0] && 0xBB == Data[1] && 0xBF == Data[2]) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ starts with a byte order mark, so it is imported with "
+		            "assimp."));
+		return false;
+	}
+
+	// count the statements of the small first chunk, so that most files that
+	// are not supported are rejected before the rest is read
+	TArray<FObjChunk> Chunks;
+	SplitObjIntoChunks(Data, Size, Chunks);
+	auto& FirstChunk = Chunks[0];
+	CountObjChunk(FirstChunk);
+	if (nullptr != FirstChunk.RejectionReason) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ %s, so it is imported with assimp."),
+		       FirstChunk.RejectionReason);
+		return false;
+	}
+
+	// read the material library if the file starts with one, before the rest
+	TArray<FObjMaterial> LibraryMaterials;
+	const auto&          bHasMaterialLibrary =
+	    !FirstChunk.NamedStatements.IsEmpty() &&
+	    EObjStatement::MaterialLibrary ==
+	        FirstChunk.NamedStatements[0].Statement &&
+	    0 == FirstChunk.NamedStatements[0].NumCornersBefore;
+	if (bHasMaterialLibrary &&
+	    !LoadMaterialLibrary(FirstChunk.NamedStatements[0].Name,
+	                         LibraryMaterials)) {
+		return false;
+	}
+
+	// count the statements of the other chunks concurrently
+	ParallelFor(Chunks.Num() - 1, [&Chunks](const int32 Chunk_i) {
+		CountObjChunk(Chunks[Chunk_i + 1]);
+	});
+
+	// place the chunks one after another, and collect the kinds of indices of
+	// the corners
+	FObjCounts Total;
+	auto       CornerLayouts = uint8{0};
+	for (auto& Chunk : Chunks) {
+		if (nullptr != Chunk.RejectionReason) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("OBJ %s, so it is imported with assimp."),
+			       Chunk.RejectionReason);
+			return false;
+		}
+
+		Chunk.First = Total;
+		Total.NumPositions += Chunk.Counts.NumPositions;
+		Total.NumColors += Chunk.Counts.NumColors;
+		Total.NumTexCoords += Chunk.Counts.NumTexCoords;
+		Total.NumNormals += Chunk.Counts.NumNormals;
+		Total.NumCorners += Chunk.Counts.NumCorners;
+		Total.NumTriangles += Chunk.Counts.NumTriangles;
+		CornerLayouts |= Chunk.CornerLayouts;
+	}
+
+	// the faces must fit in sections, and all corners must have the same
+	// attributes
+	constexpr auto MaxNum          = int64{TNumericLimits<int32>::Max()};
+	const TCHAR*   RejectionReason = nullptr;
+	if (0 == Total.NumTriangles) {
+		RejectionReason = TEXT("has no faces");
+	} else if (Total.NumPositions > MaxNum || Total.NumTexCoords > MaxNum ||
+	           Total.NumNormals > MaxNum || Total.NumCorners > MaxNum ||
+	           3 * Total.NumTriangles > MaxNum) {
+		RejectionReason = TEXT("has too many vertices or faces");
+	} else if (!FMath::IsPowerOfTwo(CornerLayouts)) {
+		RejectionReason =
+		    TEXT("has faces whose corners have different kinds of indices");
+	} else if (0 != Total.NumColors && Total.NumPositions != Total.NumColors) {
+		RejectionReason = TEXT("has vertices with and without colors");
+	}
+	if (nullptr != RejectionReason) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ %s, so it is imported with assimp."), RejectionReason);
+		return false;
+	}
+	const auto& CornerLayout =
+	    static_cast<uint8>(FMath::FloorLog2(CornerLayouts));
+
+	// objects, meshes and materials
+	if (!MakeObjObjects(Chunks, Total,
+	                    bHasMaterialLibrary ? &LibraryMaterials : nullptr,
+	                    File)) {
+		return false;
+	}
+
+	// size the arrays for all chunks
+	File.Positions.SetNumUninitialized(static_cast<int32>(Total.NumPositions));
+	File.Colors.SetNumUninitialized(static_cast<int32>(Total.NumColors));
+	File.TexCoords.SetNumUninitialized(static_cast<int32>(Total.NumTexCoords));
+	File.Normals.SetNumUninitialized(static_cast<int32>(Total.NumNormals));
+	const auto& NumCorners = static_cast<int32>(Total.NumCorners);
+	File.CornerPositionIndices.SetNumUninitialized(NumCorners);
+	if (0 != (CornerLayout & ObjCornerHasTexCoord)) {
+		File.CornerTexCoordIndices.SetNumUninitialized(NumCorners);
+	}
+	if (0 != (CornerLayout & ObjCornerHasNormal)) {
+		File.CornerNormalIndices.SetNumUninitialized(NumCorners);
+	}
+	File.TriangleCorners.SetNumUninitialized(
+	    static_cast<int32>(3 * Total.NumTriangles));
+
+	// read the statements of each chunk concurrently into their place
+	ParallelFor(Chunks.Num(), [&](const int32 Chunk_i) {
+		ReadObjChunk(Chunks[Chunk_i], CornerLayout, Total, File);
+	});
+	for (const auto& Chunk : Chunks) {
+		if (nullptr != Chunk.RejectionReason) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("OBJ %s, so it is imported with assimp."),
+			       Chunk.RejectionReason);
+			return false;
+		}
+	}
+
+	// split the quads now that all positions have been read
+	ParallelFor(Chunks.Num(), [&](const int32 Chunk_i) {
+		for (const auto& Triangle : Chunks[Chunk_i].QuadTriangles) {
+			auto* const Corners     = &File.TriangleCorners[3 * Triangle];
+			const auto  FirstCorner = Corners[0];
+			const auto& Start       = FindObjQuadStartCorner(File, FirstCorner);
+			Corners[0]              = FirstCorner + Start;
+			Corners[1]              = FirstCorner + (Start + 1) % 4;
+			Corners[2]              = FirstCorner + (Start + 2) % 4;
+			Corners[3]              = FirstCorner + Start;
+			Corners[4]              = FirstCorner + (Start + 2) % 4;
+			Corners[5]              = FirstCorner + (Start + 3) % 4;
+		}
+	});
+
+	return true;
+}
+
+bool ParseObjMaterialLibrary(const uint8* const Data, const int64 Size,
+                             TArray<FObjMaterial>& Materials) {
+	// a byte order mark may be read differently
+	if (Size >= 3 && 0xEF == Data[0] && 0xBB == Data[1] && 0xBF == Data[2]) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ material library starts with a byte order mark, so "
+		            "the OBJ is imported with assimp."));
+		return false;
+	}
+
+	// material being read, which is added once the next one starts
+	FString                Name;
+	FObjMaterialProperties Properties;
+	auto                   bHasMaterial = false;
+
+	const TCHAR* RejectionReason = nullptr;
+	const auto&  End             = Data + Size;
+	for (auto Line = Data; Line < End && nullptr == RejectionReason;) {
+		// the line without "\n" or "\r\n"
+		auto        LineEnd  = FindObjLineEnd(Line, End);
+		const auto& NextLine = LineEnd < End ? LineEnd + 1 : LineEnd;
+		if (LineEnd > Line && '\r' == LineEnd[-1]) {
+			--LineEnd;
+		}
+
+		// keyword
+		auto KeywordEnd = Line;
+		while (KeywordEnd < LineEnd && !IsObjSpace(*KeywordEnd)) {
+			++KeywordEnd;
+		}
+		const auto& IsKeyword = [Line, KeywordEnd](const ANSICHAR* Keyword) {
+			const auto& Length = FCStringAnsi::Strlen(Keyword);
+			return KeywordEnd - Line == Length &&
+			       0 == std::memcmp(Line, Keyword, Length);
+		};
+
+		// property set by the keyword if it is a color or a number
+		auto* const Color  = IsKeyword("Ka")   ? &Properties.Ambient
+		                     : IsKeyword("Kd") ? &Properties.Diffuse
+		                     : IsKeyword("Ks") ? &Properties.Specular
+		                     : IsKeyword("Ke") ? &Properties.Emissive
+		                     : IsKeyword("Tf") ? &Properties.Transparent
+		                                       : nullptr;
+		auto* const Number = IsKeyword("Ns")   ? &Properties.Shininess
+		                     : IsKeyword("Ni") ? &Properties.RefractionIndex
+		                     : IsKeyword("d")  ? &Properties.Opacity
+		                                       : nullptr;
+
+		if (Line == LineEnd || '#' == *Line) {
+			// empty lines and comments
+		} else if (IsObjSpace(*Line)) {
+			// assimp may skip an indented statement as a whole
+			if (0 != CountObjTokens(Line, LineEnd)) {
+				RejectionReason = TEXT("has an indented statement");
+			}
+		} else if (IsKeyword("newmtl")) {
+			if (bHasMaterial) {
+				Materials.Add(MakeObjMaterial(Name, Properties));
+			}
+			bHasMaterial = true;
+			Properties   = FObjMaterialProperties();
+
+			// assimp replaces a material of the same name
+			if (!ParseObjName(KeywordEnd, LineEnd, Name)) {
+				RejectionReason =
+				    TEXT("has a material whose name is not a single word");
+			} else if (TEXT("DefaultMaterial") == Name ||
+			           Materials.ContainsByPredicate(
+			               [&Name](const FObjMaterial& Material) {
+				               return Material.Name == Name;
+			               })) {
+				RejectionReason =
+				    TEXT("has multiple materials of the same name");
+			}
+		} else if (!bHasMaterial) {
+			RejectionReason = TEXT("has a property before its first material");
+		} else if (nullptr != Color) {
+			float Values[3];
+			if (3 != ParseObjFloats(KeywordEnd, LineEnd, Values, 3)) {
+				RejectionReason =
+				    TEXT("has a color whose numbers are not supported");
+			} else {
+				*Color = FVector3f(Values[0], Values[1], Values[2]);
+			}
+		} else if (nullptr != Number || IsKeyword("Tr")) {
+			// "Tr" is the transparency, whose complement is the opacity
+			float Value;
+			if (1 != ParseObjFloats(KeywordEnd, LineEnd, &Value, 1)) {
+				RejectionReason = TEXT("has a number that is not supported");
+			} else if (nullptr != Number) {
+				*Number = Value;
+			} else {
+				Properties.Opacity = 1.0f - Value;
+			}
+		} else if (IsKeyword("illum")) {
+			// a small integer, which assimp reads with atoi
+			auto Cursor = KeywordEnd;
+			while (Cursor < LineEnd && IsObjSpace(*Cursor)) {
+				++Cursor;
+			}
+			auto Model     = 0;
+			auto NumDigits = 0;
+			for (; Cursor < LineEnd && '0' <= *Cursor && *Cursor <= '9' &&
+			       NumDigits < 2;
+			     ++Cursor, ++NumDigits) {
+				Model = 10 * Model + (*Cursor - '0');
+			}
+			while (Cursor < LineEnd && IsObjSpace(*Cursor)) {
+				++Cursor;
+			}
+			if (0 == NumDigits || Cursor != LineEnd) {
+				RejectionReason =
+				    TEXT("has an illumination model that is not supported");
+			} else {
+				Properties.IlluminationModel = Model;
+			}
+		} else if (IsKeyword("map_Kd")) {
+			// options start with "-"
+			if (!ParseObjName(KeywordEnd, LineEnd,
+			                  Properties.DiffuseTexturePath) ||
+			    Properties.DiffuseTexturePath.StartsWith(TEXT("-"))) {
+				RejectionReason = TEXT("has a texture with options or whose "
+				                       "name is not a single word");
+			}
+		} else {
+			// the other statements import properties that are not reproduced
+			RejectionReason = TEXT("has a statement that is not supported");
+		}
+
+		Line = NextLine;
+	}
+	if (nullptr != RejectionReason) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ material library %s, so the OBJ is imported with "
+		            "assimp."),
+		       RejectionReason);
+		return false;
+	}
+	if (bHasMaterial) {
+		Materials.Add(MakeObjMaterial(Name, Properties));
+	}
+
+	return true;
+}
+
+bool TryConstructMeshDataFromObjFile(const FString&             FilePath,
+                                     const uint8* const         Data,
+                                     const int64                Size,
+                                     const FAssetImportProfile& ImportProfile,
+                                     const FLoadOptions&        LoadOptions,
+                                     FLoadedMeshData&           MeshData,
+                                     TArray<FString>& DependencyFilePaths) {
+	// assimp picks the importer by the extension of the file
+	if (!FPaths::GetExtension(FilePath).Equals(TEXT("obj"),
+	                                           ESearchCase::IgnoreCase)) {
+		return false;
+	}
+
+	// Decide steps in auto mode. Since the faces of assimp's scene of an OBJ
+	// file never share vertices, they always include joining identical
+	// vertices, which is not reproduced.
+	const auto& AiPostProcessSteps =
+	    EAssetImportProfileType::Auto == ImportProfile.ProfileType
+	        ? GetAutoAiPostProcessSteps(true, true, false)
+	        : GetAiPostProcessSteps(ImportProfile);
+
+	// post-process steps must be reproducible
+	if (0 != (AiPostProcessSteps & ~ObjPostProcessSteps)) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ is imported with assimp, since post-process steps "
+		            "0x%08x are not reproduced by the native loader."),
+		       AiPostProcessSteps & ~ObjPostProcessSteps);
+		return false;
+	}
+
+	// the material library is read from the directory of the file, as
+	// assimp's IO system opens it
+	const auto& AssetDirectory =
+	    FPaths::GetPath(FPaths::ConvertRelativePathToFull(FilePath));
+	FString     MaterialLibraryPath;
+	const auto& LoadMaterialLibrary = [&](const FString&        Name,
+	                                      TArray<FObjMaterial>& Materials) {
+		if (!FPaths::IsRelative(Name)) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("OBJ refers to material library %s by an absolute "
+			            "path, so it is imported with assimp."),
+			       *Name);
+			return false;
+		}
+
+		// assimp looks for another library if it cannot be read
+		MaterialLibraryPath =
+		    FPaths::ConvertRelativePathToFull(AssetDirectory, Name);
+		TArray<uint8> LibraryData;
+		if (!FFileHelper::LoadFileToArray(LibraryData, *MaterialLibraryPath,
+		                                  FILEREAD_Silent)) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("OBJ material library %s cannot be read, so the OBJ is "
+			            "imported with assimp."),
+			       *MaterialLibraryPath);
+			return false;
+		}
+		return ParseObjMaterialLibrary(LibraryData.GetData(),
+		                               LibraryData.Num(), Materials);
+	};
+
+	FObjFile File;
+	if (!ParseObj(Data, Size, LoadMaterialLibrary, File)) {
+		return false;
+	}
+
+	// the caller discards the mesh data if canceled while parsing
+	if (LoadOptions.IsCanceled()) {
+		return true;
+	}
+
+	// tangents are not reproduced, so they must not be calculated
+	const auto& bHasTexCoords = !File.CornerTexCoordIndices.IsEmpty();
+	if (0 != (AiPostProcessSteps & aiProcess_CalcTangentSpace) &&
+	    bHasTexCoords) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("OBJ needs tangents to be calculated, so it is imported "
+		            "with assimp."));
+		return false;
+	}
+
+	// generate normals if the faces have none
+	if (0 != (AiPostProcessSteps & aiProcess_GenSmoothNormals) &&
+	    File.CornerNormalIndices.IsEmpty()) {
+		GenerateObjNormals(File);
+	}
+
+	// vertex attributes present in all sections (all vertices have colors if
+	// any has)
+	const auto& bHasNormals = !File.CornerNormalIndices.IsEmpty();
+	auto        Attributes  = EAiVertexAttributes::Vertices;
+	if (bHasNormals) {
+		Attributes |= EAiVertexAttributes::Normals;
+	}
+	if (bHasTexCoords) {
+		Attributes |= EAiVertexAttributes::UV0Channel;
+	}
+	if (!File.Colors.IsEmpty()) {
+		Attributes |= EAiVertexAttributes::VertexColors0;
+	}
+
+	// index in MaterialList of each material of the file, and the other way
+	// round. RemoveRedundantMaterials removes the materials no mesh with
+	// faces refers to, and merges the materials with the same properties into
+	// the first one.
+	const auto&   NumObjMaterials = File.Materials.Num();
+	TArray<int32> MaterialIndexOfObjMaterial;
+	TArray<int32> ObjMaterialIndexOfMaterial;
+	MaterialIndexOfObjMaterial.Init(INDEX_NONE, NumObjMaterials);
+	if (0 != (AiPostProcessSteps & aiProcess_RemoveRedundantMaterials)) {
+		TArray<bool> bIsObjMaterialReferenced;
+		bIsObjMaterialReferenced.SetNumZeroed(NumObjMaterials);
+		for (const auto& Mesh : File.Meshes) {
+			if (0 != Mesh.NumTriangles) {
+				bIsObjMaterialReferenced[Mesh.MaterialIndex] = true;
+			}
+		}
+
+		for (auto ObjMaterial_i = 0; ObjMaterial_i < NumObjMaterials;
+		     ++ObjMaterial_i) {
+			if (!bIsObjMaterialReferenced[ObjMaterial_i]) {
+				continue;
+			}
+
+			auto& MaterialIndex = MaterialIndexOfObjMaterial[ObjMaterial_i];
+			for (auto Other_i = 0; Other_i < ObjMaterial_i; ++Other_i) {
+				if (bIsObjMaterialReferenced[Other_i] &&
+				    File.Materials[Other_i].Key ==
+				        File.Materials[ObjMaterial_i].Key) {
+					MaterialIndex = MaterialIndexOfObjMaterial[Other_i];
+					break;
+				}
+			}
+			if (INDEX_NONE == MaterialIndex) {
+				MaterialIndex = ObjMaterialIndexOfMaterial.Add(ObjMaterial_i);
+			}
+		}
+	} else {
+		for (auto ObjMaterial_i = 0; ObjMaterial_i < NumObjMaterials;
+		     ++ObjMaterial_i) {
+			MaterialIndexOfObjMaterial[ObjMaterial_i] =
+			    ObjMaterialIndexOfMaterial.Add(ObjMaterial_i);
+		}
+	}
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("OBJ is converted by the native loader, without assimp."));
+
+	// make material list and texture list, as GenerateMaterialList does
+	FAiTextureTable TextureTable;
+	for (const auto& ObjMaterial_i : ObjMaterialIndexOfMaterial) {
+		const auto& ObjMaterial  = File.Materials[ObjMaterial_i];
+		auto&       MaterialData = MeshData.MaterialList.AddDefaulted_GetRef();
+
+		if (ObjMaterial.DiffuseTexturePath.IsEmpty()) {
+			MaterialData.ColorStatus = EColorStatus::ColorIsSet;
+			MaterialData.Color       = ObjMaterial.DiffuseColor;
+			continue;
+		}
+
+		// refer to the external texture file in the texture table
+		const auto& TextureIndex = AddExternalTexture(
+		    ObjMaterial.DiffuseTexturePath, AssetDirectory, TextureTable);
+		if (INDEX_NONE == TextureIndex) {
+			MaterialData.ColorStatus = EColorStatus::TextureWasSetButError;
+		} else {
+			MaterialData.ColorStatus  = EColorStatus::TextureIsSet;
+			MaterialData.TextureIndex = TextureIndex;
+		}
+	}
+	MeshData.TextureList = MoveTemp(TextureTable.TextureList);
+
+	// start reading and decoding external textures, while the sections are
+	// converted
+	const auto& ExternalTextureTasks =
+	    FExternalTextureCache::Get().FindOrLoadAll(MeshData.TextureList);
+
+	// set up a root node named after the file, and a child node for each
+	// object, referring to the sections of its meshes that have faces
+	const auto& NumNodes = 1 + File.Objects.Num();
+	auto&       NodeList = MeshData.NodeList;
+	NodeList.SetNum(NumNodes);
+	TArray<int32>         MeshIndexOfSection;
+	TArray<TArray<int32>> NodeIndicesOfSection;
+	for (auto Node_i = decltype(NumNodes){0}; Node_i < NumNodes; ++Node_i) {
+		auto& Node           = NodeList[Node_i];
+		Node.ParentNodeIndex = 0 == Node_i ? INDEX_NONE : 0;
+
+		// identity, post-processed as assimp does, and transformed to the UE
+		// coordinate system for the root node (there is no UnitScaleFactor)
+		auto AiTransform = aiMatrix4x4();
+		MirrorAiTransformZ(AiTransform);
+		if (0 == Node_i) {
+			AiTransform = GenerateAi_UE_XformMatrix(1.0f) * AiTransform;
+		}
+		Node.RelativeTransform =
+		    static_cast<FTransform>(AiMatrixToUEMatrix(AiTransform));
+
+		if (0 == Node_i) {
+			Node.Name = FPaths::GetCleanFilename(FilePath);
+			continue;
+		}
+		const auto& Object = File.Objects[Node_i - 1];
+		Node.Name          = Object.Name;
+		for (auto Mesh_i = Object.FirstMesh;
+		     Mesh_i < Object.FirstMesh + Object.NumMeshes; ++Mesh_i) {
+			if (0 != File.Meshes[Mesh_i].NumTriangles) {
+				Node.SectionIndices.Add(MeshIndexOfSection.Add(Mesh_i));
+				NodeIndicesOfSection.Add({Node_i});
+			}
+		}
+	}
+
+	// set up the sections and make conversion jobs
+	const auto& NumSections = MeshIndexOfSection.Num();
+	auto&       SectionList = MeshData.SectionList;
+	SectionList.SetNum(NumSections);
+	TArray<FSectionConversionJob> Jobs;
+	for (auto Section_i = decltype(NumSections){0}; Section_i < NumSections;
+	     ++Section_i) {
+		const auto& Mesh      = File.Meshes[MeshIndexOfSection[Section_i]];
+		auto&       Section   = SectionList[Section_i];
+		Section.MaterialIndex = MaterialIndexOfObjMaterial[Mesh.MaterialIndex];
+		SizeSectionAndAddJobs(Section_i, Attributes, Mesh.NumCorners,
+		                      Mesh.NumTriangles, ImportProfile.bCompactPrecision,
+		                      Section, Jobs);
+	}
+
+	UE_LOG(LogAssetLoader, Log,
+	       TEXT("OBJ has %d objects with %d meshes, %d vertices and %d "
+	            "triangles, converted in %d jobs."),
+	       File.Objects.Num(), NumSections, File.CornerPositionIndices.Num(),
+	       File.TriangleCorners.Num() / 3, Jobs.Num());
+
+	// convert all ranges concurrently
+	RunSectionConversionJobs(
+	    Jobs, NodeIndicesOfSection,
+	    [&](const FSectionConversionJob& Job) {
+		    const auto& Mesh = File.Meshes[MeshIndexOfSection[Job.SectionIndex]];
+		    auto&       Section = SectionList[Job.SectionIndex];
+
+		    if (Job.bFaces) {
+			    if (!Section.CompactTriangles.IsEmpty()) {
+				    ConvertObjFaceRange(File, Mesh, Job.Begin, Job.End,
+				                        Section.CompactTriangles);
+			    } else {
+				    ConvertObjFaceRange(File, Mesh, Job.Begin, Job.End,
+				                        Section.Triangles);
+			    }
+		    } else if (ImportProfile.bCompactPrecision) {
+			    ConvertObjVertexRangeCompact(File, Mesh, Attributes, Job.Begin,
+			                                 Job.End, Section);
+		    } else {
+			    ConvertObjVertexRange(File, Mesh, Attributes, Job.Begin,
+			                          Job.End, Section);
+		    }
+	    },
+	    [](int32) {}, LoadOptions, MeshData);
+
+	// wait for external textures, and process all textures
+	FinishTextureList(ExternalTextureTasks, ImportProfile, LoadOptions,
+	                  /*out*/ MeshData);
+
+	// the material library is a dependency, as it is of assimp's import (the
+	// textures are recorded by their SourceFilePath)
+	if (!MaterialLibraryPath.IsEmpty()) {
+		DependencyFilePaths.AddUnique(MaterialLibraryPath);
+	}
+
+	return true;
+}
+
+#pragma region definitions of static functions
+static void SplitObjIntoChunks(const uint8* const Data, const int64 Size,
+                               TArray<FObjChunk>& Chunks) {
+	const auto& DataEnd = Data + Size;
+	for (auto Begin = Data; Begin < DataEnd;) {
+		// extend the chunk to the end of its last line
+		const auto& ChunkSize = Chunks.IsEmpty() ? ObjPrefixSize : ObjChunkSize;
+		auto        End = Begin + FMath::Min(ChunkSize, DataEnd - Begin);
+		if (End < DataEnd) {
+			End = FindObjLineEnd(End - 1, DataEnd);
+			if (End < DataEnd) {
+				++End;
+			}
+		}
+
+		auto& Chunk = Chunks.AddDefaulted_GetRef();
+		Chunk.Begin = Begin;
+		Chunk.End   = End;
+		Begin       = End;
+	}
+}
+
+static const uint8* FindObjLineEnd(const uint8* const Line,
+                                   const uint8* const End) {
+	const auto& LineEnd = std::memchr(Line, '\n', End - Line);
+	return nullptr == LineEnd ? End : static_cast<const uint8*>(LineEnd);
+}
+
+static void CountObjChunk(FObjChunk& Chunk) {
+	// assimp joins lines continued with "\" before parsing them
+	if (nullptr != std::memchr(Chunk.Begin, '\\', Chunk.End - Chunk.Begin)) {
+		Chunk.RejectionReason = TEXT("has a line continuation");
+		return;
+	}
+
+	auto& Counts = Chunk.Counts;
+	for (auto Line = Chunk.Begin;
+	     Line < Chunk.End && nullptr == Chunk.RejectionReason;) {
+		// the line without "\n" or "\r\n"
+		auto        LineEnd  = FindObjLineEnd(Line, Chunk.End);
+		const auto& NextLine = LineEnd < Chunk.End ? LineEnd + 1 : LineEnd;
+		if (LineEnd > Line && '\r' == LineEnd[-1]) {
+			--LineEnd;
+		}
+
+		auto        Cursor = Line;
+		const auto& ClassifiedStatement =
+		    ClassifyObjLine(Cursor, LineEnd, Chunk.RejectionReason);
+		switch (ClassifiedStatement) {
+		case EObjStatement::Position:
+			// a position followed by a color has 6 numbers
+			++Counts.NumPositions;
+			if (6 == CountObjTokens(Cursor, LineEnd)) {
+				++Counts.NumColors;
+			}
+			break;
+		case EObjStatement::TexCoord:
+			++Counts.NumTexCoords;
+			break;
+		case EObjStatement::Normal:
+			++Counts.NumNormals;
+			break;
+		case EObjStatement::Face: {
+			// a triangle, or a quad split into 2 triangles
+			const auto& NumFaceCorners = CountObjTokens(Cursor, LineEnd);
+			if (3 != NumFaceCorners && 4 != NumFaceCorners) {
+				Chunk.RejectionReason =
+				    TEXT("has a face that is not a triangle or a quad");
+				break;
+			}
+			Counts.NumCorners += NumFaceCorners;
+			Counts.NumTriangles += NumFaceCorners - 2;
+			Chunk.CornerLayouts |=
+			    static_cast<uint8>(1 << GetObjCornerLayout(Cursor, LineEnd));
+			break;
+		}
+		case EObjStatement::Object:
+		case EObjStatement::MaterialLibrary:
+		case EObjStatement::Material: {
+			// assimp ignores the statement on the last line if it does not end
+			// with "\n"
+			auto& Statement     = Chunk.NamedStatements.AddDefaulted_GetRef();
+			Statement.Statement = ClassifiedStatement;
+			if ('\n' != NextLine[-1] ||
+			    !ParseObjName(Cursor, LineEnd, Statement.Name)) {
+				Chunk.RejectionReason =
+				    TEXT("has an object, group or material whose name is not a "
+				         "single word on a line of its own");
+				break;
+			}
+			Statement.NumCornersBefore   = Counts.NumCorners;
+			Statement.NumTrianglesBefore = Counts.NumTriangles;
+			break;
+		}
+		default:
+			break;
+		}
+
+		Line = NextLine;
+	}
+}
+
+static void ReadObjChunk(FObjChunk& Chunk, const uint8 CornerLayout,
+                         const FObjCounts& Total, FObjFile& File) {
+	// indices of the next elements in the file, which are also the numbers of
+	// the elements read before them
+	auto Position = static_cast<int32>(Chunk.First.NumPositions);
+	auto TexCoord = static_cast<int32>(Chunk.First.NumTexCoords);
+	auto Normal   = static_cast<int32>(Chunk.First.NumNormals);
+	auto Corner   = static_cast<int32>(Chunk.First.NumCorners);
+	auto Triangle = static_cast<int32>(Chunk.First.NumTriangles);
+
+	const auto& bHasColors = !File.Colors.IsEmpty();
+	for (auto Line = Chunk.Begin;
+	     Line < Chunk.End && nullptr == Chunk.RejectionReason;) {
+		// the line without "\n" or "\r\n"
+		auto        LineEnd  = FindObjLineEnd(Line, Chunk.End);
+		const auto& NextLine = LineEnd < Chunk.End ? LineEnd + 1 : LineEnd;
+		if (LineEnd > Line && '\r' == LineEnd[-1]) {
+			--LineEnd;
+		}
+
+		auto Cursor = Line;
+		switch (ClassifyObjLine(Cursor, LineEnd, Chunk.RejectionReason)) {
+		case EObjStatement::Position: {
+			float       Values[6];
+			const auto& NumValues = ParseObjFloats(Cursor, LineEnd, Values, 6);
+			if ((bHasColors ? 6 : 3) != NumValues) {
+				Chunk.RejectionReason =
+				    TEXT("has a vertex whose numbers are not supported");
+				break;
+			}
+			File.Positions[Position] = FVector3f(Values[0], Values[1], Values[2]);
+			if (bHasColors) {
+				File.Colors[Position] = FVector3f(Values[3], Values[4], Values[5]);
+			}
+			++Position;
+			break;
+		}
+		case EObjStatement::TexCoord: {
+			// 2D or 3D, of which u and v are used
+			float       Values[3];
+			const auto& NumValues = ParseObjFloats(Cursor, LineEnd, Values, 3);
+			if (2 != NumValues && 3 != NumValues) {
+				Chunk.RejectionReason =
+				    TEXT("has a texture coordinate whose numbers are not "
+				         "supported");
+				break;
+			}
+			File.TexCoords[TexCoord++] = FVector2f(Values[0], Values[1]);
+			break;
+		}
+		case EObjStatement::Normal: {
+			float Values[3];
+			if (3 != ParseObjFloats(Cursor, LineEnd, Values, 3)) {
+				Chunk.RejectionReason =
+				    TEXT("has a normal whose numbers are not supported");
+				break;
+			}
+			File.Normals[Normal++] = FVector3f(Values[0], Values[1], Values[2]);
+			break;
+		}
+		case EObjStatement::Face: {
+			const auto& FirstCorner    = Corner;
+			auto        NumFaceCorners = 0;
+			for (;;) {
+				while (Cursor < LineEnd && IsObjSpace(*Cursor)) {
+					++Cursor;
+				}
+				if (Cursor == LineEnd || '#' == *Cursor) {
+					break;
+				}
+				if (4 == NumFaceCorners) {
+					Chunk.RejectionReason =
+					    TEXT("has a face that is not a triangle or a quad");
+					break;
+				}
+
+				// "v", "v/vt", "v//vn" or "v/vt/vn", whose relative indices
+				// count back from the elements read so far
+				auto  Layout = uint8{0};
+				int32 Indices[3];
+				auto  bIsValid = ParseObjIndex(Cursor, LineEnd, Position,
+				                               Total.NumPositions, Indices[0]);
+				if (bIsValid && Cursor < LineEnd && '/' == *Cursor) {
+					++Cursor;
+					if (Cursor < LineEnd && '/' != *Cursor) {
+						// assimp reads the index as that of a normal if there
+						// has been no texture coordinate yet, but a normal
+						Layout |= ObjCornerHasTexCoord;
+						bIsValid = (0 != TexCoord || 0 == Normal) &&
+						           ParseObjIndex(Cursor, LineEnd, TexCoord,
+						                         Total.NumTexCoords, Indices[1]);
+					}
+					if (bIsValid && Cursor < LineEnd && '/' == *Cursor) {
+						++Cursor;
+						Layout |= ObjCornerHasNormal;
+						bIsValid = ParseObjIndex(Cursor, LineEnd, Normal,
+						                         Total.NumNormals, Indices[2]);
+					}
+				}
+				if (!bIsValid || CornerLayout != Layout ||
+				    (Cursor < LineEnd && !IsObjSpace(*Cursor) && '#' != *Cursor)) {
+					Chunk.RejectionReason =
+					    TEXT("has a face whose indices are not supported or "
+					         "out of range");
+					break;
+				}
+
+				File.CornerPositionIndices[Corner] = Indices[0];
+				if (0 != (Layout & ObjCornerHasTexCoord)) {
+					File.CornerTexCoordIndices[Corner] = Indices[1];
+				}
+				if (0 != (Layout & ObjCornerHasNormal)) {
+					File.CornerNormalIndices[Corner] = Indices[2];
+				}
+				++Corner;
+				++NumFaceCorners;
+			}
+			if (nullptr != Chunk.RejectionReason) {
+				break;
+			}
+			checkf(3 == NumFaceCorners || 4 == NumFaceCorners,
+			       TEXT("Bug. A face must have as many corners as counted."));
+
+			// fan the face from its first corner (quads are split again once
+			// all positions have been read)
+			auto* const Corners = &File.TriangleCorners[3 * Triangle];
+			Corners[0]          = FirstCorner;
+			Corners[1]          = FirstCorner + 1;
+			Corners[2]          = FirstCorner + 2;
+			if (4 == NumFaceCorners) {
+				Chunk.QuadTriangles.Add(Triangle);
+				Corners[3] = FirstCorner;
+				Corners[4] = FirstCorner + 2;
+				Corners[5] = FirstCorner + 3;
+			}
+			Triangle += NumFaceCorners - 2;
+			break;
+		}
+		default:
+			break;
+		}
+
+		Line = NextLine;
+	}
+}
+
+static bool MakeObjObjects(const TArray<FObjChunk>&    Chunks,
+                           const FObjCounts&           Total,
+                           const TArray<FObjMaterial>* LibraryMaterials,
+                           FObjFile&                   File) {
+	auto& Objects   = File.Objects;
+	auto& Meshes    = File.Meshes;
+	auto& Materials = File.Materials;
+
+	// the default material, followed by the materials of the library
+	Materials.Add(
+	    MakeObjMaterial(TEXT("DefaultMaterial"), FObjMaterialProperties()));
+	if (nullptr != LibraryMaterials) {
+		Materials.Append(*LibraryMaterials);
+	}
+
+	// material that new meshes get, INDEX_NONE if none (reading the library
+	// makes its last material current)
+	auto CurrentMaterial = nullptr != LibraryMaterials &&
+	                               !LibraryMaterials->IsEmpty()
+	                           ? Materials.Num() - 1
+	                           : INDEX_NONE;
+
+	// start a mesh of the last object at its first corner and triangle
+	const auto& StartMesh = [&](const int64 FirstCorner,
+	                            const int64 FirstTriangle,
+	                            const int32 MaterialIndex) {
+		auto& Mesh         = Meshes.AddDefaulted_GetRef();
+		Mesh.MaterialIndex = MaterialIndex;
+		Mesh.FirstCorner   = static_cast<int32>(FirstCorner);
+		Mesh.FirstTriangle = static_cast<int32>(FirstTriangle);
+		++Objects.Last().NumMeshes;
+	};
+
+	// start an object with a mesh of the current material
+	const auto& StartObject = [&](const FString& Name, const int64 FirstCorner,
+	                              const int64 FirstTriangle) {
+		auto& Object     = Objects.AddDefaulted_GetRef();
+		Object.Name      = Name;
+		Object.FirstMesh = Meshes.Num();
+		StartMesh(FirstCorner, FirstTriangle, CurrentMaterial);
+	};
+
+	// follow the statements in order
+	auto bIsFirstStatement = true;
+	for (const auto& Chunk : Chunks) {
+		for (const auto& Statement : Chunk.NamedStatements) {
+			const auto& FirstCorner =
+			    Chunk.First.NumCorners + Statement.NumCornersBefore;
+			const auto& FirstTriangle =
+			    Chunk.First.NumTriangles + Statement.NumTrianglesBefore;
+			const auto bIsFirst = bIsFirstStatement;
+			bIsFirstStatement   = false;
+
+			// faces before the first object are put in a default object by
+			// assimp
+			if (Objects.IsEmpty() && 0 != FirstCorner) {
+				StartObject(TEXT("defaultobject"), 0, 0);
+			}
+
+			switch (Statement.Statement) {
+			case EObjStatement::Object:
+				StartObject(Statement.Name, FirstCorner, FirstTriangle);
+				break;
+			case EObjStatement::MaterialLibrary:
+				// only the library read before the other chunks is supported
+				if (!bIsFirst || nullptr == LibraryMaterials) {
+					UE_LOG(LogAssetLoader, Log,
+					       TEXT("OBJ refers to material library %s after other "
+					            "statements, so it is imported with assimp."),
+					       *Statement.Name);
+					return false;
+				}
+				break;
+			default: {
+				// a "usemtl" of the current material is ignored
+				if (INDEX_NONE != CurrentMaterial &&
+				    Materials[CurrentMaterial].Name == Statement.Name) {
+					break;
+				}
+
+				// a name that is not in the library gets a default material
+				CurrentMaterial = Materials.IndexOfByPredicate(
+				    [&Statement](const FObjMaterial& Material) {
+					    return Material.Name == Statement.Name;
+				    });
+				if (INDEX_NONE == CurrentMaterial) {
+					UE_LOG(LogAssetLoader, Warning,
+					       TEXT("OBJ material %s is not in the material "
+					            "library, so it has the default properties."),
+					       *Statement.Name);
+					CurrentMaterial = Materials.Add(MakeObjMaterial(
+					    Statement.Name, FObjMaterialProperties()));
+				}
+
+				// Before any object, only the material is changed. Otherwise a
+				// new mesh is started if the current one already has faces of
+				// another material, and the current mesh gets the material.
+				if (Objects.IsEmpty()) {
+					break;
+				}
+				if (INDEX_NONE != Meshes.Last().MaterialIndex &&
+				    CurrentMaterial != Meshes.Last().MaterialIndex &&
+				    FirstCorner != Meshes.Last().FirstCorner) {
+					StartMesh(FirstCorner, FirstTriangle, CurrentMaterial);
+				}
+				Meshes.Last().MaterialIndex = CurrentMaterial;
+				break;
+			}
+			}
+		}
+	}
+	if (Objects.IsEmpty()) {
+		StartObject(TEXT("defaultobject"), 0, 0);
+	}
+
+	// each mesh ends where the next one starts, and one without a material
+	// gets the default material
+	for (auto i = 0; i < Meshes.Num(); ++i) {
+		auto&       Mesh    = Meshes[i];
+		const auto& bIsLast = Meshes.Num() == i + 1;
+		Mesh.NumCorners =
+		    (bIsLast ? static_cast<int32>(Total.NumCorners)
+		             : Meshes[i + 1].FirstCorner) -
+		    Mesh.FirstCorner;
+		Mesh.NumTriangles =
+		    (bIsLast ? static_cast<int32>(Total.NumTriangles)
+		             : Meshes[i + 1].FirstTriangle) -
+		    Mesh.FirstTriangle;
+		if (INDEX_NONE == Mesh.MaterialIndex) {
+			Mesh.MaterialIndex = 0;
+		}
+	}
+
+	// assimp adds faces to an existing object of the same name (or ignores a
+	// group of the same name as the current one)
+	TSet<FString> Names;
+	for (const auto& Object : Objects) {
+		auto bIsAlreadyInSet = false;
+		Names.Add(Object.Name, &bIsAlreadyInSet);
+		if (bIsAlreadyInSet) {
+			UE_LOG(LogAssetLoader, Log,
+			       TEXT("OBJ has multiple objects or groups named %s, so it is "
+			            "imported with assimp."),
+			       *Object.Name);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static FObjMaterial MakeObjMaterial(const FString&                Name,
+                                    const FObjMaterialProperties& Properties) {
+	FObjMaterial Material;
+	Material.Name               = Name;
+	Material.DiffuseTexturePath = Properties.DiffuseTexturePath;
+
+	// assimp reads the diffuse color as RGB, with alpha 1
+	const auto& Diffuse   = Properties.Diffuse;
+	Material.DiffuseColor = FLinearColor(Diffuse.X, Diffuse.Y, Diffuse.Z, 1.0f);
+
+	// every property with all the digits of its numbers, since
+	// RemoveRedundantMaterials merges only materials whose properties have the
+	// same bytes
+	auto&       Key         = Material.Key;
+	const auto& AppendColor = [&Key](const TCHAR*     Keyword,
+	                                 const FVector3f& Color) {
+		Key += FString::Printf(TEXT("%s %.9g %.9g %.9g\n"), Keyword, Color.X,
+		                       Color.Y, Color.Z);
+	};
+	AppendColor(TEXT("Ka"), Properties.Ambient);
+	AppendColor(TEXT("Kd"), Properties.Diffuse);
+	AppendColor(TEXT("Ks"), Properties.Specular);
+	AppendColor(TEXT("Ke"), Properties.Emissive);
+	AppendColor(TEXT("Tf"), Properties.Transparent);
+	Key += FString::Printf(TEXT("Ns %.9g\nd %.9g\nNi %.9g\nillum %d\n"),
+	                       Properties.Shininess, Properties.Opacity,
+	                       Properties.RefractionIndex,
+	                       Properties.IlluminationModel);
+	Key += TEXT("map_Kd ") + Properties.DiffuseTexturePath;
+
+	return Material;
+}
+
+static void GenerateObjNormals(FObjFile& File) {
+	const auto& NumCorners = File.CornerPositionIndices.Num();
+	File.Normals.SetNumUninitialized(NumCorners);
+	File.CornerNormalIndices.SetNumUninitialized(NumCorners);
+
+	// each mesh concurrently, since normals are averaged within a mesh
+	ParallelFor(File.Meshes.Num(), [&File](const int32 Mesh_i) {
+		const auto& Mesh        = File.Meshes[Mesh_i];
+		const auto& GetPosition = [&File](const int32 Corner) {
+			return File.Positions[File.CornerPositionIndices[Corner]];
+		};
+
+		// normal of the face of each corner in the coordinate system of the
+		// file (assimp computes it after MakeLeftHanded with the flipped
+		// winding order swapped back, which gives the same normal mirrored)
+		for (auto Triangle = Mesh.FirstTriangle;
+		     Triangle < Mesh.FirstTriangle + Mesh.NumTriangles; ++Triangle) {
+			const auto* const Corners = &File.TriangleCorners[3 * Triangle];
+			const auto&       P0      = GetPosition(Corners[0]);
+			const auto&       P1      = GetPosition(Corners[1]);
+			const auto&       P2      = GetPosition(Corners[2]);
+
+			// normalized only if it is not zero, as NormalizeSafe does
+			auto        FaceNormal = (P1 - P0) ^ (P2 - P0);
+			const auto& Length     = FaceNormal.Size();
+			if (Length > 0.0f) {
+				FaceNormal /= Length;
+			}
+			for (auto i = 0; i < 3; ++i) {
+				File.Normals[Corners[i]] = FaceNormal;
+			}
+		}
+
+		// sum up the normals of the corners at each position
+		TMap<FVector3f, FVector3f> PositionNormals;
+		PositionNormals.Reserve(Mesh.NumCorners);
+		const auto& EndCorner = Mesh.FirstCorner + Mesh.NumCorners;
+		for (auto Corner = Mesh.FirstCorner; Corner < EndCorner; ++Corner) {
+			PositionNormals.FindOrAdd(GetPosition(Corner),
+			                          FVector3f::ZeroVector) +=
+			    File.Normals[Corner];
+		}
+		for (auto& Pair : PositionNormals) {
+			const auto& Length = Pair.Value.Size();
+			if (Length > 0.0f) {
+				Pair.Value /= Length;
+			}
+		}
+
+		// each corner gets the normal of its position
+		for (auto Corner = Mesh.FirstCorner; Corner < EndCorner; ++Corner) {
+			File.Normals[Corner] =
+			    PositionNormals.FindChecked(GetPosition(Corner));
+			File.CornerNormalIndices[Corner] = Corner;
+		}
+	});
+}
+
+static EObjStatement ClassifyObjLine(const uint8*& Cursor,
+                                     const uint8* const LineEnd,
+                                     const TCHAR*&      RejectionReason) {
+	if (Cursor == LineEnd) {
+		return EObjStatement::Ignored;
+	}
+
+	// keyword
+	const auto& First      = *Cursor;
+	auto        KeywordEnd = Cursor;
+	while (KeywordEnd < LineEnd && !IsObjSpace(*KeywordEnd)) {
+		++KeywordEnd;
+	}
+	const auto& KeywordLength = KeywordEnd - Cursor;
+	const auto& Second        = 2 == KeywordLength ? Cursor[1] : uint8{0};
+
+	auto Statement = EObjStatement::Ignored;
+	switch (First) {
+	case 'v':
+		Statement = 1 == KeywordLength   ? EObjStatement::Position
+		            : 't' == Second      ? EObjStatement::TexCoord
+		            : 'n' == Second      ? EObjStatement::Normal
+		                                 : EObjStatement::Unsupported;
+		break;
+	case 'f':
+		Statement =
+		    1 == KeywordLength ? EObjStatement::Face : EObjStatement::Unsupported;
+		break;
+	case 'o':
+	case 'g':
+		Statement = 1 == KeywordLength ? EObjStatement::Object
+		                               : EObjStatement::Unsupported;
+		break;
+	case 'p':
+	case 'l':
+		RejectionReason = TEXT("has points or lines");
+		return EObjStatement::Unsupported;
+	case 'm':
+		// assimp ignores the other keywords starting with "m"
+		if (2 == KeywordLength && 'g' == Second) {
+			RejectionReason = TEXT("has merging groups");
+			return EObjStatement::Unsupported;
+		}
+		if (6 != KeywordLength || 0 != std::memcmp(Cursor, "mtllib", 6)) {
+			return EObjStatement::Ignored;
+		}
+		Statement = EObjStatement::MaterialLibrary;
+		break;
+	case 'u':
+		// assimp ignores the other keywords starting with "u"
+		if (6 != KeywordLength || 0 != std::memcmp(Cursor, "usemtl", 6)) {
+			return EObjStatement::Ignored;
+		}
+		Statement = EObjStatement::Material;
+		break;
+	case ' ':
+	case '\t':
+		// assimp may skip an indented statement as a whole
+		if (0 != CountObjTokens(Cursor, LineEnd)) {
+			RejectionReason = TEXT("has an indented statement");
+			return EObjStatement::Unsupported;
+		}
+		return EObjStatement::Ignored;
+	default:
+		// comments, "s" and the statements assimp ignores
+		return EObjStatement::Ignored;
+	}
+
+	if (EObjStatement::Unsupported == Statement) {
+		RejectionReason = TEXT("has a statement that is not supported");
+	}
+	Cursor = KeywordEnd;
+	return Statement;
+}
+
+static bool IsObjSpace(const uint8 Char) {
+	return ' ' == Char || '\t' == Char;
+}
+
+static int32 CountObjTokens(const uint8* Cursor, const uint8* const End) {
+	auto NumTokens = 0;
+	for (;;) {
+		while (Cursor < End && IsObjSpace(*Cursor)) {
+			++Cursor;
+		}
+		if (Cursor == End || '#' == *Cursor) {
+			return NumTokens;
+		}
+		++NumTokens;
+		while (Cursor < End && !IsObjSpace(*Cursor)) {
+			++Cursor;
+		}
+	}
+}
+
+static uint8 GetObjCornerLayout(const uint8* Cursor, const uint8* const End) {
+	while (Cursor < End && IsObjSpace(*Cursor)) {
+		++Cursor;
+	}
+
+	// "v", "v/vt", "v//vn" or "v/vt/vn" by the slashes in the token
+	auto Layout       = uint8{0};
+	auto NumSlashes   = 0;
+	auto PreviousChar = uint8{0};
+	for (; Cursor < End && !IsObjSpace(*Cursor) && '#' != *Cursor; ++Cursor) {
+		if ('/' == *Cursor) {
+			++NumSlashes;
+		} else if ('/' == PreviousChar) {
+			Layout |= 1 == NumSlashes ? ObjCornerHasTexCoord : ObjCornerHasNormal;
+		}
+		PreviousChar = *Cursor;
+	}
+	return Layout;
+}
+
+static bool ParseObjName(const uint8* Cursor, const uint8* const End,
+                         FString& Name) {
+	while (Cursor < End && IsObjSpace(*Cursor)) {
+		++Cursor;
+	}
+
+	// a single token up to the end of the line
+	const auto& NameBegin = Cursor;
+	while (Cursor < End && !IsObjSpace(*Cursor)) {
+		++Cursor;
+	}
+	if (NameBegin == Cursor || Cursor != End) {
+		return false;
+	}
+
+	// UTF-8, as assimp's node names are converted
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(NameBegin),
+	                             static_cast<int32>(Cursor - NameBegin));
+	Name = FString(Converted.Length(), Converted.Get());
+	return true;
+}
+
+static int32 ParseObjFloats(const uint8* Cursor, const uint8* const End,
+                            float* const Values, const int32 MaxNum) {
+	auto Num = 0;
+	for (;;) {
+		while (Cursor < End && IsObjSpace(*Cursor)) {
+			++Cursor;
+		}
+		if (Cursor == End || '#' == *Cursor) {
+			return Num;
+		}
+
+		// the number must be the whole token
+		if (MaxNum == Num || !ParseObjFloat(Cursor, End, Values[Num]) ||
+		    (Cursor < End && !IsObjSpace(*Cursor))) {
+			return INDEX_NONE;
+		}
+		++Num;
+	}
+}
+
+static bool ParseObjFloat(const uint8*& Cursor, const uint8* const End,
+                          float& Value) {
+	const auto& IsDigit = [End](const uint8* const Char) {
+		return Char < End && '0' <= *Char && *Char <= '9';
+	};
+
+	// sign, followed by a digit or a decimal point and a digit
+	const auto& bIsNegative = '-' == *Cursor;
+	if (bIsNegative || '+' == *Cursor) {
+		++Cursor;
+		if (!IsDigit(Cursor) &&
+		    !(Cursor < End && '.' == *Cursor && IsDigit(Cursor + 1))) {
+			return false;
+		}
+	} else if (!IsDigit(Cursor)) {
+		return false;
+	}
+
+	// integer part, converted to float
+	Value = 0.0f;
+	if (IsDigit(Cursor)) {
+		auto Integer   = uint64{0};
+		auto NumDigits = 0;
+		for (; IsDigit(Cursor); ++Cursor) {
+			if (++NumDigits > 19) {
+				return false;
+			}
+			Integer = Integer * 10 + (*Cursor - '0');
+		}
+		Value = static_cast<float>(Integer);
+	}
+
+	// fraction (its first 15 digits), scaled in double and added in float
+	if (Cursor < End && '.' == *Cursor && IsDigit(Cursor + 1)) {
+		++Cursor;
+		auto Fraction  = uint64{0};
+		auto NumDigits = 0;
+		for (; IsDigit(Cursor); ++Cursor) {
+			if (NumDigits < ObjMaxFractionDigits) {
+				Fraction = Fraction * 10 + (*Cursor - '0');
+				++NumDigits;
+			}
+		}
+		Value += static_cast<float>(static_cast<double>(Fraction) *
+		                            ObjFractionScales[NumDigits]);
+	}
+	// trailing decimal point
+	else if (Cursor < End && '.' == *Cursor) {
+		++Cursor;
+	}
+
+	// exponent, applied as a power of 10 in float
+	if (Cursor < End && ('e' == *Cursor || 'E' == *Cursor)) {
+		++Cursor;
+		const auto& bIsExponentNegative = Cursor < End && '-' == *Cursor;
+		if (bIsExponentNegative || (Cursor < End && '+' == *Cursor)) {
+			++Cursor;
+		}
+		if (!IsDigit(Cursor)) {
+			return false;
+		}
+		auto Exponent  = uint64{0};
+		auto NumDigits = 0;
+		for (; IsDigit(Cursor); ++Cursor) {
+			if (++NumDigits > 9) {
+				return false;
+			}
+			Exponent = Exponent * 10 + (*Cursor - '0');
+		}
+		const auto& ExponentValue = static_cast<float>(Exponent);
+		Value *= FMath::Pow(10.0f,
+		                    bIsExponentNegative ? -ExponentValue : ExponentValue);
+	}
+
+	if (bIsNegative) {
+		Value = -Value;
+	}
+	return true;
+}
+
+static bool ParseObjIndex(const uint8*& Cursor, const uint8* const End,
+                          const int64 NumBefore, const int64 NumTotal,
+                          int32& Index) {
+	const auto& bIsRelative = Cursor < End && '-' == *Cursor;
+	if (bIsRelative) {
+		++Cursor;
+	}
+
+	// digits without leading zeros, which assimp would read as another index
+	if (Cursor == End || *Cursor < '1' || '9' < *Cursor) {
+		return false;
+	}
+	auto Value     = int64{0};
+	auto NumDigits = 0;
+	for (; Cursor < End && '0' <= *Cursor && *Cursor <= '9'; ++Cursor) {
+		if (++NumDigits > 9) {
+			return false;
+		}
+		Value = Value * 10 + (*Cursor - '0');
+	}
+
+	// out of range makes assimp fail, or drop the attribute of the mesh
+	Value = bIsRelative ? NumBefore - Value : Value - 1;
+	if (Value < 0 || NumTotal <= Value) {
+		return false;
+	}
+	Index = static_cast<int32>(Value);
+	return true;
+}
+
+static int32 FindObjQuadStartCorner(const FObjFile& File,
+                                    const int32     FirstCorner) {
+	FVector3f Vertices[4];
+	for (auto i = 0; i < 4; ++i) {
+		Vertices[i] =
+		    File.Positions[File.CornerPositionIndices[FirstCorner + i]];
+	}
+
+	// normalize as aiVector3D::Normalize does
+	const auto& Normalize = [](FVector3f& Vector) {
+		const auto& Length = FMath::Sqrt(
+		    Vector.X * Vector.X + Vector.Y * Vector.Y + Vector.Z * Vector.Z);
+		if (0.0f != Length) {
+			const auto& InvLength = 1.0f / Length;
+			Vector.X *= InvLength;
+			Vector.Y *= InvLength;
+			Vector.Z *= InvLength;
+		}
+	};
+
+	// dot product as aiVector3D's operator* computes it
+	const auto& Dot = [](const FVector3f& A, const FVector3f& B) {
+		return A.X * B.X + A.Y * B.Y + A.Z * B.Z;
+	};
+
+	// a quad has at most one concave corner, whose angle is larger than pi
+	for (auto i = 0; i < 4; ++i) {
+		const auto& Vertex   = Vertices[i];
+		auto        Left     = Vertices[(i + 3) % 4] - Vertex;
+		auto        Diagonal = Vertices[(i + 2) % 4] - Vertex;
+		auto        Right    = Vertices[(i + 1) % 4] - Vertex;
+		Normalize(Left);
+		Normalize(Diagonal);
+		Normalize(Right);
+
+		const float Angle = FMath::Acos(Dot(Left, Diagonal)) +
+		                    FMath::Acos(Dot(Right, Diagonal));
+		if (Angle > AiMathPiF) {
+			return i;
+		}
+	}
+	return 0;
+}
+
+static void ConvertObjVertexRange(const FObjFile&           File,
+                                  const FObjMesh&           Mesh,
+                                  const EAiVertexAttributes Attributes,
+                                  const int32 Begin, const int32 End,
+                                  FLoadedMeshSectionData& Section) {
+	// the vertices of the section are the corners of the mesh
+	const auto& FirstCorner = Mesh.FirstCorner;
+
+	// vertices (Z is negated by MakeLeftHanded)
+	for (auto i = Begin; i < End; ++i) {
+		const auto& Position =
+		    File.Positions[File.CornerPositionIndices[FirstCorner + i]];
+		Section.Vertices[i] = FVector(Position.X, Position.Y, -Position.Z);
+	}
+
+	// normals
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Normal =
+			    File.Normals[File.CornerNormalIndices[FirstCorner + i]];
+			Section.Normals[i] = FVector(Normal.X, Normal.Y, -Normal.Z);
+		}
+	}
+
+	// UV channel (V is flipped by FlipUVs)
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::UV0Channel)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& TexCoord =
+			    File.TexCoords[File.CornerTexCoordIndices[FirstCorner + i]];
+			Section.UV0Channel[i] = FVector2D(TexCoord.X, 1.0f - TexCoord.Y);
+		}
+	}
+
+	// vertex colors (alpha is 1)
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Color =
+			    File.Colors[File.CornerPositionIndices[FirstCorner + i]];
+			Section.VertexColors0[i] =
+			    FLinearColor(Color.X, Color.Y, Color.Z, 1.0f);
+		}
+	}
+}
+
+static void ConvertObjVertexRangeCompact(const FObjFile&           File,
+                                         const FObjMesh&           Mesh,
+                                         const EAiVertexAttributes Attributes,
+                                         const int32 Begin, const int32 End,
+                                         FLoadedMeshSectionData& Section) {
+	// the vertices of the section are the corners of the mesh
+	const auto& FirstCorner = Mesh.FirstCorner;
+
+	// vertices (Z is negated by MakeLeftHanded)
+	for (auto i = Begin; i < End; ++i) {
+		const auto& Position =
+		    File.Positions[File.CornerPositionIndices[FirstCorner + i]];
+		Section.CompactVertices[i] =
+		    FVector3f(Position.X, Position.Y, -Position.Z);
+	}
+
+	// normals
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::Normals)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Normal =
+			    File.Normals[File.CornerNormalIndices[FirstCorner + i]];
+			Section.CompactNormals[i] =
+			    EncodeOctahedral(Normal.X, Normal.Y, -Normal.Z);
+		}
+	}
+
+	// UV channel (V is flipped by FlipUVs)
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::UV0Channel)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& TexCoord =
+			    File.TexCoords[File.CornerTexCoordIndices[FirstCorner + i]];
+			Section.CompactUV0Channel[i] =
+			    FVector2DHalf(TexCoord.X, 1.0f - TexCoord.Y);
+		}
+	}
+
+	// vertex colors (without sRGB conversion, same as the full precision path)
+	if (EnumHasAnyFlags(Attributes, EAiVertexAttributes::VertexColors0)) {
+		for (auto i = Begin; i < End; ++i) {
+			const auto& Color =
+			    File.Colors[File.CornerPositionIndices[FirstCorner + i]];
+			Section.CompactVertexColors0[i] =
+			    FLinearColor(Color.X, Color.Y, Color.Z, 1.0f).ToFColor(false);
+		}
+	}
+}
+
+template <typename IndexT>
+static void ConvertObjFaceRange(const FObjFile& File, const FObjMesh& Mesh,
+                                const int32 Begin, const int32 End,
+                                TArray<IndexT>& Triangles) {
+	// corners of the file, relative to the first corner of the mesh
+	const auto& TriangleCorners = File.TriangleCorners;
+	const auto& FirstCorner     = 3 * Mesh.FirstTriangle;
+	for (auto i = 3 * Begin; i < 3 * End; ++i) {
+		Triangles[i] = static_cast<IndexT>(TriangleCorners[FirstCorner + i] -
+		                                   Mesh.FirstCorner);
+	}
+}
+#pragma endregion
@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FAssetImportProfile;
+struct FLoadedMeshData;
+struct FLoadOptions;
+
+/**
+ * Material of an OBJ file, as assimp's OBJ importer makes it: the default
+ * material, a material of the material library (.mtl file), or a material
+ * made for a "usemtl" name that is not in the library.
+ */
+struct FObjMaterial {
+	// name ("DefaultMaterial" for the default material, as assimp names it)
+	FString Name;
+
+	// canonical form of the properties assimp imports (all but the name),
+	// equal for materials that assimp's RemoveRedundantMaterials step merges
+	FString Key;
+
+	// diffuse color ("Kd"), 0.6 gray by default
+	FLinearColor DiffuseColor = FLinearColor(0.6f, 0.6f, 0.6f, 1.0f);
+
+	// path of the diffuse texture as the library refers to it ("map_Kd"),
+	// empty if none
+	FString DiffuseTexturePath;
+};
+
+/**
+ * Mesh of an OBJ object: the faces of the object between two "usemtl"
+ * statements that change its material, as assimp splits them. It becomes a
+ * section, unless it has no faces. Its faces are a range of the corners and
+ * triangles of the file.
+ */
+struct FObjMesh {
+	// index in FObjFile::Materials of the material
+	int32 MaterialIndex = 0;
+
+	// first corner and number of corners, which become the vertices of the
+	// section
+	int32 FirstCorner = 0;
+	int32 NumCorners  = 0;
+
+	// first triangle and number of triangles
+	int32 FirstTriangle = 0;
+	int32 NumTriangles  = 0;
+};
+
+/**
+ * Object of an OBJ file: an "o" or "g" statement, or the default object of
+ * the faces before any of them. It becomes a node referring to the sections
+ * of its meshes.
+ */
+struct FObjObject {
+	// name ("defaultobject" for the default object, as assimp names it)
+	FString Name;
+
+	// first mesh in FObjFile::Meshes and number of meshes
+	int32 FirstMesh = 0;
+	int32 NumMeshes = 0;
+};
+
+/**
+ * Wavefront OBJ file, read as assimp's OBJ importer reads it: every corner of
+ * a face is a vertex of its own, in the order of the faces, and each quad is
+ * split into two triangles as assimp's Triangulate step splits it.
+ */
+struct FObjFile {
+	// positions ("v")
+	TArray<FVector3f> Positions;
+
+	// colors following the positions ("v x y z r g b"), empty if none
+	TArray<FVector3f> Colors;
+
+	// texture coordinates ("vt"), u and v only
+	TArray<FVector2f> TexCoords;
+
+	// normals ("vn")
+	TArray<FVector3f> Normals;
+
+	// index in Positions of each corner of the faces
+	TArray<int32> CornerPositionIndices;
+
+	// index in TexCoords of each corner, empty if the faces have no texture
+	// coordinates
+	TArray<int32> CornerTexCoordIndices;
+
+	// index in Normals of each corner, empty if the faces have no normals
+	// (unless normals are generated for them)
+	TArray<int32> CornerNormalIndices;
+
+	// corners of the triangles, 3 per triangle
+	TArray<int32> TriangleCorners;
+
+	// objects in the order they appear
+	TArray<FObjObject> Objects;
+
+	// meshes of all objects in the order they appear
+	TArray<FObjMesh> Meshes;
+
+	// materials in the order assimp adds them to the scene: the default
+	// material, the materials of the library, and the materials made for
+	// "usemtl" names that are not in the library
+	TArray<FObjMaterial> Materials;
+};
+
+/**
+ * Parse an OBJ file. The file is split into chunks at line ends, which are
+ * parsed concurrently: once to count the statements of each chunk, and once
+ * more to read them into their place in File. The first chunk is small and is
+ * counted before the others, so that a file with statements that are not
+ * supported near its start is rejected without reading the rest of it.
+ * Only files that the native loader converts as assimp does are accepted:
+ * there are only "v" (with or without RGB colors), "vt", "vn", "f", "o", "g",
+ * "s", "usemtl" and "mtllib" statements (and those that assimp ignores), every
+ * face is a triangle or a quad whose corners all have the same kinds of
+ * indices, every index is in range, every object name is unique, and every
+ * number is written in the plain decimal notation that assimp's float parser
+ * reads (e.g. not "nan" or "1,5"). A material library must be referred to by a
+ * single "mtllib" statement before any face, object or "usemtl" statement in
+ * the first chunk. Lines, points, polygons of more than 4 corners and line
+ * continuations are left to assimp.
+ * Numbers are converted with the same arithmetic as assimp's fast_atof (which
+ * is not correctly rounded), so that the values are the same.
+ * @param        Data                  content of the file
+ * @param        Size                  size of Data in bytes
+ * @param        LoadMaterialLibrary   reads the materials of the library of
+ *                                     the given name (see
+ *                                     ParseObjMaterialLibrary), and returns
+ *                                     whether they are accepted
+ * @param[out]   File                  parsed file
+ * @return  whether Data is accepted. If not, the reason is logged, and it
+ *          should be imported with assimp.
+ */
+bool ParseObj(const uint8* Data, int64 Size,
+              TFunctionRef<bool(const FString&, TArray<FObjMaterial>&)>
+                  LoadMaterialLibrary,
+              FObjFile& File);
+
+/**
+ * Parse a material library (.mtl file) of an OBJ file, as assimp's MTL
+ * importer reads it. Only libraries whose statements are "newmtl", "Ka", "Kd",
+ * "Ks", "Ke", "Tf", "Ns", "Ni", "d", "Tr", "illum" and "map_Kd" (without
+ * options), each material with a unique name, are accepted, since the others
+ * import properties that are not reproduced.
+ * @param        Data        content of the library
+ * @param        Size        size of Data in bytes
+ * @param[out]   Materials   materials in the order they appear
+ * @return  whether Data is accepted. If not, the reason is logged.
+ */
+bool ParseObjMaterialLibrary(const uint8* Data, int64 Size,
+                             TArray<FObjMaterial>& Materials);
+
+/**
+ * Try to construct mesh data from an OBJ file natively, without assimp. Its
+ * statements are parsed and its vertices are converted by all cores, while
+ * the textures of its materials are read through the texture cache.
+ * The result is the one assimp's OBJ importer makes of the file with the
+ * post-process steps of the import profile (see ParseObj for the files that
+ * are accepted), except for the last bit of values computed where compilers
+ * may contract floating-point operations differently from assimp's build (the
+ * power of 10 of numbers with an exponent, and whether a nearly flat quad is
+ * concave, which decides how it is split), and for normals generated by
+ * GenSmoothNormals, which are averaged at exactly equal positions (not within
+ * assimp's epsilon) and summed in another order.
+ * Since it is not guaranteed to be identical, entries of the disk cache made
+ * with the native loaders enabled are kept apart from the others.
+ * The Auto and Quality profiles join identical vertices and reorder faces,
+ * which is not reproduced, so files are always imported with assimp in them,
+ * as are files whose tangents need to be calculated.
+ * If the file is in another format, or is not accepted, MeshData is left
+ * untouched so that the file is imported with assimp.
+ * @param        FilePath              path to the file, whose extension tells
+ *                                     the format as it does to assimp
+ * @param        Data                  content of the file
+ * @param        Size                  size of Data in bytes
+ * @param        ImportProfile         which post-process steps to apply
+ * @param        LoadOptions           progressive delivery and cancellation
+ *                                     of the load. If canceled, the returned
+ *                                     mesh data is incomplete and must be
+ *                                     discarded.
+ * @param[out]   MeshData              constructed mesh data
+ * @param[out]   DependencyFilePaths   full paths of the files other than the
+ *                                     OBJ file that the mesh data is
+ *                                     converted from (the material library),
+ *                                     added to if constructed
+ * @return  whether the mesh data has been constructed
+ */
+bool TryConstructMeshDataFromObjFile(const FString& FilePath, const uint8* Data,
+                                     int64                      Size,
+                                     const FAssetImportProfile& ImportProfile,
+                                     const FLoadOptions&        LoadOptions,
+                                     FLoadedMeshData&           MeshData,
+                                     TArray<FString>& DependencyFilePaths);
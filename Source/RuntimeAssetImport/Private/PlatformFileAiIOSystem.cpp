@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PlatformFileAiIOSystem.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "LogAssetLoader.h"
+#include "Misc/Paths.h"
+
+FPlatformFileAiIOStream::FPlatformFileAiIOStream(
+    TUniquePtr<IMappedFileHandle> InMappedFileHandle,
+    TUniquePtr<IMappedFileRegion> InMappedFileRegion)
+    : MappedFileHandle(MoveTemp(InMappedFileHandle)),
+      MappedFileRegion(MoveTemp(InMappedFileRegion)),
+      Size(MappedFileRegion->GetMappedSize()) {}
+
+FPlatformFileAiIOStream::FPlatformFileAiIOStream(
+    TUniquePtr<IFileHandle> InFileHandle)
+    : FileHandle(MoveTemp(InFileHandle)), Size(FileHandle->Size()) {}
+
+size_t FPlatformFileAiIOStream::Read(void* const  pvBuffer,
+                                     const size_t pSize,
+                                     const size_t pCount) {
+	// nothing to read
+	if (0 == pSize || 0 == pCount) {
+		return 0;
+	}
+
+	// read only whole elements that remain in the file
+	const auto& NumRemainingElements =
+	    static_cast<size_t>(Size - Position) / pSize;
+	const auto& NumElementsToRead = FMath::Min(pCount, NumRemainingElements);
+	const auto& BytesToRead       = static_cast<int64>(NumElementsToRead * pSize);
+
+	if (MappedFileRegion.IsValid()) {
+		// copy from the mapped region
+		FMemory::Memcpy(pvBuffer, MappedFileRegion->GetMappedPtr() + Position,
+		                BytesToRead);
+	} else {
+		// read from the file handle
+		if (!FileHandle->Read(static_cast<uint8*>(pvBuffer), BytesToRead)) {
+			UE_LOG(LogAssetLoader, Error, TEXT("Failed to read %lld bytes."),
+			       BytesToRead);
+			return 0;
+		}
+	}
+
+	// advance position
+	Position += BytesToRead;
+
+	return NumElementsToRead;
+}
+
+size_t FPlatformFileAiIOStream::Write(const void* /* pvBuffer */,
+                                      size_t /* pSize */,
+                                      size_t /* pCount */) {
+	// writing is not supported
+	return 0;
+}
+
+aiReturn FPlatformFileAiIOStream::Seek(const size_t   pOffset,
+                                       const aiOrigin pOrigin) {
+	// calculate new position
+	int64 NewPosition;
+	switch (pOrigin) {
+	case aiOrigin_SET:
+		NewPosition = pOffset;
+		break;
+	case aiOrigin_CUR:
+		NewPosition = Position + pOffset;
+		break;
+	case aiOrigin_END:
+		NewPosition = Size - pOffset;
+		break;
+	default:
+		return aiReturn_FAILURE;
+	}
+
+	// out of range
+	if (NewPosition < 0 || Size < NewPosition) {
+		return aiReturn_FAILURE;
+	}
+
+	// seek the file handle too
+	if (FileHandle.IsValid() && !FileHandle->Seek(NewPosition)) {
+		return aiReturn_FAILURE;
+	}
+
+	Position = NewPosition;
+
+	return aiReturn_SUCCESS;
+}
+
+size_t FPlatformFileAiIOStream::Tell() const {
+	return Position;
+}
+
+size_t FPlatformFileAiIOStream::FileSize() const {
+	return Size;
+}
+
+void FPlatformFileAiIOStream::Flush() {
+	// nothing to flush since writing is not supported
+}
+
+const TArray<FString>& FPlatformFileAiIOSystem::GetOpenedFilePaths() const {
+	return OpenedFilePaths;
+}
+
+bool FPlatformFileAiIOSystem::Exists(const char* const pFile) const {
+	// get platform file (top of the chain, so pak files are included)
+	auto& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	return PlatformFile.FileExists(UTF8_TO_TCHAR(pFile));
+}
+
+char FPlatformFileAiIOSystem::getOsSeparator() const {
+	// UE accepts '/' on all platforms
+	return '/';
+}
+
+Assimp::IOStream* FPlatformFileAiIOSystem::Open(const char* const pFile,
+                                                const char* const pMode) {
+	// writing is not supported
+	if (nullptr != FCStringAnsi::Strchr(pMode, 'w') ||
+	    nullptr != FCStringAnsi::Strchr(pMode, 'a')) {
+		UE_LOG(LogAssetLoader, Error,
+		       TEXT("Opening %s with mode %s is not supported."),
+		       UTF8_TO_TCHAR(pFile), ANSI_TO_TCHAR(pMode));
+		return nullptr;
+	}
+
+	// get platform file (top of the chain, so pak files are included)
+	auto& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// get file path
+	const FString FilePath = UTF8_TO_TCHAR(pFile);
+
+	// try to memory-map the file first
+	auto OpenMappedResult = PlatformFile.OpenMappedEx(*FilePath);
+	if (OpenMappedResult.HasValue()) {
+		auto MappedFileHandle = OpenMappedResult.StealValue();
+
+		// map whole file
+		TUniquePtr<IMappedFileRegion> MappedFileRegion(
+		    MappedFileHandle->MapRegion(0, MappedFileHandle->GetFileSize()));
+
+		if (MappedFileRegion.IsValid()) {
+			OpenedFilePaths.AddUnique(FPaths::ConvertRelativePathToFull(FilePath));
+			return new FPlatformFileAiIOStream(MoveTemp(MappedFileHandle),
+			                                   MoveTemp(MappedFileRegion));
+		}
+	}
+
+	// if the file cannot be mapped (e.g. compressed in a pak file), read it
+	// through a file handle
+	TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenRead(*FilePath));
+	if (!FileHandle.IsValid()) {
+		UE_LOG(LogAssetLoader, Log, TEXT("Failed to open %s."), *FilePath);
+		return nullptr;
+	}
+
+	OpenedFilePaths.AddUnique(FPaths::ConvertRelativePathToFull(FilePath));
+	return new FPlatformFileAiIOStream(MoveTemp(FileHandle));
+}
+
+void FPlatformFileAiIOSystem::Close(Assimp::IOStream* const pFile) {
+	delete pFile;
+}
@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+/**
+ * Assimp IOStream that reads a file through UE's IPlatformFile.
+ * If the file can be memory-mapped, reads are served from the mapped region,
+ * otherwise from a regular file handle.
+ */
+class FPlatformFileAiIOStream : public Assimp::IOStream {
+public:
+	/**
+	 * Construct a stream that reads from a memory-mapped file.
+	 * @param   InMappedFileHandle   handle of the mapped file
+	 * @param   InMappedFileRegion   region covering the whole file
+	 */
+	FPlatformFileAiIOStream(TUniquePtr<IMappedFileHandle> InMappedFileHandle,
+	                        TUniquePtr<IMappedFileRegion> InMappedFileRegion);
+
+	/**
+	 * Construct a stream that reads from a file handle.
+	 * @param   InFileHandle   handle of the file opened for reading
+	 */
+	explicit FPlatformFileAiIOStream(TUniquePtr<IFileHandle> InFileHandle);
+
+public:
+	/* Assimp::IOStream implementation */
+	virtual size_t   Read(void* pvBuffer, size_t pSize, size_t pCount) override;
+	virtual size_t   Write(const void* pvBuffer, size_t pSize,
+	                       size_t pCount) override;
+	virtual aiReturn Seek(size_t pOffset, aiOrigin pOrigin) override;
+	virtual size_t   Tell() const override;
+	virtual size_t   FileSize() const override;
+	virtual void     Flush() override;
+
+	/* internal fields */
+private:
+	// mapped file (null if reading from FileHandle)
+	TUniquePtr<IMappedFileHandle> MappedFileHandle;
+	TUniquePtr<IMappedFileRegion> MappedFileRegion;
+
+	// file handle (null if reading from MappedFileRegion)
+	TUniquePtr<IFileHandle> FileHandle;
+
+	// size of the file
+	int64 Size = 0;
+
+	// current read position
+	int64 Position = 0;
+};
+
+/**
+ * Assimp IOSystem that opens files through UE's IPlatformFile, so that assets
+ * in pak files or IoStore containers can be imported directly, and large files
+ * are memory-mapped instead of being copied through stdio buffers.
+ * Only reading is supported.
+ * The files that have been opened are recorded, so that the caller knows which
+ * files an import has read.
+ */
+class FPlatformFileAiIOSystem : public Assimp::IOSystem {
+public:
+	/**
+	 * Get the full paths of the files that have been opened, each only once.
+	 */
+	const TArray<FString>& GetOpenedFilePaths() const;
+
+public:
+	/* Assimp::IOSystem implementation */
+	virtual bool              Exists(const char* pFile) const override;
+	virtual char              getOsSeparator() const override;
+	virtual Assimp::IOStream* Open(const char* pFile,
+	                               const char* pMode = "rb") override;
+	virtual void              Close(Assimp::IOStream* pFile) override;
+
+	/* internal fields */
+private:
+	// full paths of the opened files
+	TArray<FString> OpenedFilePaths;
+};
@@ -2,17 +2,35 @@
 
 #include "RuntimeAssetImport.h"
 
+#include "AiImporterPool.h"
+#include "IImageWrapperModule.h"
+#include "RuntimeAssetImportSettings.h"
+
 #define LOCTEXT_NAMESPACE "FRuntimeAssetImportModule"
 
 void FRuntimeAssetImportModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// FImageUtils, which is used while loading materials, loads the ImageWrapper module on demand.
+	// Since loading may run on worker threads (UAssetLoader::Load*Async), load the module here in advance.
+	FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+
+	// Load assimp and construct the importers that loads borrow in advance, so that the first load does not hitch.
+	if (GetDefault<URuntimeAssetImportSettings>()->bWarmUpImportersOnStartup)
+	{
+		ImporterWarmUpTask = FAiImporterPool::Get().WarmUpAsync();
+	}
 }
 
 void FRuntimeAssetImportModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+
+	// Delete the pooled importers while assimp is still loaded.
+	ImporterWarmUpTask.Wait();
+	FAiImporterPool::Get().Empty();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetLoader.h"
+#include "ExternalTextureCache.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Guid.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "RuntimeAssetImportSettings.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#pragma region forward declarations of static functions
+/**
+ * Make a PNG of 2x2 pixels.
+ * @return  content of the PNG, empty on failure
+ */
+static TArray64<uint8> MakeTexturePng();
+
+/**
+ * Make an OBJ of a triangle with texture coordinates, which uses the material
+ * of an .mtl file.
+ * @param   MtlFileName   name of the .mtl file next to the OBJ
+ * @param   Offset        offset of the vertices, so that OBJs differ
+ * @return  content of the OBJ
+ */
+static FString MakeTexturedTriangleObj(const FString& MtlFileName,
+                                       float          Offset);
+#pragma endregion
+
+BEGIN_DEFINE_SPEC(FExternalTextureCacheSpec,
+                  "RuntimeAssetImport.ExternalTextureCache",
+                  EAutomationTestFlags::ApplicationContextMask |
+                      EAutomationTestFlags::ProductFilter)
+// settings that the tests change, restored after each of them
+bool  bEnableDiskCache      = false;
+bool  bEnableMemoryCache    = false;
+int32 MaxTextureCacheSizeMB = 0;
+END_DEFINE_SPEC(FExternalTextureCacheSpec)
+
+void FExternalTextureCacheSpec::Define() {
+	BeforeEach([this] {
+		auto* const Settings  = GetMutableDefault<URuntimeAssetImportSettings>();
+		bEnableDiskCache      = Settings->bEnableDiskCache;
+		bEnableMemoryCache    = Settings->bEnableMemoryCache;
+		MaxTextureCacheSizeMB = Settings->MaxTextureCacheSizeMB;
+
+		// every load must import its asset, and only the texture may be cached
+		Settings->bEnableDiskCache      = false;
+		Settings->bEnableMemoryCache    = false;
+		Settings->MaxTextureCacheSizeMB = FMath::Max(1, MaxTextureCacheSizeMB);
+	});
+
+	AfterEach([this] {
+		auto* const Settings = GetMutableDefault<URuntimeAssetImportSettings>();
+		Settings->bEnableDiskCache      = bEnableDiskCache;
+		Settings->bEnableMemoryCache    = bEnableMemoryCache;
+		Settings->MaxTextureCacheSizeMB = MaxTextureCacheSizeMB;
+	});
+
+	It("reads a texture file shared by two models only once", [this] {
+		// write the texture under a new name, so that no earlier load cached it
+		const auto& Directory =
+		    FPaths::AutomationTransientDir() / TEXT("ExternalTextureCache");
+		const auto& Name = FGuid::NewGuid().ToString();
+		const auto& PngFileName = Name + TEXT(".png");
+		const auto& MtlFileName = Name + TEXT(".mtl");
+		const auto& Png         = MakeTexturePng();
+		if (!TestFalse(TEXT("texture is encoded"), Png.IsEmpty()) ||
+		    !TestTrue(TEXT("texture is written"),
+		              FFileHelper::SaveArrayToFile(
+		                  Png, *(Directory / PngFileName)))) {
+			return;
+		}
+
+		// write a material library referring to it, and two models using it
+		const auto& Mtl = FString::Printf(
+		    TEXT("newmtl Shared\nKd 1 1 1\nmap_Kd %s\n"), *PngFileName);
+		TArray<FString> ObjFilePaths;
+		for (auto i = 0; i < 2; ++i) {
+			ObjFilePaths.Add(Directory /
+			                 FString::Printf(TEXT("%s_%d.obj"), *Name, i));
+			if (!TestTrue(TEXT("model is written"),
+			              FFileHelper::SaveStringToFile(
+			                  MakeTexturedTriangleObj(MtlFileName, i),
+			                  *ObjFilePaths.Last()))) {
+				return;
+			}
+		}
+		if (!TestTrue(TEXT("material library is written"),
+		              FFileHelper::SaveStringToFile(
+		                  Mtl, *(Directory / MtlFileName)))) {
+			return;
+		}
+
+		// load both models
+		auto&       TextureCache  = FExternalTextureCache::Get();
+		const auto& NumLoadsStart = TextureCache.GetNumLoads();
+		for (const auto& ObjFilePath : ObjFilePaths) {
+			ELoadMeshFromAssetFileResult Result;
+			const auto&                  MeshData =
+			    UAssetLoader::LoadMeshFromAssetFile(ObjFilePath, Result);
+			if (!TestTrue(TEXT("model is loaded"),
+			              ELoadMeshFromAssetFileResult::Success == Result) ||
+			    !TestEqual(TEXT("number of materials"),
+			               MeshData.MaterialList.Num(), 1)) {
+				return;
+			}
+			TestTrue(TEXT("texture is set"),
+			         EColorStatus::TextureIsSet ==
+			             MeshData.MaterialList[0].ColorStatus);
+		}
+
+		// the texture file is read by the first load, and found by the second
+		TestEqual(TEXT("number of texture loads"),
+		          TextureCache.GetNumLoads() - NumLoadsStart, uint64(1));
+	});
+}
+
+#pragma region definitions of static functions
+static TArray64<uint8> MakeTexturePng() {
+	// BGRA pixels
+	const uint8 Pixels[2 * 2 * 4] = {0,   0,   255, 255, 0,   255, 0,   255,
+	                                 255, 0,   0,   255, 255, 255, 255, 255};
+
+	auto&       ImageWrapperModule =
+	    FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+	const auto& ImageWrapper =
+	    ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() ||
+	    !ImageWrapper->SetRaw(Pixels, sizeof(Pixels), 2, 2, ERGBFormat::BGRA,
+	                          8)) {
+		return TArray64<uint8>();
+	}
+	return ImageWrapper->GetCompressed();
+}
+
+static FString MakeTexturedTriangleObj(const FString& MtlFileName,
+                                       float          Offset) {
+	return FString::Printf(TEXT("mtllib %s\n"
+	                            "v %f 0 0\n"
+	                            "v %f 0 0\n"
+	                            "v %f 1 0\n"
+	                            "vt 0 0\n"
+	                            "vt 1 0\n"
+	                            "vt 1 1\n"
+	                            "usemtl Shared\n"
+	                            "f 1/1 2/2 3/3\n"),
+	                       *MtlFileName, Offset, Offset + 1.0f, Offset + 1.0f);
+}
+#pragma endregion
+
+#endif
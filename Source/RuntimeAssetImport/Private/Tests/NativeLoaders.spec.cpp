@@ -0,0 +1,1008 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetLoader.h"
+#include "BinaryMeshFiles.h"
+#include "GltfAsset.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "MeshDataConstruction.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "ObjFile.h"
+#include "RuntimeAssetImportSettings.h"
+#include "VertexStreamConversion.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * How the attributes of the quad fixture are stored in a GLB.
+ */
+enum class EQuadGlbEncoding : uint8 {
+	// floats
+	Float,
+
+	// floats, with the positions compressed with EXT_meshopt_compression
+	Meshopt,
+
+	// integers (KHR_mesh_quantization)
+	Quantized,
+};
+
+// vertices of the quad fixture (as quantized in the quantized GLB)
+static const uint16 QuadPositions[4][3] = {
+    {0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}};
+static const int8  QuadNormal[3]          = {0, 0, 127};
+static const uint8 QuadTexCoords[4][2]    = {
+    {0, 0}, {255, 51}, {255, 255}, {51, 255}};
+static const uint8 QuadColors[4][4] = {
+    {255, 0, 0, 255}, {0, 255, 0, 255}, {0, 0, 255, 255}, {255, 255, 255, 128}};
+static const uint16 QuadIndices[6] = {0, 1, 2, 0, 2, 3};
+
+// the same texture coordinates dequantized as glTF specifies (51 / 255 is 0.2)
+static const FVector4f DequantizedQuadTexCoords[4] = {
+    {0.0f, 0.0f, 0.0f, 0.0f},
+    {1.0f, 0.2f, 0.0f, 0.0f},
+    {1.0f, 1.0f, 0.0f, 0.0f},
+    {0.2f, 1.0f, 0.0f, 0.0f}};
+
+#pragma region forward declarations of static functions
+/**
+ * Make a GLB of a quad with positions, normals, texture coordinates, indices,
+ * a material and a translated node.
+ * @param   Encoding   how the attributes are stored
+ * @return  content of the GLB
+ */
+static TArray<uint8> MakeQuadGlb(EQuadGlbEncoding Encoding);
+
+/**
+ * Make a binary STL of the quad (two facets).
+ * @return  content of the STL
+ */
+static TArray<uint8> MakeQuadStl();
+
+/**
+ * Make a binary little-endian PLY of the quad with normals and colors.
+ * @return  content of the PLY
+ */
+static TArray<uint8> MakeQuadPly();
+
+/**
+ * Make an OBJ of the quad and a triangle in one object, and a concave quad in
+ * a group, with normals, texture coordinates and relative indices.
+ * @return  content of the OBJ
+ */
+static TArray<uint8> MakeQuadObj();
+
+/**
+ * Make an OBJ of a pyramid without normals, whose corners at the same position
+ * get the averaged normal of their faces when normals are generated.
+ * @return  content of the OBJ
+ */
+static TArray<uint8> MakePyramidObj();
+
+/**
+ * Make an OBJ of three objects whose faces use the materials of a material
+ * library (see MakeMaterialLibrary), a material that is not in it, and the
+ * same material more than once.
+ * @param   MaterialLibraryName   name of the material library next to the OBJ
+ * @return  content of the OBJ
+ */
+static TArray<uint8> MakeMaterialsObj(const FString& MaterialLibraryName);
+
+/**
+ * Make a material library with a textured material, two materials with the
+ * same properties written differently, and a material no face uses.
+ * @param   TextureName   name of the texture next to the library
+ * @return  content of the material library
+ */
+static FString MakeMaterialLibrary(const FString& TextureName);
+
+/**
+ * Make a PNG of 2x2 pixels.
+ * @return  content of the PNG, empty on failure
+ */
+static TArray64<uint8> MakeTexturePng();
+
+/**
+ * Encode vertices as an EXT_meshopt_compression attribute buffer, storing
+ * every byte group raw. The result is larger than meshoptimizer's, but is
+ * decoded the same way.
+ * @param   Vertices     vertices to encode
+ * @param   Count        number of vertices
+ * @param   ByteStride   size of a vertex in bytes (a multiple of 4)
+ * @return  encoded buffer
+ */
+static TArray<uint8> EncodeMeshoptVertices(const uint8* Vertices, int32 Count,
+                                           int32 ByteStride);
+
+/**
+ * Append the bytes of a value to data (in the byte order of the platform,
+ * which is little-endian as glTF, STL and PLY are).
+ * @param[in,out]   Data    data to append to
+ * @param           Value   value
+ */
+template <typename T>
+static void AppendValue(TArray<uint8>& Data, const T& Value);
+
+/**
+ * Whether two elements of a stream are equal within a tolerance.
+ * @param   Actual      element of the native loader
+ * @param   Expected    element of assimp
+ * @param   Tolerance   maximum difference of each component
+ */
+template <typename T>
+static bool IsNearlyEqual(const T& Actual, const T& Expected, float Tolerance);
+
+/**
+ * Whether two indices are equal (indices have no tolerance).
+ */
+static bool IsNearlyEqual(int32 Actual, int32 Expected, float Tolerance);
+static bool IsNearlyEqual(uint16 Actual, uint16 Expected, float Tolerance);
+
+/**
+ * Whether two octahedral-encoded unit vectors are equal within a tolerance
+ * after being decoded, allowing for the quantization.
+ */
+static bool IsNearlyEqual(uint32 Actual, uint32 Expected, float Tolerance);
+
+/**
+ * Whether two half precision texture coordinates are equal within a
+ * tolerance, allowing for the rounding to half precision.
+ */
+static bool IsNearlyEqual(const FVector2DHalf& Actual,
+                          const FVector2DHalf& Expected, float Tolerance);
+
+/**
+ * Whether two 8-bit colors are equal, allowing for rounding by one step.
+ */
+static bool IsNearlyEqual(const FColor& Actual, const FColor& Expected,
+                          float Tolerance);
+#pragma endregion
+
+BEGIN_DEFINE_SPEC(FNativeLoadersSpec, "RuntimeAssetImport.NativeLoaders",
+                  EAutomationTestFlags::ApplicationContextMask |
+                      EAutomationTestFlags::ProductFilter)
+// settings that the tests change, restored after each of them
+bool bEnableNativeLoaders = true;
+bool bEnableDiskCache     = false;
+bool bEnableMemoryCache   = false;
+
+/**
+ * Convert an asset with the native loader, import another one with assimp,
+ * and test that the mesh data is identical. Both are read from the same path
+ * in the transient directory, next to the files the asset refers to.
+ * @param   FileName        name of the file, whose extension tells the format
+ * @param   NativeData      content of the asset converted natively
+ * @param   AssimpData      content of the asset imported with assimp
+ * @param   ImportProfile   which post-process steps to apply
+ * @param   Tolerance       maximum difference of each component of the
+ *                          values, 0 to compare them bit by bit
+ */
+void TestNativeLoaderMatchesAssimp(const FString&             FileName,
+                                   const TArray<uint8>&       NativeData,
+                                   const TArray<uint8>&       AssimpData,
+                                   const FAssetImportProfile& ImportProfile,
+                                   float                      Tolerance = 0.0f);
+
+/**
+ * Test that two mesh data are identical, bit by bit or within a tolerance.
+ * @param   Actual      mesh data of the native loader
+ * @param   Expected    mesh data of assimp
+ * @param   Tolerance   maximum difference of each component of the values, 0
+ *                      to compare them bit by bit
+ */
+void TestMeshDataEqual(const FLoadedMeshData& Actual,
+                       const FLoadedMeshData& Expected, float Tolerance);
+
+/**
+ * Test that two streams are identical, bit by bit or within a tolerance.
+ * @param   What        name of the stream
+ * @param   Actual      stream of the native loader
+ * @param   Expected    stream of assimp
+ * @param   Tolerance   maximum difference of each component, 0 to compare
+ *                      the streams bit by bit
+ */
+template <typename T>
+void TestStreamEqual(const FString& What, const TArray<T>& Actual,
+                     const TArray<T>& Expected, const float Tolerance) {
+	if (0.0f == Tolerance) {
+		TestTrue(What,
+		         Actual.Num() == Expected.Num() &&
+		             0 == FMemory::Memcmp(Actual.GetData(), Expected.GetData(),
+		                                  Actual.Num() * sizeof(T)));
+		return;
+	}
+
+	auto bIsEqual = Actual.Num() == Expected.Num();
+	for (auto i = 0; bIsEqual && i < Actual.Num(); ++i) {
+		bIsEqual = IsNearlyEqual(Actual[i], Expected[i], Tolerance);
+	}
+	TestTrue(What, bIsEqual);
+}
+END_DEFINE_SPEC(FNativeLoadersSpec)
+
+void FNativeLoadersSpec::Define() {
+	BeforeEach([this] {
+		auto* const Settings = GetMutableDefault<URuntimeAssetImportSettings>();
+		bEnableNativeLoaders = Settings->bEnableNativeLoaders;
+		bEnableDiskCache     = Settings->bEnableDiskCache;
+		bEnableMemoryCache   = Settings->bEnableMemoryCache;
+
+		// the assimp results must not come from the caches
+		Settings->bEnableDiskCache   = false;
+		Settings->bEnableMemoryCache = false;
+	});
+
+	AfterEach([this] {
+		auto* const Settings = GetMutableDefault<URuntimeAssetImportSettings>();
+		Settings->bEnableNativeLoaders = bEnableNativeLoaders;
+		Settings->bEnableDiskCache     = bEnableDiskCache;
+		Settings->bEnableMemoryCache   = bEnableMemoryCache;
+	});
+
+	for (const auto bCompactPrecision : {false, true}) {
+		// the Fast profile applies only steps that the native loaders reproduce
+		FAssetImportProfile ImportProfile;
+		ImportProfile.ProfileType       = EAssetImportProfileType::Fast;
+		ImportProfile.bCompactPrecision = bCompactPrecision;
+
+		const auto& Precision = bCompactPrecision ? TEXT("in compact precision")
+		                                          : TEXT("in full precision");
+		Describe(Precision, [this, ImportProfile] {
+			It("converts a GLB as assimp does", [this, ImportProfile] {
+				const auto& Glb = MakeQuadGlb(EQuadGlbEncoding::Float);
+				TestNativeLoaderMatchesAssimp(TEXT("Quad.glb"), Glb, Glb,
+				                              ImportProfile);
+			});
+
+			It("converts a meshopt-compressed GLB as assimp does the "
+			   "uncompressed one",
+			   [this, ImportProfile] {
+				   TestNativeLoaderMatchesAssimp(
+				       TEXT("Quad.glb"), MakeQuadGlb(EQuadGlbEncoding::Meshopt),
+				       MakeQuadGlb(EQuadGlbEncoding::Float), ImportProfile);
+			   });
+
+			It("converts a quantized GLB as assimp does the dequantized one",
+			   [this, ImportProfile] {
+				   TestNativeLoaderMatchesAssimp(
+				       TEXT("Quad.glb"),
+				       MakeQuadGlb(EQuadGlbEncoding::Quantized),
+				       MakeQuadGlb(EQuadGlbEncoding::Float), ImportProfile);
+			   });
+
+			It("converts a binary STL as assimp does", [this, ImportProfile] {
+				const auto& Stl = MakeQuadStl();
+				TestNativeLoaderMatchesAssimp(TEXT("Quad.stl"), Stl, Stl,
+				                              ImportProfile);
+			});
+
+			It("converts a binary PLY as assimp does", [this, ImportProfile] {
+				const auto& Ply = MakeQuadPly();
+				TestNativeLoaderMatchesAssimp(TEXT("Quad.ply"), Ply, Ply,
+				                              ImportProfile);
+			});
+
+			// OBJ values may differ slightly (see
+			// TryConstructMeshDataFromObjFile)
+			It("converts an OBJ as assimp does", [this, ImportProfile] {
+				const auto& Obj = MakeQuadObj();
+				TestNativeLoaderMatchesAssimp(TEXT("Quad.obj"), Obj, Obj,
+				                              ImportProfile, KINDA_SMALL_NUMBER);
+			});
+
+			It("converts an OBJ without normals as assimp does",
+			   [this, ImportProfile] {
+				   const auto& Obj = MakePyramidObj();
+				   TestNativeLoaderMatchesAssimp(TEXT("Pyramid.obj"), Obj, Obj,
+				                                 ImportProfile,
+				                                 KINDA_SMALL_NUMBER);
+			   });
+		});
+	}
+
+	Describe("with an OBJ that uses materials", [this] {
+		BeforeEach([this] {
+			// the material library and its texture next to the OBJ
+			const auto& Directory =
+			    FPaths::AutomationTransientDir() / TEXT("NativeLoaders");
+			const auto& Png = MakeTexturePng();
+			TestFalse(TEXT("texture is encoded"), Png.IsEmpty());
+			TestTrue(TEXT("texture is written"),
+			         FFileHelper::SaveArrayToFile(
+			             Png, *(Directory / TEXT("Materials.png"))));
+			TestTrue(TEXT("material library is written"),
+			         FFileHelper::SaveStringToFile(
+			             MakeMaterialLibrary(TEXT("Materials.png")),
+			             *(Directory / TEXT("Materials.mtl"))));
+		});
+
+		It("converts it as assimp does", [this] {
+			FAssetImportProfile ImportProfile;
+			ImportProfile.ProfileType = EAssetImportProfileType::Fast;
+			const auto& Obj = MakeMaterialsObj(TEXT("Materials.mtl"));
+			TestNativeLoaderMatchesAssimp(TEXT("Materials.obj"), Obj, Obj,
+			                              ImportProfile, KINDA_SMALL_NUMBER);
+		});
+
+		It("removes redundant materials as assimp does", [this] {
+			FAssetImportProfile ImportProfile;
+			ImportProfile.ProfileType = EAssetImportProfileType::Custom;
+			ImportProfile.CustomPostProcessSteps = static_cast<int32>(
+			    EAssetImportPostProcessStep::RemoveRedundantMaterials);
+			const auto& Obj = MakeMaterialsObj(TEXT("Materials.mtl"));
+			TestNativeLoaderMatchesAssimp(TEXT("Materials.obj"), Obj, Obj,
+			                              ImportProfile, KINDA_SMALL_NUMBER);
+		});
+
+		It("records the material library as a dependency", [this] {
+			FAssetImportProfile ImportProfile;
+			ImportProfile.ProfileType = EAssetImportProfileType::Fast;
+			const auto& Directory = FPaths::ConvertRelativePathToFull(
+			    FPaths::AutomationTransientDir() / TEXT("NativeLoaders"));
+			const auto& Obj = MakeMaterialsObj(TEXT("Materials.mtl"));
+			FLoadedMeshData MeshData;
+			TArray<FString> DependencyFilePaths;
+			if (!TestTrue(TEXT("native loader converts the asset"),
+			              TryConstructMeshDataFromObjFile(
+			                  Directory / TEXT("Materials.obj"), Obj.GetData(),
+			                  Obj.Num(), ImportProfile, FLoadOptions(),
+			                  MeshData, DependencyFilePaths))) {
+				return;
+			}
+			TestTrue(TEXT("material library is the only dependency"),
+			         DependencyFilePaths ==
+			             TArray<FString>{Directory / TEXT("Materials.mtl")});
+		});
+	});
+
+	It("dequantizes the attributes of a quantized GLB", [this] {
+		const auto& Glb = MakeQuadGlb(EQuadGlbEncoding::Quantized);
+		FGltfAsset  Asset;
+		if (!TestTrue(TEXT("GLB is parsed"),
+		              ParseGlb(Glb.GetData(), Glb.Num(), Asset))) {
+			return;
+		}
+
+		const auto& Primitive = Asset.Meshes[0].Primitives[0];
+		for (auto i = 0; i < 4; ++i) {
+			TestTrue(FString::Printf(TEXT("position %d"), i),
+			         Primitive.Positions.GetFloats(i).Equals(
+			             FVector4f(QuadPositions[i][0], QuadPositions[i][1],
+			                       QuadPositions[i][2], 0.0f),
+			             0.0f));
+			TestTrue(FString::Printf(TEXT("normal %d"), i),
+			         Primitive.Normals->GetFloats(i).Equals(
+			             FVector4f(0.0f, 0.0f, 1.0f, 0.0f), 0.0f));
+			TestTrue(FString::Printf(TEXT("texture coordinate %d"), i),
+			         Primitive.TexCoords0->GetFloats(i).Equals(
+			             DequantizedQuadTexCoords[i], KINDA_SMALL_NUMBER));
+		}
+	});
+
+	It("splits a concave quad of an OBJ at its concave corner", [this] {
+		const auto& Obj = MakeQuadObj();
+		FObjFile    File;
+		if (!TestTrue(TEXT("OBJ is parsed"),
+		              ParseObj(Obj.GetData(), Obj.Num(),
+		                       [](const FString&, TArray<FObjMaterial>&) {
+			                       return false;
+		                       },
+		                       File)) ||
+		    !TestEqual(TEXT("number of objects"), File.Objects.Num(), 2)) {
+			return;
+		}
+
+		// the quad is fanned from its 4th corner, which is concave
+		const auto& Object = File.Objects[1];
+		const auto& Mesh   = File.Meshes[Object.FirstMesh];
+		TestEqual(TEXT("name"), Object.Name, FString(TEXT("Concave")));
+		TestEqual(TEXT("number of triangles"), Mesh.NumTriangles, 2);
+		const int32 Expected[6] = {3, 0, 1, 3, 1, 2};
+		for (auto i = 0; i < 6; ++i) {
+			TestEqual(FString::Printf(TEXT("corner %d"), i),
+			          File.TriangleCorners[3 * Mesh.FirstTriangle + i] -
+			              Mesh.FirstCorner,
+			          Expected[i]);
+		}
+	});
+}
+
+void FNativeLoadersSpec::TestNativeLoaderMatchesAssimp(
+    const FString& FileName, const TArray<uint8>& NativeData,
+    const TArray<uint8>& AssimpData, const FAssetImportProfile& ImportProfile,
+    const float Tolerance) {
+	// write the file for assimp, which picks the importer by the extension
+	const auto& FilePath = FPaths::ConvertRelativePathToFull(
+	    FPaths::AutomationTransientDir() / TEXT("NativeLoaders") / FileName);
+	if (!TestTrue(TEXT("fixture is written"),
+	              FFileHelper::SaveArrayToFile(AssimpData, *FilePath))) {
+		return;
+	}
+
+	// convert natively from the same path (the loader must accept the asset)
+	FLoadedMeshData NativeMeshData;
+	TArray<FString> DependencyFilePaths;
+	const auto&     Data = NativeData.GetData();
+	const auto&     Size = NativeData.Num();
+	const auto&     bIsConverted =
+	    HasGlbSignature(Data, Size)
+	        ? TryConstructMeshDataFromGlb(Data, Size, ImportProfile,
+	                                      FLoadOptions(), NativeMeshData)
+	        : TryConstructMeshDataFromBinaryMeshFile(
+	              FilePath, Data, Size, ImportProfile, FLoadOptions(),
+	              NativeMeshData) ||
+	              TryConstructMeshDataFromObjFile(
+	                  FilePath, Data, Size, ImportProfile, FLoadOptions(),
+	                  NativeMeshData, DependencyFilePaths);
+	if (!TestTrue(TEXT("native loader converts the asset"), bIsConverted)) {
+		return;
+	}
+
+	// import with assimp
+	GetMutableDefault<URuntimeAssetImportSettings>()->bEnableNativeLoaders =
+	    false;
+	ELoadMeshFromAssetFileResult Result;
+	const auto& AiMeshData =
+	    UAssetLoader::LoadMeshFromAssetFile(FilePath, Result, ImportProfile);
+	if (!TestTrue(TEXT("assimp imports the asset"),
+	              ELoadMeshFromAssetFileResult::Success == Result)) {
+		return;
+	}
+
+	TestMeshDataEqual(NativeMeshData, AiMeshData, Tolerance);
+}
+
+void FNativeLoadersSpec::TestMeshDataEqual(const FLoadedMeshData& Actual,
+                                           const FLoadedMeshData& Expected,
+                                           const float            Tolerance) {
+	// nodes
+	if (!TestEqual(TEXT("number of nodes"), Actual.NodeList.Num(),
+	               Expected.NodeList.Num())) {
+		return;
+	}
+	for (auto i = 0; i < Actual.NodeList.Num(); ++i) {
+		const auto& ActualNode   = Actual.NodeList[i];
+		const auto& ExpectedNode = Expected.NodeList[i];
+		TestEqual(FString::Printf(TEXT("name of node %d"), i), ActualNode.Name,
+		          ExpectedNode.Name);
+		TestEqual(FString::Printf(TEXT("parent of node %d"), i),
+		          ActualNode.ParentNodeIndex, ExpectedNode.ParentNodeIndex);
+		TestTrue(FString::Printf(TEXT("transform of node %d"), i),
+		         ActualNode.RelativeTransform.Equals(
+		             ExpectedNode.RelativeTransform, 0.0));
+		TestTrue(FString::Printf(TEXT("sections of node %d"), i),
+		         ActualNode.SectionIndices == ExpectedNode.SectionIndices);
+	}
+
+	// sections
+	if (!TestEqual(TEXT("number of sections"), Actual.SectionList.Num(),
+	               Expected.SectionList.Num())) {
+		return;
+	}
+	for (auto i = 0; i < Actual.SectionList.Num(); ++i) {
+		const auto& ActualSection   = Actual.SectionList[i];
+		const auto& ExpectedSection = Expected.SectionList[i];
+		const auto& Section         = FString::Printf(TEXT("section %d"), i);
+		TestEqual(Section + TEXT(" material"), ActualSection.MaterialIndex,
+		          ExpectedSection.MaterialIndex);
+		TestStreamEqual(Section + TEXT(" vertices"), ActualSection.Vertices,
+		                ExpectedSection.Vertices, Tolerance);
+		TestStreamEqual(Section + TEXT(" triangles"), ActualSection.Triangles,
+		                ExpectedSection.Triangles, Tolerance);
+		TestStreamEqual(Section + TEXT(" normals"), ActualSection.Normals,
+		                ExpectedSection.Normals, Tolerance);
+		TestStreamEqual(Section + TEXT(" UVs"), ActualSection.UV0Channel,
+		                ExpectedSection.UV0Channel, Tolerance);
+		TestStreamEqual(Section + TEXT(" colors"), ActualSection.VertexColors0,
+		                ExpectedSection.VertexColors0, Tolerance);
+		TestStreamEqual(Section + TEXT(" compact vertices"),
+		                ActualSection.CompactVertices,
+		                ExpectedSection.CompactVertices, Tolerance);
+		TestStreamEqual(Section + TEXT(" compact triangles"),
+		                ActualSection.CompactTriangles,
+		                ExpectedSection.CompactTriangles, Tolerance);
+		TestStreamEqual(Section + TEXT(" compact normals"),
+		                ActualSection.CompactNormals,
+		                ExpectedSection.CompactNormals, Tolerance);
+		TestStreamEqual(Section + TEXT(" compact UVs"),
+		                ActualSection.CompactUV0Channel,
+		                ExpectedSection.CompactUV0Channel, Tolerance);
+		TestStreamEqual(Section + TEXT(" compact colors"),
+		                ActualSection.CompactVertexColors0,
+		                ExpectedSection.CompactVertexColors0, Tolerance);
+		TestStreamEqual(Section + TEXT(" compact tangents"),
+		                ActualSection.CompactTangents,
+		                ExpectedSection.CompactTangents, Tolerance);
+
+		// tangents are compared by member, since they have padding
+		if (TestEqual(Section + TEXT(" number of tangents"),
+		              ActualSection.Tangents.Num(),
+		              ExpectedSection.Tangents.Num())) {
+			for (auto j = 0; j < ActualSection.Tangents.Num(); ++j) {
+				const auto& ActualTangent   = ActualSection.Tangents[j];
+				const auto& ExpectedTangent = ExpectedSection.Tangents[j];
+				TestTrue(Section + TEXT(" tangents"),
+				         ActualTangent.TangentX == ExpectedTangent.TangentX &&
+				             ActualTangent.bFlipTangentY ==
+				                 ExpectedTangent.bFlipTangentY);
+			}
+		}
+	}
+
+	// materials
+	if (!TestEqual(TEXT("number of materials"), Actual.MaterialList.Num(),
+	               Expected.MaterialList.Num())) {
+		return;
+	}
+	for (auto i = 0; i < Actual.MaterialList.Num(); ++i) {
+		const auto& ActualMaterial   = Actual.MaterialList[i];
+		const auto& ExpectedMaterial = Expected.MaterialList[i];
+		const auto& Material = FString::Printf(TEXT("material %d"), i);
+		TestTrue(Material + TEXT(" color status"),
+		         ActualMaterial.ColorStatus == ExpectedMaterial.ColorStatus);
+		TestTrue(Material + TEXT(" color"),
+		         ActualMaterial.Color.Equals(ExpectedMaterial.Color, Tolerance));
+		TestEqual(Material + TEXT(" texture"), ActualMaterial.TextureIndex,
+		          ExpectedMaterial.TextureIndex);
+	}
+
+	// textures, which are external files read the same way on both paths
+	if (!TestEqual(TEXT("number of textures"), Actual.TextureList.Num(),
+	               Expected.TextureList.Num())) {
+		return;
+	}
+	for (auto i = 0; i < Actual.TextureList.Num(); ++i) {
+		const auto& ActualTexture   = Actual.TextureList[i];
+		const auto& ExpectedTexture = Expected.TextureList[i];
+		const auto& Texture = FString::Printf(TEXT("texture %d"), i);
+		TestEqual(Texture + TEXT(" path"), ActualTexture.SourceFilePathInAsset,
+		          ExpectedTexture.SourceFilePathInAsset);
+		TestEqual(Texture + TEXT(" width"), ActualTexture.RawWidth,
+		          ExpectedTexture.RawWidth);
+		TestEqual(Texture + TEXT(" height"), ActualTexture.RawHeight,
+		          ExpectedTexture.RawHeight);
+	}
+}
+
+#pragma region definitions of static functions
+static TArray<uint8> MakeQuadGlb(const EQuadGlbEncoding Encoding) {
+	TArray<uint8>   Bin;
+	TArray<FString> Buffers;
+	TArray<FString> BufferViews;
+	TArray<FString> Accessors;
+	TArray<FString> Extensions;
+
+	// add a buffer view in the binary chunk, aligned to 4 bytes
+	const auto& AddBufferView = [&](const TArray<uint8>& Data,
+	                                const int32          ByteStride) {
+		const auto& ByteOffset = Bin.Num();
+		Bin.Append(Data);
+		Bin.SetNumZeroed(Align(Bin.Num(), 4));
+		BufferViews.Add(FString::Printf(
+		    TEXT("{\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d%s}"),
+		    ByteOffset, Data.Num(),
+		    0 == ByteStride
+		        ? TEXT("")
+		        : *FString::Printf(TEXT(",\"byteStride\":%d"), ByteStride)));
+		return BufferViews.Num() - 1;
+	};
+
+	// add an accessor of the 4 vertices or of the 6 indices
+	const auto& AddAccessor = [&](const int32 BufferView, const int32 Count,
+	                              const int32 ComponentType, const TCHAR* Type,
+	                              const TCHAR* Rest) {
+		Accessors.Add(FString::Printf(
+		    TEXT("{\"bufferView\":%d,\"componentType\":%d,\"count\":%d,"
+		         "\"type\":\"%s\"%s}"),
+		    BufferView, ComponentType, Count, Type, Rest));
+	};
+	const auto& PositionBounds =
+	    TEXT(",\"min\":[0,0,0],\"max\":[1,1,0]");
+
+	// attributes
+	TArray<uint8> Positions;
+	TArray<uint8> Normals;
+	TArray<uint8> TexCoords;
+	if (EQuadGlbEncoding::Quantized == Encoding) {
+		// unsigned shorts, normalized bytes and normalized unsigned bytes,
+		// each vertex padded to 4 bytes
+		for (auto i = 0; i < 4; ++i) {
+			for (const auto& Component : QuadPositions[i]) {
+				AppendValue(Positions, Component);
+			}
+			AppendValue(Positions, uint16{0});
+			for (const auto& Component : QuadNormal) {
+				AppendValue(Normals, Component);
+			}
+			AppendValue(Normals, int8{0});
+			for (const auto& Component : QuadTexCoords[i]) {
+				AppendValue(TexCoords, Component);
+			}
+			AppendValue(TexCoords, uint16{0});
+		}
+		AddAccessor(AddBufferView(Positions, 8), 4, 5123, TEXT("VEC3"),
+		            PositionBounds);
+		AddAccessor(AddBufferView(Normals, 4), 4, 5120, TEXT("VEC3"),
+		            TEXT(",\"normalized\":true"));
+		AddAccessor(AddBufferView(TexCoords, 4), 4, 5121, TEXT("VEC2"),
+		            TEXT(",\"normalized\":true"));
+		Extensions.Add(TEXT("KHR_mesh_quantization"));
+	} else {
+		// floats, with the values the quantized attributes are dequantized to
+		for (auto i = 0; i < 4; ++i) {
+			for (const auto& Component : QuadPositions[i]) {
+				AppendValue(Positions, static_cast<float>(Component));
+			}
+			for (const auto& Component : QuadNormal) {
+				AppendValue(Normals, Component / 127.0f);
+			}
+			for (const auto& Component : QuadTexCoords[i]) {
+				AppendValue(TexCoords, Component / 255.0f);
+			}
+		}
+
+		// positions compressed into the binary chunk, with an uncompressed
+		// fallback buffer that is not read
+		if (EQuadGlbEncoding::Meshopt == Encoding) {
+			const auto& Encoded =
+			    EncodeMeshoptVertices(Positions.GetData(), 4, 12);
+			const auto& ByteOffset = Bin.Num();
+			Bin.Append(Encoded);
+			Bin.SetNumZeroed(Align(Bin.Num(), 4));
+			BufferViews.Add(FString::Printf(
+			    TEXT("{\"buffer\":1,\"byteLength\":%d,\"byteStride\":12,"
+			         "\"extensions\":{\"EXT_meshopt_compression\":{"
+			         "\"buffer\":0,\"byteOffset\":%d,\"byteLength\":%d,"
+			         "\"byteStride\":12,\"count\":4,"
+			         "\"mode\":\"ATTRIBUTES\"}}}"),
+			    Positions.Num(), ByteOffset, Encoded.Num()));
+			Buffers.Add(FString::Printf(
+			    TEXT("{\"byteLength\":%d,\"extensions\":{"
+			         "\"EXT_meshopt_compression\":{\"fallback\":true}}}"),
+			    Positions.Num()));
+			AddAccessor(BufferViews.Num() - 1, 4, 5126, TEXT("VEC3"),
+			            PositionBounds);
+			Extensions.Add(TEXT("EXT_meshopt_compression"));
+		} else {
+			AddAccessor(AddBufferView(Positions, 12), 4, 5126, TEXT("VEC3"),
+			            PositionBounds);
+		}
+		AddAccessor(AddBufferView(Normals, 12), 4, 5126, TEXT("VEC3"),
+		            TEXT(""));
+		AddAccessor(AddBufferView(TexCoords, 8), 4, 5126, TEXT("VEC2"),
+		            TEXT(""));
+	}
+
+	// indices
+	TArray<uint8> Indices;
+	for (const auto& Index : QuadIndices) {
+		AppendValue(Indices, Index);
+	}
+	AddAccessor(AddBufferView(Indices, 0), 6, 5123, TEXT("SCALAR"), TEXT(""));
+
+	// the binary chunk is the first buffer
+	Buffers.Insert(FString::Printf(TEXT("{\"byteLength\":%d}"), Bin.Num()), 0);
+
+	// document
+	FString ExtensionList;
+	if (!Extensions.IsEmpty()) {
+		const auto& Names =
+		    TEXT("\"") + FString::Join(Extensions, TEXT("\",\"")) + TEXT("\"");
+		ExtensionList = FString::Printf(
+		    TEXT("\"extensionsUsed\":[%s],\"extensionsRequired\":[%s],"),
+		    *Names, *Names);
+	}
+	const auto& Json = FString::Printf(
+	    TEXT("{\"asset\":{\"version\":\"2.0\"},%s"
+	         "\"scene\":0,\"scenes\":[{\"nodes\":[0]}],"
+	         "\"nodes\":[{\"name\":\"Quad\",\"translation\":[1,2,3],"
+	         "\"mesh\":0}],"
+	         "\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0,"
+	         "\"NORMAL\":1,\"TEXCOORD_0\":2},\"indices\":3,\"material\":0}]}],"
+	         "\"materials\":[{\"pbrMetallicRoughness\":{"
+	         "\"baseColorFactor\":[0.5,0.25,1,1]}}],"
+	         "\"buffers\":[%s],\"bufferViews\":[%s],\"accessors\":[%s]}"),
+	    *ExtensionList, *FString::Join(Buffers, TEXT(",")),
+	    *FString::Join(BufferViews, TEXT(",")),
+	    *FString::Join(Accessors, TEXT(",")));
+
+	// JSON chunk padded with spaces, and binary chunk
+	const FTCHARToUTF8 JsonUtf8(*Json);
+	TArray<uint8>      JsonChunk(
+	    reinterpret_cast<const uint8*>(JsonUtf8.Get()), JsonUtf8.Length());
+	while (0 != JsonChunk.Num() % 4) {
+		JsonChunk.Add(' ');
+	}
+	TArray<uint8> Glb;
+	AppendValue(Glb, uint32{0x46546C67}); // "glTF"
+	AppendValue(Glb, uint32{2});
+	AppendValue(Glb, static_cast<uint32>(12 + 8 + JsonChunk.Num() + 8 +
+	                                     Bin.Num()));
+	AppendValue(Glb, static_cast<uint32>(JsonChunk.Num()));
+	AppendValue(Glb, uint32{0x4E4F534A}); // "JSON"
+	Glb.Append(JsonChunk);
+	AppendValue(Glb, static_cast<uint32>(Bin.Num()));
+	AppendValue(Glb, uint32{0x004E4942}); // "BIN\0"
+	Glb.Append(Bin);
+	return Glb;
+}
+
+static TArray<uint8> MakeQuadStl() {
+	// header (which must not start with "solid") and number of facets
+	TArray<uint8> Stl;
+	Stl.SetNumZeroed(80);
+	AppendValue(Stl, uint32{2});
+
+	// facets: normal, vertices and attribute byte count
+	for (auto Facet_i = 0; Facet_i < 2; ++Facet_i) {
+		for (const auto& Component : QuadNormal) {
+			AppendValue(Stl, Component / 127.0f);
+		}
+		for (auto i = 0; i < 3; ++i) {
+			const auto& Position = QuadPositions[QuadIndices[3 * Facet_i + i]];
+			for (const auto& Component : Position) {
+				AppendValue(Stl, static_cast<float>(Component));
+			}
+		}
+		AppendValue(Stl, uint16{0});
+	}
+	return Stl;
+}
+
+static TArray<uint8> MakeQuadPly() {
+	// header
+	const ANSICHAR* const Header =
+	    "ply\n"
+	    "format binary_little_endian 1.0\n"
+	    "element vertex 4\n"
+	    "property float x\n"
+	    "property float y\n"
+	    "property float z\n"
+	    "property float nx\n"
+	    "property float ny\n"
+	    "property float nz\n"
+	    "property uchar red\n"
+	    "property uchar green\n"
+	    "property uchar blue\n"
+	    "property uchar alpha\n"
+	    "element face 2\n"
+	    "property list uchar int vertex_indices\n"
+	    "end_header\n";
+	TArray<uint8> Ply(reinterpret_cast<const uint8*>(Header),
+	                  FCStringAnsi::Strlen(Header));
+
+	// vertices
+	for (auto i = 0; i < 4; ++i) {
+		for (const auto& Component : QuadPositions[i]) {
+			AppendValue(Ply, static_cast<float>(Component));
+		}
+		for (const auto& Component : QuadNormal) {
+			AppendValue(Ply, Component / 127.0f);
+		}
+		for (const auto& Component : QuadColors[i]) {
+			AppendValue(Ply, Component);
+		}
+	}
+
+	// faces
+	for (auto Face_i = 0; Face_i < 2; ++Face_i) {
+		AppendValue(Ply, uint8{3});
+		for (auto i = 0; i < 3; ++i) {
+			AppendValue(Ply, int32{QuadIndices[3 * Face_i + i]});
+		}
+	}
+	return Ply;
+}
+
+static TArray<uint8> MakeQuadObj() {
+	// the last face refers to the same elements as the one before it, by
+	// relative indices
+	const ANSICHAR* const Obj =
+	    "# quads and a triangle\n"
+	    "v 0 0 0\n"
+	    "v 1 0 0\n"
+	    "v 1 1 0\n"
+	    "v 0 1 0\n"
+	    "v 2 1 0\n"
+	    "v 0 2 0\n"
+	    "v 0.5 1.000000000000000001 -0.0e+1\n"
+	    "vt 0 0\n"
+	    "vt 1 0.2\n"
+	    "vt 1 1\n"
+	    "vt 0.2 1\n"
+	    "vn 0 0 1\n"
+	    "vn -0.333333333333333333 6.666666666666667E-1 +0.6666666666666667\n"
+	    "s off\n"
+	    "o Quad\n"
+	    "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+	    "f 1/1/1 3/3/1 4/4/1 # triangle\r\n"
+	    "g Concave\n"
+	    "f -7/-4/-1 -3/-3/-1 -2/-2/-1 -1/-1/-1\n";
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Obj),
+	                     FCStringAnsi::Strlen(Obj));
+}
+
+static TArray<uint8> MakePyramidObj() {
+	// 4 sides and a square base
+	const ANSICHAR* const Obj = "v -1 0 -1\n"
+	                            "v 1 0 -1\n"
+	                            "v 1 0 1\n"
+	                            "v -1 0 1\n"
+	                            "v 0 1 0\n"
+	                            "f 1 2 5\n"
+	                            "f 2 3 5\n"
+	                            "f 3 4 5\n"
+	                            "f 4 1 5\n"
+	                            "f 1 4 3 2\n";
+	return TArray<uint8>(reinterpret_cast<const uint8*>(Obj),
+	                     FCStringAnsi::Strlen(Obj));
+}
+
+static TArray<uint8> MakeMaterialsObj(const FString& MaterialLibraryName) {
+	// "Missing" is not in the library, and "Red" and "RedAgain" have the same
+	// properties
+	const auto& Obj = FString::Printf(TEXT("mtllib %s\n"
+	                                       "v 0 0 0\n"
+	                                       "v 1 0 0\n"
+	                                       "v 1 1 0\n"
+	                                       "v 0 1 0\n"
+	                                       "vt 0 0\n"
+	                                       "vt 1 0\n"
+	                                       "vt 1 1\n"
+	                                       "vt 0 1\n"
+	                                       "vn 0 0 1\n"
+	                                       "usemtl Red\n"
+	                                       "o First\n"
+	                                       "f 1/1/1 2/2/1 3/3/1\n"
+	                                       "usemtl Textured\n"
+	                                       "f 1/1/1 3/3/1 4/4/1\n"
+	                                       "usemtl Missing\n"
+	                                       "o Second\n"
+	                                       "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+	                                       "usemtl Red\n"
+	                                       "f 1/1/1 2/2/1 3/3/1\n"
+	                                       "usemtl RedAgain\n"
+	                                       "f 1/1/1 3/3/1 4/4/1\n"
+	                                       "o Third\n"
+	                                       "f 1/1/1 2/2/1 4/4/1\n"),
+	                                  *MaterialLibraryName);
+	const FTCHARToUTF8 ObjUtf8(*Obj);
+	return TArray<uint8>(reinterpret_cast<const uint8*>(ObjUtf8.Get()),
+	                     ObjUtf8.Length());
+}
+
+static FString MakeMaterialLibrary(const FString& TextureName) {
+	return FString::Printf(TEXT("# materials\n"
+	                            "newmtl Red\n"
+	                            "Ka 0 0 0\n"
+	                            "Kd 1 0 0\n"
+	                            "Ks 0.5 0.5 0.5\n"
+	                            "Ns 10\n"
+	                            "d 1\n"
+	                            "illum 2\n"
+	                            "\n"
+	                            "newmtl Textured\n"
+	                            "Kd 1 1 1\n"
+	                            "map_Kd %s\n"
+	                            "\n"
+	                            "newmtl RedAgain\n"
+	                            "Ka 0 0 0\n"
+	                            "Kd 1.0 0.0 0.0\n"
+	                            "Ks 0.5 0.5 0.5\n"
+	                            "Ns 10\n"
+	                            "Tr 0\n"
+	                            "illum 2\n"
+	                            "\n"
+	                            "newmtl Unused\n"
+	                            "Kd 0 0 1\n"),
+	                       *TextureName);
+}
+
+static TArray64<uint8> MakeTexturePng() {
+	// BGRA pixels
+	const uint8 Pixels[2 * 2 * 4] = {0,   0,   255, 255, 0,   255, 0,   255,
+	                                 255, 0,   0,   255, 255, 255, 255, 255};
+
+	auto&       ImageWrapperModule =
+	    FModuleManager::LoadModuleChecked<IImageWrapperModule>("ImageWrapper");
+	const auto& ImageWrapper =
+	    ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() ||
+	    !ImageWrapper->SetRaw(Pixels, sizeof(Pixels), 2, 2, ERGBFormat::BGRA,
+	                          8)) {
+		return TArray64<uint8>();
+	}
+	return ImageWrapper->GetCompressed();
+}
+
+static TArray<uint8> EncodeMeshoptVertices(const uint8* const Vertices,
+                                           const int32        Count,
+                                           const int32        ByteStride) {
+	// header (version 0)
+	TArray<uint8> Encoded = {0xA0};
+
+	// blocks of up to 8 KiB of whole groups of 16 vertices. Each byte of the
+	// vertices is stored as zigzag-encoded deltas from the previous vertex,
+	// starting from the first vertex.
+	const auto& BlockSize = FMath::Min(8192 / ByteStride & ~15, 256);
+	TArray<uint8> LastVertex(Vertices, ByteStride);
+	for (auto Begin = 0; Begin < Count; Begin += BlockSize) {
+		const auto& NumVertices = FMath::Min(BlockSize, Count - Begin);
+		const auto& NumGroups   = Align(NumVertices, 16) / 16;
+		for (auto Byte_i = 0; Byte_i < ByteStride; ++Byte_i) {
+			// modes of the groups (all raw bytes)
+			for (auto i = 0; i < (NumGroups + 3) / 4; ++i) {
+				Encoded.Add(0xFF);
+			}
+
+			// deltas, padded with zeros to whole groups
+			for (auto i = 0; i < NumGroups * 16; ++i) {
+				auto Delta = uint8{0};
+				if (i < NumVertices) {
+					const auto& Byte =
+					    Vertices[int64{Begin + i} * ByteStride + Byte_i];
+					const auto& Difference =
+					    static_cast<int8>(Byte - LastVertex[Byte_i]);
+					Delta =
+					    static_cast<uint8>(Difference << 1 ^ Difference >> 7);
+					LastVertex[Byte_i] = Byte;
+				}
+				Encoded.Add(Delta);
+			}
+		}
+	}
+
+	// first vertex at the end, padded to at least 32 bytes
+	Encoded.AddZeroed(FMath::Max(32 - ByteStride, 0));
+	Encoded.Append(Vertices, ByteStride);
+	return Encoded;
+}
+
+template <typename T>
+static void AppendValue(TArray<uint8>& Data, const T& Value) {
+	Data.Append(reinterpret_cast<const uint8*>(&Value), sizeof(T));
+}
+
+template <typename T>
+static bool IsNearlyEqual(const T& Actual, const T& Expected,
+                          const float Tolerance) {
+	return Actual.Equals(Expected, Tolerance);
+}
+
+static bool IsNearlyEqual(const int32 Actual, const int32 Expected,
+                          const float Tolerance) {
+	return Actual == Expected;
+}
+
+static bool IsNearlyEqual(const uint16 Actual, const uint16 Expected,
+                          const float Tolerance) {
+	return Actual == Expected;
+}
+
+static bool IsNearlyEqual(const uint32 Actual, const uint32 Expected,
+                          const float Tolerance) {
+	// a step of the 16-bit snorms on either side
+	return DecodeOctahedral(Actual).Equals(DecodeOctahedral(Expected),
+	                                       Tolerance + 2.0f / 32767.0f);
+}
+
+static bool IsNearlyEqual(const FVector2DHalf& Actual,
+                          const FVector2DHalf& Expected,
+                          const float          Tolerance) {
+	// a step of half precision in [0, 1]
+	return FVector2f(Actual).Equals(FVector2f(Expected), Tolerance + 1.0e-3f);
+}
+
+static bool IsNearlyEqual(const FColor& Actual, const FColor& Expected,
+                          const float Tolerance) {
+	return FMath::Abs(Actual.R - Expected.R) <= 1 &&
+	       FMath::Abs(Actual.G - Expected.G) <= 1 &&
+	       FMath::Abs(Actual.B - Expected.B) <= 1 &&
+	       FMath::Abs(Actual.A - Expected.A) <= 1;
+}
+#pragma endregion
+
+#endif
@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "TextureBlockCompression.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#pragma region forward declarations of static functions
+/**
+ * Make a block of a linear gradient in every component, alpha included.
+ * @param[out]   Pixels   16 pixels in BGRA order
+ */
+static void MakeGradientBlock(uint8 (&Pixels)[16 * 4]);
+
+/**
+ * Decode a BC7 block in mode 6.
+ * @param        Block    16-byte BC7 block
+ * @param[out]   Pixels   16 pixels in BGRA order
+ * @return  whether the block is in mode 6
+ */
+static bool DecodeBC7Mode6Block(const uint8* Block, uint8 (&Pixels)[16 * 4]);
+#pragma endregion
+
+BEGIN_DEFINE_SPEC(FTextureBlockCompressionSpec,
+                  "RuntimeAssetImport.TextureBlockCompression",
+                  EAutomationTestFlags::ApplicationContextMask |
+                      EAutomationTestFlags::ProductFilter)
+END_DEFINE_SPEC(FTextureBlockCompressionSpec)
+
+void FTextureBlockCompressionSpec::Define() {
+	for (const auto bHighQuality : {false, true}) {
+		const auto& Quality = bHighQuality ? TEXT("in high quality")
+		                                   : TEXT("fast");
+		Describe(Quality, [this, bHighQuality] {
+			It("encodes a BC7 block that decodes close to the pixels",
+			   [this, bHighQuality] {
+				   uint8 Pixels[16 * 4];
+				   MakeGradientBlock(Pixels);
+
+				   uint8 Block[16];
+				   EncodeBC7Block(Pixels, bHighQuality, Block);
+
+				   uint8 DecodedPixels[16 * 4];
+				   if (!TestTrue(TEXT("block is in mode 6"),
+				                 DecodeBC7Mode6Block(Block, DecodedPixels))) {
+					   return;
+				   }
+
+				   // A linear gradient is on the line between the endpoints,
+				   // so only quantization error remains. The fast mode insets
+				   // the endpoints by 1/16 of the range (240 in red).
+				   const auto& Tolerance = bHighQuality ? 4 : 16;
+				   auto        MaxError  = 0;
+				   for (auto i = 0; i < 16 * 4; ++i) {
+					   MaxError = FMath::Max(
+					       MaxError, FMath::Abs(DecodedPixels[i] - Pixels[i]));
+				   }
+				   TestTrue(FString::Printf(TEXT("error %d is small"), MaxError),
+				            MaxError <= Tolerance);
+			   });
+		});
+	}
+}
+
+#pragma region definitions of static functions
+static void MakeGradientBlock(uint8 (&Pixels)[16 * 4]) {
+	for (auto i = 0; i < 16; ++i) {
+		Pixels[4 * i + 0] = static_cast<uint8>(20 + 10 * i);
+		Pixels[4 * i + 1] = static_cast<uint8>(40 + 8 * i);
+		Pixels[4 * i + 2] = static_cast<uint8>(16 * i);
+		Pixels[4 * i + 3] = static_cast<uint8>(195 + 4 * i);
+	}
+}
+
+static bool DecodeBC7Mode6Block(const uint8* const Block,
+                                uint8 (&Pixels)[16 * 4]) {
+	static constexpr int32 Weights[16] = {0,  4,  9,  13, 17, 21, 26, 30,
+	                                      34, 38, 43, 47, 51, 55, 60, 64};
+
+	// read bits from the lowest bit of the first byte
+	auto       Offset   = 0;
+	const auto ReadBits = [Block, &Offset](const int32 NumBits) {
+		auto Value = 0;
+		for (auto i = 0; i < NumBits; ++i, ++Offset) {
+			Value |= ((Block[Offset / 8] >> (Offset % 8)) & 1) << i;
+		}
+		return Value;
+	};
+
+	if (1 << 6 != ReadBits(7)) {
+		return false;
+	}
+
+	// endpoints in RGBA order, with the p-bit as their lowest bit
+	int32 Endpoints[2][4];
+	for (auto Component = 0; Component < 4; ++Component) {
+		Endpoints[0][Component] = ReadBits(7) << 1;
+		Endpoints[1][Component] = ReadBits(7) << 1;
+	}
+	const auto& PBit0 = ReadBits(1);
+	const auto& PBit1 = ReadBits(1);
+	for (auto Component = 0; Component < 4; ++Component) {
+		Endpoints[0][Component] |= PBit0;
+		Endpoints[1][Component] |= PBit1;
+	}
+
+	// interpolate, writing in BGRA order
+	static constexpr int32 BGRAComponents[4] = {2, 1, 0, 3};
+	for (auto i = 0; i < 16; ++i) {
+		const auto& Weight = Weights[ReadBits(0 == i ? 3 : 4)];
+		for (auto Component = 0; Component < 4; ++Component) {
+			const auto& Value = ((64 - Weight) * Endpoints[0][Component] +
+			                     Weight * Endpoints[1][Component] + 32) >>
+			                    6;
+			Pixels[4 * i + BGRAComponents[Component]] =
+			    static_cast<uint8>(Value);
+		}
+	}
+
+	return true;
+}
+#pragma endregion
+
+#endif
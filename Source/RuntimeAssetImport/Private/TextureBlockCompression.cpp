@@ -0,0 +1,721 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TextureBlockCompression.h"
+
+#include "Math/VectorRegister.h"
+
+// number of pixels in a block
+static constexpr int32 NumBlockPixels = 16;
+
+// pixels of a block as floats in BGRA order, in [0, 255]
+using FBlockPixels = VectorRegister4Float[NumBlockPixels];
+
+// weights of the second endpoint of each index of BC1 (in the 4-color mode)
+static constexpr float BC1Weights[4] = {0.0f, 1.0f, 1.0f / 3, 2.0f / 3};
+
+// weights of the second endpoint of each 4-bit index of BC7
+static constexpr float BC7Weights[16] = {
+    0 / 64.0f,  4 / 64.0f,  9 / 64.0f,  13 / 64.0f, 17 / 64.0f, 21 / 64.0f,
+    26 / 64.0f, 30 / 64.0f, 34 / 64.0f, 38 / 64.0f, 43 / 64.0f, 47 / 64.0f,
+    51 / 64.0f, 55 / 64.0f, 60 / 64.0f, 64 / 64.0f};
+
+// weights of the second endpoint of each 2-bit and 3-bit weight of ASTC, as
+// unquantized by the decoder
+static constexpr float ASTC2BitWeights[4] = {0 / 64.0f, 21 / 64.0f, 43 / 64.0f,
+                                             64 / 64.0f};
+static constexpr float ASTC3BitWeights[8] = {0 / 64.0f,  9 / 64.0f,  18 / 64.0f,
+                                             27 / 64.0f, 37 / 64.0f, 46 / 64.0f,
+                                             55 / 64.0f, 64 / 64.0f};
+
+/**
+ * Writer of bits into a block, from the lowest bit of its first byte.
+ */
+struct FBlockBitWriter {
+	// block to write to, which must be zeroed
+	uint8* Block;
+
+	// number of bits written so far
+	int32 Offset = 0;
+
+	/**
+	 * Write the lowest bits of a value, from its lowest bit.
+	 * @param   Value     value to write
+	 * @param   NumBits   number of bits to write
+	 */
+	void Write(const uint32 Value, const int32 NumBits) {
+		for (auto i = 0; i < NumBits; ++i, ++Offset) {
+			Block[Offset / 8] |= static_cast<uint8>(((Value >> i) & 1)
+			                                        << (Offset % 8));
+		}
+	}
+};
+
+#pragma region forward declarations of static functions
+/**
+ * Load the pixels of a block as floats.
+ * @param        Pixels         16 pixels as bytes in BGRA order
+ * @param[out]   PixelVectors   pixels of the block
+ */
+static void LoadBlockPixels(const uint8* Pixels, FBlockPixels& PixelVectors);
+
+/**
+ * Fit two endpoints to the pixels of a block, either to the bounding box of
+ * the block or along its principal axis.
+ * @param        Pixels         pixels of the block
+ * @param        bHighQuality   see EncodeBC1Block
+ * @param        bWithAlpha     whether alpha is fitted with the color, rather
+ *                              than left to another part of the block
+ * @param[out]   Max            endpoint at the larger end
+ * @param[out]   Min            endpoint at the smaller end
+ */
+static void FitEndpoints(const FBlockPixels& Pixels, bool bHighQuality,
+                         bool bWithAlpha, VectorRegister4Float& Max,
+                         VectorRegister4Float& Min);
+
+/**
+ * Choose for each pixel the nearest of the colors interpolated between two
+ * endpoints.
+ * @param        Pixels       pixels of the block
+ * @param        Endpoint0    first endpoint as decoded
+ * @param        Endpoint1    second endpoint as decoded
+ * @param        Weights      weight of Endpoint1 of each index
+ * @param        NumIndices   number of indices
+ * @param        bWithAlpha   whether the error of alpha counts
+ * @param[out]   Indices      index of each pixel
+ * @return  sum of the squared errors
+ */
+static float FindNearestIndices(const FBlockPixels&         Pixels,
+                                const VectorRegister4Float& Endpoint0,
+                                const VectorRegister4Float& Endpoint1,
+                                const float* Weights, int32 NumIndices,
+                                bool bWithAlpha,
+                                uint8 (&Indices)[NumBlockPixels]);
+
+/**
+ * Encode the color part of a block into a BC1 color block (always in the
+ * 4-color mode).
+ * @param   Pixels         pixels of the block
+ * @param   bHighQuality   see EncodeBC1Block
+ * @param   Block          destination of the 8-byte color block
+ */
+static void EncodeColorBlock(const FBlockPixels& Pixels, bool bHighQuality,
+                             uint8* Block);
+
+/**
+ * Encode the alpha of a block into a BC3 alpha block (in the 8-alpha mode).
+ * @param   Pixels   16 pixels as bytes in BGRA order
+ * @param   Block    destination of the 8-byte alpha block
+ */
+static void EncodeAlphaBlock(const uint8* Pixels, uint8* Block);
+
+/**
+ * Choose the nearest palette entry for each pixel.
+ * @param        Pixels    pixels of the block
+ * @param        Color0    first endpoint in RGB565
+ * @param        Color1    second endpoint in RGB565
+ * @param[out]   Indices   2-bit index of each pixel, the first pixel in the
+ *                         lowest bits
+ * @return  sum of the squared errors
+ */
+static float FindColorIndices(const FBlockPixels& Pixels, uint16 Color0,
+                              uint16 Color1, uint32& Indices);
+
+/**
+ * Refine endpoints by least squares for the given indices.
+ * @param           Pixels       pixels of the block
+ * @param           Indices      index of each pixel
+ * @param           Weights      weight of Endpoint1 of each index
+ * @param[in,out]   Endpoint0    first endpoint
+ * @param[in,out]   Endpoint1    second endpoint
+ */
+static void RefineEndpoints(const FBlockPixels& Pixels,
+                            const uint8 (&Indices)[NumBlockPixels],
+                            const float*          Weights,
+                            VectorRegister4Float& Endpoint0,
+                            VectorRegister4Float& Endpoint1);
+
+/**
+ * Quantize an endpoint of BC7 mode 6 to 7 bits per component and a p-bit
+ * (the lowest bit shared by all components).
+ * @param        Color       color in BGRA order, in [0, 255]
+ * @param[out]   Quantized   7-bit components in BGRA order
+ * @param[out]   PBit        p-bit
+ */
+static void QuantizeBC7Endpoint(const VectorRegister4Float& Color,
+                                uint8 (&Quantized)[4], uint8& PBit);
+
+/**
+ * Expand an endpoint of BC7 mode 6 to floats in BGRA order, in [0, 255].
+ * @param   Quantized   7-bit components in BGRA order
+ * @param   PBit        p-bit
+ */
+static VectorRegister4Float ExpandBC7Endpoint(const uint8 (&Quantized)[4],
+                                              uint8 PBit);
+
+/**
+ * Quantize a color to 8 bits per component.
+ * @param        Color       color in BGRA order, in [0, 255]
+ * @param[out]   Quantized   components in BGRA order
+ */
+static void QuantizeTo8888(const VectorRegister4Float& Color,
+                           uint8 (&Quantized)[4]);
+
+/**
+ * Quantize a color in BGRA order to RGB565.
+ * @param   Color   color in [0, 255]
+ */
+static uint16 QuantizeTo565(const VectorRegister4Float& Color);
+
+/**
+ * Expand an RGB565 color to floats in BGRA order, in [0, 255].
+ * @param   Color   color in RGB565
+ */
+static VectorRegister4Float ExpandFrom565(uint16 Color);
+
+/**
+ * Write a little-endian integer.
+ * @param   Value   value to write
+ * @param   Dst     destination of sizeof(T) bytes
+ */
+template <typename T>
+static void WriteLittleEndian(T Value, uint8* Dst);
+#pragma endregion
+
+void EncodeBC1Block(const uint8* const Pixels, const bool bHighQuality,
+                    uint8* const Block) {
+	// load pixels as floats
+	FBlockPixels PixelVectors;
+	LoadBlockPixels(Pixels, PixelVectors);
+
+	EncodeColorBlock(PixelVectors, bHighQuality, Block);
+}
+
+void EncodeBC3Block(const uint8* const Pixels, const bool bHighQuality,
+                    uint8* const Block) {
+	// load pixels as floats
+	FBlockPixels PixelVectors;
+	LoadBlockPixels(Pixels, PixelVectors);
+
+	// alpha block followed by color block
+	EncodeAlphaBlock(Pixels, Block);
+	EncodeColorBlock(PixelVectors, bHighQuality, Block + 8);
+}
+
+void EncodeBC7Block(const uint8* const Pixels, const bool bHighQuality,
+                    uint8* const Block) {
+	// load pixels as floats
+	FBlockPixels PixelVectors;
+	LoadBlockPixels(Pixels, PixelVectors);
+
+	// fit and quantize endpoints
+	VectorRegister4Float Max;
+	VectorRegister4Float Min;
+	FitEndpoints(PixelVectors, bHighQuality, /* bWithAlpha = */ true, Max, Min);
+	uint8 Endpoints[2][4];
+	uint8 PBits[2];
+	QuantizeBC7Endpoint(Max, Endpoints[0], PBits[0]);
+	QuantizeBC7Endpoint(Min, Endpoints[1], PBits[1]);
+
+	// choose indices
+	uint8       Indices[NumBlockPixels];
+	const auto& Error = FindNearestIndices(
+	    PixelVectors, ExpandBC7Endpoint(Endpoints[0], PBits[0]),
+	    ExpandBC7Endpoint(Endpoints[1], PBits[1]), BC7Weights, 16,
+	    /* bWithAlpha = */ true, Indices);
+
+	// refine endpoints for the chosen indices, and keep them if better
+	if (bHighQuality) {
+		auto RefinedMax = ExpandBC7Endpoint(Endpoints[0], PBits[0]);
+		auto RefinedMin = ExpandBC7Endpoint(Endpoints[1], PBits[1]);
+		RefineEndpoints(PixelVectors, Indices, BC7Weights, RefinedMax,
+		                RefinedMin);
+
+		uint8 RefinedEndpoints[2][4];
+		uint8 RefinedPBits[2];
+		QuantizeBC7Endpoint(RefinedMax, RefinedEndpoints[0], RefinedPBits[0]);
+		QuantizeBC7Endpoint(RefinedMin, RefinedEndpoints[1], RefinedPBits[1]);
+
+		uint8       RefinedIndices[NumBlockPixels];
+		const auto& RefinedError = FindNearestIndices(
+		    PixelVectors,
+		    ExpandBC7Endpoint(RefinedEndpoints[0], RefinedPBits[0]),
+		    ExpandBC7Endpoint(RefinedEndpoints[1], RefinedPBits[1]),
+		    BC7Weights, 16, /* bWithAlpha = */ true, RefinedIndices);
+		if (RefinedError < Error) {
+			FMemory::Memcpy(Endpoints, RefinedEndpoints, sizeof(Endpoints));
+			FMemory::Memcpy(PBits, RefinedPBits, sizeof(PBits));
+			FMemory::Memcpy(Indices, RefinedIndices, sizeof(Indices));
+		}
+	}
+
+	// the highest bit of the index of the first pixel is implicitly 0, so
+	// swap the endpoints if it is set
+	if (Indices[0] >= 8) {
+		Swap(Endpoints[0], Endpoints[1]);
+		Swap(PBits[0], PBits[1]);
+		for (auto& Index : Indices) {
+			Index = 15 - Index;
+		}
+	}
+
+	// write mode 6, the endpoints in RGBA order, the p-bits and the indices
+	FMemory::Memzero(Block, 16);
+	FBlockBitWriter Writer{Block};
+	Writer.Write(1 << 6, 7);
+	for (const auto& Component : {2, 1, 0, 3}) {
+		Writer.Write(Endpoints[0][Component], 7);
+		Writer.Write(Endpoints[1][Component], 7);
+	}
+	Writer.Write(PBits[0], 1);
+	Writer.Write(PBits[1], 1);
+	Writer.Write(Indices[0], 3);
+	for (auto i = 1; i < NumBlockPixels; ++i) {
+		Writer.Write(Indices[i], 4);
+	}
+}
+
+void EncodeASTC4x4Block(const uint8* const Pixels, const bool bHighQuality,
+                        uint8* const Block) {
+	// load pixels as floats
+	FBlockPixels PixelVectors;
+	LoadBlockPixels(Pixels, PixelVectors);
+
+	// An opaque block stores RGB endpoints with 3-bit weights, and the others
+	// RGBA endpoints with 2-bit weights, so that the endpoints fit in 8 bits
+	// per component without trits or quints.
+	auto bIsOpaque = true;
+	for (auto i = 0; i < NumBlockPixels && bIsOpaque; ++i) {
+		bIsOpaque = 0xFF == Pixels[4 * i + 3];
+	}
+	const auto& WeightBits = bIsOpaque ? 3 : 2;
+	const auto& NumWeights = 1 << WeightBits;
+	const auto& Weights    = bIsOpaque ? ASTC3BitWeights : ASTC2BitWeights;
+	const auto& bWithAlpha = !bIsOpaque;
+
+	// fit and quantize endpoints
+	VectorRegister4Float Max;
+	VectorRegister4Float Min;
+	FitEndpoints(PixelVectors, bHighQuality, bWithAlpha, Max, Min);
+	uint8 Endpoints[2][4];
+	QuantizeTo8888(Max, Endpoints[0]);
+	QuantizeTo8888(Min, Endpoints[1]);
+
+	// choose weights
+	uint8       Indices[NumBlockPixels];
+	const auto& Error = FindNearestIndices(
+	    PixelVectors, VectorLoadByte4(Endpoints[0]),
+	    VectorLoadByte4(Endpoints[1]), Weights, NumWeights, bWithAlpha, Indices);
+
+	// refine endpoints for the chosen weights, and keep them if better
+	if (bHighQuality) {
+		auto RefinedMax = VectorLoadByte4(Endpoints[0]);
+		auto RefinedMin = VectorLoadByte4(Endpoints[1]);
+		RefineEndpoints(PixelVectors, Indices, Weights, RefinedMax, RefinedMin);
+
+		uint8 RefinedEndpoints[2][4];
+		QuantizeTo8888(RefinedMax, RefinedEndpoints[0]);
+		QuantizeTo8888(RefinedMin, RefinedEndpoints[1]);
+
+		uint8       RefinedIndices[NumBlockPixels];
+		const auto& RefinedError = FindNearestIndices(
+		    PixelVectors, VectorLoadByte4(RefinedEndpoints[0]),
+		    VectorLoadByte4(RefinedEndpoints[1]), Weights, NumWeights,
+		    bWithAlpha, RefinedIndices);
+		if (RefinedError < Error) {
+			FMemory::Memcpy(Endpoints, RefinedEndpoints, sizeof(Endpoints));
+			FMemory::Memcpy(Indices, RefinedIndices, sizeof(Indices));
+		}
+	}
+
+	// the decoder applies blue contraction if the first endpoint is brighter
+	// than the second, so put the darker one first
+	const auto& Sum0 = Endpoints[0][0] + Endpoints[0][1] + Endpoints[0][2];
+	const auto& Sum1 = Endpoints[1][0] + Endpoints[1][1] + Endpoints[1][2];
+	if (Sum1 < Sum0) {
+		Swap(Endpoints[0], Endpoints[1]);
+		for (auto& Index : Indices) {
+			Index = static_cast<uint8>(NumWeights - 1 - Index);
+		}
+	}
+
+	// Write the block mode (a 4x4 weight grid of 8 or 4 levels), a single
+	// partition, the color endpoint mode (LDR RGB or RGBA direct) and the
+	// endpoints in RGBA order.
+	FMemory::Memzero(Block, 16);
+	FBlockBitWriter Writer{Block};
+	Writer.Write(bIsOpaque ? 0x053 : 0x042, 11);
+	Writer.Write(0, 2);
+	Writer.Write(bIsOpaque ? 8 : 12, 4);
+	for (const auto& Component : {2, 1, 0, 3}) {
+		if (3 == Component && bIsOpaque) {
+			break;
+		}
+		Writer.Write(Endpoints[0][Component], 8);
+		Writer.Write(Endpoints[1][Component], 8);
+	}
+
+	// write the weights from the highest bit of the block downward
+	for (auto i = 0; i < NumBlockPixels; ++i) {
+		for (auto Bit_i = 0; Bit_i < WeightBits; ++Bit_i) {
+			const auto& Offset = 127 - (WeightBits * i + Bit_i);
+			Block[Offset / 8] |=
+			    static_cast<uint8>(((Indices[i] >> Bit_i) & 1) << (Offset % 8));
+		}
+	}
+}
+
+#pragma region definitions of static functions
+static void LoadBlockPixels(const uint8* const Pixels,
+                            FBlockPixels&      PixelVectors) {
+	for (auto i = 0; i < NumBlockPixels; ++i) {
+		PixelVectors[i] = VectorLoadByte4(Pixels + 4 * i);
+	}
+}
+
+static void FitEndpoints(const FBlockPixels& Pixels, const bool bHighQuality,
+                         const bool bWithAlpha, VectorRegister4Float& Max,
+                         VectorRegister4Float& Min) {
+	// dot product of the components that are fitted
+	const auto& Dot = [bWithAlpha](const VectorRegister4Float& A,
+	                               const VectorRegister4Float& B) {
+		return bWithAlpha ? VectorDot4(A, B) : VectorDot3(A, B);
+	};
+
+	// bounding box of the block
+	Min = Pixels[0];
+	Max = Pixels[0];
+	for (auto i = 1; i < NumBlockPixels; ++i) {
+		Min = VectorMin(Min, Pixels[i]);
+		Max = VectorMax(Max, Pixels[i]);
+	}
+
+	if (!bHighQuality) {
+		// inset the bounding box by 1/16, since the extremes are rarely hit
+		// exactly by the interpolated colors
+		const auto& Inset =
+		    VectorMultiply(VectorSubtract(Max, Min), VectorSetFloat1(1.0f / 16));
+		Max = VectorSubtract(Max, Inset);
+		Min = VectorAdd(Min, Inset);
+		return;
+	}
+
+	// mean of the block
+	auto Mean = VectorZeroFloat();
+	for (const auto& Pixel : Pixels) {
+		Mean = VectorAdd(Mean, Pixel);
+	}
+	Mean = VectorMultiply(Mean, VectorSetFloat1(1.0f / NumBlockPixels));
+
+	// find the principal axis by power iteration on the covariance, starting
+	// from the diagonal of the bounding box
+	auto Axis = VectorSubtract(Max, Min);
+	for (auto Iteration = 0; Iteration < 4; ++Iteration) {
+		auto NextAxis = VectorZeroFloat();
+		for (const auto& Pixel : Pixels) {
+			const auto& Offset = VectorSubtract(Pixel, Mean);
+			NextAxis = VectorMultiplyAdd(Offset, Dot(Offset, Axis), NextAxis);
+		}
+		Axis = NextAxis;
+	}
+
+	// project the pixels onto the axis, and take the extremes as endpoints
+	const auto& LengthSquared = VectorGetComponent(Dot(Axis, Axis), 0);
+	if (LengthSquared > UE_SMALL_NUMBER) {
+		Axis =
+		    VectorMultiply(Axis, VectorSetFloat1(FMath::InvSqrt(LengthSquared)));
+
+		auto MinT = 0.0f;
+		auto MaxT = 0.0f;
+		for (const auto& Pixel : Pixels) {
+			const auto& T =
+			    VectorGetComponent(Dot(VectorSubtract(Pixel, Mean), Axis), 0);
+			MinT = FMath::Min(MinT, T);
+			MaxT = FMath::Max(MaxT, T);
+		}
+		Max = VectorMultiplyAdd(Axis, VectorSetFloat1(MaxT), Mean);
+		Min = VectorMultiplyAdd(Axis, VectorSetFloat1(MinT), Mean);
+	}
+}
+
+static float FindNearestIndices(const FBlockPixels&         Pixels,
+                                const VectorRegister4Float& Endpoint0,
+                                const VectorRegister4Float& Endpoint1,
+                                const float* const Weights,
+                                const int32 NumIndices, const bool bWithAlpha,
+                                uint8 (&Indices)[NumBlockPixels]) {
+	// palette of interpolated colors
+	VectorRegister4Float Palette[16];
+	check(NumIndices <= 16);
+	const auto& Difference = VectorSubtract(Endpoint1, Endpoint0);
+	for (auto Index = 0; Index < NumIndices; ++Index) {
+		Palette[Index] = VectorMultiplyAdd(
+		    Difference, VectorSetFloat1(Weights[Index]), Endpoint0);
+	}
+
+	// choose the nearest palette entry for each pixel
+	auto TotalError = 0.0f;
+	for (auto i = 0; i < NumBlockPixels; ++i) {
+		auto BestIndex = 0;
+		auto BestError = TNumericLimits<float>::Max();
+		for (auto Index = 0; Index < NumIndices; ++Index) {
+			const auto& Offset = VectorSubtract(Pixels[i], Palette[Index]);
+			const auto& Error  = VectorGetComponent(
+			    bWithAlpha ? VectorDot4(Offset, Offset)
+			               : VectorDot3(Offset, Offset),
+			    0);
+			if (Error < BestError) {
+				BestIndex = Index;
+				BestError = Error;
+			}
+		}
+		Indices[i] = static_cast<uint8>(BestIndex);
+		TotalError += BestError;
+	}
+
+	return TotalError;
+}
+
+static void EncodeColorBlock(const FBlockPixels& Pixels,
+                             const bool bHighQuality, uint8* const Block) {
+	// fit endpoints
+	VectorRegister4Float Max;
+	VectorRegister4Float Min;
+	FitEndpoints(Pixels, bHighQuality, /* bWithAlpha = */ false, Max, Min);
+
+	// quantize endpoints. The first endpoint must be larger for the 4-color
+	// mode.
+	auto Color0 = QuantizeTo565(Max);
+	auto Color1 = QuantizeTo565(Min);
+	if (Color0 < Color1) {
+		Swap(Color0, Color1);
+	}
+
+	// choose indices
+	auto Indices = uint32{0};
+	auto Error   = Color0 == Color1
+	                   ? 0.0f
+	                   : FindColorIndices(Pixels, Color0, Color1, Indices);
+
+	// refine endpoints for the chosen indices, and keep them if better
+	if (bHighQuality && Color0 != Color1) {
+		uint8 PixelIndices[NumBlockPixels];
+		for (auto i = 0; i < NumBlockPixels; ++i) {
+			PixelIndices[i] = static_cast<uint8>((Indices >> (2 * i)) & 3);
+		}
+		auto RefinedMax = ExpandFrom565(Color0);
+		auto RefinedMin = ExpandFrom565(Color1);
+		RefineEndpoints(Pixels, PixelIndices, BC1Weights, RefinedMax,
+		                RefinedMin);
+
+		auto RefinedColor0 = QuantizeTo565(RefinedMax);
+		auto RefinedColor1 = QuantizeTo565(RefinedMin);
+		if (RefinedColor0 < RefinedColor1) {
+			Swap(RefinedColor0, RefinedColor1);
+		}
+
+		if (RefinedColor0 != RefinedColor1) {
+			auto        RefinedIndices = uint32{0};
+			const auto& RefinedError   = FindColorIndices(
+			    Pixels, RefinedColor0, RefinedColor1, RefinedIndices);
+			if (RefinedError < Error) {
+				Color0  = RefinedColor0;
+				Color1  = RefinedColor1;
+				Indices = RefinedIndices;
+			}
+		}
+	}
+
+	// write block
+	WriteLittleEndian(Color0, Block);
+	WriteLittleEndian(Color1, Block + 2);
+	WriteLittleEndian(Indices, Block + 4);
+}
+
+static void EncodeAlphaBlock(const uint8* const Pixels, uint8* const Block) {
+	// range of alpha
+	auto MinAlpha = Pixels[3];
+	auto MaxAlpha = Pixels[3];
+	for (auto i = 1; i < NumBlockPixels; ++i) {
+		MinAlpha = FMath::Min(MinAlpha, Pixels[4 * i + 3]);
+		MaxAlpha = FMath::Max(MaxAlpha, Pixels[4 * i + 3]);
+	}
+
+	// endpoints (the first must be larger for the 8-alpha mode)
+	Block[0] = MaxAlpha;
+	Block[1] = MinAlpha;
+
+	// palette of the 8-alpha mode
+	int32 Palette[8] = {MaxAlpha, MinAlpha};
+	for (auto i = 1; i < 7; ++i) {
+		Palette[i + 1] = ((7 - i) * MaxAlpha + i * MinAlpha) / 7;
+	}
+
+	// choose the nearest palette entry for each pixel (3 bits each)
+	auto Indices = uint64{0};
+	if (MaxAlpha != MinAlpha) {
+		for (auto i = 0; i < NumBlockPixels; ++i) {
+			const auto& Alpha = static_cast<int32>(Pixels[4 * i + 3]);
+
+			auto BestIndex = 0;
+			auto BestError = TNumericLimits<int32>::Max();
+			for (auto Index = 0; Index < 8; ++Index) {
+				const auto& Error = FMath::Abs(Palette[Index] - Alpha);
+				if (Error < BestError) {
+					BestIndex = Index;
+					BestError = Error;
+				}
+			}
+			Indices |= static_cast<uint64>(BestIndex) << (3 * i);
+		}
+	}
+
+	// write 48 bits of indices
+	for (auto i = 0; i < 6; ++i) {
+		Block[2 + i] = static_cast<uint8>(Indices >> (8 * i));
+	}
+}
+
+static float FindColorIndices(const FBlockPixels& Pixels,
+                              const uint16 Color0, const uint16 Color1,
+                              uint32& Indices) {
+	// choose the nearest palette entry of the 4-color mode for each pixel
+	uint8       PixelIndices[NumBlockPixels];
+	const auto& TotalError = FindNearestIndices(
+	    Pixels, ExpandFrom565(Color0), ExpandFrom565(Color1), BC1Weights, 4,
+	    /* bWithAlpha = */ false, PixelIndices);
+
+	// pack 2 bits each
+	Indices = 0;
+	for (auto i = 0; i < NumBlockPixels; ++i) {
+		Indices |= static_cast<uint32>(PixelIndices[i]) << (2 * i);
+	}
+
+	return TotalError;
+}
+
+static void RefineEndpoints(const FBlockPixels& Pixels,
+                            const uint8 (&Indices)[NumBlockPixels],
+                            const float* const    Weights,
+                            VectorRegister4Float& Endpoint0,
+                            VectorRegister4Float& Endpoint1) {
+	// accumulate the normal equations of
+	// Pixel = Alpha * Endpoint0 + Beta * Endpoint1
+	auto AlphaAlpha = 0.0f;
+	auto BetaBeta   = 0.0f;
+	auto AlphaBeta  = 0.0f;
+	auto AlphaX     = VectorZeroFloat();
+	auto BetaX      = VectorZeroFloat();
+	for (auto i = 0; i < NumBlockPixels; ++i) {
+		const auto& Beta  = Weights[Indices[i]];
+		const auto& Alpha = 1.0f - Beta;
+
+		AlphaAlpha += Alpha * Alpha;
+		BetaBeta += Beta * Beta;
+		AlphaBeta += Alpha * Beta;
+		AlphaX = VectorMultiplyAdd(Pixels[i], VectorSetFloat1(Alpha), AlphaX);
+		BetaX  = VectorMultiplyAdd(Pixels[i], VectorSetFloat1(Beta), BetaX);
+	}
+
+	// singular if all pixels have the same weight
+	const auto& Determinant = AlphaAlpha * BetaBeta - AlphaBeta * AlphaBeta;
+	if (FMath::Abs(Determinant) < UE_SMALL_NUMBER) {
+		return;
+	}
+
+	// solve
+	const auto& Factor = VectorSetFloat1(1.0f / Determinant);
+	const auto& Zero   = VectorZeroFloat();
+	const auto& Full   = VectorSetFloat1(255.0f);
+	Endpoint0 = VectorMultiply(
+	    VectorSubtract(VectorMultiply(AlphaX, VectorSetFloat1(BetaBeta)),
+	                   VectorMultiply(BetaX, VectorSetFloat1(AlphaBeta))),
+	    Factor);
+	Endpoint1 = VectorMultiply(
+	    VectorSubtract(VectorMultiply(BetaX, VectorSetFloat1(AlphaAlpha)),
+	                   VectorMultiply(AlphaX, VectorSetFloat1(AlphaBeta))),
+	    Factor);
+	Endpoint0 = VectorMin(VectorMax(Endpoint0, Zero), Full);
+	Endpoint1 = VectorMin(VectorMax(Endpoint1, Zero), Full);
+}
+
+static void QuantizeBC7Endpoint(const VectorRegister4Float& Color,
+                                uint8 (&Quantized)[4], uint8& PBit) {
+	alignas(16) float Components[4];
+	VectorStoreAligned(Color, Components);
+
+	// try both p-bits, and keep the one with less error
+	auto BestError = TNumericLimits<float>::Max();
+	for (auto P = 0; P < 2; ++P) {
+		uint8 Candidate[4];
+		auto  Error = 0.0f;
+		for (auto i = 0; i < 4; ++i) {
+			const auto& Value = FMath::Clamp(
+			    FMath::RoundToInt((Components[i] - P) / 2), 0, 127);
+			Candidate[i]      = static_cast<uint8>(Value);
+			Error += FMath::Square(static_cast<float>(2 * Value + P) -
+			                       Components[i]);
+		}
+		if (Error < BestError) {
+			BestError = Error;
+			FMemory::Memcpy(Quantized, Candidate, sizeof(Candidate));
+			PBit = static_cast<uint8>(P);
+		}
+	}
+}
+
+static VectorRegister4Float ExpandBC7Endpoint(const uint8 (&Quantized)[4],
+                                              const uint8 PBit) {
+	// the p-bit is the lowest bit of every component
+	float Components[4];
+	for (auto i = 0; i < 4; ++i) {
+		Components[i] = static_cast<float>((Quantized[i] << 1) | PBit);
+	}
+
+	return VectorLoad(Components);
+}
+
+static void QuantizeTo8888(const VectorRegister4Float& Color,
+                           uint8 (&Quantized)[4]) {
+	alignas(16) float Components[4];
+	VectorStoreAligned(Color, Components);
+
+	for (auto i = 0; i < 4; ++i) {
+		Quantized[i] = static_cast<uint8>(
+		    FMath::Clamp(FMath::RoundToInt(Components[i]), 0, 255));
+	}
+}
+
+static uint16 QuantizeTo565(const VectorRegister4Float& Color) {
+	alignas(16) float Components[4];
+	VectorStoreAligned(Color, Components);
+
+	// components are in BGRA order
+	const auto& B =
+	    FMath::Clamp(FMath::RoundToInt(Components[0] * 31 / 255.0f), 0, 31);
+	const auto& G =
+	    FMath::Clamp(FMath::RoundToInt(Components[1] * 63 / 255.0f), 0, 63);
+	const auto& R =
+	    FMath::Clamp(FMath::RoundToInt(Components[2] * 31 / 255.0f), 0, 31);
+
+	return static_cast<uint16>((R << 11) | (G << 5) | B);
+}
+
+static VectorRegister4Float ExpandFrom565(const uint16 Color) {
+	// replicate the high bits into the low bits, as GPUs do
+	const auto& R = (Color >> 11) & 0x1F;
+	const auto& G = (Color >> 5) & 0x3F;
+	const auto& B = Color & 0x1F;
+
+	return MakeVectorRegisterFloat(static_cast<float>((B << 3) | (B >> 2)),
+	                               static_cast<float>((G << 2) | (G >> 4)),
+	                               static_cast<float>((R << 3) | (R >> 2)),
+	                               0.0f);
+}
+
+template <typename T>
+static void WriteLittleEndian(const T Value, uint8* const Dst) {
+	for (auto i = 0; i < static_cast<int32>(sizeof(T)); ++i) {
+		Dst[i] = static_cast<uint8>(Value >> (8 * i));
+	}
+}
+#pragma endregion
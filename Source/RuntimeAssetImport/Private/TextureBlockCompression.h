@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Encode a 4x4 block of BGRA8 pixels into a BC1 (DXT1) block. Alpha is
+ * ignored.
+ * @param   Pixels         16 pixels of the block in row-major order, 4 bytes
+ *                         each in BGRA order
+ * @param   bHighQuality   whether to fit the endpoints along the principal
+ *                         axis of the block and refine them by least squares,
+ *                         instead of using the bounding box of the block
+ * @param   Block          destination of the 8-byte BC1 block
+ */
+void EncodeBC1Block(const uint8* Pixels, bool bHighQuality, uint8* Block);
+
+/**
+ * Encode a 4x4 block of BGRA8 pixels into a BC3 (DXT5) block.
+ * @param   Pixels         16 pixels of the block in row-major order, 4 bytes
+ *                         each in BGRA order
+ * @param   bHighQuality   same as EncodeBC1Block, for the color part
+ * @param   Block          destination of the 16-byte BC3 block
+ */
+void EncodeBC3Block(const uint8* Pixels, bool bHighQuality, uint8* Block);
+
+/**
+ * Encode a 4x4 block of BGRA8 pixels into a BC7 block in mode 6, that is, a
+ * single subset of RGBA endpoints with 4-bit indices.
+ * @param   Pixels         16 pixels of the block in row-major order, 4 bytes
+ *                         each in BGRA order
+ * @param   bHighQuality   same as EncodeBC1Block, fitting alpha with the color
+ * @param   Block          destination of the 16-byte BC7 block
+ */
+void EncodeBC7Block(const uint8* Pixels, bool bHighQuality, uint8* Block);
+
+/**
+ * Encode a 4x4 block of BGRA8 pixels into an ASTC 4x4 block with a single
+ * partition. Opaque blocks store RGB endpoints with 3-bit weights, and the
+ * others RGBA endpoints with 2-bit weights.
+ * @param   Pixels         16 pixels of the block in row-major order, 4 bytes
+ *                         each in BGRA order
+ * @param   bHighQuality   same as EncodeBC7Block
+ * @param   Block          destination of the 16-byte ASTC block
+ */
+void EncodeASTC4x4Block(const uint8* Pixels, bool bHighQuality, uint8* Block);
@@ -0,0 +1,361 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TextureContainers.h"
+
+#include "LogAssetLoader.h"
+#include "TextureProcessing.h"
+
+/**
+ * Color space of a format code in a container.
+ */
+enum class EContainerColorSpace : uint8 {
+	Linear,
+	SRGB,
+
+	// not told by the container (legacy DDS), decided by the caller
+	Unspecified,
+};
+
+/**
+ * Pixel format of a format code in a container.
+ */
+struct FContainerFormat {
+	// format code in the container (FourCC, DXGI_FORMAT or VkFormat)
+	uint32 Code;
+
+	// corresponding pixel format
+	EPixelFormat Format;
+
+	// color space of the data
+	EContainerColorSpace ColorSpace;
+};
+
+/**
+ * Make a FourCC code of DDS.
+ */
+static constexpr uint32 MakeFourCC(const char (&Chars)[5]) {
+	return static_cast<uint32>(Chars[0]) | static_cast<uint32>(Chars[1]) << 8 |
+	       static_cast<uint32>(Chars[2]) << 16 |
+	       static_cast<uint32>(Chars[3]) << 24;
+}
+
+static constexpr auto Linear      = EContainerColorSpace::Linear;
+static constexpr auto SRGB        = EContainerColorSpace::SRGB;
+static constexpr auto Unspecified = EContainerColorSpace::Unspecified;
+
+// FourCC codes of DDS without the DX10 header, which do not tell the color
+// space of DXT1-5
+static constexpr FContainerFormat DDSFourCCFormats[] = {
+    {MakeFourCC("DXT1"), PF_DXT1, Unspecified},
+    {MakeFourCC("DXT3"), PF_DXT3, Unspecified},
+    {MakeFourCC("DXT5"), PF_DXT5, Unspecified},
+    {MakeFourCC("ATI1"), PF_BC4, Linear},
+    {MakeFourCC("BC4U"), PF_BC4, Linear},
+    {MakeFourCC("ATI2"), PF_BC5, Linear},
+    {MakeFourCC("BC5U"), PF_BC5, Linear},
+};
+
+// DXGI_FORMATs of DDS with the DX10 header (the signed BC6H_SF16 is not
+// supported, since PF_BC6H is unsigned)
+static constexpr FContainerFormat DDSDXGIFormats[] = {
+    {71, PF_DXT1, Linear}, {72, PF_DXT1, SRGB},   {74, PF_DXT3, Linear},
+    {75, PF_DXT3, SRGB},   {77, PF_DXT5, Linear}, {78, PF_DXT5, SRGB},
+    {80, PF_BC4, Linear},  {83, PF_BC5, Linear},  {95, PF_BC6H, Linear},
+    {98, PF_BC7, Linear},  {99, PF_BC7, SRGB},
+};
+
+// VkFormats of KTX2 (the signed BC6H_SFLOAT is not supported, since PF_BC6H
+// is unsigned)
+static constexpr FContainerFormat KTX2VkFormats[] = {
+    {131, PF_DXT1, Linear},       {132, PF_DXT1, SRGB},
+    {133, PF_DXT1, Linear},       {134, PF_DXT1, SRGB},
+    {135, PF_DXT3, Linear},       {136, PF_DXT3, SRGB},
+    {137, PF_DXT5, Linear},       {138, PF_DXT5, SRGB},
+    {139, PF_BC4, Linear},        {141, PF_BC5, Linear},
+    {143, PF_BC6H, Linear},       {145, PF_BC7, Linear},
+    {146, PF_BC7, SRGB},          {157, PF_ASTC_4x4, Linear},
+    {158, PF_ASTC_4x4, SRGB},     {165, PF_ASTC_6x6, Linear},
+    {166, PF_ASTC_6x6, SRGB},     {171, PF_ASTC_8x8, Linear},
+    {172, PF_ASTC_8x8, SRGB},     {179, PF_ASTC_10x10, Linear},
+    {180, PF_ASTC_10x10, SRGB},   {183, PF_ASTC_12x12, Linear},
+    {184, PF_ASTC_12x12, SRGB},
+};
+
+#pragma region forward declarations of static functions
+/**
+ * Read a DDS file. See ReadPrecompressedTexture.
+ */
+static bool ReadDDSTexture(const uint8* Data, int64 Size,
+                           bool bUnspecifiedIsSRGB, FLoadedTextureData& TextureData);
+
+/**
+ * Read a KTX2 file. See ReadPrecompressedTexture.
+ */
+static bool ReadKTX2Texture(const uint8* Data, int64 Size,
+                            FLoadedTextureData& TextureData);
+
+/**
+ * Find the pixel format of a format code.
+ * @param   Formats   table of the container
+ * @param   Code      format code
+ * @return  the entry of Code, or nullptr if not supported
+ */
+template <SIZE_T N>
+static const FContainerFormat* FindContainerFormat(
+    const FContainerFormat (&Formats)[N], uint32 Code);
+
+/**
+ * Get the size of a mip chain.
+ * @param   Width     width of the first mip
+ * @param   Height    height of the first mip
+ * @param   Format    pixel format
+ * @param   NumMips   number of mips
+ * @return  the number of bytes
+ */
+static int64 GetMipChainSize(int32 Width, int32 Height, EPixelFormat Format,
+                             int32 NumMips);
+
+/**
+ * Read a little-endian integer.
+ * @param   Data     data to read from
+ * @param   Offset   offset in Data in bytes
+ */
+template <typename T>
+static T ReadLittleEndian(const uint8* Data, int64 Offset);
+#pragma endregion
+
+bool ReadPrecompressedTexture(const uint8* const Data, const int64 Size,
+                              const bool          bUnspecifiedIsSRGB,
+                              FLoadedTextureData& TextureData) {
+	return ReadDDSTexture(Data, Size, bUnspecifiedIsSRGB, TextureData) ||
+	       ReadKTX2Texture(Data, Size, TextureData);
+}
+
+#pragma region definitions of static functions
+static bool ReadDDSTexture(const uint8* const Data, const int64 Size,
+                           const bool          bUnspecifiedIsSRGB,
+                           FLoadedTextureData& TextureData) {
+	// magic number and DDS_HEADER
+	constexpr auto HeaderSize = int64{4 + 124};
+	if (Size < HeaderSize || FMemory::Memcmp(Data, "DDS ", 4) != 0) {
+		return false;
+	}
+
+	// read header
+	const auto& Flags       = ReadLittleEndian<uint32>(Data, 8);
+	const auto& Height      = ReadLittleEndian<uint32>(Data, 12);
+	const auto& Width       = ReadLittleEndian<uint32>(Data, 16);
+	const auto& MipMapCount = ReadLittleEndian<uint32>(Data, 28);
+	const auto& PixelFlags  = ReadLittleEndian<uint32>(Data, 80);
+	const auto& FourCC      = ReadLittleEndian<uint32>(Data, 84);
+	const auto& Caps2       = ReadLittleEndian<uint32>(Data, 112);
+
+	// uncompressed DDS is left to the image decoder
+	constexpr auto DDPF_FOURCC = 0x4u;
+	if (0 == (PixelFlags & DDPF_FOURCC)) {
+		return false;
+	}
+
+	// only 2D textures (no cube maps or volumes)
+	constexpr auto DDSCAPS2_CUBEMAP = 0x200u;
+	constexpr auto DDSCAPS2_VOLUME  = 0x200000u;
+	if (0 != (Caps2 & (DDSCAPS2_CUBEMAP | DDSCAPS2_VOLUME))) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("DDS cube maps and volume textures are not supported."));
+		return false;
+	}
+
+	// find pixel format, in the DX10 header if any
+	const FContainerFormat* ContainerFormat;
+	auto                    DataOffset = HeaderSize;
+	if (MakeFourCC("DX10") == FourCC) {
+		// DDS_HEADER_DXT10
+		constexpr auto DX10HeaderSize = int64{20};
+		if (Size < HeaderSize + DX10HeaderSize) {
+			return false;
+		}
+		const auto& DXGIFormat = ReadLittleEndian<uint32>(Data, HeaderSize);
+		const auto& Dimension  = ReadLittleEndian<uint32>(Data, HeaderSize + 4);
+		const auto& ArraySize  = ReadLittleEndian<uint32>(Data, HeaderSize + 12);
+
+		constexpr auto D3D10_RESOURCE_DIMENSION_TEXTURE2D = 3u;
+		if (D3D10_RESOURCE_DIMENSION_TEXTURE2D != Dimension || ArraySize > 1) {
+			UE_LOG(LogAssetLoader, Warning,
+			       TEXT("DDS textures other than single 2D textures are not "
+			            "supported."));
+			return false;
+		}
+
+		ContainerFormat = FindContainerFormat(DDSDXGIFormats, DXGIFormat);
+		DataOffset += DX10HeaderSize;
+	} else {
+		ContainerFormat = FindContainerFormat(DDSFourCCFormats, FourCC);
+	}
+	if (nullptr == ContainerFormat) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("Pixel format of the DDS texture is not supported."));
+		return false;
+	}
+
+	// number of mips
+	constexpr auto DDSD_MIPMAPCOUNT = 0x20000u;
+	const auto&    NumMips          = 0 != (Flags & DDSD_MIPMAPCOUNT)
+	                                      ? FMath::Max(1u, MipMapCount)
+	                                      : 1u;
+
+	// check size (the mips are packed from the largest)
+	if (0 == Width || 0 == Height || Width > TNumericLimits<int32>::Max() ||
+	    Height > TNumericLimits<int32>::Max() || NumMips > 32) {
+		return false;
+	}
+	const auto& MipChainSize =
+	    GetMipChainSize(Width, Height, ContainerFormat->Format, NumMips);
+	if (Size - DataOffset < MipChainSize ||
+	    MipChainSize > TNumericLimits<int32>::Max()) {
+		UE_LOG(LogAssetLoader, Warning, TEXT("DDS texture is truncated."));
+		return false;
+	}
+
+	// copy the blocks as they are
+	TextureData.RawData = TArray<uint8>(Data + DataOffset,
+	                                    static_cast<int32>(MipChainSize));
+	TextureData.RawWidth  = Width;
+	TextureData.RawHeight = Height;
+	TextureData.RawFormat = ContainerFormat->Format;
+	TextureData.NumMips   = NumMips;
+	TextureData.bSRGB =
+	    Unspecified == ContainerFormat->ColorSpace
+	        ? bUnspecifiedIsSRGB
+	        : SRGB == ContainerFormat->ColorSpace;
+
+	return true;
+}
+
+static bool ReadKTX2Texture(const uint8* const Data, const int64 Size,
+                            FLoadedTextureData& TextureData) {
+	// identifier and header
+	static constexpr uint8 Identifier[12] = {0xAB, 'K',  'T',  'X', ' ',  '2',
+	                                         '0',  0xBB, '\r', '\n', 0x1A, '\n'};
+	constexpr auto         HeaderSize     = int64{80};
+	if (Size < HeaderSize ||
+	    FMemory::Memcmp(Data, Identifier, sizeof(Identifier)) != 0) {
+		return false;
+	}
+
+	// read header
+	const auto& VkFormat    = ReadLittleEndian<uint32>(Data, 12);
+	const auto& Width       = ReadLittleEndian<uint32>(Data, 20);
+	const auto& Height      = ReadLittleEndian<uint32>(Data, 24);
+	const auto& Depth       = ReadLittleEndian<uint32>(Data, 28);
+	const auto& LayerCount  = ReadLittleEndian<uint32>(Data, 32);
+	const auto& FaceCount   = ReadLittleEndian<uint32>(Data, 36);
+	const auto& LevelCount  = ReadLittleEndian<uint32>(Data, 40);
+	const auto& Compression = ReadLittleEndian<uint32>(Data, 44);
+
+	// supercompressed data cannot be uploaded without transcoding
+	if (0 != Compression) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("KTX2 textures with supercompression scheme %u (e.g. Basis "
+		            "Universal) are not supported, since no transcoder is "
+		            "available."),
+		       Compression);
+		return false;
+	}
+
+	// only 2D textures
+	if (0 != Depth || LayerCount > 1 || 1 != FaceCount) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("KTX2 textures other than single 2D textures are not "
+		            "supported."));
+		return false;
+	}
+
+	// find pixel format
+	const auto& ContainerFormat = FindContainerFormat(KTX2VkFormats, VkFormat);
+	if (nullptr == ContainerFormat) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("VkFormat %u of the KTX2 texture is not supported."),
+		       VkFormat);
+		return false;
+	}
+
+	// number of mips (0 means only the base level is stored)
+	const auto& NumMips = FMath::Max(1u, LevelCount);
+
+	// check size
+	constexpr auto LevelIndexEntrySize = int64{24};
+	if (0 == Width || 0 == Height || Width > TNumericLimits<int32>::Max() ||
+	    Height > TNumericLimits<int32>::Max() || NumMips > 32 ||
+	    Size < HeaderSize + LevelIndexEntrySize * NumMips) {
+		return false;
+	}
+	const auto& MipChainSize =
+	    GetMipChainSize(Width, Height, ContainerFormat->Format, NumMips);
+	if (MipChainSize > TNumericLimits<int32>::Max()) {
+		return false;
+	}
+
+	// copy each level (stored anywhere in the file, listed from the largest in
+	// the level index)
+	TArray<uint8> MipData;
+	MipData.Reserve(static_cast<int32>(MipChainSize));
+	for (auto Level_i = 0u; Level_i < NumMips; ++Level_i) {
+		const auto& EntryOffset = HeaderSize + LevelIndexEntrySize * Level_i;
+		const auto& ByteOffset  = ReadLittleEndian<uint64>(Data, EntryOffset);
+		const auto& ByteLength = ReadLittleEndian<uint64>(Data, EntryOffset + 8);
+
+		const auto& ExpectedLength = GetTextureMipSize(
+		    FMath::Max(1u, Width >> Level_i), FMath::Max(1u, Height >> Level_i),
+		    ContainerFormat->Format);
+		if (ByteLength != static_cast<uint64>(ExpectedLength) ||
+		    ByteOffset > static_cast<uint64>(Size) ||
+		    ByteLength > static_cast<uint64>(Size) - ByteOffset) {
+			UE_LOG(LogAssetLoader, Warning,
+			       TEXT("Level %u of the KTX2 texture is broken."), Level_i);
+			return false;
+		}
+
+		MipData.Append(Data + ByteOffset, static_cast<int32>(ByteLength));
+	}
+
+	// set texture data
+	TextureData.RawData   = MoveTemp(MipData);
+	TextureData.RawWidth  = Width;
+	TextureData.RawHeight = Height;
+	TextureData.RawFormat = ContainerFormat->Format;
+	TextureData.NumMips   = NumMips;
+	TextureData.bSRGB     = SRGB == ContainerFormat->ColorSpace;
+
+	return true;
+}
+
+template <SIZE_T N>
+static const FContainerFormat* FindContainerFormat(
+    const FContainerFormat (&Formats)[N], const uint32 Code) {
+	for (const auto& ContainerFormat : Formats) {
+		if (Code == ContainerFormat.Code) {
+			return &ContainerFormat;
+		}
+	}
+	return nullptr;
+}
+
+static int64 GetMipChainSize(const int32 Width, const int32 Height,
+                             const EPixelFormat Format, const int32 NumMips) {
+	auto MipChainSize = int64{0};
+	for (auto Mip_i = 0; Mip_i < NumMips; ++Mip_i) {
+		MipChainSize += GetTextureMipSize(FMath::Max(1, Width >> Mip_i),
+		                                  FMath::Max(1, Height >> Mip_i), Format);
+	}
+	return MipChainSize;
+}
+
+template <typename T>
+static T ReadLittleEndian(const uint8* const Data, const int64 Offset) {
+	auto Value = T{0};
+	for (auto i = 0; i < static_cast<int32>(sizeof(T)); ++i) {
+		Value |= static_cast<T>(Data[Offset + i]) << (8 * i);
+	}
+	return Value;
+}
+#pragma endregion
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LoadedTextureData.h"
+
+/**
+ * Read a texture stored in a GPU-ready container, that is, DDS or KTX2 with
+ * block-compressed data (BC1-7, or ASTC for KTX2), so that its blocks and
+ * mips are uploaded as they are instead of being decoded.
+ * Only 2D textures without supercompression are supported. KTX2 files
+ * supercompressed with Basis Universal or Zstandard are rejected, since no
+ * transcoder is available at runtime.
+ * @param        Data                 content of the file
+ * @param        Size                 size of Data in bytes
+ * @param        bUnspecifiedIsSRGB   whether the data is in sRGB color space
+ *                                    if the container does not tell it
+ *                                    (DXT1-5 in DDS without the DX10 header),
+ *                                    decided by how the texture is used
+ * @param[out]   TextureData          texture data whose RawData, RawWidth,
+ *                                    RawHeight, RawFormat, NumMips and bSRGB
+ *                                    are set on success
+ * @return  whether Data is a supported container. false if it is in another
+ *          format (e.g. PNG), which should be decoded instead.
+ */
+bool ReadPrecompressedTexture(const uint8* Data, int64 Size,
+                              bool bUnspecifiedIsSRGB,
+                              FLoadedTextureData& TextureData);
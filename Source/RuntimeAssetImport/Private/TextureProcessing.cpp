@@ -0,0 +1,481 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TextureProcessing.h"
+
+#include "Async/ParallelFor.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "LogAssetLoader.h"
+#include "Math/VectorRegister.h"
+#include "Modules/ModuleManager.h"
+#include "TextureBlockCompression.h"
+
+/**
+ * Pixels of PF_B8G8R8A8, filtered as 4 floats in a vector register.
+ */
+struct FBGRA8Pixel {
+	static constexpr int32 Size = 4;
+
+	static VectorRegister4Float Load(const uint8* const Pixel) {
+		return VectorLoadByte4(Pixel);
+	}
+
+	static void Store(const VectorRegister4Float& Value, uint8* const Pixel) {
+		// round to nearest (VectorStoreByte4 truncates)
+		VectorStoreByte4(VectorAdd(Value, VectorSetFloat1(0.5f)), Pixel);
+	}
+};
+
+/**
+ * Pixels of PF_FloatRGBA, filtered as 4 floats in a vector register.
+ */
+struct FRGBA16FPixel {
+	static constexpr int32 Size = 8;
+
+	static VectorRegister4Float Load(const uint8* const Pixel) {
+		const auto& Halves = reinterpret_cast<const FFloat16*>(Pixel);
+		return MakeVectorRegisterFloat(Halves[0].GetFloat(), Halves[1].GetFloat(),
+		                               Halves[2].GetFloat(), Halves[3].GetFloat());
+	}
+
+	static void Store(const VectorRegister4Float& Value, uint8* const Pixel) {
+		alignas(16) float Floats[4];
+		VectorStoreAligned(Value, Floats);
+
+		const auto& Halves = reinterpret_cast<FFloat16*>(Pixel);
+		for (auto c = 0; c < 4; ++c) {
+			Halves[c] = FFloat16(Floats[c]);
+		}
+	}
+};
+
+#pragma region forward declarations of static functions
+/**
+ * Whether mips of the pixel format can be generated by HalveMip.
+ * @param   Format   pixel format
+ */
+static bool IsFilterableFormat(EPixelFormat Format);
+
+/**
+ * Halve a mip with a 2x2 box filter. The size of the halved mip is half of
+ * the source (rounded down, and at least 1).
+ * @param   Src         source mip
+ * @param   SrcWidth    width of the source mip
+ * @param   SrcHeight   height of the source mip
+ * @param   Dst         destination mip. Must not overlap Src.
+ * @param   Format      pixel format of the mips. Must be filterable.
+ */
+static void HalveMip(const uint8* RESTRICT Src, int32 SrcWidth, int32 SrcHeight,
+                     uint8* RESTRICT Dst, EPixelFormat Format);
+
+/**
+ * HalveMip for each pixel format.
+ * @tparam  PixelT   FBGRA8Pixel or FRGBA16FPixel
+ */
+template <typename PixelT>
+static void HalveMip(const uint8* RESTRICT Src, int32 SrcWidth, int32 SrcHeight,
+                     uint8* RESTRICT Dst);
+#pragma endregion
+
+bool DecodeTextureData(const uint8* const Data, const int64 Size,
+                       FLoadedTextureData& TextureData) {
+	// decode
+	FImage Image;
+	if (!FImageUtils::DecompressImage(Data, Size, Image)) {
+		return false;
+	}
+
+	// keep HDR images in half float, and convert the others to BGRA8
+	const auto& bHDR = ERawImageFormat::IsHDR(Image.Format);
+	if (bHDR) {
+		Image.ChangeFormat(ERawImageFormat::RGBA16F, EGammaSpace::Linear);
+	} else {
+		Image.ChangeFormat(ERawImageFormat::BGRA8, EGammaSpace::sRGB);
+	}
+
+	// RawData is indexed by int32
+	if (Image.RawData.Num() > TNumericLimits<int32>::Max()) {
+		return false;
+	}
+
+	TextureData.RawData   = TArray<uint8>(Image.RawData.GetData(),
+	                                      static_cast<int32>(Image.RawData.Num()));
+	TextureData.RawWidth  = Image.SizeX;
+	TextureData.RawHeight = Image.SizeY;
+	TextureData.RawFormat = bHDR ? PF_FloatRGBA : PF_B8G8R8A8;
+	TextureData.NumMips   = 1;
+	TextureData.bSRGB     = !bHDR;
+
+	return true;
+}
+
+int64 GetTextureMipSize(const int32 Width, const int32 Height,
+                        const EPixelFormat Format) {
+	const auto& PixelFormatInfo = GPixelFormats[Format];
+	const auto& NumBlocksX =
+	    FMath::DivideAndRoundUp(Width, PixelFormatInfo.BlockSizeX);
+	const auto& NumBlocksY =
+	    FMath::DivideAndRoundUp(Height, PixelFormatInfo.BlockSizeY);
+
+	return static_cast<int64>(NumBlocksX) * NumBlocksY *
+	       PixelFormatInfo.BlockBytes;
+}
+
+void DownscaleTexture(FLoadedTextureData& TextureData,
+                      const int32         MaxTextureSize) {
+	// get size and format
+	auto        Width  = TextureData.RawWidth;
+	auto        Height = TextureData.RawHeight;
+	const auto& Format = TextureData.RawFormat.GetValue();
+
+	// nothing to do if there is no limit, or the texture fits
+	if (MaxTextureSize <= 0 || TextureData.RawData.IsEmpty() ||
+	    FMath::Max(Width, Height) <= MaxTextureSize) {
+		return;
+	}
+
+	// block-compressed textures cannot be filtered, but their smaller mips
+	// can be used as they are
+	if (!IsFilterableFormat(Format)) {
+		auto FirstMip_i = 0;
+		auto MipOffset  = int64{0};
+		while (FirstMip_i + 1 < TextureData.NumMips &&
+		       FMath::Max(Width, Height) > MaxTextureSize) {
+			MipOffset += GetTextureMipSize(Width, Height, Format);
+			Width      = FMath::Max(1, Width / 2);
+			Height     = FMath::Max(1, Height / 2);
+			++FirstMip_i;
+		}
+
+		if (FMath::Max(Width, Height) > MaxTextureSize) {
+			UE_LOG(LogAssetLoader, Warning,
+			       TEXT("Texture of %dx%d in pixel format %s cannot be "
+			            "downscaled to fit %d."),
+			       Width, Height, GPixelFormats[Format].Name, MaxTextureSize);
+		}
+		if (0 == FirstMip_i) {
+			return;
+		}
+
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("Dropping %d mips of texture of %dx%d to fit %d."),
+		       FirstMip_i, TextureData.RawWidth, TextureData.RawHeight,
+		       MaxTextureSize);
+
+		// drop the larger mips
+		TextureData.RawData.RemoveAt(0, static_cast<int32>(MipOffset));
+		TextureData.RawWidth   = Width;
+		TextureData.RawHeight  = Height;
+		TextureData.NumMips   -= FirstMip_i;
+		return;
+	}
+
+	UE_LOG(LogAssetLoader, Log, TEXT("Downscaling texture of %dx%d to fit %d."),
+	       Width, Height, MaxTextureSize);
+
+	// halve until it fits, starting from the first mip
+	TArray<uint8> Mip;
+	while (FMath::Max(Width, Height) > MaxTextureSize) {
+		const auto& HalvedWidth  = FMath::Max(1, Width / 2);
+		const auto& HalvedHeight = FMath::Max(1, Height / 2);
+
+		TArray<uint8> HalvedMip;
+		HalvedMip.SetNumUninitialized(static_cast<int32>(
+		    GetTextureMipSize(HalvedWidth, HalvedHeight, Format)));
+		HalveMip(Mip.IsEmpty() ? TextureData.RawData.GetData() : Mip.GetData(),
+		         Width, Height, HalvedMip.GetData(), Format);
+
+		Mip    = MoveTemp(HalvedMip);
+		Width  = HalvedWidth;
+		Height = HalvedHeight;
+	}
+
+	// set downscaled texture
+	TextureData.RawData   = MoveTemp(Mip);
+	TextureData.RawWidth  = Width;
+	TextureData.RawHeight = Height;
+	TextureData.NumMips   = 1;
+}
+
+void GenerateTextureMips(FLoadedTextureData& TextureData) {
+	// get size and format
+	const auto& Width  = TextureData.RawWidth;
+	const auto& Height = TextureData.RawHeight;
+	const auto& Format = TextureData.RawFormat.GetValue();
+
+	// nothing to do if not uncompressed, or mips already exist
+	if (TextureData.RawData.IsEmpty() || TextureData.NumMips > 1) {
+		return;
+	}
+
+	if (!IsFilterableFormat(Format)) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("Mips of texture of %dx%d in pixel format %s cannot be "
+		            "generated."),
+		       Width, Height, GPixelFormats[Format].Name);
+		return;
+	}
+
+	// number of mips down to 1x1
+	const auto& NumMips =
+	    static_cast<int32>(FMath::FloorLog2(FMath::Max(Width, Height))) + 1;
+
+	// size of the whole mip chain
+	auto TotalSize = int64{0};
+	for (auto Mip_i = 0; Mip_i < NumMips; ++Mip_i) {
+		TotalSize += GetTextureMipSize(FMath::Max(1, Width >> Mip_i),
+		                               FMath::Max(1, Height >> Mip_i), Format);
+	}
+	if (TotalSize > TNumericLimits<int32>::Max()) {
+		UE_LOG(LogAssetLoader, Warning,
+		       TEXT("Mips of texture of %dx%d are too large to be generated."),
+		       Width, Height);
+		return;
+	}
+
+	// append each mip after the previous one
+	TextureData.RawData.SetNumUninitialized(static_cast<int32>(TotalSize));
+	auto Offset = int64{0};
+	for (auto Mip_i = 1; Mip_i < NumMips; ++Mip_i) {
+		const auto& SrcWidth  = FMath::Max(1, Width >> (Mip_i - 1));
+		const auto& SrcHeight = FMath::Max(1, Height >> (Mip_i - 1));
+		const auto& SrcSize   = GetTextureMipSize(SrcWidth, SrcHeight, Format);
+
+		const auto& Src = TextureData.RawData.GetData() + Offset;
+		HalveMip(Src, SrcWidth, SrcHeight, Src + SrcSize, Format);
+
+		Offset += SrcSize;
+	}
+
+	TextureData.NumMips = NumMips;
+}
+
+void CompressTexture(FLoadedTextureData&             TextureData,
+                     const ETextureCompressionMode   CompressionMode,
+                     const ETextureCompressionFormat CompressionFormat) {
+	// get size and format
+	const auto& Width   = TextureData.RawWidth;
+	const auto& Height  = TextureData.RawHeight;
+	const auto& NumMips = TextureData.NumMips;
+	const auto& RawData = TextureData.RawData;
+
+	// nothing to do if not requested, or not uncompressed BGRA8
+	if (ETextureCompressionMode::None == CompressionMode || RawData.IsEmpty() ||
+	    PF_B8G8R8A8 != TextureData.RawFormat) {
+		return;
+	}
+
+	// the first mip must consist of whole blocks
+	if (Width % 4 != 0 || Height % 4 != 0) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("Texture of %dx%d is not compressed, since its size is not "
+		            "a multiple of 4."),
+		       Width, Height);
+		return;
+	}
+
+	// BC3 if any pixel is not opaque, BC1 otherwise
+	auto IsOpaque = true;
+	for (auto i = 3; i < RawData.Num() && IsOpaque; i += 4) {
+		IsOpaque = 0xFF == RawData[i];
+	}
+	const auto& BCFormat = IsOpaque ? PF_DXT1 : PF_DXT5;
+
+	// choose the format, falling back to ASTC where BC is not supported
+	auto Format = BCFormat;
+	switch (CompressionFormat) {
+	case ETextureCompressionFormat::Auto:
+		if (!GPixelFormats[BCFormat].Supported &&
+		    GPixelFormats[PF_ASTC_4x4].Supported) {
+			Format = PF_ASTC_4x4;
+		}
+		break;
+	case ETextureCompressionFormat::BC7:
+		Format = PF_BC7;
+		break;
+	case ETextureCompressionFormat::ASTC4x4:
+		Format = PF_ASTC_4x4;
+		break;
+	default:
+		break;
+	}
+
+	if (!GPixelFormats[Format].Supported) {
+		UE_LOG(LogAssetLoader, Log,
+		       TEXT("Texture of %dx%d is not compressed, since %s is not "
+		            "supported."),
+		       Width, Height, GPixelFormats[Format].Name);
+		return;
+	}
+
+	// size of the whole compressed mip chain
+	auto TotalSize = int64{0};
+	for (auto Mip_i = 0; Mip_i < NumMips; ++Mip_i) {
+		TotalSize += GetTextureMipSize(FMath::Max(1, Width >> Mip_i),
+		                               FMath::Max(1, Height >> Mip_i), Format);
+	}
+	TArray<uint8> CompressedMips;
+	CompressedMips.SetNumUninitialized(static_cast<int32>(TotalSize));
+
+	// encode each mip
+	const auto& bHighQuality =
+	    ETextureCompressionMode::HighQuality == CompressionMode;
+	const auto& BlockBytes = GPixelFormats[Format].BlockBytes;
+	auto        SrcOffset  = int64{0};
+	auto        DstOffset  = int64{0};
+	for (auto Mip_i = 0; Mip_i < NumMips; ++Mip_i) {
+		const auto& MipWidth   = FMath::Max(1, Width >> Mip_i);
+		const auto& MipHeight  = FMath::Max(1, Height >> Mip_i);
+		const auto& NumBlocksX = FMath::DivideAndRoundUp(MipWidth, 4);
+		const auto& NumBlocksY = FMath::DivideAndRoundUp(MipHeight, 4);
+		const auto& Src        = RawData.GetData() + SrcOffset;
+		const auto& Dst        = CompressedMips.GetData() + DstOffset;
+
+		// rows of blocks are independent of each other
+		ParallelFor(NumBlocksY, [&](const int32 BlockY) {
+			for (auto BlockX = 0; BlockX < NumBlocksX; ++BlockX) {
+				// gather the pixels of the block. Mips smaller than a block
+				// repeat their last row and column.
+				uint8 BlockPixels[16 * 4];
+				for (auto y = 0; y < 4; ++y) {
+					const auto& PixelY = FMath::Min(4 * BlockY + y, MipHeight - 1);
+					for (auto x = 0; x < 4; ++x) {
+						const auto& PixelX = FMath::Min(4 * BlockX + x, MipWidth - 1);
+						FMemory::Memcpy(
+						    BlockPixels + 4 * (4 * y + x),
+						    Src + (static_cast<int64>(PixelY) * MipWidth + PixelX) * 4,
+						    4);
+					}
+				}
+
+				// encode
+				const auto& Block =
+				    Dst + (static_cast<int64>(BlockY) * NumBlocksX + BlockX) *
+				              BlockBytes;
+				switch (Format) {
+				case PF_DXT1:
+					EncodeBC1Block(BlockPixels, bHighQuality, Block);
+					break;
+				case PF_DXT5:
+					EncodeBC3Block(BlockPixels, bHighQuality, Block);
+					break;
+				case PF_BC7:
+					EncodeBC7Block(BlockPixels, bHighQuality, Block);
+					break;
+				default:
+					EncodeASTC4x4Block(BlockPixels, bHighQuality, Block);
+					break;
+				}
+			}
+		});
+
+		SrcOffset += GetTextureMipSize(MipWidth, MipHeight, PF_B8G8R8A8);
+		DstOffset += GetTextureMipSize(MipWidth, MipHeight, Format);
+	}
+
+	// set compressed texture
+	TextureData.RawData   = MoveTemp(CompressedMips);
+	TextureData.RawFormat = Format;
+}
+
+int64 GetTextureMemorySize(const FLoadedTextureData& TextureData) {
+	// if uncompressed, sum the size of the mips
+	if (!TextureData.GetRawData().IsEmpty()) {
+		auto MemorySize = int64{0};
+		for (auto Mip_i = 0; Mip_i < TextureData.NumMips; ++Mip_i) {
+			MemorySize += GetTextureMipSize(
+			    FMath::Max(1, TextureData.RawWidth >> Mip_i),
+			    FMath::Max(1, TextureData.RawHeight >> Mip_i),
+			    TextureData.RawFormat.GetValue());
+		}
+		return MemorySize;
+	}
+
+	// if compressed, read the size from the header of the image. It will be
+	// decoded into a single mip of RGBA16F if HDR, or BGRA8 otherwise.
+	const auto& CompressedData = TextureData.CompressedData;
+	if (CompressedData.IsEmpty()) {
+		return 0;
+	}
+
+	auto& ImageWrapperModule =
+	    FModuleManager::GetModuleChecked<IImageWrapperModule>("ImageWrapper");
+	const auto& ImageFormat = ImageWrapperModule.DetectImageFormat(
+	    CompressedData.GetData(), CompressedData.Num());
+	const auto& ImageWrapper = ImageWrapperModule.CreateImageWrapper(ImageFormat);
+	if (!ImageWrapper.IsValid() ||
+	    !ImageWrapper->SetCompressed(CompressedData.GetData(),
+	                                 CompressedData.Num())) {
+		return 0;
+	}
+
+	const auto& Format =
+	    ERawImageFormat::IsHDR(ImageWrapper->GetClosestRawImageFormat())
+	        ? PF_FloatRGBA
+	        : PF_B8G8R8A8;
+	return GetTextureMipSize(static_cast<int32>(ImageWrapper->GetWidth()),
+	                         static_cast<int32>(ImageWrapper->GetHeight()),
+	                         Format);
+}
+
+#pragma region definitions of static functions
+static bool IsFilterableFormat(const EPixelFormat Format) {
+	return PF_B8G8R8A8 == Format || PF_FloatRGBA == Format;
+}
+
+static void HalveMip(const uint8* RESTRICT Src, const int32 SrcWidth,
+                     const int32 SrcHeight, uint8* RESTRICT Dst,
+                     const EPixelFormat Format) {
+	switch (Format) {
+	case PF_B8G8R8A8:
+		HalveMip<FBGRA8Pixel>(Src, SrcWidth, SrcHeight, Dst);
+		break;
+	case PF_FloatRGBA:
+		HalveMip<FRGBA16FPixel>(Src, SrcWidth, SrcHeight, Dst);
+		break;
+	default:
+		verifyf(false, TEXT("Bug. Pixel format %s is not filterable."),
+		        GPixelFormats[Format].Name);
+		break;
+	}
+}
+
+template <typename PixelT>
+static void HalveMip(const uint8* RESTRICT Src, const int32 SrcWidth,
+                     const int32 SrcHeight, uint8* RESTRICT Dst) {
+	// get size of the halved mip
+	const auto& DstWidth  = FMath::Max(1, SrcWidth / 2);
+	const auto& DstHeight = FMath::Max(1, SrcHeight / 2);
+
+	// filter rows in parallel. The 4 channels of a pixel are filtered at once
+	// in a vector register.
+	ParallelFor(DstHeight, [&](const int32 Y) {
+		// source rows (the same row twice if the source has only 1 row)
+		const auto& SrcRow0 =
+		    Src + static_cast<int64>(FMath::Min(2 * Y, SrcHeight - 1)) *
+		              SrcWidth * PixelT::Size;
+		const auto& SrcRow1 =
+		    Src + static_cast<int64>(FMath::Min(2 * Y + 1, SrcHeight - 1)) *
+		              SrcWidth * PixelT::Size;
+
+		// destination row
+		const auto& DstRow = Dst + static_cast<int64>(Y) * DstWidth * PixelT::Size;
+
+		const auto& Quarter = VectorSetFloat1(0.25f);
+		for (auto X = 0; X < DstWidth; ++X) {
+			// source columns (the same column twice if the source has only 1)
+			const auto& SrcX0 = FMath::Min(2 * X, SrcWidth - 1) * PixelT::Size;
+			const auto& SrcX1 = FMath::Min(2 * X + 1, SrcWidth - 1) * PixelT::Size;
+
+			// average of 2x2 pixels
+			const auto& Sum =
+			    VectorAdd(VectorAdd(PixelT::Load(SrcRow0 + SrcX0),
+			                        PixelT::Load(SrcRow0 + SrcX1)),
+			              VectorAdd(PixelT::Load(SrcRow1 + SrcX0),
+			                        PixelT::Load(SrcRow1 + SrcX1)));
+			PixelT::Store(VectorMultiply(Sum, Quarter), DstRow + X * PixelT::Size);
+		}
+	});
+}
+#pragma endregion
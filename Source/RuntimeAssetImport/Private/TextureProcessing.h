@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AssetImportProfile.h"
+#include "CoreMinimal.h"
+#include "LoadedTextureData.h"
+
+/**
+ * Decode texture data compressed into some image format (e.g. PNG, JPEG)
+ * into uncompressed pixels. HDR images are decoded into RGBA16F
+ * (PF_FloatRGBA), and the others into sRGB BGRA8 (PF_B8G8R8A8).
+ * Thread-safe.
+ * @param        Data          compressed data
+ * @param        Size          size of Data in bytes
+ * @param[out]   TextureData   texture data whose RawData, RawWidth, RawHeight,
+ *                             RawFormat, NumMips and bSRGB are set. The other
+ *                             fields are not modified.
+ * @return  whether the data could be decoded
+ */
+bool DecodeTextureData(const uint8* Data, int64 Size,
+                       FLoadedTextureData& TextureData);
+
+/**
+ * Get the number of bytes of a mip.
+ * @param   Width    width of the mip in pixels
+ * @param   Height   height of the mip in pixels
+ * @param   Format   pixel format of the mip
+ * @return  the number of bytes
+ */
+int64 GetTextureMipSize(int32 Width, int32 Height, EPixelFormat Format);
+
+/**
+ * Downscale uncompressed texture data by halving it with a box filter until
+ * both its width and height are at most MaxTextureSize. Only the first mip is
+ * kept. Rows are filtered in parallel.
+ * Textures in a pixel format that cannot be filtered (e.g. block-compressed
+ * textures read from DDS or KTX2) are downscaled by dropping their larger mips
+ * instead, as far as their mips allow.
+ * Textures which already fit, or are not uncompressed are left as they are.
+ * @param[in,out]   TextureData      texture data to downscale
+ * @param           MaxTextureSize   maximum width and height. 0 or less means
+ *                                   no limit.
+ */
+void DownscaleTexture(FLoadedTextureData& TextureData, int32 MaxTextureSize);
+
+/**
+ * Generate the full mip chain (down to 1x1) of uncompressed texture data with
+ * a box filter. Rows are filtered in parallel.
+ * Textures which already have mips, are not uncompressed, or are in a pixel
+ * format that cannot be filtered are left as they are.
+ * @param[in,out]   TextureData   texture data to generate mips of
+ */
+void GenerateTextureMips(FLoadedTextureData& TextureData);
+
+/**
+ * Compress uncompressed BGRA8 texture data (with all its mips) into a block-
+ * compressed format: BC1 (or BC3 if any pixel is not opaque), BC7 or ASTC
+ * 4x4. Each mip is split into rows of 4x4 blocks, which are encoded in
+ * parallel.
+ * Textures which are not BGRA8, whose width or height is not a multiple of 4,
+ * or whose compressed format is not supported by the RHI are left as they
+ * are.
+ * @param[in,out]   TextureData         texture data to compress
+ * @param           CompressionMode     how to compress. None does nothing.
+ * @param           CompressionFormat   format to compress into
+ */
+void CompressTexture(FLoadedTextureData&       TextureData,
+                     ETextureCompressionMode   CompressionMode,
+                     ETextureCompressionFormat CompressionFormat);
+
+/**
+ * Estimate the number of bytes texture data takes once the texture is
+ * created, with all its mips. For compressed texture data, only the header of
+ * the image is read to get its size.
+ * @param   TextureData   texture data
+ * @return  the number of bytes, or 0 if unknown
+ */
+int64 GetTextureMemorySize(const FLoadedTextureData& TextureData);
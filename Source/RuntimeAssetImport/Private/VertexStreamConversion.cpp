@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "VertexStreamConversion.h"
+
+#include "Math/VectorRegister.h"
+
+void WidenFloatsToDoubles(const float* RESTRICT Src, double* RESTRICT Dst,
+                          const int64 Num) {
+	auto i = int64{0};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	// 4 floats at a time. Widening a VectorRegister4Float to a
+	// VectorRegister4Double is a single cvtps2pd on AVX, two on SSE and two
+	// fcvtl on NEON.
+	for (; i + 4 <= Num; i += 4) {
+		const auto& Floats  = VectorLoad(Src + i);
+		const auto& Doubles = VectorRegister4Double(Floats);
+		VectorStore(Doubles, Dst + i);
+	}
+#endif
+
+	// remainder
+	for (; i < Num; ++i) {
+		Dst[i] = Src[i];
+	}
+}
+
+void WidenFloat3sToDouble2s(const float* RESTRICT Src, double* RESTRICT Dst,
+                            const int64 Num) {
+	auto i = int64{0};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	// 4 vectors at a time. Loading 4 floats at the start of each vector reads
+	// 1 float past it, which is inside the source as long as this is not the
+	// last vector.
+	for (; i + 4 < Num; i += 4) {
+		const auto& XY01 = VectorRegister4Double(VectorShuffle(
+		    VectorLoad(Src + 3 * i), VectorLoad(Src + 3 * (i + 1)), 0, 1, 0, 1));
+		const auto& XY23 = VectorRegister4Double(VectorShuffle(
+		    VectorLoad(Src + 3 * (i + 2)), VectorLoad(Src + 3 * (i + 3)), 0, 1, 0,
+		    1));
+		VectorStore(XY01, Dst + 2 * i);
+		VectorStore(XY23, Dst + 2 * (i + 2));
+	}
+#endif
+
+	// remainder
+	for (; i < Num; ++i) {
+		Dst[2 * i]     = Src[3 * i];
+		Dst[2 * i + 1] = Src[3 * i + 1];
+	}
+}
+
+void NarrowFloat3sToHalf2s(const float* RESTRICT Src, uint16* RESTRICT Dst,
+                           const int64 Num) {
+	auto i = int64{0};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	// 4 vectors at a time, gathered in the same way as WidenFloat3sToDouble2s
+	// (reading 1 float past each vector). VectorStoreHalf is a single
+	// vcvtps2ph where F16C is available.
+	for (; i + 4 < Num; i += 4) {
+		alignas(16) float XY0123[8];
+		VectorStoreAligned(VectorShuffle(VectorLoad(Src + 3 * i),
+		                                 VectorLoad(Src + 3 * (i + 1)), 0, 1, 0,
+		                                 1),
+		                   XY0123);
+		VectorStoreAligned(VectorShuffle(VectorLoad(Src + 3 * (i + 2)),
+		                                 VectorLoad(Src + 3 * (i + 3)), 0, 1, 0,
+		                                 1),
+		                   XY0123 + 4);
+		FPlatformMath::VectorStoreHalf(Dst + 2 * i, XY0123);
+		FPlatformMath::VectorStoreHalf(Dst + 2 * (i + 2), XY0123 + 4);
+	}
+#endif
+
+	// remainder
+	for (; i < Num; ++i) {
+		FPlatformMath::StoreHalf(Dst + 2 * i, Src[3 * i]);
+		FPlatformMath::StoreHalf(Dst + 2 * i + 1, Src[3 * i + 1]);
+	}
+}
+
+void QuantizeLinearColors(const float* RESTRICT Src, FColor* RESTRICT Dst,
+                          const int64 Num) {
+	auto i = int64{0};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	// 1 color (4 channels) at a time: clamp, scale and truncate, which is what
+	// ToFColor(false) does to each channel
+	const auto& Scale = VectorSetFloat1(255.999f);
+	for (; i < Num; ++i) {
+		const auto& Clamped = VectorMin(
+		    VectorMax(VectorLoad(Src + 4 * i), VectorZeroFloat()),
+		    VectorOneFloat());
+		alignas(16) int32 RGBA[4];
+		VectorIntStoreAligned(VectorFloatToInt(VectorMultiply(Clamped, Scale)),
+		                      RGBA);
+		Dst[i] = FColor(static_cast<uint8>(RGBA[0]),
+		                static_cast<uint8>(RGBA[1]),
+		                static_cast<uint8>(RGBA[2]),
+		                static_cast<uint8>(RGBA[3]));
+	}
+#endif
+
+	// remainder
+	for (; i < Num; ++i) {
+		Dst[i] = FLinearColor(Src[4 * i], Src[4 * i + 1], Src[4 * i + 2],
+		                      Src[4 * i + 3])
+		             .ToFColor(false);
+	}
+}
+
+void EncodeOctahedrals(const float* RESTRICT Src, uint32* RESTRICT Dst,
+                       const int64 Num) {
+	auto i = int64{0};
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS || PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+	// 4 vectors at a time, with the same operations in the same order as
+	// EncodeOctahedral, so that the results are identical (no fused
+	// multiply-add)
+	const auto& Zero      = VectorZeroFloat();
+	const auto& One       = VectorOneFloat();
+	const auto& MinusOne  = VectorSetFloat1(-1.0f);
+	const auto& Half      = VectorSetFloat1(0.5f);
+	const auto& SnormMax  = VectorSetFloat1(32767.0f);
+	const auto& LowerMask = VectorIntSet1(0xFFFF);
+	for (; i + 4 <= Num; i += 4) {
+		// transpose x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3 to X, Y and Z
+		const auto& A   = VectorLoad(Src + 3 * i);
+		const auto& B   = VectorLoad(Src + 3 * i + 4);
+		const auto& C   = VectorLoad(Src + 3 * i + 8);
+		const auto& X01 = VectorShuffle(A, A, 0, 0, 3, 3);
+		const auto& X23 = VectorShuffle(B, C, 2, 2, 1, 1);
+		const auto& Y01 = VectorShuffle(A, B, 1, 1, 0, 0);
+		const auto& Y23 = VectorShuffle(B, C, 3, 3, 2, 2);
+		const auto& Z01 = VectorShuffle(A, B, 2, 2, 1, 1);
+		const auto& Z23 = VectorShuffle(C, C, 0, 0, 3, 3);
+		const auto& X   = VectorShuffle(X01, X23, 0, 2, 0, 2);
+		const auto& Y   = VectorShuffle(Y01, Y23, 0, 2, 0, 2);
+		const auto& Z   = VectorShuffle(Z01, Z23, 0, 2, 0, 2);
+
+		// project onto the octahedron (zero vectors are encoded as 0, which
+		// is what the zeroed U and V are quantized to)
+		const auto& L1Norm =
+		    VectorAdd(VectorAdd(VectorAbs(X), VectorAbs(Y)), VectorAbs(Z));
+		const auto& IsZero     = VectorCompareLE(L1Norm, Zero);
+		const auto& SafeL1Norm = VectorSelect(IsZero, One, L1Norm);
+		auto        U = VectorSelect(IsZero, Zero, VectorDivide(X, SafeL1Norm));
+		auto        V = VectorSelect(IsZero, Zero, VectorDivide(Y, SafeL1Norm));
+
+		// fold the lower hemisphere over the diagonals
+		const auto& IsUPositive = VectorCompareGE(U, Zero);
+		const auto& IsVPositive = VectorCompareGE(V, Zero);
+		const auto& SignU       = VectorSelect(IsUPositive, One, MinusOne);
+		const auto& SignV       = VectorSelect(IsVPositive, One, MinusOne);
+		const auto& FoldedU =
+		    VectorMultiply(VectorSubtract(One, VectorAbs(V)), SignU);
+		const auto& FoldedV =
+		    VectorMultiply(VectorSubtract(One, VectorAbs(U)), SignV);
+		const auto& IsLower = VectorCompareLT(Z, Zero);
+		U                   = VectorSelect(IsLower, FoldedU, U);
+		V                   = VectorSelect(IsLower, FoldedV, V);
+
+		// quantize to 16-bit snorms (rounding half up, as RoundToInt does)
+		const auto& Quantize = [&](const VectorRegister4Float& W) {
+			const auto& Clamped = VectorMin(VectorMax(W, MinusOne), One);
+			const auto& Scaled  = VectorMultiply(Clamped, SnormMax);
+			return VectorFloatToInt(VectorFloor(VectorAdd(Scaled, Half)));
+		};
+		const auto& Encoded =
+		    VectorIntOr(VectorIntAnd(Quantize(U), LowerMask),
+		                VectorShiftLeftImm(Quantize(V), 16));
+		VectorIntStore(Encoded, Dst + i);
+	}
+#endif
+
+	// remainder
+	for (; i < Num; ++i) {
+		Dst[i] = EncodeOctahedral(Src[3 * i], Src[3 * i + 1], Src[3 * i + 2]);
+	}
+}
+
+uint32 EncodeOctahedral(const float X, const float Y, const float Z) {
+	// project onto the octahedron |x| + |y| + |z| = 1
+	const auto& L1Norm = FMath::Abs(X) + FMath::Abs(Y) + FMath::Abs(Z);
+	if (L1Norm <= 0.0f) {
+		return 0;
+	}
+	auto U = X / L1Norm;
+	auto V = Y / L1Norm;
+
+	// fold the lower hemisphere over the diagonals
+	if (Z < 0.0f) {
+		const auto& FoldedU = (1.0f - FMath::Abs(V)) * (U >= 0.0f ? 1.0f : -1.0f);
+		const auto& FoldedV = (1.0f - FMath::Abs(U)) * (V >= 0.0f ? 1.0f : -1.0f);
+		U                   = FoldedU;
+		V                   = FoldedV;
+	}
+
+	// quantize to 16-bit snorms
+	const auto& QuantizedU = static_cast<int16>(
+	    FMath::RoundToInt(FMath::Clamp(U, -1.0f, 1.0f) * 32767.0f));
+	const auto& QuantizedV = static_cast<int16>(
+	    FMath::RoundToInt(FMath::Clamp(V, -1.0f, 1.0f) * 32767.0f));
+
+	return static_cast<uint32>(static_cast<uint16>(QuantizedU)) |
+	       (static_cast<uint32>(static_cast<uint16>(QuantizedV)) << 16);
+}
+
+FVector3f DecodeOctahedral(const uint32 Encoded) {
+	// dequantize
+	auto U = static_cast<int16>(Encoded & 0xFFFF) / 32767.0f;
+	auto V = static_cast<int16>(Encoded >> 16) / 32767.0f;
+
+	// unfold the lower hemisphere
+	const auto& Z = 1.0f - FMath::Abs(U) - FMath::Abs(V);
+	const auto& T = FMath::Max(-Z, 0.0f);
+	U += U >= 0.0f ? -T : T;
+	V += V >= 0.0f ? -T : T;
+
+	return FVector3f(U, V, Z).GetSafeNormal(UE_SMALL_NUMBER,
+	                                        FVector3f::UpVector);
+}
@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Widen single-precision floats to double precision.
+ * Uses the engine's vector registers (SSE/AVX/NEON, whichever the target is
+ * built for) and falls back to scalar code for the remainder.
+ * Since assimp's vectors and UE's FVector are tightly packed x, y, z, a
+ * stream of aiVector3D can be converted to FVector by widening 3 * N floats.
+ * @param   Src   source floats
+ * @param   Dst   destination doubles. Must not overlap Src.
+ * @param   Num   number of floats to widen
+ */
+void WidenFloatsToDoubles(const float* RESTRICT Src, double* RESTRICT Dst,
+                          int64 Num);
+
+/**
+ * Widen the first 2 components of 3-component single-precision vectors to
+ * 2-component double-precision vectors (e.g. aiVector3D UVs to FVector2D).
+ * @param   Src   source vectors, 3 floats each
+ * @param   Dst   destination vectors, 2 doubles each. Must not overlap Src.
+ * @param   Num   number of vectors to widen
+ */
+void WidenFloat3sToDouble2s(const float* RESTRICT Src, double* RESTRICT Dst,
+                            int64 Num);
+
+/**
+ * Narrow the first 2 components of 3-component single-precision vectors to
+ * half precision (e.g. aiVector3D UVs to FVector2DHalf), rounding to nearest
+ * even in the same way as FFloat16.
+ * @param   Src   source vectors, 3 floats each
+ * @param   Dst   destination vectors, 2 halves each. Must not overlap Src.
+ * @param   Num   number of vectors to narrow
+ */
+void NarrowFloat3sToHalf2s(const float* RESTRICT Src, uint16* RESTRICT Dst,
+                           int64 Num);
+
+/**
+ * Quantize linear colors to 8 bits per channel without sRGB conversion, with
+ * the same results as FLinearColor::ToFColor(false).
+ * @param   Src   source colors, 4 floats each in RGBA order
+ * @param   Dst   destination colors. Must not overlap Src.
+ * @param   Num   number of colors to quantize
+ */
+void QuantizeLinearColors(const float* RESTRICT Src, FColor* RESTRICT Dst,
+                          int64 Num);
+
+/**
+ * Encode 3-component single-precision unit vectors (e.g. aiVector3D normals)
+ * with EncodeOctahedral, 4 vectors at a time, with the same results.
+ * @param   Src   source vectors, 3 floats each
+ * @param   Dst   destination encoded vectors. Must not overlap Src.
+ * @param   Num   number of vectors to encode
+ */
+void EncodeOctahedrals(const float* RESTRICT Src, uint32* RESTRICT Dst,
+                       int64 Num);
+
+/**
+ * Encode a unit vector into 2 16-bit snorms with octahedral mapping.
+ * @param   X   x component
+ * @param   Y   y component
+ * @param   Z   z component
+ * @return  the encoded vector, u in the lower 16 bits and v in the upper.
+ *          A zero vector is encoded as +Z.
+ */
+uint32 EncodeOctahedral(float X, float Y, float Z);
+
+/**
+ * Decode a unit vector encoded by EncodeOctahedral.
+ * @param   Encoded   the encoded vector
+ * @return  the decoded unit vector
+ */
+FVector3f DecodeOctahedral(uint32 Encoded);
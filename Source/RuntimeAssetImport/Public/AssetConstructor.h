@@ -59,6 +59,9 @@ class RUNTIMEASSETIMPORT_API UAssetConstructor
 public:
 	/**
 	 * Create mesh sections on specified procedural mesh component
+	 * The construction stops, skipping the pending mesh sections, when the
+	 * target component is destroyed or the latent action is aborted (e.g. its
+	 * owner is destroyed).
 	 * @param   MeshData                    mesh data
 	 * @param   ParentMaterialInterface     The base material interface used to
 	 *                                      create materials for the constructed
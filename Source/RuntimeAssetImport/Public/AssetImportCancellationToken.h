@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include <atomic>
+
+/**
+ * Token to cancel an in-flight asynchronous import.
+ * Cancel can be called from any thread. The import checks the token between
+ * its steps, and stops parsing, converting and processing as soon as it
+ * notices, releasing the memory it has allocated so far. A canceled import
+ * fails, i.e. its result is unset.
+ */
+class RUNTIMEASSETIMPORT_API FAssetImportCancellationToken {
+public:
+	/**
+	 * Request the import to stop. Has no effect if it has already finished.
+	 */
+	void Cancel();
+
+	/**
+	 * Whether Cancel has been called.
+	 */
+	bool IsCanceled() const;
+
+	/* internal fields */
+private:
+	std::atomic<bool> bCanceled = false;
+};
+
+/**
+ * Cancellation token shared between the caller and the import.
+ */
+using FAssetImportCancellationTokenPtr =
+    TSharedPtr<FAssetImportCancellationToken, ESPMode::ThreadSafe>;
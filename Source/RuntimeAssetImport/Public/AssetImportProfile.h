@@ -0,0 +1,169 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "AssetImportProfile.generated.h"
+
+/**
+ * Preset of post-process steps applied to the scene loaded by assimp.
+ */
+UENUM(BlueprintType)
+enum class EAssetImportProfileType : uint8 {
+	/* All post-process steps. Slowest, but gives the most complete data. */
+	Quality,
+
+	/* Only the steps that are cheap and needed for correct rendering. */
+	Fast,
+
+	/* Only the steps that matter for collision (geometry). */
+	CollisionOnly,
+
+	/* Inspect the loaded data and skip the steps that would be redundant. */
+	Auto,
+
+	/* Use the steps specified in FAssetImportProfile::CustomPostProcessSteps. */
+	Custom
+};
+
+/**
+ * Optional post-process steps that can be selected in a custom import
+ * profile. The values are the same as assimp's aiPostProcessSteps.
+ * Triangulation, conversion to left-handed coordinates and UV flipping are
+ * always applied since the loaded data relies on them.
+ */
+UENUM(meta = (Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EAssetImportPostProcessStep : int32 {
+	None                     = 0 UMETA(Hidden),
+	CalcTangentSpace         = 0x1,
+	JoinIdenticalVertices    = 0x2,
+	GenSmoothNormals         = 0x40,
+	ImproveCacheLocality     = 0x800,
+	RemoveRedundantMaterials = 0x1000,
+	FindDegenerates          = 0x10000,
+	FindInvalidData          = 0x20000,
+	GenUVCoords              = 0x40000,
+	TransformUVCoords        = 0x80000,
+	OptimizeMeshes           = 0x200000,
+};
+ENUM_CLASS_FLAGS(EAssetImportPostProcessStep);
+
+/**
+ * Block compression applied to the loaded textures.
+ */
+UENUM(BlueprintType)
+enum class ETextureCompressionMode : uint8 {
+	/* Keep textures uncompressed. */
+	None,
+
+	/* Compress with endpoints from the bounding box of each block. Fastest. */
+	Fast,
+
+	/* Compress with endpoints fitted along the principal axis of each block,
+	   refined by least squares. Slower, but with less error. */
+	HighQuality
+};
+
+/**
+ * Pixel format the loaded textures are block-compressed into.
+ */
+UENUM(BlueprintType)
+enum class ETextureCompressionFormat : uint8 {
+	/* BC1 or BC3 where BC is supported (desktops and consoles), and ASTC 4x4
+	   otherwise (mobile). */
+	Auto,
+
+	/* BC1 for opaque textures and BC3 for the others. 4 or 8 bits per pixel. */
+	BC1BC3,
+
+	/* BC7 with a single subset. 8 bits per pixel, with less error than BC1
+	   and BC3 on gradients and alpha. */
+	BC7,
+
+	/* ASTC with 4x4 blocks, for mobile. 8 bits per pixel. */
+	ASTC4x4
+};
+
+/**
+ * Settings that decide which post-process steps are applied when loading an
+ * asset.
+ */
+USTRUCT(BlueprintType)
+struct RUNTIMEASSETIMPORT_API FAssetImportProfile {
+	GENERATED_BODY()
+
+	// Preset of post-process steps.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	EAssetImportProfileType ProfileType = EAssetImportProfileType::Quality;
+
+	// Post-process steps to apply, available only if ProfileType is Custom.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere,
+	          meta = (Bitmask,
+	                  BitmaskEnum = "/Script/RuntimeAssetImport."
+	                                "EAssetImportPostProcessStep",
+	                  EditCondition = "ProfileType == "
+	                                  "EAssetImportProfileType::Custom"))
+	int32 CustomPostProcessSteps = 0;
+
+	// Store the loaded sections in compact precision (float positions, packed
+	// normals and tangents, 8-bit colors, half-float UVs and 16-bit indices
+	// where possible) to reduce memory. See FLoadedMeshSectionData.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bCompactPrecision = false;
+
+	// Maximum width and height of the loaded textures in pixels. Larger
+	// textures are downscaled by halving (box filter) until they fit, keeping
+	// their aspect ratio. 0 means no limit.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ClampMin = "0"))
+	int32 MaxTextureSize = 0;
+
+	// Generate a full mip chain for the loaded textures (box filter), so that
+	// they do not alias at distance. Textures are decoded while loading
+	// instead of while constructing.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bGenerateTextureMips = false;
+
+	// Compress the loaded 8-bit textures into TextureCompressionFormat on the
+	// CPU, which takes 1/8 to 1/4 of the memory of uncompressed pixels.
+	// Textures whose size is not a multiple of 4, HDR textures, and textures
+	// on platforms without support for the format are left uncompressed.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	ETextureCompressionMode TextureCompression = ETextureCompressionMode::None;
+
+	// Pixel format to compress the loaded textures into, available only if
+	// TextureCompression is not None.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere,
+	          meta = (EditCondition = "TextureCompression != "
+	                                  "ETextureCompressionMode::None"))
+	ETextureCompressionFormat TextureCompressionFormat =
+	    ETextureCompressionFormat::Auto;
+
+public:
+	/**
+	 * Whether textures are processed (downscaled, mipmapped or compressed)
+	 * while loading, which requires them to be decoded.
+	 */
+	bool ProcessesTextures() const;
+};
+
+/**
+ * Hash of an import profile, used as a part of cache keys.
+ */
+FORCEINLINE uint32 GetTypeHash(const FAssetImportProfile& ImportProfile) {
+	// CustomPostProcessSteps matters only for the Custom profile
+	const auto& CustomPostProcessSteps =
+	    EAssetImportProfileType::Custom == ImportProfile.ProfileType
+	        ? ImportProfile.CustomPostProcessSteps
+	        : 0;
+
+	auto Hash = HashCombine(GetTypeHash(ImportProfile.ProfileType),
+	                        GetTypeHash(CustomPostProcessSteps));
+	Hash = HashCombine(Hash, GetTypeHash(ImportProfile.bCompactPrecision));
+	Hash = HashCombine(Hash, GetTypeHash(ImportProfile.MaxTextureSize));
+	Hash = HashCombine(Hash, GetTypeHash(ImportProfile.bGenerateTextureMips));
+	Hash = HashCombine(Hash, GetTypeHash(ImportProfile.TextureCompression));
+	Hash =
+	    HashCombine(Hash, GetTypeHash(ImportProfile.TextureCompressionFormat));
+	return Hash;
+}
@@ -2,9 +2,13 @@
 
 #pragma once
 
+#include "AssetImportCancellationToken.h"
+#include "AssetImportProfile.h"
 #include "CoreMinimal.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "LoadedMeshData.h"
+#include "LoadedMeshNodeData.h"
+#include "Tasks/Task.h"
 
 #include "AssetLoader.generated.h"
 
@@ -34,6 +38,13 @@ enum class ELoadMeshFromAssetDataResult : uint8 {
 	Failure
 };
 
+/**
+ * Callback receiving each node of a progressive load as soon as the node and
+ * all its sections are converted. Called on worker threads, possibly from
+ * multiple threads at the same time.
+ */
+using FOnLoadedMeshNode = TFunction<void(FLoadedMeshNodeData&& NodeData)>;
+
 /**
  * Blueprint Function Library for easy loading of assets at runtime.
  */
@@ -47,30 +58,186 @@ public:
 	 * supported by assimp.
 	 * @param        FilePath   Path to the asset file.
 	 * @param[out]   LoadMeshFromAssetFileResult Result of the execution.
+	 * @param        ImportProfile   Which post-process steps to apply.
 	 * @return  If the result is Success, the return value is valid,
 	 *          If the result is Failure, the return value is empty
 	 *          (default-constructed).
 	 */
 	UFUNCTION(BlueprintCallable,
-	          meta = (ExpandEnumAsExecs = "LoadMeshFromAssetFileResult"))
+	          meta = (ExpandEnumAsExecs = "LoadMeshFromAssetFileResult",
+	                  AutoCreateRefTerm = "ImportProfile"))
 	static UPARAM(DisplayName = "Mesh Data") FLoadedMeshData
 	    LoadMeshFromAssetFile(
 	        const FString&                FilePath,
-	        ELoadMeshFromAssetFileResult& LoadMeshFromAssetFileResult);
+	        ELoadMeshFromAssetFileResult& LoadMeshFromAssetFileResult,
+	        const FAssetImportProfile&    ImportProfile = FAssetImportProfile());
 
 	/**
 	 * Load mesh from the specified asset data. The data format must be one
 	 * supported by assimp.
 	 * @param        AssetData   Asset data on memory.
 	 * @param[out]   LoadMeshFromAssetDataResult Result of the execution.
+	 * @param        ImportProfile   Which post-process steps to apply.
 	 * @return  If the result is Success, the return value is valid,
 	 *          If the result is Failure, the return value is empty
 	 *          (default-constructed).
 	 */
 	UFUNCTION(BlueprintCallable,
-	          meta = (ExpandEnumAsExecs = "LoadMeshFromAssetDataResult"))
+	          meta = (ExpandEnumAsExecs = "LoadMeshFromAssetDataResult",
+	                  AutoCreateRefTerm = "ImportProfile"))
 	static UPARAM(DisplayName = "Mesh Data") FLoadedMeshData
 	    LoadMeshFromAssetData(
 	        const TArray<uint8>&          AssetData,
-	        ELoadMeshFromAssetDataResult& LoadMeshFromAssetDataResult);
+	        ELoadMeshFromAssetDataResult& LoadMeshFromAssetDataResult,
+	        const FAssetImportProfile&    ImportProfile = FAssetImportProfile());
+
+	/**
+	 * Load meshes from the specified asset files in parallel. The file formats
+	 * must be ones supported by assimp. Files are distributed over the worker
+	 * threads of the task graph and this function blocks until all of them
+	 * are loaded.
+	 * @param        FilePaths   Paths to the asset files.
+	 * @param[out]   LoadMeshFromAssetFileResults   Result of the execution for
+	 *                  each file, in the same order as FilePaths.
+	 * @param        MaxParallelism   Maximum number of files loaded at the same
+	 *                                time. 0 or less means as many as there are
+	 *                                worker threads.
+	 * @param        ImportProfile    Which post-process steps to apply.
+	 * @return  Mesh data for each file, in the same order as FilePaths.
+	 *          If the result of a file is Success, its element is valid,
+	 *          If the result of a file is Failure, its element is empty
+	 *          (default-constructed).
+	 */
+	UFUNCTION(BlueprintCallable, meta = (AutoCreateRefTerm = "ImportProfile"))
+	static UPARAM(DisplayName = "Mesh Data List") TArray<FLoadedMeshData>
+	    LoadMeshesFromAssetFiles(
+	        const TArray<FString>&                FilePaths,
+	        TArray<ELoadMeshFromAssetFileResult>& LoadMeshFromAssetFileResults,
+	        int32                                 MaxParallelism = 0,
+	        const FAssetImportProfile& ImportProfile = FAssetImportProfile());
+
+public:
+	/**
+	 * Asynchronous version of LoadMeshFromAssetFile. Reading the file, parsing
+	 * it with assimp and converting it to mesh data are all done on a worker
+	 * thread, so this function returns immediately.
+	 * @param   FilePath        Path to the asset file.
+	 * @param   ImportProfile   Which post-process steps to apply.
+	 * @param   CancellationToken   Token to cancel the load, or null. A
+	 *                              cancelable load does not use the memory
+	 *                              cache.
+	 * @return  Task whose result is the loaded mesh data if loading succeeded,
+	 *          or unset if it failed or was canceled.
+	 * @details  Not available from Blueprint. Use
+	 *           ULoadMeshFromAssetFileAsyncAction there.
+	 */
+	static UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+	    LoadMeshFromAssetFileAsync(
+	        const FString& FilePath, const FAssetImportProfile& ImportProfile = {},
+	        const FAssetImportCancellationTokenPtr& CancellationToken = nullptr);
+
+	/**
+	 * Asynchronous version of LoadMeshFromAssetData. Parsing the data with
+	 * assimp and converting it to mesh data are all done on a worker thread,
+	 * so this function returns immediately.
+	 * @param   AssetData   Asset data on memory. It is moved into the task, so
+	 *                      pass it with MoveTemp if the caller no longer needs
+	 *                      it.
+	 * @param   ImportProfile   Which post-process steps to apply.
+	 * @param   CancellationToken   Token to cancel the load, or null. A
+	 *                              cancelable load does not use the memory
+	 *                              cache.
+	 * @return  Task whose result is the loaded mesh data if loading succeeded,
+	 *          or unset if it failed or was canceled.
+	 * @details  Not available from Blueprint. Use
+	 *           ULoadMeshFromAssetDataAsyncAction there.
+	 */
+	static UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+	    LoadMeshFromAssetDataAsync(
+	        TArray<uint8> AssetData, const FAssetImportProfile& ImportProfile = {},
+	        const FAssetImportCancellationTokenPtr& CancellationToken = nullptr);
+
+	/**
+	 * Asynchronous version of LoadMeshesFromAssetFiles.
+	 * @param   FilePaths        Paths to the asset files.
+	 * @param   MaxParallelism   Maximum number of files loaded at the same
+	 *                           time. 0 or less means as many as there are
+	 *                           worker threads.
+	 * @param   ImportProfile    Which post-process steps to apply.
+	 * @return  Task whose result has an element for each file, in the same
+	 *          order as FilePaths. Each element is the loaded mesh data if
+	 *          loading of the file succeeded, or unset if it failed.
+	 */
+	static UE::Tasks::TTask<TArray<TOptional<FLoadedMeshData>>>
+	    LoadMeshesFromAssetFilesAsync(
+	        TArray<FString> FilePaths, int32 MaxParallelism = 0,
+	        const FAssetImportProfile& ImportProfile = {});
+
+	/**
+	 * Same as LoadMeshFromAssetFileAsync, but each node is also delivered to
+	 * OnNodeLoaded as soon as it is converted, while the other nodes are still
+	 * being converted, so that components can be built for the first nodes
+	 * before the whole scene is loaded. Nodes are delivered roughly in the
+	 * order of FLoadedMeshData::NodeList, and nodes without sections first.
+	 * The memory cache is not used, since a shared load cannot be delivered
+	 * progressively. On a disk cache hit, all nodes are delivered at once.
+	 * @param   FilePath        Path to the asset file.
+	 * @param   OnNodeLoaded    Callback receiving each node. Not called for
+	 *                          any node if the scene fails to load.
+	 * @param   ImportProfile   Which post-process steps to apply.
+	 * @param   CancellationToken   Token to cancel the load, or null. No more
+	 *                              nodes are delivered once canceled.
+	 * @return  Task whose result is the whole loaded mesh data (including
+	 *          textures) if loading succeeded, or unset if it failed or was
+	 *          canceled. It completes after OnNodeLoaded has returned for
+	 *          every delivered node.
+	 */
+	static UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+	    LoadMeshFromAssetFileProgressiveAsync(
+	        const FString& FilePath, FOnLoadedMeshNode OnNodeLoaded,
+	        const FAssetImportProfile&              ImportProfile     = {},
+	        const FAssetImportCancellationTokenPtr& CancellationToken = nullptr);
+
+	/**
+	 * Same as LoadMeshFromAssetFileProgressiveAsync, but from asset data.
+	 * @param   AssetData       Asset data on memory. It is moved into the task.
+	 * @param   OnNodeLoaded    Callback receiving each node.
+	 * @param   ImportProfile   Which post-process steps to apply.
+	 * @param   CancellationToken   Token to cancel the load, or null.
+	 * @return  Task whose result is the whole loaded mesh data if loading
+	 *          succeeded, or unset if it failed or was canceled.
+	 */
+	static UE::Tasks::TTask<TOptional<FLoadedMeshData>>
+	    LoadMeshFromAssetDataProgressiveAsync(
+	        TArray<uint8> AssetData, FOnLoadedMeshNode OnNodeLoaded,
+	        const FAssetImportProfile&              ImportProfile     = {},
+	        const FAssetImportCancellationTokenPtr& CancellationToken = nullptr);
+
+	/**
+	 * Same as LoadMeshFromAssetFileAsync, but the result is shared instead of
+	 * copied. If the memory cache is enabled in the project settings, the mesh
+	 * data is taken from / added to the cache, and concurrent requests for the
+	 * same file wait on a single load.
+	 * @param   FilePath        Path to the asset file.
+	 * @param   ImportProfile   Which post-process steps to apply.
+	 * @return  Task whose result is the shared mesh data if loading succeeded,
+	 *          or nullptr if it failed.
+	 */
+	static UE::Tasks::TTask<FLoadedMeshDataPtr>
+	    LoadSharedMeshFromAssetFileAsync(
+	        const FString& FilePath, const FAssetImportProfile& ImportProfile = {});
+
+	/**
+	 * Same as LoadMeshFromAssetDataAsync, but the result is shared instead of
+	 * copied. If the memory cache is enabled in the project settings, the mesh
+	 * data is taken from / added to the cache, and concurrent requests for the
+	 * same data wait on a single load.
+	 * @param   AssetData       Asset data on memory. It is moved into the task.
+	 * @param   ImportProfile   Which post-process steps to apply.
+	 * @return  Task whose result is the shared mesh data if loading succeeded,
+	 *          or nullptr if it failed.
+	 */
+	static UE::Tasks::TTask<FLoadedMeshDataPtr>
+	    LoadSharedMeshFromAssetDataAsync(
+	        TArray<uint8> AssetData, const FAssetImportProfile& ImportProfile = {});
 };
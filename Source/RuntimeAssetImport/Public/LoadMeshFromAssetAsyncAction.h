@@ -0,0 +1,160 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "AssetImportCancellationToken.h"
+#include "AssetImportProfile.h"
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintAsyncActionBase.h"
+#include "LoadedMeshData.h"
+#include "LoadedMeshNodeData.h"
+
+#include "LoadMeshFromAssetAsyncAction.generated.h"
+
+/**
+ * Output pin of the asynchronous load nodes.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FLoadMeshFromAssetAsyncActionOutputPin, const FLoadedMeshData&, MeshData);
+
+/**
+ * Output pin of the asynchronous load nodes, fired for each node as soon as it
+ * is converted.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+    FLoadMeshFromAssetAsyncActionNodePin, const FLoadedMeshNodeData&, NodeData);
+
+/**
+ * Blueprint async node that loads mesh from the specified asset file without
+ * blocking the game thread.
+ */
+UCLASS()
+class RUNTIMEASSETIMPORT_API ULoadMeshFromAssetFileAsyncAction
+    : public UBlueprintAsyncActionBase {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Load mesh from the specified asset file asynchronously. The file format
+	 * must be one supported by assimp. Loading is done on worker threads and
+	 * only the result is handed back to the game thread.
+	 * @param   WorldContextObject   World context object.
+	 * @param   FilePath             Path to the asset file.
+	 * @param   ImportProfile        Which post-process steps to apply.
+	 * @return  the async action object.
+	 */
+	UFUNCTION(BlueprintCallable,
+	          meta = (BlueprintInternalUseOnly = "true",
+	                  WorldContext = "WorldContextObject",
+	                  AutoCreateRefTerm = "ImportProfile"))
+	static ULoadMeshFromAssetFileAsyncAction* LoadMeshFromAssetFileAsync(
+	    UObject* WorldContextObject, const FString& FilePath,
+	    const FAssetImportProfile& ImportProfile = FAssetImportProfile());
+
+public:
+	// Called on the game thread when loading succeeded.
+	UPROPERTY(BlueprintAssignable)
+	FLoadMeshFromAssetAsyncActionOutputPin OnSuccess;
+
+	// Called on the game thread when loading failed. MeshData is empty
+	// (default-constructed).
+	UPROPERTY(BlueprintAssignable)
+	FLoadMeshFromAssetAsyncActionOutputPin OnFailure;
+
+	// Called on the game thread for each node as soon as it is converted,
+	// before OnSuccess. If bound, the memory cache is not used.
+	UPROPERTY(BlueprintAssignable)
+	FLoadMeshFromAssetAsyncActionNodePin OnNodeLoaded;
+
+public:
+	/**
+	 * Cancel loading. OnFailure is called once the load stops, and no more
+	 * nodes are delivered to OnNodeLoaded. If the load goes through the memory
+	 * cache, it is shared with other callers and runs to the end, but its
+	 * result is dropped.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void Cancel();
+
+	/**
+	 * Whether Cancel has been called.
+	 */
+	bool IsCanceled() const;
+
+public:
+	virtual void Activate() override;
+
+	/* internal fields */
+private:
+	FString FilePath;
+
+	FAssetImportCancellationTokenPtr CancellationToken;
+
+	FAssetImportProfile ImportProfile;
+};
+
+/**
+ * Blueprint async node that loads mesh from the specified asset data without
+ * blocking the game thread.
+ */
+UCLASS()
+class RUNTIMEASSETIMPORT_API ULoadMeshFromAssetDataAsyncAction
+    : public UBlueprintAsyncActionBase {
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Load mesh from the specified asset data asynchronously. The data format
+	 * must be one supported by assimp. Loading is done on worker threads and
+	 * only the result is handed back to the game thread.
+	 * @param   WorldContextObject   World context object.
+	 * @param   AssetData            Asset data on memory.
+	 * @param   ImportProfile        Which post-process steps to apply.
+	 * @return  the async action object.
+	 */
+	UFUNCTION(BlueprintCallable,
+	          meta = (BlueprintInternalUseOnly = "true",
+	                  WorldContext = "WorldContextObject",
+	                  AutoCreateRefTerm = "ImportProfile"))
+	static ULoadMeshFromAssetDataAsyncAction* LoadMeshFromAssetDataAsync(
+	    UObject* WorldContextObject, const TArray<uint8>& AssetData,
+	    const FAssetImportProfile& ImportProfile = FAssetImportProfile());
+
+public:
+	// Called on the game thread when loading succeeded.
+	UPROPERTY(BlueprintAssignable)
+	FLoadMeshFromAssetAsyncActionOutputPin OnSuccess;
+
+	// Called on the game thread when loading failed. MeshData is empty
+	// (default-constructed).
+	UPROPERTY(BlueprintAssignable)
+	FLoadMeshFromAssetAsyncActionOutputPin OnFailure;
+
+	// Called on the game thread for each node as soon as it is converted,
+	// before OnSuccess. If bound, the memory cache is not used.
+	UPROPERTY(BlueprintAssignable)
+	FLoadMeshFromAssetAsyncActionNodePin OnNodeLoaded;
+
+public:
+	/**
+	 * Cancel loading. Same as ULoadMeshFromAssetFileAsyncAction::Cancel.
+	 */
+	UFUNCTION(BlueprintCallable)
+	void Cancel();
+
+	/**
+	 * Whether Cancel has been called.
+	 */
+	bool IsCanceled() const;
+
+public:
+	virtual void Activate() override;
+
+	/* internal fields */
+private:
+	TArray<uint8> AssetData;
+
+	FAssetImportCancellationTokenPtr CancellationToken;
+
+	FAssetImportProfile ImportProfile;
+};
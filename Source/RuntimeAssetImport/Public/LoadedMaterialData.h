@@ -35,18 +35,19 @@ struct RUNTIMEASSETIMPORT_API FLoadedMaterialData {
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FLinearColor Color = FLinearColor(ForceInit);
 
-	// Texture data compressed into some format, available only if ColorStatus is
-	// TextureIsSet.
+	// Index in FLoadedMeshData::TextureList of the diffuse texture, available
+	// only if ColorStatus is TextureIsSet. Materials using the same image refer
+	// to the same texture.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	TArray<uint8> CompressedTextureData;
+	int32 TextureIndex = INDEX_NONE;
 
 	// Whether there exists texture or not.
 	// If the status is ColorIsSet, the Color property is set
-	// (CompressedTextureData is not available);
-	// if the status is TextureIsSet, the texture data is stored in
-	// CompressedTextureData. (Color property is not available);
+	// (TextureIndex is not available);
+	// if the status is TextureIsSet, TextureIndex refers to the texture.
+	// (Color property is not available);
 	// if the status is TextureWasSetButError, it means that the texture was set
-	// but its data could not be loaded, and both Color and CompressedTextureData
+	// but its data could not be loaded, and both Color and TextureIndex
 	// properties are not available.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	EColorStatus ColorStatus = EColorStatus::None;
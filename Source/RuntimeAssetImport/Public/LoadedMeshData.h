@@ -5,6 +5,8 @@
 #include "CoreMinimal.h"
 #include "LoadedMaterialData.h"
 #include "LoadedMeshNode.h"
+#include "LoadedMeshSectionData.h"
+#include "LoadedTextureData.h"
 
 #include "LoadedMeshData.generated.h"
 
@@ -22,8 +24,31 @@ struct RUNTIMEASSETIMPORT_API FLoadedMeshData {
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FLoadedMeshNode> NodeList;
 
+	// List of unique mesh sections. Which node has which sections is indicated
+	// by FLoadedMeshNode::SectionIndices.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FLoadedMeshSectionData> SectionList;
+
 	// List of materials. Which mesh (or more precisely, mesh section) uses which
 	// material is indicated by FLoadedMeshSectionData::MaterialIndex.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FLoadedMaterialData> MaterialList;
+
+	// List of unique textures. Which material uses which texture is indicated
+	// by FLoadedMaterialData::TextureIndex.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FLoadedTextureData> TextureList;
+
+public:
+	/**
+	 * Get the number of bytes allocated by the arrays of this mesh data.
+	 */
+	SIZE_T GetAllocatedSize() const;
 };
+
+/**
+ * Immutable mesh data shared between multiple owners (e.g. a cache and the
+ * callers that requested the same asset).
+ */
+using FLoadedMeshDataPtr =
+    TSharedPtr<const FLoadedMeshData, ESPMode::ThreadSafe>;
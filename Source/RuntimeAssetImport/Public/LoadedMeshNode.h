@@ -3,15 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "LoadedMeshSectionData.h"
 
 #include "LoadedMeshNode.generated.h"
 
 /**
  * A class that represents a grouping of multiple mesh sections, called a Node.
  * One loaded mesh is made up of tree-like nodes. Each node has a name, a
- * parent, and a Transform relative to the parent. Each node also has multiple
- * mesh sections.
+ * parent, and a Transform relative to the parent. Each node also refers to
+ * multiple mesh sections.
  */
 USTRUCT(BlueprintType)
 struct RUNTIMEASSETIMPORT_API FLoadedMeshNode {
@@ -25,13 +24,21 @@ struct RUNTIMEASSETIMPORT_API FLoadedMeshNode {
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	FTransform RelativeTransform;
 
-	// Actual mesh section data. There may be more than one.
+	// Indices in FLoadedMeshData::SectionList of the mesh sections of this
+	// node. There may be more than one. The same section may be referred to by
+	// multiple nodes (instancing).
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
-	TArray<FLoadedMeshSectionData> Sections;
+	TArray<int32> SectionIndices;
 
 	// All nodes are stored in FLoadedMeshData::NodeList as a sequence list.
 	// The index of the parent node in that array.
 	// Min indicates that there is no parent node (i.e., the only root node).
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	int ParentNodeIndex = std::numeric_limits<int>::min();
+
+public:
+	/**
+	 * Get the number of bytes allocated by the arrays of this node.
+	 */
+	SIZE_T GetAllocatedSize() const;
 };
@@ -0,0 +1,47 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "LoadedMaterialData.h"
+#include "LoadedMeshNode.h"
+#include "LoadedMeshSectionData.h"
+
+#include "LoadedMeshNodeData.generated.h"
+
+/**
+ * Data of a single node delivered while the rest of the mesh data is still
+ * being converted (see UAssetLoader::LoadMeshFromAssetFileProgressiveAsync).
+ * It holds the node together with copies of its sections and of the materials
+ * they use, so that components can be built for it right away.
+ * Textures are not included, since they are finished after all nodes. They
+ * are in the mesh data returned at the end of the load.
+ */
+USTRUCT(BlueprintType)
+struct RUNTIMEASSETIMPORT_API FLoadedMeshNodeData {
+	GENERATED_BODY()
+
+	// Index of the node in FLoadedMeshData::NodeList of the final mesh data.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int32 NodeIndex = INDEX_NONE;
+
+	// The node. Its SectionIndices and ParentNodeIndex refer to the lists of
+	// the final mesh data.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FLoadedMeshNode Node;
+
+	// Sections of the node, in the same order as Node.SectionIndices.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FLoadedMeshSectionData> Sections;
+
+	// Indices in FLoadedMeshData::MaterialList of the materials used by
+	// Sections, without duplicates.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<int32> MaterialIndices;
+
+	// Materials used by Sections, in the same order as MaterialIndices.
+	// Their TextureIndex refers to FLoadedMeshData::TextureList of the final
+	// mesh data.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<FLoadedMaterialData> Materials;
+};
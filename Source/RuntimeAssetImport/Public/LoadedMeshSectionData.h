@@ -3,12 +3,20 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Math/Vector2DHalf.h"
 #include "ProceduralMeshComponent.h"
 
 #include "LoadedMeshSectionData.generated.h"
 
 /**
- * Mesh section data that make up a portion of a single mesh node.
+ * Mesh section data that make up a portion of mesh nodes.
+ * A section may be shared by multiple nodes.
+ * A section is stored either in full precision (Vertices, Triangles, ...) or,
+ * if loaded with FAssetImportProfile::bCompactPrecision, in compact precision
+ * (CompactVertices, CompactTriangles, ...). Use IsCompact() to tell which, and
+ * ToFullPrecision() to get a full precision copy of a compact section.
+ * Attribute streams other than the vertices are empty if the attribute is
+ * absent, and have a single element if all vertices share the same value.
  */
 USTRUCT(BlueprintType)
 struct RUNTIMEASSETIMPORT_API FLoadedMeshSectionData {
@@ -32,22 +40,26 @@ struct RUNTIMEASSETIMPORT_API FLoadedMeshSectionData {
 	TArray<int32> Triangles;
 
 	// An array of normal vectors for each element of Vertices. Must have
-	// the same number of elements as Vertices.
+	// the same number of elements as Vertices, or be empty if there is no
+	// normal, or have 1 element if all the normals are the same.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FVector> Normals;
 
 	// An array of texture coordinates for each element of Vertices.
-	// Must have the same number of elements as Vertices.
+	// Must have the same number of elements as Vertices, or be empty if there
+	// is no UV channel, or have 1 element if all the coordinates are the same.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FVector2D> UV0Channel;
 
 	// Array of vertex color for each element of Vertices.
-	// Must have the same number of elements as Vertices.
+	// Must have the same number of elements as Vertices, or be empty if there
+	// is no vertex color, or have 1 element if all the colors are the same.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FLinearColor> VertexColors0;
 
 	// An array indicating the tangent direction of each element of Vertices.
-	// Must have the same number of elements as Vertices.
+	// Must have the same number of elements as Vertices, or be empty if there
+	// is no tangent, or have 1 element if all the tangents are the same.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	TArray<FProcMeshTangent> Tangents;
 
@@ -55,4 +67,83 @@ struct RUNTIMEASSETIMPORT_API FLoadedMeshSectionData {
 	// section. Max means no material.
 	UPROPERTY(BlueprintReadWrite, EditAnywhere)
 	int MaterialIndex = std::numeric_limits<int>::min();
+
+	/* compact precision streams (not exposed to Blueprint, since their element
+	 * types are not). The same rules for absent and constant streams apply. */
+public:
+	// Coordinates of vertices in single precision.
+	TArray<FVector3f> CompactVertices;
+
+	// Same as Triangles, used instead of it if there are fewer than 65536
+	// vertices. Otherwise Triangles is used even in compact precision.
+	TArray<uint16> CompactTriangles;
+
+	// Normals, octahedral-encoded into 2 16-bit snorms each.
+	TArray<uint32> CompactNormals;
+
+	// Texture coordinates in half precision.
+	TArray<FVector2DHalf> CompactUV0Channel;
+
+	// Vertex colors quantized to 8 bits per channel (without sRGB conversion).
+	TArray<FColor> CompactVertexColors0;
+
+	// Tangents, octahedral-encoded into 2 16-bit snorms each.
+	// bFlipTangentY is always false.
+	TArray<uint32> CompactTangents;
+
+public:
+	/**
+	 * Get the number of bytes allocated by the arrays of this section.
+	 */
+	SIZE_T GetAllocatedSize() const;
+
+	/**
+	 * Whether this section is stored in compact precision.
+	 */
+	bool IsCompact() const;
+
+	/**
+	 * Whether this section is stored in full precision and every present
+	 * attribute stream has one element per vertex, so that it can be passed to
+	 * mesh components as it is.
+	 */
+	bool IsFullPrecision() const;
+
+	/**
+	 * Get a copy of this section in full precision, with every present
+	 * attribute stream having one element per vertex. Absent streams stay
+	 * empty. If IsFullPrecision(), this section is just copied.
+	 */
+	FLoadedMeshSectionData ToFullPrecision() const;
+
+	/**
+	 * Get this section in full precision without copying it if it already is.
+	 * @param[out]   Storage   section to store the full precision copy in, if
+	 *                         one is needed. Must outlive the returned
+	 *                         reference.
+	 * @return  this section if IsFullPrecision(), otherwise Storage set to
+	 *          ToFullPrecision().
+	 */
+	const FLoadedMeshSectionData&
+	    GetFullPrecision(FLoadedMeshSectionData& Storage) const;
+
+	/**
+	 * Whether the section has normals.
+	 */
+	bool HasNormals() const;
+
+	/**
+	 * Whether the section has the first UV channel.
+	 */
+	bool HasUV0Channel() const;
+
+	/**
+	 * Whether the section has the first vertex color channel.
+	 */
+	bool HasVertexColors0() const;
+
+	/**
+	 * Whether the section has tangents.
+	 */
+	bool HasTangents() const;
 };
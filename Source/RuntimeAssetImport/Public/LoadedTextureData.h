@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PixelFormat.h"
+
+#include "LoadedTextureData.generated.h"
+
+/**
+ * Data of a loaded texture.
+ * The texture is stored either compressed into some image format
+ * (CompressedData) or as uncompressed pixels (RawData).
+ * A texture may be shared by multiple materials.
+ * Textures read from external files (rather than embedded in the asset) have
+ * SourceFilePath set, and are always stored uncompressed. Unless they are
+ * processed while loading, their pixels are shared with the texture cache
+ * through SharedRawData instead of being copied into RawData.
+ * Textures stored in GPU-ready containers (DDS, KTX2) are kept in RawData in
+ * their block-compressed pixel format, without being decoded.
+ */
+USTRUCT(BlueprintType)
+struct RUNTIMEASSETIMPORT_API FLoadedTextureData {
+	GENERATED_BODY()
+
+	// Texture data compressed into some image format (e.g. PNG, JPEG).
+	// Empty if the texture is stored in RawData.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<uint8> CompressedData;
+
+	// Uncompressed pixels of the texture in RawFormat. Textures stored
+	// uncompressed in the asset are passed through as they are, without being
+	// encoded to an image format. Empty if the texture is stored in
+	// CompressedData. If NumMips is more than 1, the mips are packed one after
+	// another from the largest.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TArray<uint8> RawData;
+
+	// Width of RawData in pixels.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int32 RawWidth = 0;
+
+	// Height of RawData in pixels.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int32 RawHeight = 0;
+
+	// Pixel format of RawData.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	TEnumAsByte<EPixelFormat> RawFormat = PF_Unknown;
+
+	// Number of mips in RawData. The width and height of each mip are half of
+	// the previous one (rounded down, and at least 1).
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int32 NumMips = 1;
+
+	// Whether RawData is in sRGB color space. false for linear data such as
+	// HDR images and normal maps stored in BC4/BC5.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	bool bSRGB = true;
+
+	// Estimated number of bytes the texture takes once it is created, with
+	// all its mips, which can be used to enforce texture memory budgets.
+	// 0 if unknown (e.g. the texture could not be decoded).
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	int64 MemorySize = 0;
+
+	// Absolute path of the file the texture was read from, if the texture is
+	// not embedded in the asset. Empty if embedded.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FString SourceFilePath;
+
+	// Path of the file the texture was read from as the asset refers to it
+	// (relative to the directory of the asset, or absolute), if the texture is
+	// not embedded in the asset. Empty if embedded.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere)
+	FString SourceFilePathInAsset;
+
+	// Uncompressed pixels shared with the texture cache and the other assets
+	// referring to the same file, used instead of RawData. Null if the pixels
+	// are in RawData or CompressedData. Not exposed to Blueprints, since it is
+	// immutable.
+	TSharedPtr<const TArray<uint8>, ESPMode::ThreadSafe> SharedRawData;
+
+public:
+	/**
+	 * Get the uncompressed pixels, whether they are in RawData or shared
+	 * through SharedRawData.
+	 */
+	const TArray<uint8>& GetRawData() const {
+		return SharedRawData.IsValid() ? *SharedRawData : RawData;
+	}
+
+	/**
+	 * Get the number of bytes allocated by the arrays of this texture data,
+	 * including the shared pixels.
+	 */
+	SIZE_T GetAllocatedSize() const;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
+#include "Tasks/Task.h"
 
 class FRuntimeAssetImportModule : public IModuleInterface
 {
@@ -12,4 +13,8 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** Task filling the importer pool, started at startup if enabled in the settings */
+	UE::Tasks::FTask ImporterWarmUpTask;
 };
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+
+#include "RuntimeAssetImportSettings.generated.h"
+
+/**
+ * Project settings of the Runtime Asset Import plugin.
+ * Shown in Project Settings > Plugins > Runtime Asset Import.
+ */
+UCLASS(config = Game, defaultconfig,
+       meta = (DisplayName = "Runtime Asset Import"))
+class RUNTIMEASSETIMPORT_API URuntimeAssetImportSettings
+    : public UDeveloperSettings {
+	GENERATED_BODY()
+
+public:
+	// Whether to cache converted mesh data on disk. When enabled, loading an
+	// asset whose content and import profile are the same as a previous load
+	// reads the cached data instead of importing it again with assimp.
+	// External textures referenced from the asset are not stored in the cache,
+	// but read again through the texture cache when an entry is loaded.
+	UPROPERTY(config, EditAnywhere, Category = "Disk Cache")
+	bool bEnableDiskCache = false;
+
+	// Directory to store the disk cache in. A relative path is relative to the
+	// project's Saved directory.
+	UPROPERTY(config, EditAnywhere, Category = "Disk Cache",
+	          meta = (EditCondition = "bEnableDiskCache"))
+	FString DiskCacheDirectory = TEXT("RuntimeAssetImportCache");
+
+	// Maximum total size of the disk cache in megabytes. Least recently used
+	// entries are deleted when the cache grows larger than this.
+	UPROPERTY(config, EditAnywhere, Category = "Disk Cache",
+	          meta = (EditCondition = "bEnableDiskCache", ClampMin = "1"))
+	int32 MaxDiskCacheSizeMB = 2048;
+
+	// Whether to keep loaded mesh data in memory and share it between callers
+	// that load the same asset. Files are identified by path, modification time
+	// and size, and data on memory by its content hash. An entry is loaded
+	// again if another file it was converted from (e.g. a texture) has changed.
+	// Concurrent loads of the same asset are coalesced onto one import.
+	UPROPERTY(config, EditAnywhere, Category = "Memory Cache")
+	bool bEnableMemoryCache = false;
+
+	// Maximum total size of the mesh data kept in the memory cache in
+	// megabytes. Least recently used entries are released when the cache grows
+	// larger than this.
+	UPROPERTY(config, EditAnywhere, Category = "Memory Cache",
+	          meta = (EditCondition = "bEnableMemoryCache", ClampMin = "1"))
+	int32 MaxMemoryCacheSizeMB = 512;
+
+	// Maximum total size of the decoded external textures (image files
+	// referenced from assets) kept in memory in megabytes. Files are identified
+	// by path, modification time and size, so a texture shared by multiple
+	// assets is read and decoded only once while it is cached. 0 keeps no
+	// texture, but concurrent loads of the same file are still coalesced.
+	UPROPERTY(config, EditAnywhere, Category = "Texture Cache",
+	          meta = (ClampMin = "0"))
+	int32 MaxTextureCacheSizeMB = 256;
+
+	// Maximum number of idle assimp importers kept for reuse. Loads borrow an
+	// importer instead of constructing one, which registers every importer and
+	// post-processing step of assimp. 0 constructs a new importer for every
+	// load.
+	UPROPERTY(config, EditAnywhere, Category = "Importer Pool",
+	          meta = (ClampMin = "0"))
+	int32 NumPooledImporters = 4;
+
+	// Whether to fill the importer pool on a worker thread when the module
+	// starts up. This also loads the assimp library, so that the first load
+	// does not hitch.
+	UPROPERTY(config, EditAnywhere, Category = "Importer Pool")
+	bool bWarmUpImportersOnStartup = false;
+
+	// Whether to convert GLB, binary STL, binary PLY and OBJ files without
+	// assimp when the result is the same as assimp's (OBJ values may differ
+	// slightly, e.g. generated normals). Disable this to import every asset
+	// with assimp (e.g. to compare the results). The disk cache keeps the
+	// entries of both apart.
+	UPROPERTY(config, EditAnywhere, Category = "Native Loaders")
+	bool bEnableNativeLoaders = true;
+};
@@ -42,6 +42,10 @@ public class RuntimeAssetImport : ModuleRules
                 "Engine",
                 "Slate",
                 "SlateCore",
+                "ImageWrapper",
+                "ImageCore",
+                "DeveloperSettings",
+                "Json",
 				// ... add private dependencies that you statically link with here ...	
 			}
             );
@@ -43,8 +43,9 @@ public class assimp : ModuleRules
             // Delay-load the DLL, so we can load it from the right place first
             PublicDelayLoadDLLs.Add(Path.Combine(assimpDylibFilePath));
 
-            // Ensure that the DLL is staged along with the executable
-            RuntimeDependencies.Add(assimpDylibFilePath);
+            // Ensure that the DLL is staged along with the executable, with
+            // the libraries it links (e.g. draco)
+            RuntimeDependencies.Add(Path.Combine(assimpBinDirectoryPath, "*.dylib"));
         }
         else if (Target.Platform == UnrealTargetPlatform.Android)
         {